@@ -0,0 +1,62 @@
+/*
+ * bench.h
+ * Timing helpers shared by the CAM benchmark programs.
+ */
+
+#ifndef CAM_BENCH_H
+#define CAM_BENCH_H
+
+#include "cam/cam.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(CAM_CMP_MSVC) && (defined(CAM_ARCH_X86) || defined(CAM_ARCH_X64))
+#include <intrin.h>
+#define BENCH_HAS_TSC
+#elif (defined(CAM_CMP_GCC) || defined(CAM_CMP_CLANG)) && (defined(CAM_ARCH_X86) || defined(CAM_ARCH_X64))
+#include <x86intrin.h>
+#define BENCH_HAS_TSC
+#endif
+
+/* Monotonic wall clock in nanoseconds */
+static inline double bench_now_ns() {
+#if defined(_WIN32)
+  LARGE_INTEGER freq, t;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+#endif
+}
+
+/* Time stamp counter in reference cycles, or 0 where there is none */
+static inline uint64_t bench_cycles() {
+#if defined(BENCH_HAS_TSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* Keep the optimizer from discarding a computed value */
+static volatile float bench_sink;
+
+static inline void bench_consume(float f) {
+  bench_sink = f;
+}
+
+/* Uniform random float in [lo, hi) from a fixed-seed LCG, so runs are comparable */
+static inline float bench_randf(uint32_t* state, float lo, float hi) {
+  *state = *state * 1664525u + 1013904223u;
+  return lo + (hi - lo) * (float)(*state >> 8) * (1.0f / 16777216.0f);
+}
+
+#endif
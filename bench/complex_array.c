@@ -0,0 +1,152 @@
+/*
+ * complex_array.c
+ * Compares the interleaved (cfloat_*_n) and split (cfloat_soa_*) array kernels
+ * against C99 float _Complex loops over the same data.
+ */
+
+#include "bench.h"
+#include <complex.h>
+#include <math.h>
+
+#define BENCH_COUNT (1 << 16)
+#define BENCH_REPS  25
+
+/* Shared operands */
+static cfloat* aos_a;
+static cfloat* aos_b;
+static cfloat* aos_r;
+static float* real_r;
+static cfloat_soa soa_a, soa_b, soa_r;
+
+/* C99 loops, reading the cfloat arrays through their float _Complex layout */
+static void c99_mul() {
+  float _Complex* a = (float _Complex*)aos_a;
+  float _Complex* b = (float _Complex*)aos_b;
+  float _Complex* r = (float _Complex*)aos_r;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r[i] = a[i] * b[i]; }
+}
+static void c99_conjmul() {
+  float _Complex* a = (float _Complex*)aos_a;
+  float _Complex* b = (float _Complex*)aos_b;
+  float _Complex* r = (float _Complex*)aos_r;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r[i] = a[i] * conjf(b[i]); }
+}
+static void c99_mag() {
+  float _Complex* a = (float _Complex*)aos_a;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { real_r[i] = cabsf(a[i]); }
+}
+static void c99_phase() {
+  float _Complex* a = (float _Complex*)aos_a;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { real_r[i] = cargf(a[i]); }
+}
+static void c99_exp() {
+  float _Complex* b = (float _Complex*)aos_b;
+  float _Complex* r = (float _Complex*)aos_r;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r[i] = cexpf(b[i]); }
+}
+
+/* Interleaved calls */
+static void aos_mul() { cfloat_mul_n(aos_r, aos_a, aos_b, BENCH_COUNT); }
+static void aos_conjmul() { cfloat_conjmul_n(aos_r, aos_a, aos_b, BENCH_COUNT); }
+static void aos_mag() { cfloat_mag_n(real_r, aos_a, BENCH_COUNT); }
+static void aos_phase() { cfloat_phase_n(real_r, aos_a, BENCH_COUNT); }
+static void aos_exp() { cfloat_exp_n(aos_r, aos_b, BENCH_COUNT); }
+
+/* Split calls */
+static void soa_mul() { cfloat_soa_mul(&soa_r, &soa_a, &soa_b); }
+static void soa_conjmul() { cfloat_soa_conjmul(&soa_r, &soa_a, &soa_b); }
+static void soa_mag() { cfloat_soa_mag(real_r, &soa_a); }
+static void soa_phase() { cfloat_soa_phase(real_r, &soa_a); }
+static void soa_exp() { cfloat_soa_exp(&soa_r, &soa_b); }
+static void soa_split() { cfloat_soa_from_interleaved(&soa_r, aos_a); }
+static void soa_join() { cfloat_soa_to_interleaved(aos_r, &soa_a); }
+
+typedef struct {
+  const char* name;
+  void (*fn)();
+} bench_case;
+
+static const bench_case cases[] = {
+  { "c99 mul",                 c99_mul },
+  { "cfloat_mul_n",            aos_mul },
+  { "cfloat_soa_mul",          soa_mul },
+  { "c99 conjmul",             c99_conjmul },
+  { "cfloat_conjmul_n",        aos_conjmul },
+  { "cfloat_soa_conjmul",      soa_conjmul },
+  { "c99 cabsf",               c99_mag },
+  { "cfloat_mag_n",            aos_mag },
+  { "cfloat_soa_mag",          soa_mag },
+  { "c99 cargf",               c99_phase },
+  { "cfloat_phase_n",          aos_phase },
+  { "cfloat_soa_phase",        soa_phase },
+  { "c99 cexpf",               c99_exp },
+  { "cfloat_exp_n",            aos_exp },
+  { "cfloat_soa_exp",          soa_exp },
+  { "from_interleaved",        soa_split },
+  { "to_interleaved",          soa_join },
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(void (*fn)()) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    fn();
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / BENCH_COUNT;
+}
+
+int main() {
+  aos_a = (cfloat*)cam_aligned_alloc(BENCH_COUNT * sizeof(cfloat), CAM_SIMD_ALIGN);
+  aos_b = (cfloat*)cam_aligned_alloc(BENCH_COUNT * sizeof(cfloat), CAM_SIMD_ALIGN);
+  aos_r = (cfloat*)cam_aligned_alloc(BENCH_COUNT * sizeof(cfloat), CAM_SIMD_ALIGN);
+  real_r = (float*)cam_aligned_alloc(BENCH_COUNT * sizeof(float), CAM_SIMD_ALIGN);
+  soa_a = cfloat_soa_make(BENCH_COUNT);
+  soa_b = cfloat_soa_make(BENCH_COUNT);
+  soa_r = cfloat_soa_make(BENCH_COUNT);
+  if (!aos_a || !aos_b || !aos_r || !real_r || !soa_a.count || !soa_b.count || !soa_r.count) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  // Random values in both layouts; b stays small enough for exp
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    aos_a[i] = cfloat_make(bench_randf(&seed, -100.0f, 100.0f), bench_randf(&seed, -100.0f, 100.0f));
+    aos_b[i] = cfloat_make(bench_randf(&seed, -4.0f, 4.0f), bench_randf(&seed, -10.0f, 10.0f));
+  }
+  cfloat_soa_from_interleaved(&soa_a, aos_a);
+  cfloat_soa_from_interleaved(&soa_b, aos_b);
+
+  printf("%d values, tier %s, best of %d runs\n", BENCH_COUNT, cam_tier_name(cam_get_tier()), BENCH_REPS);
+  printf("%-22s %10s\n", "op", "ns/elem");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    printf("%-22s %10.3f\n", cases[c].name, time_per_element(cases[c].fn));
+  }
+
+  // Largest relative deviation of the approximated kernels from libm
+  float err_phase = 0.0f, err_exp = 0.0f;
+  cfloat_phase_n(real_r, aos_a, BENCH_COUNT);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    err_phase = fmaxf(err_phase, fabsf(real_r[i] - cfloat_phase(&aos_a[i])));
+  }
+  cfloat_exp_n(aos_r, aos_b, BENCH_COUNT);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    cfloat ref = cfloat_exp(&aos_b[i]);
+    cfloat d = cfloat_sub(&aos_r[i], &ref);
+    err_exp = fmaxf(err_exp, cfloat_mag(&d) / cfloat_mag(&ref));
+  }
+  printf("max |phase - atan2f| = %.3g, max relative |exp - libm| = %.3g\n", err_phase, err_exp);
+  bench_consume(real_r[BENCH_COUNT - 1] + aos_r[BENCH_COUNT - 1].re);
+
+  cfloat_soa_free(&soa_a);
+  cfloat_soa_free(&soa_b);
+  cfloat_soa_free(&soa_r);
+  cam_aligned_free(aos_a);
+  cam_aligned_free(aos_b);
+  cam_aligned_free(aos_r);
+  cam_aligned_free(real_r);
+  return 0;
+}
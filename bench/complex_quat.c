@@ -0,0 +1,135 @@
+/*
+ * complex_quat.c
+ * Compares the quat_soa batch kernels against looping over the per-quaternion
+ * functions, and slerp against the textbook acos/sin formulation.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_COUNT (1 << 16)
+#define BENCH_REPS  25
+
+/* Shared operands */
+static quat* aos_a;
+static quat* aos_b;
+static quat* aos_r;
+static quat_soa soa_a, soa_b, soa_r;
+static const float blend = 0.35f;
+
+/* Reference slerp with a branch for nearly parallel inputs */
+static quat slerp_exact(quat* a, quat* b, float t) {
+  float d = quat_dot(a, b);
+  float s = 1.0f;
+  if (d < 0.0f) { d = -d; s = -1.0f; }
+  float wa, wb;
+  if (d > 0.9995f) {
+    wa = 1.0f - t;
+    wb = t;
+  }
+  else {
+    float angle = acosf(d);
+    float rsin = 1.0f / sinf(angle);
+    wa = sinf((1.0f - t) * angle) * rsin;
+    wb = sinf(t * angle) * rsin;
+  }
+  wb *= s;
+  return quat_make((wa * quat_getx(a)) + (wb * quat_getx(b)), (wa * quat_gety(a)) + (wb * quat_gety(b)),
+                   (wa * quat_getz(a)) + (wb * quat_getz(b)), (wa * quat_getw(a)) + (wb * quat_getw(b)));
+}
+
+/* Per-element loops */
+static void loop_mul() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos_r[i] = quat_mul(&aos_a[i], &aos_b[i]); } }
+static void loop_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos_r[i] = quat_norm(&aos_a[i]); } }
+static void loop_nlerp() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos_r[i] = quat_nlerp(&aos_a[i], &aos_b[i], blend); } }
+static void loop_slerp() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos_r[i] = quat_slerp(&aos_a[i], &aos_b[i], blend); } }
+static void loop_slerp_exact() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos_r[i] = slerp_exact(&aos_a[i], &aos_b[i], blend); } }
+
+/* Batch calls */
+static void soa_mul() { quat_soa_mul(&soa_r, &soa_a, &soa_b); }
+static void soa_norm() { quat_soa_norm(&soa_r, &soa_a); }
+static void soa_nlerp() { quat_soa_nlerp(&soa_r, &soa_a, &soa_b, blend); }
+static void soa_slerp() { quat_soa_slerp(&soa_r, &soa_a, &soa_b, blend); }
+
+typedef struct {
+  const char* name;
+  void (*fn)();
+} bench_case;
+
+static const bench_case cases[] = {
+  { "loop quat_mul",         loop_mul },
+  { "batch quat_soa_mul",    soa_mul },
+  { "loop quat_norm",        loop_norm },
+  { "batch quat_soa_norm",   soa_norm },
+  { "loop quat_nlerp",       loop_nlerp },
+  { "batch quat_soa_nlerp",  soa_nlerp },
+  { "loop acos/sin slerp",   loop_slerp_exact },
+  { "loop quat_slerp",       loop_slerp },
+  { "batch quat_soa_slerp",  soa_slerp },
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(void (*fn)()) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    fn();
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / BENCH_COUNT;
+}
+
+int main() {
+  aos_a = (quat*)cam_aligned_alloc(BENCH_COUNT * sizeof(quat), CAM_SIMD_ALIGN);
+  aos_b = (quat*)cam_aligned_alloc(BENCH_COUNT * sizeof(quat), CAM_SIMD_ALIGN);
+  aos_r = (quat*)cam_aligned_alloc(BENCH_COUNT * sizeof(quat), CAM_SIMD_ALIGN);
+  soa_a = quat_soa_make(BENCH_COUNT);
+  soa_b = quat_soa_make(BENCH_COUNT);
+  soa_r = quat_soa_make(BENCH_COUNT);
+  if (!aos_a || !aos_b || !aos_r || !soa_a.count || !soa_b.count || !soa_r.count) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  // Random unit quaternions in both layouts
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    quat a = quat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f),
+                       bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+    quat b = quat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f),
+                       bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+    aos_a[i] = quat_norm(&a);
+    aos_b[i] = quat_norm(&b);
+    quat_soa_set(&soa_a, i, &aos_a[i]);
+    quat_soa_set(&soa_b, i, &aos_b[i]);
+  }
+
+  printf("%d quaternions, tier %s, best of %d runs\n", BENCH_COUNT, cam_tier_name(cam_get_tier()), BENCH_REPS);
+  printf("%-22s %10s\n", "op", "ns/elem");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    printf("%-22s %10.3f\n", cases[c].name, time_per_element(cases[c].fn));
+  }
+
+  // Largest deviation of the batch slerp from the reference
+  float err = 0.0f;
+  quat_soa_slerp(&soa_r, &soa_a, &soa_b, blend);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    quat ref = slerp_exact(&aos_a[i], &aos_b[i], blend);
+    quat got = quat_soa_get(&soa_r, i);
+    err = fmaxf(err, fabsf(quat_getx(&ref) - quat_getx(&got)));
+    err = fmaxf(err, fabsf(quat_gety(&ref) - quat_gety(&got)));
+    err = fmaxf(err, fabsf(quat_getz(&ref) - quat_getz(&got)));
+    err = fmaxf(err, fabsf(quat_getw(&ref) - quat_getw(&got)));
+  }
+  printf("max |quat_soa_slerp - reference| = %.3g\n", err);
+  bench_consume(quat_getx(&aos_r[BENCH_COUNT - 1]));
+
+  quat_soa_free(&soa_a);
+  quat_soa_free(&soa_b);
+  quat_soa_free(&soa_r);
+  cam_aligned_free(aos_a);
+  cam_aligned_free(aos_b);
+  cam_aligned_free(aos_r);
+  return 0;
+}
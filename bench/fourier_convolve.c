@@ -0,0 +1,150 @@
+/*
+ * fourier_convolve.c
+ * Times cam_convolve and cam_cconvolve of a long signal by filters from 4 to 4096
+ * values against plain sums of products, and cam_fir_run over a stream in blocks.
+ * Reports nanoseconds per output, and the largest difference from the sums in
+ * double precision relative to the largest output.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_SIGNAL ((size_t)1 << 16)   // Signal length
+#define BENCH_STREAM ((size_t)1 << 20)   // Stream length for cam_fir_run
+#define BENCH_REPS 5
+
+static const size_t taps[] = { 4, 8, 16, 32, 64, 128, 256, 512, 1024, 4096 };
+static const size_t blocks[] = { 64, 512, 4096 };
+
+// Largest difference of dst from the exact convolution, over its largest value
+static double check_real(const float* dst, const float* x, size_t nx, const float* h, size_t nh) {
+  double err = 0.0, top = 0.0;
+  for (size_t k = 0; k < nx + nh - 1; k += 7) {
+    double s = 0.0;
+    for (size_t j = (k >= nx) ? k - nx + 1 : 0; j < nh && j <= k; ++j) { s += (double)h[j] * (double)x[k - j]; }
+    if (fabs(s) > top) { top = fabs(s); }
+    if (fabs(s - (double)dst[k]) > err) { err = fabs(s - (double)dst[k]); }
+  }
+  return (top > 0.0) ? err / top : err;
+}
+
+static double check_complex(const cfloat* dst, const cfloat* x, size_t nx, const cfloat* h, size_t nh) {
+  double err = 0.0, top = 0.0;
+  for (size_t k = 0; k < nx + nh - 1; k += 7) {
+    double re = 0.0, im = 0.0;
+    for (size_t j = (k >= nx) ? k - nx + 1 : 0; j < nh && j <= k; ++j) {
+      re += ((double)h[j].re * x[k - j].re) - ((double)h[j].im * x[k - j].im);
+      im += ((double)h[j].re * x[k - j].im) + ((double)h[j].im * x[k - j].re);
+    }
+    double mag = hypot(re, im), d = hypot(re - dst[k].re, im - dst[k].im);
+    if (mag > top) { top = mag; }
+    if (d > err) { err = d; }
+  }
+  return (top > 0.0) ? err / top : err;
+}
+
+int main() {
+  size_t most = taps[sizeof(taps) / sizeof(taps[0]) - 1];
+  float* x = (float*)cam_aligned_alloc(BENCH_STREAM * sizeof(float), CAM_SIMD_ALIGN);
+  float* y = (float*)cam_aligned_alloc(BENCH_STREAM * sizeof(float), CAM_SIMD_ALIGN);
+  float* h = (float*)cam_aligned_alloc(most * sizeof(float), CAM_SIMD_ALIGN);
+  cfloat* cx = (cfloat*)cam_aligned_alloc(BENCH_SIGNAL * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* cy = (cfloat*)cam_aligned_alloc((BENCH_SIGNAL + most) * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* ch = (cfloat*)cam_aligned_alloc(most * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!x || !y || !h || !cx || !cy || !ch) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_STREAM; ++i) { x[i] = bench_randf(&seed, -1.0f, 1.0f); }
+  for (size_t i = 0; i < most; ++i) { h[i] = bench_randf(&seed, -1.0f, 1.0f); }
+  for (size_t i = 0; i < BENCH_SIGNAL; ++i) {
+    cx[i].re = bench_randf(&seed, -1.0f, 1.0f);
+    cx[i].im = bench_randf(&seed, -1.0f, 1.0f);
+  }
+  for (size_t i = 0; i < most; ++i) {
+    ch[i].re = bench_randf(&seed, -1.0f, 1.0f);
+    ch[i].im = bench_randf(&seed, -1.0f, 1.0f);
+  }
+
+  printf("tier %s, signal of %zu\n", cam_tier_name(cam_get_tier()), BENCH_SIGNAL);
+  printf("%6s %12s %12s %10s %12s %12s %10s\n", "taps", "sums ns", "real ns", "error", "complex ns", "cx sums ns", "error");
+  for (size_t t = 0; t < sizeof(taps) / sizeof(taps[0]); ++t) {
+    size_t nh = taps[t], count = BENCH_SIGNAL + nh - 1;
+
+    // Plain sums of the valid outputs, as a compiler vectorizes them
+    double best_p = 1e300, best_r = 1e300, best_c = 1e300, best_cp = 1e300;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      for (size_t k = 0; k + nh <= BENCH_SIGNAL; ++k) {
+        float s = 0.0f;
+        for (size_t j = 0; j < nh; ++j) { s += h[j] * x[k + nh - 1 - j]; }
+        y[k] = s;
+      }
+      double t1 = bench_now_ns();
+      cam_convolve(y, x, BENCH_SIGNAL, h, nh);
+      double t2 = bench_now_ns();
+      cam_cconvolve(cy, cx, BENCH_SIGNAL, ch, nh);
+      double t3 = bench_now_ns();
+      if (t1 - t0 < best_p) { best_p = t1 - t0; }
+      if (t2 - t1 < best_r) { best_r = t2 - t1; }
+      if (t3 - t2 < best_c) { best_c = t3 - t2; }
+    }
+    double err_r = check_real(y, x, BENCH_SIGNAL, h, nh);
+    double err_c = check_complex(cy, cx, BENCH_SIGNAL, ch, nh);
+
+    // Complex sums only for the short filters, where they finish quickly
+    if (nh <= 256) {
+      for (int r = 0; r < BENCH_REPS; ++r) {
+        double t0 = bench_now_ns();
+        for (size_t k = 0; k + nh <= BENCH_SIGNAL; ++k) {
+          float re = 0.0f, im = 0.0f;
+          for (size_t j = 0; j < nh; ++j) {
+            cfloat v = cx[k + nh - 1 - j];
+            re += (ch[j].re * v.re) - (ch[j].im * v.im);
+            im += (ch[j].re * v.im) + (ch[j].im * v.re);
+          }
+          cy[k].re = re;
+          cy[k].im = im;
+        }
+        double t1 = bench_now_ns();
+        if (t1 - t0 < best_cp) { best_cp = t1 - t0; }
+      }
+    }
+    printf("%6zu %12.2f %12.2f %10.2e %12.2f %12.2f %10.2e\n", nh,
+      best_p / (double)(BENCH_SIGNAL - nh + 1), best_r / (double)count, err_r,
+      best_c / (double)count, (nh <= 256) ? best_cp / (double)(BENCH_SIGNAL - nh + 1) : 0.0, err_c);
+  }
+
+  printf("\ncam_fir_run, stream of %zu\n", BENCH_STREAM);
+  printf("%6s %8s %8s %12s\n", "taps", "block", "n", "ns/sample");
+  for (size_t t = 0; t < sizeof(taps) / sizeof(taps[0]); ++t) {
+    for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); ++b) {
+      size_t nh = taps[t], block = blocks[b];
+      cam_fir* f = cam_fir_make(h, nh, block);
+      if (!f) {
+        fprintf(stderr, "filter of %zu in blocks of %zu failed\n", nh, block);
+        return 1;
+      }
+      double best = 1e300;
+      for (int r = 0; r < BENCH_REPS; ++r) {
+        cam_fir_reset(f);
+        double t0 = bench_now_ns();
+        for (size_t i = 0; i + block <= BENCH_STREAM; i += block) { cam_fir_run(f, y + i, x + i); }
+        double t1 = bench_now_ns();
+        if (t1 - t0 < best) { best = t1 - t0; }
+      }
+      printf("%6zu %8zu %8zu %12.3f\n", nh, block, f->n, best / (double)BENCH_STREAM);
+      cam_fir_free(f);
+    }
+  }
+  bench_consume(y[BENCH_STREAM / 2] + cy[BENCH_SIGNAL / 2].re);
+
+  cam_aligned_free(x);
+  cam_aligned_free(y);
+  cam_aligned_free(h);
+  cam_aligned_free(cx);
+  cam_aligned_free(cy);
+  cam_aligned_free(ch);
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * fourier_dct.c
+ * Times cam_dct, cam_idct, cam_mdct and cam_imdct for a few sizes against a DCT-II
+ * through cam_rfft of the signal mirrored to twice its length, and cam_dct8x8_many
+ * against the separable sums of products. Reports nanoseconds per transform, and
+ * the largest difference of a round trip from its input.
+ */
+
+#include "bench.h"
+#include <math.h>
+#include <string.h>
+
+#define BENCH_VALUES ((size_t)1 << 18)   // Values transformed per timing
+#define BENCH_BLOCKS ((size_t)1 << 12)   // 8 x 8 blocks per timing
+#define BENCH_REPS 5
+
+static const size_t sizes[] = { 32, 40, 256, 1024, 4096, 65536 };
+
+int main() {
+  float* src = (float*)cam_aligned_alloc(2 * BENCH_VALUES * sizeof(float), CAM_SIMD_ALIGN);
+  float* dst = (float*)cam_aligned_alloc(2 * BENCH_VALUES * sizeof(float), CAM_SIMD_ALIGN);
+  float* back = (float*)cam_aligned_alloc(2 * BENCH_VALUES * sizeof(float), CAM_SIMD_ALIGN);
+  cfloat* spec = (cfloat*)cam_aligned_alloc((BENCH_VALUES + 1) * sizeof(cfloat), CAM_SIMD_ALIGN);
+  float* wide = (float*)cam_aligned_alloc(2 * BENCH_VALUES * sizeof(float), CAM_SIMD_ALIGN);
+  cfloat* rot = (cfloat*)cam_aligned_alloc(BENCH_VALUES * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src || !dst || !back || !spec || !wide || !rot) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < 2 * BENCH_VALUES; ++i) { src[i] = bench_randf(&seed, -1.0f, 1.0f); }
+
+  printf("tier %s\n", cam_tier_name(cam_get_tier()));
+  printf("%6s %10s %10s %10s %10s %10s %10s %10s\n", "n", "dct ns", "idct ns", "rfft 2n ns", "error", "mdct ns", "imdct ns", "error");
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    size_t n = sizes[s], count = BENCH_VALUES / n;
+    cam_dct_plan* dct = cam_dct_plan_make(n);
+    cam_mdct_plan* mdct = cam_mdct_plan_make(n);
+    if (!dct || !mdct) {
+      fprintf(stderr, "plans of %zu failed\n", n);
+      return 1;
+    }
+
+    // The mirrored transform needs a power of two
+    bool pow2 = (n & (n - 1)) == 0;
+    cam_rfft_plan* rfft = pow2 ? cam_rfft_plan_make(2 * n) : NULL;
+    for (size_t k = 0; k < n; ++k) {
+      double a = C_PI * (double)k / (double)(2 * n);
+      rot[k] = cfloat_make((float)(0.5 * cos(a)), (float)(0.5 * sin(a)));
+    }
+    double best_d = 1e300, best_i = 1e300, best_r = 1e300, best_m = 1e300, best_im = 1e300;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      for (size_t c = 0; c < count; ++c) { cam_dct(dct, dst + (c * n), src + (c * n)); }
+      double t1 = bench_now_ns();
+      for (size_t c = 0; c < count; ++c) { cam_idct(dct, back + (c * n), dst + (c * n)); }
+      double t2 = bench_now_ns();
+      if (rfft) {
+        // X[k] = Re(e^(-i pi k / 2n) Y[k]) / 2, Y the spectrum of (x, x reversed), rotated by rot
+        for (size_t c = 0; c < count; ++c) {
+          const float* x = src + (c * n);
+          for (size_t j = 0; j < n; ++j) {
+            wide[j] = x[j];
+            wide[(2 * n) - 1 - j] = x[j];
+          }
+          cam_rfft(rfft, spec, wide);
+          for (size_t k = 0; k < n; ++k) { wide[k] = (spec[k].re * rot[k].re) + (spec[k].im * rot[k].im); }
+        }
+      }
+      double t3 = bench_now_ns();
+      for (size_t c = 0; c + 1 < count; ++c) { cam_mdct(mdct, dst + (c * n), src + (c * n)); }
+      double t4 = bench_now_ns();
+      for (size_t c = 0; c + 1 < count; ++c) { cam_imdct(mdct, wide, dst + (c * n)); }
+      double t5 = bench_now_ns();
+      if (t1 - t0 < best_d) { best_d = t1 - t0; }
+      if (t2 - t1 < best_i) { best_i = t2 - t1; }
+      if (t3 - t2 < best_r) { best_r = t3 - t2; }
+      if (t4 - t3 < best_m) { best_m = t4 - t3; }
+      if (t5 - t4 < best_im) { best_im = t5 - t4; }
+    }
+    double err = 0.0;
+    for (size_t i = 0; i < count * n; ++i) {
+      double d = fabs((double)back[i] - (double)src[i]);
+      if (d > err) { err = d; }
+    }
+
+    // Overlap-added sine windowed frames give back the signal between the first and last
+    size_t frames = (BENCH_VALUES / n) - 1;
+    memset(back, 0, (frames + 1) * n * sizeof(float));
+    for (size_t c = 0; c < frames; ++c) {
+      for (size_t j = 0; j < 2 * n; ++j) { wide[j] = src[(c * n) + j] * (float)sin(C_PI * ((double)j + 0.5) / (double)(2 * n)); }
+      cam_mdct(mdct, dst, wide);
+      cam_imdct(mdct, wide, dst);
+      for (size_t j = 0; j < 2 * n; ++j) { back[(c * n) + j] += wide[j] * (float)sin(C_PI * ((double)j + 0.5) / (double)(2 * n)); }
+    }
+    double err_m = 0.0;
+    for (size_t i = n; i < frames * n; ++i) {
+      double d = fabs((double)back[i] - (double)src[i]);
+      if (d > err_m) { err_m = d; }
+    }
+    printf("%6zu %10.1f %10.1f %10.1f %10.2e %10.1f %10.1f %10.2e\n", n, best_d / (double)count, best_i / (double)count,
+      rfft ? best_r / (double)count : 0.0, err, best_m / (double)(count - 1), best_im / (double)(count - 1), err_m);
+    cam_dct_plan_free(dct);
+    cam_mdct_plan_free(mdct);
+    cam_rfft_plan_free(rfft);
+  }
+
+  // Separable sums of products, the 8 point DCT of every row then every column
+  float cs[8][8];
+  for (size_t k = 0; k < 8; ++k) {
+    for (size_t j = 0; j < 8; ++j) { cs[k][j] = (float)cos(C_PI * (double)(((2 * j) + 1) * k) / 16.0); }
+  }
+  double best_b = 1e300, best_ib = 1e300, best_n = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    cam_dct8x8_many(dst, src, BENCH_BLOCKS);
+    double t1 = bench_now_ns();
+    cam_idct8x8_many(back, dst, BENCH_BLOCKS);
+    double t2 = bench_now_ns();
+    for (size_t b = 0; b < BENCH_BLOCKS; ++b) {
+      const float* x = src + (64 * b);
+      float* y = wide + (64 * b);
+      float t[64];
+      for (size_t i = 0; i < 8; ++i) {
+        for (size_t k = 0; k < 8; ++k) {
+          float s = 0.0f;
+          for (size_t j = 0; j < 8; ++j) { s += x[(8 * i) + j] * cs[k][j]; }
+          t[(8 * i) + k] = s;
+        }
+      }
+      for (size_t k = 0; k < 8; ++k) {
+        for (size_t c = 0; c < 8; ++c) {
+          float s = 0.0f;
+          for (size_t i = 0; i < 8; ++i) { s += t[(8 * i) + c] * cs[k][i]; }
+          y[(8 * k) + c] = s;
+        }
+      }
+    }
+    double t3 = bench_now_ns();
+    if (t1 - t0 < best_b) { best_b = t1 - t0; }
+    if (t2 - t1 < best_ib) { best_ib = t2 - t1; }
+    if (t3 - t2 < best_n) { best_n = t3 - t2; }
+  }
+  double err_b = 0.0, err_s = 0.0;
+  for (size_t i = 0; i < 64 * BENCH_BLOCKS; ++i) {
+    double d = fabs((double)back[i] - (double)src[i]);
+    double e = fabs((double)wide[i] - (double)dst[i]);
+    if (d > err_b) { err_b = d; }
+    if (e > err_s) { err_s = e; }
+  }
+  printf("\n8x8 blocks: dct %.1f ns, idct %.1f ns, sums %.1f ns per block, round trip error %.2e, difference from sums %.2e\n",
+    best_b / (double)BENCH_BLOCKS, best_ib / (double)BENCH_BLOCKS, best_n / (double)BENCH_BLOCKS, err_b, err_s);
+  bench_consume(dst[BENCH_VALUES / 2] + back[BENCH_VALUES / 2] + wide[0]);
+
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  cam_aligned_free(back);
+  cam_aligned_free(spec);
+  cam_aligned_free(wide);
+  cam_aligned_free(rot);
+  return 0;
+}
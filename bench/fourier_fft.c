@@ -0,0 +1,104 @@
+/*
+ * fourier_fft.c
+ * Times cam_fft_forward out of place and in place for sizes 2^4 .. 2^22 against
+ * a naive O(n^2) DFT, reported as GFLOPS using the usual 5 n log2(n) flop count.
+ */
+
+#include "bench.h"
+#include <math.h>
+#include <string.h>
+
+#define BENCH_MIN_LOG2 4
+#define BENCH_MAX_LOG2 22
+#define BENCH_DFT_MAX_LOG2 12   // The naive DFT takes too long past this
+#define BENCH_WORK 50000000.0   // Flops to spend timing each case
+
+// Naive DFT with a precomputed table of the n roots of unity
+static void dft(cfloat* dst, cfloat* src, cfloat* roots, size_t n) {
+  for (size_t k = 0; k < n; ++k) {
+    float re = 0.0f, im = 0.0f;
+    for (size_t j = 0; j < n; ++j) {
+      cfloat w = roots[(j * k) & (n - 1)];
+      re += (src[j].re * w.re) - (src[j].im * w.im);
+      im += (src[j].re * w.im) + (src[j].im * w.re);
+    }
+    dst[k] = cfloat_make(re, im);
+  }
+}
+
+// Best time in ns over enough runs to spend about BENCH_WORK flops. In place runs
+// start from a fresh copy of src each time so the values stay bounded.
+static double time_fft(cam_fft_plan* plan, cfloat* dst, cfloat* src, bool in_place, double flops) {
+  int reps = (int)(BENCH_WORK / flops);
+  if (reps < 3) { reps = 3; }
+  double best = 1e300;
+  for (int r = 0; r < reps; ++r) {
+    if (in_place) { memcpy(dst, src, plan->n * sizeof(cfloat)); }
+    double t0 = bench_now_ns();
+    cam_fft_forward(plan, dst, in_place ? dst : src);
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+int main() {
+  size_t max = (size_t)1 << BENCH_MAX_LOG2;
+  cfloat* src = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* roots = (cfloat*)cam_aligned_alloc(((size_t)1 << BENCH_DFT_MAX_LOG2) * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src || !dst || !roots) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < max; ++i) {
+    src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+  }
+
+  printf("tier %s, GFLOPS = 5 n log2(n) / time\n", cam_tier_name(cam_get_tier()));
+  printf("%8s %12s %12s %12s %12s %10s\n", "n", "fft ns", "out GFLOPS", "in GFLOPS", "dft GFLOPS", "vs dft");
+  for (int lg = BENCH_MIN_LOG2; lg <= BENCH_MAX_LOG2; ++lg) {
+    size_t n = (size_t)1 << lg;
+    double flops = 5.0 * (double)n * (double)lg;
+    cam_fft_plan* plan = cam_fft_plan_make(n);
+    if (!plan) {
+      fprintf(stderr, "plan for %zu failed\n", n);
+      return 1;
+    }
+    double t_out = time_fft(plan, dst, src, false, flops);
+    double t_in = time_fft(plan, dst, src, true, flops);
+
+    if (lg <= BENCH_DFT_MAX_LOG2) {
+      for (size_t k = 0; k < n; ++k) {
+        double a = -2.0 * C_PI * (double)k / (double)n;
+        roots[k] = cfloat_make((float)cos(a), (float)sin(a));
+      }
+      double t0 = bench_now_ns();
+      dft(dst, src, roots, n);
+      double t_dft = bench_now_ns() - t0;
+
+      // Largest deviation of the FFT from the DFT, relative to the largest output
+      cfloat* out = (cfloat*)cam_aligned_alloc(n * sizeof(cfloat), CAM_SIMD_ALIGN);
+      cam_fft_forward(plan, out, src);
+      float err = 0.0f, mag = 0.0f;
+      for (size_t k = 0; k < n; ++k) {
+        cfloat d = cfloat_sub(&out[k], &dst[k]);
+        err = fmaxf(err, cfloat_mag(&d));
+        mag = fmaxf(mag, cfloat_mag(&dst[k]));
+      }
+      cam_aligned_free(out);
+      printf("%8zu %12.0f %12.2f %12.2f %12.3f %10.2g\n", n, t_out, flops / t_out, flops / t_in, flops / t_dft, err / mag);
+    }
+    else {
+      printf("%8zu %12.0f %12.2f %12.2f %12s %10s\n", n, t_out, flops / t_out, flops / t_in, "-", "-");
+    }
+    cam_fft_plan_free(plan);
+  }
+  bench_consume(dst[0].re);
+
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  cam_aligned_free(roots);
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * fourier_fft2d.c
+ * Times cam_fft2d_forward of a few image sizes against the 1D plans run over the rows,
+ * then over the columns gathered and scattered one at a time, and cam_rfft2d against
+ * cam_fft2d_forward of the same real matrix. Reports milliseconds per transform, the
+ * largest difference between the two paths over the largest value, and the largest
+ * difference of a round trip from its input.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_REPS 3
+
+static const size_t shapes[][2] = { { 256, 256 }, { 1024, 1024 }, { 2048, 2048 }, { 1080, 1920 }, { 2160, 3840 } };
+
+// Largest difference of a from b over the largest magnitude of b
+static double compare(const cfloat* a, const cfloat* b, size_t rows, size_t cols, size_t lda) {
+  double err = 0.0, top = 0.0;
+  for (size_t r = 0; r < rows; ++r) {
+    for (size_t c = 0; c < cols; ++c) {
+      cfloat u = a[(r * lda) + c], v = b[(r * lda) + c];
+      double mag = hypot(v.re, v.im), d = hypot((double)u.re - v.re, (double)u.im - v.im);
+      if (mag > top) { top = mag; }
+      if (d > err) { err = d; }
+    }
+  }
+  return (top > 0.0) ? err / top : err;
+}
+
+int main() {
+  size_t most = 0;
+  for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); ++s) {
+    if (shapes[s][0] * shapes[s][1] > most) { most = shapes[s][0] * shapes[s][1]; }
+  }
+  cfloat* src = (cfloat*)cam_aligned_alloc(most * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(most * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* ref = (cfloat*)cam_aligned_alloc(most * sizeof(cfloat), CAM_SIMD_ALIGN);
+  float* real = (float*)cam_aligned_alloc(most * sizeof(float), CAM_SIMD_ALIGN);
+  float* back = (float*)cam_aligned_alloc(most * sizeof(float), CAM_SIMD_ALIGN);
+  cfloat* column = (cfloat*)cam_aligned_alloc(4096 * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src || !dst || !ref || !real || !back || !column) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < most; ++i) {
+    src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+    real[i] = bench_randf(&seed, -1.0f, 1.0f);
+  }
+
+  printf("tier %s, %d threads\n", cam_tier_name(cam_get_tier()), cam_get_threads());
+  printf("%11s %10s %10s %10s %10s %10s %10s %10s\n", "shape", "fft2d ms", "1d ms", "error", "rfft2d ms", "irfft2d ms", "error", "round trip");
+  for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); ++s) {
+    size_t rows = shapes[s][0], cols = shapes[s][1], width = (cols / 2) + 1;
+    cam_fft2d_plan* plan = cam_fft2d_plan_make(rows, cols);
+    if (!plan) {
+      fprintf(stderr, "plan of %zu x %zu failed\n", rows, cols);
+      return 1;
+    }
+
+    double best_f = 1e300, best_n = 1e300, best_r = 1e300, best_ir = 1e300;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      cam_fft2d_forward(plan, dst, src);
+      double t1 = bench_now_ns();
+      for (size_t j = 0; j < rows; ++j) { cam_fft_forward(plan->row, ref + (j * cols), src + (j * cols)); }
+      for (size_t c = 0; c < cols; ++c) {
+        for (size_t j = 0; j < rows; ++j) { column[j] = ref[(j * cols) + c]; }
+        cam_fft_forward(plan->col, column, column);
+        for (size_t j = 0; j < rows; ++j) { ref[(j * cols) + c] = column[j]; }
+      }
+      double t2 = bench_now_ns();
+      if (t1 - t0 < best_f) { best_f = t1 - t0; }
+      if (t2 - t1 < best_n) { best_n = t2 - t1; }
+    }
+    double err_f = compare(dst, ref, rows, cols, cols);
+
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      cam_rfft2d(plan, dst, real);
+      double t1 = bench_now_ns();
+      cam_irfft2d(plan, back, dst);
+      double t2 = bench_now_ns();
+      if (t1 - t0 < best_r) { best_r = t1 - t0; }
+      if (t2 - t1 < best_ir) { best_ir = t2 - t1; }
+    }
+    for (size_t i = 0; i < rows * cols; ++i) { src[i] = cfloat_make(real[i], 0.0f); }
+    cam_fft2d_forward(plan, ref, src);
+    for (size_t j = 0; j < rows; ++j) {
+      for (size_t c = 0; c < width; ++c) { ref[(j * width) + c] = ref[(j * cols) + c]; }
+    }
+    double err_r = compare(dst, ref, rows, width, width);
+    double err_t = 0.0;
+    for (size_t i = 0; i < rows * cols; ++i) {
+      double d = fabs((double)back[i] - (double)real[i]);
+      if (d > err_t) { err_t = d; }
+    }
+    for (size_t i = 0; i < rows * cols; ++i) { src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f)); }
+
+    printf("%5zux%-5zu %10.2f %10.2f %10.2e %10.2f %10.2f %10.2e %10.2e\n", rows, cols, best_f * 1e-6, best_n * 1e-6, err_f,
+      best_r * 1e-6, best_ir * 1e-6, err_r, err_t);
+    cam_fft2d_plan_free(plan);
+  }
+  bench_consume(dst[0].re + back[0]);
+
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  cam_aligned_free(ref);
+  cam_aligned_free(real);
+  cam_aligned_free(back);
+  cam_aligned_free(column);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * fourier_many.c
+ * Times cam_fft_many on batches of small signals against cam_fft_forward called on
+ * each signal in turn, both holding the same batch (interleaved by signal for the
+ * first, one signal after another for the second). Reports the strategy of each
+ * plan, ns per signal and GFLOPS using the usual 5 n log2(n) flop count.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_SIGNALS 4096
+#define BENCH_WORK 50000000.0   // Flops to spend timing each case
+
+static const size_t sizes[] = { 4, 8, 12, 16, 30, 32, 48, 60, 64, 128 };
+
+// Best time in ns of one batch, over enough runs to spend about BENCH_WORK flops
+static double time_many(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, double flops) {
+  int reps = (int)(BENCH_WORK / flops);
+  if (reps < 3) { reps = 3; }
+  double best = 1e300;
+  for (int r = 0; r < reps; ++r) {
+    double t0 = bench_now_ns();
+    cam_fft_many(plan, dst, src);
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+static double time_each(cam_fft_plan* plan, cfloat* dst, cfloat* src, size_t count, double flops) {
+  int reps = (int)(BENCH_WORK / flops);
+  if (reps < 3) { reps = 3; }
+  double best = 1e300;
+  for (int r = 0; r < reps; ++r) {
+    double t0 = bench_now_ns();
+    for (size_t s = 0; s < count; ++s) {
+      cam_fft_forward(plan, dst + (s * plan->n), src + (s * plan->n));
+    }
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+int main() {
+  size_t max = 128 * BENCH_SIGNALS;
+  cfloat_soa src = cfloat_soa_make(max);
+  cfloat_soa dst = cfloat_soa_make(max);
+  cfloat* isrc = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* idst = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src.re || !dst.re || !isrc || !idst) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < max; ++i) {
+    isrc[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+  }
+
+  printf("tier %s, %d signals, GFLOPS = 5 n log2(n) / time\n", cam_tier_name(cam_get_tier()), BENCH_SIGNALS);
+  printf("%6s %-28s %12s %10s %12s %10s %8s\n", "n", "strategy", "many ns/sig", "GFLOPS", "each ns/sig", "GFLOPS", "speedup");
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    size_t n = sizes[i];
+    cam_fft_plan* plan = cam_fft_plan_make(n);
+    if (!plan) {
+      fprintf(stderr, "plan for %zu failed\n", n);
+      return 1;
+    }
+    // The same signals in both layouts
+    src.count = n * BENCH_SIGNALS;
+    dst.count = src.count;
+    for (size_t s = 0; s < BENCH_SIGNALS; ++s) {
+      for (size_t k = 0; k < n; ++k) {
+        src.re[(k * BENCH_SIGNALS) + s] = isrc[(s * n) + k].re;
+        src.im[(k * BENCH_SIGNALS) + s] = isrc[(s * n) + k].im;
+      }
+    }
+    char strategy[64];
+    cam_fft_plan_describe(plan, strategy, sizeof(strategy));
+    double flops = 5.0 * (double)n * log2((double)n) * BENCH_SIGNALS;
+    double t_many = time_many(plan, &dst, &src, flops) / BENCH_SIGNALS;
+    double t_each = time_each(plan, idst, isrc, BENCH_SIGNALS, flops) / BENCH_SIGNALS;
+    double sig = flops / BENCH_SIGNALS;
+    printf("%6zu %-28s %12.1f %10.2f %12.1f %10.2f %7.2fx\n", n, strategy, t_many, sig / t_many, t_each, sig / t_each, t_each / t_many);
+    cam_fft_plan_free(plan);
+  }
+  bench_consume(dst.re[0] + idst[0].re);
+
+  cfloat_soa_free(&src);
+  cfloat_soa_free(&dst);
+  cam_aligned_free(isrc);
+  cam_aligned_free(idst);
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * fourier_mixed.c
+ * Times cam_fft_forward on sizes other than powers of two, smooth ones running the
+ * mixed-radix passes and ones with large prime factors running Bluestein's algorithm,
+ * next to the power of two each would otherwise be zero-padded to. Reports the
+ * strategy of each plan and GFLOPS using the usual 5 n log2(n) flop count.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_WORK 50000000.0   // Flops to spend timing each case
+
+static const size_t sizes[] = { 1000, 1009, 1536, 4410, 10007, 44100, 44111, 1000000, 1048573 };
+
+// Best time in ns over enough runs to spend about BENCH_WORK flops
+static double time_fft(cam_fft_plan* plan, cfloat* dst, cfloat* src, double flops) {
+  int reps = (int)(BENCH_WORK / flops);
+  if (reps < 3) { reps = 3; }
+  double best = 1e300;
+  for (int r = 0; r < reps; ++r) {
+    double t0 = bench_now_ns();
+    cam_fft_forward(plan, dst, src);
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+int main() {
+  size_t max = (size_t)1 << 21;
+  cfloat* src = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src || !dst) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < max; ++i) {
+    src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+  }
+
+  printf("tier %s, GFLOPS = 5 n log2(n) / time\n", cam_tier_name(cam_get_tier()));
+  printf("%8s %-40s %12s %10s %8s %12s\n", "n", "strategy", "ns", "GFLOPS", "pad to", "padded ns");
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    size_t n = sizes[i], pad = 1;
+    while (pad < n) { pad *= 2; }
+    cam_fft_plan* plan = cam_fft_plan_make(n);
+    cam_fft_plan* padded = cam_fft_plan_make(pad);
+    if (!plan || !padded) {
+      fprintf(stderr, "plan for %zu failed\n", n);
+      return 1;
+    }
+    char strategy[64];
+    cam_fft_plan_describe(plan, strategy, sizeof(strategy));
+    double flops = 5.0 * (double)n * log2((double)n);
+    double t = time_fft(plan, dst, src, flops);
+    double t_pad = time_fft(padded, dst, src, 5.0 * (double)pad * log2((double)pad));
+    printf("%8zu %-40s %12.0f %10.2f %8zu %12.0f\n", n, strategy, t, flops / t, pad, t_pad);
+    cam_fft_plan_free(plan);
+    cam_fft_plan_free(padded);
+  }
+  bench_consume(dst[0].re);
+
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  return 0;
+}
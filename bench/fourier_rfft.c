@@ -0,0 +1,84 @@
+/*
+ * fourier_rfft.c
+ * Times cam_rfft and cam_irfft on real signals of sizes 2^4 .. 2^22 against running
+ * the same signal through cam_fft_forward as complex values with zero imaginary parts.
+ */
+
+#include "bench.h"
+#include <math.h>
+#include <string.h>
+
+#define BENCH_MIN_LOG2 4
+#define BENCH_MAX_LOG2 22
+#define BENCH_WORK 50000000.0   // Flops to spend timing each case
+
+typedef enum { RUN_FFT, RUN_RFFT, RUN_IRFFT } bench_run;
+
+// Best time in ns over enough runs to spend about BENCH_WORK flops
+static double time_run(bench_run run, cam_fft_plan* cplan, cam_rfft_plan* rplan, cfloat* cbuf, float* rbuf, cfloat* spec, double flops) {
+  int reps = (int)(BENCH_WORK / flops);
+  if (reps < 3) { reps = 3; }
+  double best = 1e300;
+  for (int r = 0; r < reps; ++r) {
+    double t0 = bench_now_ns();
+    switch (run) {
+      case RUN_FFT: cam_fft_forward(cplan, spec, cbuf); break;
+      case RUN_RFFT: cam_rfft(rplan, spec, rbuf); break;
+      case RUN_IRFFT: cam_irfft(rplan, rbuf, spec); break;
+    }
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+int main() {
+  size_t max = (size_t)1 << BENCH_MAX_LOG2;
+  float* signal = (float*)cam_aligned_alloc(max * sizeof(float), CAM_SIMD_ALIGN);
+  float* rbuf = (float*)cam_aligned_alloc(max * sizeof(float), CAM_SIMD_ALIGN);
+  cfloat* cbuf = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* spec = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!signal || !rbuf || !cbuf || !spec) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < max; ++i) {
+    signal[i] = bench_randf(&seed, -1.0f, 1.0f);
+    cbuf[i] = cfloat_make(signal[i], 0.0f);
+  }
+
+  printf("tier %s, best time in ns\n", cam_tier_name(cam_get_tier()));
+  printf("%8s %12s %12s %12s %10s %10s\n", "n", "complex fft", "rfft", "irfft", "speedup", "round trip");
+  for (int lg = BENCH_MIN_LOG2; lg <= BENCH_MAX_LOG2; ++lg) {
+    size_t n = (size_t)1 << lg;
+    double flops = 5.0 * (double)n * (double)lg;
+    cam_fft_plan* cplan = cam_fft_plan_make(n);
+    cam_rfft_plan* rplan = cam_rfft_plan_make(n);
+    if (!cplan || !rplan) {
+      fprintf(stderr, "plan for %zu failed\n", n);
+      return 1;
+    }
+    memcpy(rbuf, signal, n * sizeof(float));
+    double t_fft = time_run(RUN_FFT, cplan, rplan, cbuf, rbuf, spec, flops);
+    double t_rfft = time_run(RUN_RFFT, cplan, rplan, cbuf, rbuf, spec, flops / 2.0);
+    double t_irfft = time_run(RUN_IRFFT, cplan, rplan, cbuf, rbuf, spec, flops / 2.0);
+
+    // Largest deviation of irfft(rfft(x)) from x
+    cam_rfft(rplan, spec, signal);
+    cam_irfft(rplan, rbuf, spec);
+    float err = 0.0f;
+    for (size_t i = 0; i < n; ++i) { err = fmaxf(err, fabsf(rbuf[i] - signal[i])); }
+
+    printf("%8zu %12.0f %12.0f %12.0f %10.2f %10.2g\n", n, t_fft, t_rfft, t_irfft, t_fft / t_rfft, err);
+    cam_fft_plan_free(cplan);
+    cam_rfft_plan_free(rplan);
+  }
+  bench_consume(spec[0].re + rbuf[0]);
+
+  cam_aligned_free(signal);
+  cam_aligned_free(rbuf);
+  cam_aligned_free(cbuf);
+  cam_aligned_free(spec);
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * fourier_stft.c
+ * Times a stream through cam_stft_push and back through cam_istft_push, pushed in
+ * pieces of several sizes, for a few frame and hop sizes. Reports millions of
+ * samples per second each way, and the largest difference between the output
+ * and the input it resynthesizes.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_SAMPLES ((size_t)1 << 20)   // Stream length
+#define BENCH_REPS 5
+
+static const size_t frames[][2] = { { 256, 64 }, { 1024, 256 }, { 1024, 512 }, { 4096, 1024 } };
+static const size_t pieces[] = { 1, 64, 441, 4096, BENCH_SAMPLES };
+
+int main() {
+  float* src = (float*)cam_aligned_alloc(BENCH_SAMPLES * sizeof(float), CAM_SIMD_ALIGN);
+  float* dst = (float*)cam_aligned_alloc(BENCH_SAMPLES * sizeof(float), CAM_SIMD_ALIGN);
+  if (!src || !dst) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_SAMPLES; ++i) { src[i] = bench_randf(&seed, -1.0f, 1.0f); }
+
+  printf("tier %s, %zu samples\n", cam_tier_name(cam_get_tier()), BENCH_SAMPLES);
+  printf("%6s %6s %8s %14s %14s %12s\n", "n", "hop", "piece", "stft Msamp/s", "istft Msamp/s", "max error");
+  for (size_t f = 0; f < sizeof(frames) / sizeof(frames[0]); ++f) {
+    size_t n = frames[f][0], hop = frames[f][1], bins = (n / 2) + 1;
+    cam_stft* s = cam_stft_make(n, hop, NULL);
+    cfloat* spec = s ? (cfloat*)cam_aligned_alloc(cam_stft_frames(s, BENCH_SAMPLES) * bins * sizeof(cfloat), CAM_SIMD_ALIGN) : NULL;
+    if (!spec) {
+      fprintf(stderr, "stft of %zu every %zu failed\n", n, hop);
+      return 1;
+    }
+    for (size_t p = 0; p < sizeof(pieces) / sizeof(pieces[0]); ++p) {
+      // The resynthesis takes as many frames at a time as the pieces fill
+      size_t piece = pieces[p], frame_piece = (piece + hop - 1) / hop, count = 0, written = 0;
+      double best_a = 1e300, best_s = 1e300;
+      for (int r = 0; r < BENCH_REPS; ++r) {
+        cam_stft_reset(s);
+        count = 0;
+        double t0 = bench_now_ns();
+        for (size_t i = 0; i < BENCH_SAMPLES; i += piece) {
+          size_t m = (BENCH_SAMPLES - i < piece) ? BENCH_SAMPLES - i : piece;
+          count += cam_stft_push(s, spec + (count * bins), src + i, m);
+        }
+        double t1 = bench_now_ns();
+        written = 0;
+        for (size_t i = 0; i < count; i += frame_piece) {
+          size_t m = (count - i < frame_piece) ? count - i : frame_piece;
+          written += cam_istft_push(s, dst + written, spec + (i * bins), m);
+        }
+        double t2 = bench_now_ns();
+        if (t1 - t0 < best_a) { best_a = t1 - t0; }
+        if (t2 - t1 < best_s) { best_s = t2 - t1; }
+      }
+
+      // The output is the input delayed by n - hop samples
+      double err = 0.0;
+      for (size_t i = n - hop; i < written; ++i) {
+        double d = fabs((double)dst[i] - (double)src[i - (n - hop)]);
+        if (d > err) { err = d; }
+      }
+      printf("%6zu %6zu %8zu %14.1f %14.1f %12.2e\n", n, hop, piece,
+        (double)BENCH_SAMPLES / best_a * 1e3, (double)written / best_s * 1e3, err);
+    }
+    cam_stft_free(s);
+    cam_aligned_free(spec);
+  }
+  bench_consume(dst[BENCH_SAMPLES / 2]);
+
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * fourier_threads.c
+ * Times the six-step cam_fft_forward at 2^24 points with 1 thread up to every
+ * logical CPU, reporting GFLOPS (5 n log2(n) / time) and the speedup over 1 thread.
+ */
+
+#include "bench.h"
+#include <string.h>
+
+#define BENCH_LOG2 24
+#define BENCH_REPS 5
+
+int main() {
+  size_t n = (size_t)1 << BENCH_LOG2;
+  double flops = 5.0 * (double)n * (double)BENCH_LOG2;
+  cfloat* src = (cfloat*)cam_aligned_alloc(n * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(n * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cam_fft_plan* plan = cam_fft_plan_make(n);
+  if (!src || !dst || !plan) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+  }
+  memset(dst, 0, n * sizeof(cfloat));
+
+  // Every count up to the default, doubling, and the default itself
+  int max = cam_set_threads(0);
+  printf("n = 2^%d, tier %s, %s path, best of %d runs\n", BENCH_LOG2, cam_tier_name(cam_get_tier()),
+    plan->cols ? "six-step" : "direct", BENCH_REPS);
+  printf("%8s %12s %12s %10s\n", "threads", "ms", "GFLOPS", "speedup");
+  double base = 0.0;
+  for (int threads = 1; threads <= max; threads = (threads * 2 > max && threads < max) ? max : threads * 2) {
+    cam_set_threads(threads);
+    double best = 1e300;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      cam_fft_forward(plan, dst, src);
+      double t = bench_now_ns() - t0;
+      if (t < best) { best = t; }
+    }
+    if (threads == 1) { base = best; }
+    printf("%8d %12.2f %12.2f %10.2f\n", threads, best * 1e-6, flops / best, base / best);
+  }
+  bench_consume(dst[0].re);
+
+  cam_set_threads(0);
+  cam_fft_plan_free(plan);
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  return 0;
+}
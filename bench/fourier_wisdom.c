@@ -0,0 +1,96 @@
+/*
+ * fourier_wisdom.c
+ * Times getting a plan for sizes 2^10 .. 2^22 by cam_fft_plan_make, by
+ * cam_fft_plan_tune and from a wisdom file of the tuned plans, and reports the
+ * strategy tuning chose and the GFLOPS of the plans it returns.
+ */
+
+#include "bench.h"
+
+#define BENCH_MIN_LOG2 10
+#define BENCH_MAX_LOG2 22
+#define BENCH_COUNT (BENCH_MAX_LOG2 - BENCH_MIN_LOG2 + 1)
+#define BENCH_REPS 5
+#define BENCH_PATH "cam_bench_fft_wisdom.bin"
+
+// Best time of a forward transform in ns
+static double time_fft(cam_fft_plan* plan, cfloat* dst, cfloat* src) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    cam_fft_forward(plan, dst, src);
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best;
+}
+
+int main() {
+  size_t max = (size_t)1 << BENCH_MAX_LOG2;
+  cfloat* src = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(max * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!src || !dst) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < max; ++i) {
+    src[i] = cfloat_make(bench_randf(&seed, -1.0f, 1.0f), bench_randf(&seed, -1.0f, 1.0f));
+  }
+
+  // Tune every size once and keep the plans for the wisdom file
+  cam_fft_plan* tuned[BENCH_COUNT];
+  double t_tune[BENCH_COUNT];
+  for (int i = 0; i < BENCH_COUNT; ++i) {
+    double t0 = bench_now_ns();
+    tuned[i] = cam_fft_plan_tune((size_t)1 << (BENCH_MIN_LOG2 + i));
+    t_tune[i] = bench_now_ns() - t0;
+    if (!tuned[i]) {
+      fprintf(stderr, "tuning failed\n");
+      return 1;
+    }
+  }
+  if (!cam_fft_wisdom_save(BENCH_PATH, tuned, BENCH_COUNT)) {
+    fprintf(stderr, "cannot write %s\n", BENCH_PATH);
+    return 1;
+  }
+  double t0 = bench_now_ns();
+  cam_fft_wisdom* wisdom = cam_fft_wisdom_load(BENCH_PATH);
+  double t_load = bench_now_ns() - t0;
+  if (!wisdom) {
+    fprintf(stderr, "cannot load %s\n", BENCH_PATH);
+    return 1;
+  }
+
+  printf("tier %s, wisdom of %d plans loaded in %.0f us\n", cam_tier_name(cam_get_tier()), BENCH_COUNT, t_load / 1e3);
+  printf("%8s %12s %12s %12s %10s %12s %12s\n", "n", "make us", "tune us", "wisdom us", "tuned", "make GFLOPS", "tune GFLOPS");
+  for (int i = 0; i < BENCH_COUNT; ++i) {
+    int lg = BENCH_MIN_LOG2 + i;
+    size_t n = (size_t)1 << lg;
+    double flops = 5.0 * (double)n * (double)lg;
+    t0 = bench_now_ns();
+    cam_fft_plan* made = cam_fft_plan_make(n);
+    double t_make = bench_now_ns() - t0;
+    t0 = bench_now_ns();
+    cam_fft_plan* wise = cam_fft_wisdom_plan(wisdom, n);
+    double t_wise = bench_now_ns() - t0;
+    if (!made || !wise) {
+      fprintf(stderr, "plan for %zu failed\n", n);
+      return 1;
+    }
+    double g_make = flops / time_fft(made, dst, src);
+    double g_wise = flops / time_fft(wise, dst, src);
+    printf("%8zu %12.1f %12.1f %12.1f %10s %12.2f %12.2f\n", n, t_make / 1e3, t_tune[i] / 1e3, t_wise / 1e3,
+      wise->cols ? "six-step" : "direct", g_make, g_wise);
+    cam_fft_plan_free(made);
+    cam_fft_plan_free(wise);
+  }
+  bench_consume(dst[0].re);
+
+  cam_fft_wisdom_close(wisdom);
+  for (int i = 0; i < BENCH_COUNT; ++i) { cam_fft_plan_free(tuned[i]); }
+  remove(BENCH_PATH);
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  return 0;
+}
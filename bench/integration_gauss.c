@@ -0,0 +1,100 @@
+/*
+ * integration_gauss.c
+ * Times Gauss-Legendre and Gauss-Jacobi node generation from order 100 to 10000, cached
+ * lookups of the same rules, and cam_gauss_apply and cam_gauss_apply_many against a
+ * plain C weighted sum over the same samples.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_REPS 5
+#define BENCH_SETS 64
+
+/* Plain C weighted sum */
+static double dot_plain(const double* w, const double* y, size_t n) {
+  double s = 0.0;
+  for (size_t i = 0; i < n; ++i) { s += w[i] * y[i]; }
+  return s;
+}
+
+int main() {
+  printf("tier %s, best of %d runs\n\n", cam_tier_name(cam_get_tier()), BENCH_REPS);
+
+  // Node generation, then a lookup of the rule the first call cached
+  size_t orders[] = { 100, 1000, 5000, 10000 };
+  printf("%6s %14s %14s %12s\n", "n", "legendre ms", "jacobi ms", "cached ns");
+  for (size_t q = 0; q < sizeof(orders) / sizeof(orders[0]); ++q) {
+    size_t n = orders[q];
+    double* x = (double*)cam_aligned_alloc(2 * n * sizeof(double), CAM_SIMD_ALIGN);
+    double* w = x + n;
+    double best_l = 1e300, best_j = 1e300, best_c = 1e300;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      cam_gauss_legendre_nodes(x, w, n);
+      double t1 = bench_now_ns();
+      cam_gauss_jacobi_nodes(x, w, n, 0.5, -0.5);
+      double t2 = bench_now_ns();
+      if (t1 - t0 < best_l) { best_l = t1 - t0; }
+      if (t2 - t1 < best_j) { best_j = t2 - t1; }
+    }
+    cam_gauss_legendre(n);
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      const cam_gauss_rule* rule = NULL;
+      for (int i = 0; i < 1000; ++i) { rule = cam_gauss_legendre(n); }
+      double t1 = bench_now_ns();
+      bench_consume((float)rule->w[0]);
+      if ((t1 - t0) / 1000.0 < best_c) { best_c = (t1 - t0) / 1000.0; }
+    }
+    printf("%6zu %14.3f %14.3f %12.1f\n", n, best_l * 1e-6, best_j * 1e-6, best_c);
+    cam_aligned_free(x);
+  }
+
+  // Weighted sums of BENCH_SETS sample sets of cos(k x)
+  size_t sizes[] = { 16, 100, 1000, 10000 };
+  printf("\n%6s %12s %12s %12s %10s\n", "n", "plain ns", "apply ns", "many ns", "error");
+  for (size_t q = 0; q < sizeof(sizes) / sizeof(sizes[0]); ++q) {
+    const cam_gauss_rule* rule = cam_gauss_legendre(sizes[q]);
+    size_t n = rule->n;
+    double* y = (double*)cam_aligned_alloc(BENCH_SETS * n * sizeof(double), CAM_SIMD_ALIGN);
+    double dst[BENCH_SETS];
+    for (size_t j = 0; j < BENCH_SETS; ++j) {
+      for (size_t i = 0; i < n; ++i) { y[(j * n) + i] = cos((double)(j + 1) * rule->x[i]); }
+    }
+    int iters = (int)(200000 / n) + 1;
+    double best_p = 1e300, best_a = 1e300, best_m = 1e300, sink = 0.0;
+    for (int r = 0; r < BENCH_REPS; ++r) {
+      double t0 = bench_now_ns();
+      for (int it = 0; it < iters; ++it) {
+        for (size_t j = 0; j < BENCH_SETS; ++j) { sink += dot_plain(rule->w, y + (j * n), n); }
+      }
+      double t1 = bench_now_ns();
+      for (int it = 0; it < iters; ++it) {
+        for (size_t j = 0; j < BENCH_SETS; ++j) { sink += cam_gauss_apply(rule, y + (j * n)); }
+      }
+      double t2 = bench_now_ns();
+      for (int it = 0; it < iters; ++it) {
+        cam_gauss_apply_many(rule, dst, y, BENCH_SETS);
+        sink += dst[it % BENCH_SETS];
+      }
+      double t3 = bench_now_ns();
+      if (t1 - t0 < best_p) { best_p = t1 - t0; }
+      if (t2 - t1 < best_a) { best_a = t2 - t1; }
+      if (t3 - t2 < best_m) { best_m = t3 - t2; }
+    }
+    bench_consume((float)sink);
+
+    // Against the exact integral of cos(k x) over [-1, 1], 2 sin(k) / k, for k the rule resolves
+    double error = 0.0;
+    for (size_t j = 0; j < BENCH_SETS && 2 * (j + 1) <= n; ++j) {
+      double k = (double)(j + 1);
+      error = fmax(error, fabs(dst[j] - (2.0 * sin(k) / k)));
+    }
+    double per = (double)iters * BENCH_SETS;
+    printf("%6zu %12.1f %12.1f %12.1f %10.2e\n", n, best_p / per, best_a / per, best_m / per, error);
+    cam_aligned_free(y);
+  }
+  cam_gauss_cache_clear();
+  return 0;
+}
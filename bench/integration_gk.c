@@ -0,0 +1,102 @@
+/*
+ * integration_gk.c
+ * Times cam_gk_integrate over a few integrands, each written once as a batched
+ * integrand filling a whole array of values and once as a scalar function called
+ * through a pointer per abscissa, the interface the batched one replaces. Reports
+ * microseconds per integral, integrand values and calls, and the difference from
+ * the exact value.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_ITERS 200
+#define BENCH_REPS 5
+
+/* Integrands */
+static void runge_many(void* arg, double* y, const double* x, size_t count) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) { y[i] = 1.0 / (1.0 + (100.0 * x[i] * x[i])); }
+}
+static double runge(double x) { return 1.0 / (1.0 + (100.0 * x * x)); }
+
+static void root_many(void* arg, double* y, const double* x, size_t count) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) { y[i] = sqrt(x[i]); }
+}
+static double root(double x) { return sqrt(x); }
+
+static void damped_many(void* arg, double* y, const double* x, size_t count) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) { y[i] = exp(-x[i]) * cos(5.0 * x[i]); }
+}
+static double damped(double x) { return exp(-x) * cos(5.0 * x); }
+
+static void logarithm_many(void* arg, double* y, const double* x, size_t count) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) { y[i] = log(x[i]); }
+}
+static double logarithm(double x) { return log(x); }
+
+// Batched integrand calling a scalar function per abscissa
+static void per_point(void* arg, double* y, const double* x, size_t count) {
+  double (*volatile f)(double) = *(double (**)(double))arg;
+  for (size_t i = 0; i < count; ++i) { y[i] = f(x[i]); }
+}
+
+typedef struct {
+  const char* name;
+  cam_integrand many;
+  double (*one)(double);
+  double a, b;
+  double exact;
+} bench_case;
+
+static const char* status_name(cam_quad_status s) {
+  switch (s) {
+  case CAM_QUAD_OK: return "ok";
+  case CAM_QUAD_LIMIT: return "limit";
+  case CAM_QUAD_ROUNDOFF: return "roundoff";
+  case CAM_QUAD_NONFINITE: return "nonfinite";
+  default: return "nomem";
+  }
+}
+
+int main() {
+  bench_case cases[] = {
+    { "1/(1+100x^2) [-1,1]", runge_many, runge, -1.0, 1.0, 0.2 * atan(10.0) },
+    { "sqrt(x) [0,1]", root_many, root, 0.0, 1.0, 2.0 / 3.0 },
+    { "e^-x cos 5x [0,10]", damped_many, damped, 0.0, 10.0, (1.0 + (exp(-10.0) * ((5.0 * sin(50.0)) - cos(50.0)))) / 26.0 },
+    { "log(x) [0,1]", logarithm_many, logarithm, 0.0, 1.0, -1.0 },
+  };
+  const cam_gk_rule rules[] = { CAM_GK15, CAM_GK21 };
+
+  printf("%-22s %4s %10s %10s %7s %7s %10s %10s %9s\n", "integrand", "rule", "batch us", "point us", "evals", "calls", "error", "estimate", "status");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    for (size_t r = 0; r < 2; ++r) {
+      bench_case* bc = &cases[c];
+      cam_quad_result res, one;
+      double best_m = 1e300, best_p = 1e300, sink = 0.0;
+      for (int rep = 0; rep < BENCH_REPS; ++rep) {
+        double t0 = bench_now_ns();
+        for (int i = 0; i < BENCH_ITERS; ++i) {
+          res = cam_gk_integrate(bc->many, NULL, bc->a, bc->b, rules[r], 1e-12, 1e-10, 2000);
+          sink += res.value;
+        }
+        double t1 = bench_now_ns();
+        for (int i = 0; i < BENCH_ITERS; ++i) {
+          one = cam_gk_integrate(per_point, (void*)&bc->one, bc->a, bc->b, rules[r], 1e-12, 1e-10, 2000);
+          sink += one.value;
+        }
+        double t2 = bench_now_ns();
+        if (t1 - t0 < best_m) { best_m = t1 - t0; }
+        if (t2 - t1 < best_p) { best_p = t2 - t1; }
+      }
+      bench_consume((float)sink);
+      printf("%-22s %4s %10.2f %10.2f %7zu %7zu %10.2e %10.2e %9s\n", bc->name, (rules[r] == CAM_GK15) ? "15" : "21",
+        best_m * 1e-3 / BENCH_ITERS, best_p * 1e-3 / BENCH_ITERS, res.evals, res.calls, fabs(res.value - bc->exact), res.error,
+        status_name(res.status));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * integration_mc.c
+ * Times cam_mc_integrate of two integrals over unit cubes of 6 to 12 dimensions, with
+ * pseudo-random and Sobol points, to a relative tolerance of 1e-4 within 2^22 integrand
+ * values, on one thread and on every thread. Reports milliseconds per integral, integrand
+ * values, the difference from the exact value against the error estimate, and whether
+ * the thread counts agree bit for bit.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define BENCH_REPS 2
+#define BENCH_MAX_EVALS ((size_t)1 << 22)
+
+static const size_t dims[] = { 6, 8, 12 };
+
+/* Integrands */
+// Sobol's g function, the product of (|4 x - 2| + a) / (1 + a) with a = j, exactly 1
+static void g_function(void* arg, double* y, const double* x, size_t count, size_t dim) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) {
+    const double* p = x + (i * dim);
+    double v = 1.0;
+    for (size_t j = 0; j < dim; ++j) { v *= (fabs((4.0 * p[j]) - 2.0) + (double)j) / (1.0 + (double)j); }
+    y[i] = v;
+  }
+}
+
+// exp of the mean coordinate, exactly (dim (e^(1 / dim) - 1))^dim
+static void exponential(void* arg, double* y, const double* x, size_t count, size_t dim) {
+  (void)arg;
+  for (size_t i = 0; i < count; ++i) {
+    const double* p = x + (i * dim);
+    double s = 0.0;
+    for (size_t j = 0; j < dim; ++j) { s += p[j]; }
+    y[i] = exp(s / (double)dim);
+  }
+}
+
+int main() {
+  int threads = cam_get_threads();
+  const char* names[] = { "g function", "exp mean" };
+  cam_integrand_nd fs[] = { g_function, exponential };
+  const cam_mc_method methods[] = { CAM_MC_PSEUDO, CAM_MC_SOBOL };
+
+  printf("%d threads\n", threads);
+  printf("%-11s %3s %6s %10s %10s %10s %10s %10s %6s %5s\n", "integrand", "dim", "points", "1 ms", "all ms", "evals", "error", "estimate",
+    "status", "same");
+  for (size_t k = 0; k < 2; ++k) {
+    for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); ++d) {
+      size_t dim = dims[d];
+      double exact = (k == 0) ? 1.0 : pow((double)dim * (exp(1.0 / (double)dim) - 1.0), (double)dim);
+      for (size_t m = 0; m < 2; ++m) {
+        cam_quad_result one, all;
+        double best_1 = 1e300, best_all = 1e300;
+        for (int r = 0; r < BENCH_REPS; ++r) {
+          cam_set_threads(1);
+          double t0 = bench_now_ns();
+          one = cam_mc_integrate(fs[k], NULL, dim, NULL, NULL, methods[m], 42, 0.0, 1e-4, BENCH_MAX_EVALS);
+          double t1 = bench_now_ns();
+          cam_set_threads(threads);
+          all = cam_mc_integrate(fs[k], NULL, dim, NULL, NULL, methods[m], 42, 0.0, 1e-4, BENCH_MAX_EVALS);
+          double t2 = bench_now_ns();
+          if (t1 - t0 < best_1) { best_1 = t1 - t0; }
+          if (t2 - t1 < best_all) { best_all = t2 - t1; }
+        }
+        printf("%-11s %3zu %6s %10.2f %10.2f %10zu %10.2e %10.2e %6s %5s\n", names[k], dim, (m == 0) ? "pseudo" : "sobol", best_1 * 1e-6,
+          best_all * 1e-6, all.evals, fabs(all.value - exact), all.error, (all.status == CAM_QUAD_OK) ? "ok" : "limit",
+          (one.value == all.value && one.error == all.error) ? "yes" : "no");
+      }
+    }
+  }
+  return 0;
+}
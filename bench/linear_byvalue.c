@@ -0,0 +1,152 @@
+/*
+ * linear_byvalue.c
+ * Compares the pointer, by-value (*v) and dst (*_to) forms of the linear
+ * algebra functions in chained expressions and array loops.
+ */
+
+#include "bench.h"
+
+#define BENCH_COUNT (1 << 16)
+#define BENCH_REPS  50
+
+/* Shared operands */
+static vec3* a3;
+static vec3* b3;
+static vec3* r3;
+static vec4* a4;
+static vec4* r4;
+static mat4x4 m;
+
+/* Chained expressions: acc = norm(acc + (a - b) * 0.5) */
+static float chain_ptr() {
+  vec3 acc = vec3_make(1.0f, 0.0f, 0.0f);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    vec3 t = vec3_sub(&a3[i], &b3[i]);
+    t = vec3_scale(&t, 0.5f);
+    t = vec3_add(&acc, &t);
+    acc = vec3_norm(&t);
+  }
+  return vec3_getx(&acc);
+}
+
+static float chain_val() {
+  vec3 acc = vec3_make(1.0f, 0.0f, 0.0f);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    acc = vec3_normv(vec3_addv(acc, vec3_scalev(vec3_subv(a3[i], b3[i]), 0.5f)));
+  }
+  return vec3_getx(&acc);
+}
+
+/* Chained transforms: v = m * v */
+static float xform_ptr() {
+  vec4 v = vec4_make(1.0f, 2.0f, 3.0f, 1.0f);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    v = mat4x4_vec4_mul(&m, &v);
+  }
+  return vec4_getx(&v);
+}
+
+static float xform_val() {
+  vec4 v = vec4_make(1.0f, 2.0f, 3.0f, 1.0f);
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    v = mat4x4_vec4_mulv(m, v);
+  }
+  return vec4_getx(&v);
+}
+
+/* Array loops: r[i] = a[i] + b[i] */
+static float add_ptr() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_add(&a3[i], &b3[i]); }
+  return vec3_getx(&r3[BENCH_COUNT - 1]);
+}
+
+static float add_val() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_addv(a3[i], b3[i]); }
+  return vec3_getx(&r3[BENCH_COUNT - 1]);
+}
+
+static float add_to() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { vec3_add_to(&r3[i], &a3[i], &b3[i]); }
+  return vec3_getx(&r3[BENCH_COUNT - 1]);
+}
+
+/* Array loops: r[i] = m * a[i] */
+static float mul_ptr() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = mat4x4_vec4_mul(&m, &a4[i]); }
+  return vec4_getx(&r4[BENCH_COUNT - 1]);
+}
+
+static float mul_val() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = mat4x4_vec4_mulv(m, a4[i]); }
+  return vec4_getx(&r4[BENCH_COUNT - 1]);
+}
+
+static float mul_to() {
+  for (size_t i = 0; i < BENCH_COUNT; ++i) { mat4x4_vec4_mul_to(&r4[i], &m, &a4[i]); }
+  return vec4_getx(&r4[BENCH_COUNT - 1]);
+}
+
+typedef struct {
+  const char* name;
+  float (*ptr)();
+  float (*val)();
+  float (*to)();
+} bench_case;
+
+static const bench_case cases[] = {
+  { "vec3 chain",        chain_ptr, chain_val, NULL },
+  { "mat4x4_vec4 chain", xform_ptr, xform_val, NULL },
+  { "vec3_add array",    add_ptr,   add_val,   add_to },
+  { "mat4x4_vec4 array", mul_ptr,   mul_val,   mul_to },
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(float (*fn)()) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    bench_consume(fn());
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / BENCH_COUNT;
+}
+
+int main() {
+  a3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  b3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  r3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  a4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  r4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  if (!a3 || !b3 || !r3 || !a4 || !r4) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    a3[i] = vec3_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    b3[i] = vec3_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    a4[i] = vec4_make(vec3_getx(&a3[i]), vec3_gety(&a3[i]), vec3_getz(&a3[i]), 1.0f);
+  }
+  // Rotation about z, so the transform chain stays bounded
+  m = mat4x4_make(0.8f, 0.6f, 0.0f, 0.0f, -0.6f, 0.8f, 0.0f, 0.0f,
+                  0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+  printf("%d elements, best of %d runs, tier %s\n", BENCH_COUNT, BENCH_REPS, cam_tier_name(cam_get_tier()));
+  printf("%-20s %12s %12s %12s\n", "case", "ptr ns/elem", "value ns/elem", "_to ns/elem");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    double ptr = time_per_element(cases[c].ptr);
+    double val = time_per_element(cases[c].val);
+    printf("%-20s %12.3f %12.3f ", cases[c].name, ptr, val);
+    if (cases[c].to) { printf("%12.3f\n", time_per_element(cases[c].to)); }
+    else { printf("%12s\n", "-"); }
+  }
+
+  cam_aligned_free(a3);
+  cam_aligned_free(b3);
+  cam_aligned_free(r3);
+  cam_aligned_free(a4);
+  cam_aligned_free(r4);
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * linear_fast.c
+ * Compares the approximate *_fast functions against the exact ones: maximum
+ * relative error over random inputs, and time per element for single calls
+ * and the *_fast_n array versions.
+ */
+
+#include "bench.h"
+
+#define BENCH_COUNT (1 << 16)
+#define BENCH_REPS  50
+
+/* Shared operands */
+static vec3* a3;
+static vec3* r3;
+static vec4* a4;
+static vec4* r4;
+static float* scalars;
+
+/* Exact loops */
+static void exact3_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec3_mag(&a3[i]); } }
+static void exact3_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_norm(&a3[i]); } }
+static void exact3_rcp() { vec3 one = vec3_make(1.0f, 1.0f, 1.0f); for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_div(&one, &a3[i]); } }
+static void exact4_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec4_mag(&a4[i]); } }
+static void exact4_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = vec4_norm(&a4[i]); } }
+static void exact4_rcp() { vec4 one = vec4_make(1.0f, 1.0f, 1.0f, 1.0f); for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = vec4_div(&one, &a4[i]); } }
+
+/* Approximate loops */
+static void fast3_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec3_mag_fast(&a3[i]); } }
+static void fast3_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_norm_fast(&a3[i]); } }
+static void fast3_rcp() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r3[i] = vec3_rcp_fast(&a3[i]); } }
+static void fast4_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec4_mag_fast(&a4[i]); } }
+static void fast4_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = vec4_norm_fast(&a4[i]); } }
+static void fast4_rcp() { for (size_t i = 0; i < BENCH_COUNT; ++i) { r4[i] = vec4_rcp_fast(&a4[i]); } }
+
+/* Array calls */
+static void batch3_mag() { vec3_mag_fast_n(scalars, a3, BENCH_COUNT); }
+static void batch3_norm() { vec3_norm_fast_n(r3, a3, BENCH_COUNT); }
+static void batch3_rcp() { vec3_rcp_fast_n(r3, a3, BENCH_COUNT); }
+static void batch4_mag() { vec4_mag_fast_n(scalars, a4, BENCH_COUNT); }
+static void batch4_norm() { vec4_norm_fast_n(r4, a4, BENCH_COUNT); }
+static void batch4_rcp() { vec4_rcp_fast_n(r4, a4, BENCH_COUNT); }
+
+typedef struct {
+  const char* name;
+  void (*exact)();
+  void (*fast)();
+  void (*batch)();
+} bench_case;
+
+static const bench_case cases[] = {
+  { "vec3_mag",  exact3_mag,  fast3_mag,  batch3_mag },
+  { "vec3_norm", exact3_norm, fast3_norm, batch3_norm },
+  { "vec3_rcp",  exact3_rcp,  fast3_rcp,  batch3_rcp },
+  { "vec4_mag",  exact4_mag,  fast4_mag,  batch4_mag },
+  { "vec4_norm", exact4_norm, fast4_norm, batch4_norm },
+  { "vec4_rcp",  exact4_rcp,  fast4_rcp,  batch4_rcp },
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(void (*fn)()) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    fn();
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / BENCH_COUNT;
+}
+
+static double rel_error(double approx, double exact) {
+  return fabs(approx - exact) / fabs(exact);
+}
+
+/* Maximum relative error of each approximation against double precision */
+static void print_errors() {
+  double mag = 0.0, norm = 0.0, rcp = 0.0;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    double x = vec4_getx(&a4[i]), y = vec4_gety(&a4[i]), z = vec4_getz(&a4[i]), w = vec4_getw(&a4[i]);
+    double m = sqrt(x * x + y * y + z * z + w * w);
+    vec4 n = vec4_norm_fast(&a4[i]);
+    vec4 r = vec4_rcp_fast(&a4[i]);
+    double e = rel_error(vec4_mag_fast(&a4[i]), m);
+    if (e > mag) { mag = e; }
+    e = rel_error(vec4_getx(&n), x / m);
+    if (e > norm) { norm = e; }
+    e = rel_error(vec4_getx(&r), 1.0 / x);
+    if (e > rcp) { rcp = e; }
+  }
+  printf("max relative error: mag %.3g, norm %.3g, rcp %.3g\n", mag, norm, rcp);
+}
+
+int main() {
+  a3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  r3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  a4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  r4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  scalars = (float*)cam_aligned_alloc(BENCH_COUNT * sizeof(float), CAM_SIMD_ALIGN);
+  if (!a3 || !r3 || !a4 || !r4 || !scalars) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  // Magnitudes spread over several decades so every estimate table entry is hit
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    float s = powf(10.0f, bench_randf(&seed, -3.0f, 3.0f));
+    a4[i] = vec4_make(s * bench_randf(&seed, 0.1f, 1.0f), s * bench_randf(&seed, 0.1f, 1.0f),
+                      s * bench_randf(&seed, 0.1f, 1.0f), s * bench_randf(&seed, 0.1f, 1.0f));
+    a3[i] = vec3_make(vec4_getx(&a4[i]), vec4_gety(&a4[i]), vec4_getz(&a4[i]));
+  }
+
+  printf("%d elements, best of %d runs, tier %s\n", BENCH_COUNT, BENCH_REPS, cam_tier_name(cam_get_tier()));
+  print_errors();
+  printf("%-10s %14s %14s %14s\n", "op", "exact ns/elem", "fast ns/elem", "fast_n ns/elem");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    double exact = time_per_element(cases[c].exact);
+    double fast = time_per_element(cases[c].fast);
+    double batch = time_per_element(cases[c].batch);
+    printf("%-10s %14.3f %14.3f %14.3f\n", cases[c].name, exact, fast, batch);
+  }
+  bench_consume(scalars[BENCH_COUNT - 1]);
+
+  cam_aligned_free(a3);
+  cam_aligned_free(r3);
+  cam_aligned_free(a4);
+  cam_aligned_free(r4);
+  cam_aligned_free(scalars);
+  return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * linear_inline.c
+ * Measures the per-call overhead removed by CAM_HEADER_ONLY: the same kernels are
+ * timed calling into the library and with the functions inlined from the headers.
+ */
+
+#include "linear_inline.h"
+
+#define BENCH_COUNT (1 << 16)
+#define BENCH_REPS  50
+
+typedef struct {
+  const char* name;
+  float (*call)(bench_data* d);
+  float (*inlined)(bench_data* d);
+} bench_case;
+
+#define BENCH_CASE(name, desc) { desc, call_##name, inline_##name },
+static const bench_case cases[] = {
+  BENCH_KERNELS(BENCH_CASE)
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(float (*fn)(bench_data*), bench_data* d) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    bench_consume(fn(d));
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / (double)d->count;
+}
+
+int main() {
+  bench_data d;
+  d.count = BENCH_COUNT;
+  d.a3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  d.b3 = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  d.a4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  d.b4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  d.r4 = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  d.m = (mat4x4*)cam_aligned_alloc(sizeof(mat4x4), CAM_SIMD_ALIGN);
+  if (!d.a3 || !d.b3 || !d.a4 || !d.b4 || !d.r4 || !d.m) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    d.a4[i] = vec4_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f),
+                        bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    d.b4[i] = vec4_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f),
+                        bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    d.a3[i] = vec3_make(vec4_getx(&d.a4[i]), vec4_gety(&d.a4[i]), vec4_getz(&d.a4[i]));
+    d.b3[i] = vec3_make(vec4_getx(&d.b4[i]), vec4_gety(&d.b4[i]), vec4_getz(&d.b4[i]));
+  }
+  // Close to a rotation so the multiply chain stays finite
+  *d.m = mat4x4_make(0.8f, 0.6f, 0.0f, 0.0f, -0.6f, 0.8f, 0.0f, 0.0f,
+                     0.0f, 0.0f, 1.0f, 0.0f, 0.1f, 0.2f, 0.3f, 1.0f);
+
+  printf("%d elements, best of %d runs, library tier %s\n", BENCH_COUNT, BENCH_REPS, cam_tier_name(cam_get_tier()));
+  printf("%-26s %13s %13s %9s\n", "kernel", "call ns/elem", "inline ns/elem", "speedup");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    double call = time_per_element(cases[c].call, &d);
+    double inlined = time_per_element(cases[c].inlined, &d);
+    printf("%-26s %13.3f %13.3f %8.2fx\n", cases[c].name, call, inlined, call / inlined);
+  }
+
+  cam_aligned_free(d.a3);
+  cam_aligned_free(d.b3);
+  cam_aligned_free(d.a4);
+  cam_aligned_free(d.b4);
+  cam_aligned_free(d.r4);
+  cam_aligned_free(d.m);
+  return 0;
+}
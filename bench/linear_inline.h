@@ -0,0 +1,93 @@
+/*
+ * linear_inline.h
+ * Kernels for the call overhead benchmark. Included once by linear_inline_call.c,
+ * which calls the library, and once by linear_inline_hdr.c, which is built with
+ * CAM_HEADER_ONLY so the same code inlines the header definitions.
+ */
+
+#ifndef CAM_BENCH_LINEAR_INLINE_H
+#define CAM_BENCH_LINEAR_INLINE_H
+
+#include "bench.h"
+
+/* Operands shared by every kernel */
+typedef struct {
+  vec3* a3;
+  vec3* b3;
+  vec4* a4;
+  vec4* b4;
+  vec4* r4;
+  mat4x4* m;
+  size_t count;
+} bench_data;
+
+/* Kernel list: X(name, description) */
+#define BENCH_KERNELS(X) \
+  X(get,       "vec3_get{x,y,z} sum") \
+  X(chain,     "vec3 sub/scale/add chain") \
+  X(dist,      "vec4_dist sum") \
+  X(norm,      "vec4_norm + vec4_add") \
+  X(transform, "mat4x4_vec4_mul") \
+  X(matmul,    "mat4x4_mul chain")
+
+#define BENCH_DECLARE(name, desc) \
+  float call_##name(bench_data* d); \
+  float inline_##name(bench_data* d);
+BENCH_KERNELS(BENCH_DECLARE)
+
+#endif
+
+/* Kernel definitions, named by the including file */
+#if defined(BENCH_KERNEL)
+
+float BENCH_KERNEL(get)(bench_data* d) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < d->count; ++i) {
+    sum += vec3_getx(&d->a3[i]) + vec3_gety(&d->a3[i]) + vec3_getz(&d->a3[i]);
+  }
+  return sum;
+}
+
+float BENCH_KERNEL(chain)(bench_data* d) {
+  vec3 acc = vec3_makez();
+  for (size_t i = 0; i < d->count; ++i) {
+    vec3 t = vec3_sub(&d->a3[i], &d->b3[i]);
+    t = vec3_scale(&t, 0.5f);
+    acc = vec3_add(&acc, &t);
+  }
+  return vec3_mag(&acc);
+}
+
+float BENCH_KERNEL(dist)(bench_data* d) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < d->count; ++i) {
+    sum += vec4_dist(&d->a4[i], &d->b4[i]);
+  }
+  return sum;
+}
+
+float BENCH_KERNEL(norm)(bench_data* d) {
+  vec4 acc = vec4_makez();
+  for (size_t i = 0; i < d->count; ++i) {
+    vec4 n = vec4_norm(&d->a4[i]);
+    acc = vec4_add(&acc, &n);
+  }
+  return vec4_getx(&acc);
+}
+
+float BENCH_KERNEL(transform)(bench_data* d) {
+  for (size_t i = 0; i < d->count; ++i) {
+    d->r4[i] = mat4x4_vec4_mul(d->m, &d->a4[i]);
+  }
+  return vec4_getw(&d->r4[d->count - 1]);
+}
+
+float BENCH_KERNEL(matmul)(bench_data* d) {
+  mat4x4 acc = mat4x4_makeid();
+  for (size_t i = 0; i < d->count; ++i) {
+    acc = mat4x4_mul(&acc, d->m);
+  }
+  return mat4x4_get(3, 3, &acc);
+}
+
+#endif
@@ -0,0 +1,7 @@
+/*
+ * linear_inline_call.c
+ * Benchmark kernels calling the linear algebra functions in the library.
+ */
+
+#define BENCH_KERNEL(name) call_##name
+#include "linear_inline.h"
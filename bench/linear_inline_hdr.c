@@ -0,0 +1,8 @@
+/*
+ * linear_inline_hdr.c
+ * Benchmark kernels inlining the linear algebra functions from the headers.
+ */
+
+#define CAM_HEADER_ONLY
+#define BENCH_KERNEL(name) inline_##name
+#include "linear_inline.h"
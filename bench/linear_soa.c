@@ -0,0 +1,214 @@
+/*
+ * linear_soa.c
+ * Compares the vec3/vec4/mat3x3/mat4x4 structure-of-arrays batch kernels against
+ * looping over the per-element functions.
+ */
+
+#include "bench.h"
+
+#define BENCH_COUNT (1 << 20)
+#define BENCH_MAT_COUNT (1 << 16)
+#define BENCH_REPS  15
+
+/* Shared operands */
+static vec3* aos3_a;
+static vec3* aos3_b;
+static vec3* aos3_r;
+static vec4* aos4_a;
+static vec4* aos4_b;
+static vec4* aos4_r;
+static float* scalars;
+static vec3_soa soa3_a, soa3_b, soa3_r;
+static vec4_soa soa4_a, soa4_b, soa4_r;
+static mat3x3* aosm3_a;
+static mat3x3* aosm3_r;
+static mat4x4* aosm4_a;
+static mat4x4* aosm4_r;
+static mat3x3_soa soam3_a, soam3_r;
+static mat4x4_soa soam4_a, soam4_r;
+
+/* Per-element loops */
+static void loop3_add() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_add(&aos3_a[i], &aos3_b[i]); } }
+static void loop3_sub() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_sub(&aos3_a[i], &aos3_b[i]); } }
+static void loop3_mul() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_mul(&aos3_a[i], &aos3_b[i]); } }
+static void loop3_div() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_div(&aos3_a[i], &aos3_b[i]); } }
+static void loop3_scale() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_scale(&aos3_a[i], 1.5f); } }
+static void loop3_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec3_mag(&aos3_a[i]); } }
+static void loop3_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos3_r[i] = vec3_norm(&aos3_a[i]); } }
+static void loop3_dist() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec3_dist(&aos3_a[i], &aos3_b[i]); } }
+
+static void loop4_add() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_add(&aos4_a[i], &aos4_b[i]); } }
+static void loop4_sub() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_sub(&aos4_a[i], &aos4_b[i]); } }
+static void loop4_mul() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_mul(&aos4_a[i], &aos4_b[i]); } }
+static void loop4_div() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_div(&aos4_a[i], &aos4_b[i]); } }
+static void loop4_scale() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_scale(&aos4_a[i], 1.5f); } }
+static void loop4_mag() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec4_mag(&aos4_a[i]); } }
+static void loop4_norm() { for (size_t i = 0; i < BENCH_COUNT; ++i) { aos4_r[i] = vec4_norm(&aos4_a[i]); } }
+static void loop4_dist() { for (size_t i = 0; i < BENCH_COUNT; ++i) { scalars[i] = vec4_dist(&aos4_a[i], &aos4_b[i]); } }
+
+static void loopm3_det() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { scalars[i] = mat3x3_det(&aosm3_a[i]); } }
+static void loopm3_inverse() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { aosm3_r[i] = mat3x3_inverse(&aosm3_a[i]); } }
+static void loopm3_inverse_rigid() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { aosm3_r[i] = mat3x3_inverse_rigid(&aosm3_a[i]); } }
+static void loopm4_det() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { scalars[i] = mat4x4_det(&aosm4_a[i]); } }
+static void loopm4_inverse() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { aosm4_r[i] = mat4x4_inverse(&aosm4_a[i]); } }
+static void loopm4_inverse_rigid() { for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) { aosm4_r[i] = mat4x4_inverse_rigid(&aosm4_a[i]); } }
+
+/* Batch calls */
+static void soa3_add() { vec3_soa_add(&soa3_r, &soa3_a, &soa3_b); }
+static void soa3_sub() { vec3_soa_sub(&soa3_r, &soa3_a, &soa3_b); }
+static void soa3_mul() { vec3_soa_mul(&soa3_r, &soa3_a, &soa3_b); }
+static void soa3_div() { vec3_soa_div(&soa3_r, &soa3_a, &soa3_b); }
+static void soa3_scale() { vec3_soa_scale(&soa3_r, &soa3_a, 1.5f); }
+static void soa3_mag() { vec3_soa_mag(scalars, &soa3_a); }
+static void soa3_norm() { vec3_soa_norm(&soa3_r, &soa3_a); }
+static void soa3_dist() { vec3_soa_dist(scalars, &soa3_a, &soa3_b); }
+
+static void soa4_add() { vec4_soa_add(&soa4_r, &soa4_a, &soa4_b); }
+static void soa4_sub() { vec4_soa_sub(&soa4_r, &soa4_a, &soa4_b); }
+static void soa4_mul() { vec4_soa_mul(&soa4_r, &soa4_a, &soa4_b); }
+static void soa4_div() { vec4_soa_div(&soa4_r, &soa4_a, &soa4_b); }
+static void soa4_scale() { vec4_soa_scale(&soa4_r, &soa4_a, 1.5f); }
+static void soa4_mag() { vec4_soa_mag(scalars, &soa4_a); }
+static void soa4_norm() { vec4_soa_norm(&soa4_r, &soa4_a); }
+static void soa4_dist() { vec4_soa_dist(scalars, &soa4_a, &soa4_b); }
+
+static void soam3_det() { mat3x3_soa_det(scalars, &soam3_a); }
+static void soam3_inverse() { mat3x3_soa_inverse(&soam3_r, &soam3_a); }
+static void soam3_inverse_rigid() { mat3x3_soa_inverse_rigid(&soam3_r, &soam3_a); }
+static void soam4_det() { mat4x4_soa_det(scalars, &soam4_a); }
+static void soam4_inverse() { mat4x4_soa_inverse(&soam4_r, &soam4_a); }
+static void soam4_inverse_rigid() { mat4x4_soa_inverse_rigid(&soam4_r, &soam4_a); }
+
+typedef struct {
+  const char* name;
+  void (*loop)();
+  void (*batch)();
+  size_t count;
+} bench_case;
+
+static const bench_case cases[] = {
+  { "vec3_add",   loop3_add,   soa3_add, BENCH_COUNT },
+  { "vec3_sub",   loop3_sub,   soa3_sub, BENCH_COUNT },
+  { "vec3_mul",   loop3_mul,   soa3_mul, BENCH_COUNT },
+  { "vec3_div",   loop3_div,   soa3_div, BENCH_COUNT },
+  { "vec3_scale", loop3_scale, soa3_scale, BENCH_COUNT },
+  { "vec3_mag",   loop3_mag,   soa3_mag, BENCH_COUNT },
+  { "vec3_norm",  loop3_norm,  soa3_norm, BENCH_COUNT },
+  { "vec3_dist",  loop3_dist,  soa3_dist, BENCH_COUNT },
+  { "vec4_add",   loop4_add,   soa4_add, BENCH_COUNT },
+  { "vec4_sub",   loop4_sub,   soa4_sub, BENCH_COUNT },
+  { "vec4_mul",   loop4_mul,   soa4_mul, BENCH_COUNT },
+  { "vec4_div",   loop4_div,   soa4_div, BENCH_COUNT },
+  { "vec4_scale", loop4_scale, soa4_scale, BENCH_COUNT },
+  { "vec4_mag",   loop4_mag,   soa4_mag, BENCH_COUNT },
+  { "vec4_norm",  loop4_norm,  soa4_norm, BENCH_COUNT },
+  { "vec4_dist",  loop4_dist,  soa4_dist, BENCH_COUNT },
+  { "mat3x3_det",           loopm3_det,           soam3_det,           BENCH_MAT_COUNT },
+  { "mat3x3_inverse",       loopm3_inverse,       soam3_inverse,       BENCH_MAT_COUNT },
+  { "mat3x3_inverse_rigid", loopm3_inverse_rigid, soam3_inverse_rigid, BENCH_MAT_COUNT },
+  { "mat4x4_det",           loopm4_det,           soam4_det,           BENCH_MAT_COUNT },
+  { "mat4x4_inverse",       loopm4_inverse,       soam4_inverse,       BENCH_MAT_COUNT },
+  { "mat4x4_inverse_rigid", loopm4_inverse_rigid, soam4_inverse_rigid, BENCH_MAT_COUNT },
+};
+
+/* Best time per element over several repetitions */
+static double time_per_element(void (*fn)(), size_t count) {
+  double best = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    double t0 = bench_now_ns();
+    fn();
+    double t = bench_now_ns() - t0;
+    if (t < best) { best = t; }
+  }
+  return best / count;
+}
+
+int main() {
+  aos3_a = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  aos3_b = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  aos3_r = (vec3*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec3), CAM_SIMD_ALIGN);
+  aos4_a = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  aos4_b = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  aos4_r = (vec4*)cam_aligned_alloc(BENCH_COUNT * sizeof(vec4), CAM_SIMD_ALIGN);
+  scalars = (float*)cam_aligned_alloc(BENCH_COUNT * sizeof(float), CAM_SIMD_ALIGN);
+  soa3_a = vec3_soa_make(BENCH_COUNT);
+  soa3_b = vec3_soa_make(BENCH_COUNT);
+  soa3_r = vec3_soa_make(BENCH_COUNT);
+  soa4_a = vec4_soa_make(BENCH_COUNT);
+  soa4_b = vec4_soa_make(BENCH_COUNT);
+  soa4_r = vec4_soa_make(BENCH_COUNT);
+  aosm3_a = (mat3x3*)cam_aligned_alloc(BENCH_MAT_COUNT * sizeof(mat3x3), CAM_SIMD_ALIGN);
+  aosm3_r = (mat3x3*)cam_aligned_alloc(BENCH_MAT_COUNT * sizeof(mat3x3), CAM_SIMD_ALIGN);
+  aosm4_a = (mat4x4*)cam_aligned_alloc(BENCH_MAT_COUNT * sizeof(mat4x4), CAM_SIMD_ALIGN);
+  aosm4_r = (mat4x4*)cam_aligned_alloc(BENCH_MAT_COUNT * sizeof(mat4x4), CAM_SIMD_ALIGN);
+  soam3_a = mat3x3_soa_make(BENCH_MAT_COUNT);
+  soam3_r = mat3x3_soa_make(BENCH_MAT_COUNT);
+  soam4_a = mat4x4_soa_make(BENCH_MAT_COUNT);
+  soam4_r = mat4x4_soa_make(BENCH_MAT_COUNT);
+  if (!aos3_a || !aos3_b || !aos3_r || !aos4_a || !aos4_b || !aos4_r || !scalars ||
+      !soa4_a.count || !soa4_b.count || !soa4_r.count ||
+      !soa3_a.count || !soa3_b.count || !soa3_r.count ||
+      !aosm3_a || !aosm3_r || !aosm4_a || !aosm4_r ||
+      !soam3_a.count || !soam3_r.count || !soam4_a.count || !soam4_r.count) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  // Same random operands in both layouts, kept away from zero for div/norm
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_COUNT; ++i) {
+    aos4_a[i] = vec4_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f),
+                          bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    aos4_b[i] = vec4_make(bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f),
+                          bench_randf(&seed, 1.0f, 2.0f), bench_randf(&seed, 1.0f, 2.0f));
+    aos3_a[i] = vec3_make(vec4_getx(&aos4_a[i]), vec4_gety(&aos4_a[i]), vec4_getz(&aos4_a[i]));
+    aos3_b[i] = vec3_make(vec4_getx(&aos4_b[i]), vec4_gety(&aos4_b[i]), vec4_getz(&aos4_b[i]));
+    vec3_soa_set(&soa3_a, i, &aos3_a[i]);
+    vec3_soa_set(&soa3_b, i, &aos3_b[i]);
+    vec4_soa_set(&soa4_a, i, &aos4_a[i]);
+    vec4_soa_set(&soa4_b, i, &aos4_b[i]);
+  }
+
+  // Diagonally dominant matrices, so every inverse is finite
+  for (size_t i = 0; i < BENCH_MAT_COUNT; ++i) {
+    float e[16];
+    for (int j = 0; j < 16; ++j) { e[j] = bench_randf(&seed, -1.0f, 1.0f) + ((j % 5) ? 0.0f : 4.0f); }
+    aosm4_a[i] = mat4x4_make(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7],
+                             e[8], e[9], e[10], e[11], e[12], e[13], e[14], e[15]);
+    aosm3_a[i] = mat3x3_make(e[0], e[1], e[2], e[4], e[5], e[6], e[8], e[9], e[10]);
+    mat3x3_soa_set(&soam3_a, i, &aosm3_a[i]);
+    mat4x4_soa_set(&soam4_a, i, &aosm4_a[i]);
+  }
+
+  printf("%d vectors, %d matrices, best of %d runs\n", BENCH_COUNT, BENCH_MAT_COUNT, BENCH_REPS);
+  printf("%-20s %14s %14s %9s\n", "op", "loop ns/elem", "batch ns/elem", "speedup");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    double loop = time_per_element(cases[c].loop, cases[c].count);
+    double batch = time_per_element(cases[c].batch, cases[c].count);
+    printf("%-20s %14.3f %14.3f %8.2fx\n", cases[c].name, loop, batch, loop / batch);
+  }
+  bench_consume(scalars[BENCH_COUNT - 1]);
+
+  vec3_soa_free(&soa3_a);
+  vec3_soa_free(&soa3_b);
+  vec3_soa_free(&soa3_r);
+  vec4_soa_free(&soa4_a);
+  vec4_soa_free(&soa4_b);
+  vec4_soa_free(&soa4_r);
+  mat3x3_soa_free(&soam3_a);
+  mat3x3_soa_free(&soam3_r);
+  mat4x4_soa_free(&soam4_a);
+  mat4x4_soa_free(&soam4_r);
+  cam_aligned_free(aos3_a);
+  cam_aligned_free(aos3_b);
+  cam_aligned_free(aos3_r);
+  cam_aligned_free(aos4_a);
+  cam_aligned_free(aos4_b);
+  cam_aligned_free(aos4_r);
+  cam_aligned_free(aosm3_a);
+  cam_aligned_free(aosm3_r);
+  cam_aligned_free(aosm4_a);
+  cam_aligned_free(aosm4_r);
+  cam_aligned_free(scalars);
+  return 0;
+}
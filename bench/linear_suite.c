@@ -0,0 +1,493 @@
+/*
+ * linear_suite.c
+ * Times every public vec2/vec3/vec4/mat2x2/mat3x3/mat4x4 function on each SIMD
+ * tier this CPU supports and writes the results as JSON.
+ *
+ * Latency mode chains each call's result into the next call's operand; functions
+ * returning a scalar feed it back as x += 0 * s, which adds a multiply and an add
+ * to the chain. Throughput mode streams independent operands. Constructors and
+ * the array (_n) functions have no meaningful chain and only report throughput,
+ * array functions per element.
+ *
+ * Usage: cam_bench [-o file.json] [--tier scalar|sse41|avx2] [--filter substring]
+ */
+
+#include "bench.h"
+#include <string.h>
+
+#define BENCH_N     64    // Operands per stream, small enough to stay in L1
+#define BENCH_MASK  (BENCH_N - 1)
+#define BENCH_CALLS 8192  // Calls per timed run
+#define BENCH_REPS  9     // Timed runs, the fastest is reported
+
+/* Operand streams */
+#define BENCH_STREAMS(T) static T a_##T[BENCH_N], b_##T[BENCH_N], r_##T[BENCH_N];
+BENCH_STREAMS(vec2)
+BENCH_STREAMS(vec3)
+BENCH_STREAMS(vec4)
+BENCH_STREAMS(mat2x2)
+BENCH_STREAMS(mat3x3)
+BENCH_STREAMS(mat4x4)
+BENCH_STREAMS(float)
+
+/* Keep the results stored by the kernels alive */
+static inline void bench_keep(const void* p) {
+  float f;
+  memcpy(&f, p, sizeof(f));
+  bench_consume(f);
+}
+
+static void bench_keep_streams() {
+  bench_keep(&r_vec2[0]);
+  bench_keep(&r_vec3[0]);
+  bench_keep(&r_vec4[0]);
+  bench_keep(&r_mat2x2[0]);
+  bench_keep(&r_mat3x3[0]);
+  bench_keep(&r_mat4x4[0]);
+  bench_keep(&r_float[0]);
+}
+
+/* Make x depend on s without changing it: every type starts with one vector */
+#if defined(CAM_SIMD_AVX)
+#define BENCH_FEED(x, s) (*(__m128*)&(x) = _mm_add_ss(*(__m128*)&(x), _mm_set_ss((float)(s) * 0.0f)))
+#elif defined(CAM_SIMD_NEON)
+#define BENCH_FEED(x, s) (*(float32x4_t*)&(x) = vaddq_f32(*(float32x4_t*)&(x), vdupq_n_f32((float)(s) * 0.0f)))
+#else
+#define BENCH_FEED(x, s) (((float*)&(x))[0] += (float)(s) * 0.0f)
+#endif
+
+/* Kernels by signature */
+#define BENCH_LAT(fn, T, body) \
+  static void lat_##fn(size_t n) { T x = a_##T[0]; for (size_t i = 0; i < n; ++i) { size_t k = i & BENCH_MASK; (void)k; body; } r_##T[0] = x; }
+#define BENCH_THR(fn, body) \
+  static void thr_##fn(size_t n) { for (size_t i = 0; i < n; ++i) { size_t k = i & BENCH_MASK; (void)k; body; } }
+
+// T fn(...) without a T operand
+#define BENCH_MAKE(T, fn, args) BENCH_THR(fn, r_##T[k] = fn args)
+// T fn(T*, T*), T fn(T, T), void fn(T* dst, T*, T*)
+#define BENCH_BIN(T, fn)   BENCH_LAT(fn, T, x = fn(&x, &b_##T[k])) BENCH_THR(fn, r_##T[k] = fn(&a_##T[k], &b_##T[k]))
+#define BENCH_BINV(T, fn)  BENCH_LAT(fn, T, x = fn(x, b_##T[k])) BENCH_THR(fn, r_##T[k] = fn(a_##T[k], b_##T[k]))
+#define BENCH_BINTO(T, fn) BENCH_LAT(fn, T, fn(&x, &x, &b_##T[k])) BENCH_THR(fn, fn(&r_##T[k], &a_##T[k], &b_##T[k]))
+// T fn(T*), T fn(T), void fn(T* dst, T*)
+#define BENCH_UN(T, fn)    BENCH_LAT(fn, T, x = fn(&x)) BENCH_THR(fn, r_##T[k] = fn(&a_##T[k]))
+#define BENCH_UNV(T, fn)   BENCH_LAT(fn, T, x = fn(x)) BENCH_THR(fn, r_##T[k] = fn(a_##T[k]))
+#define BENCH_UNTO(T, fn)  BENCH_LAT(fn, T, fn(&x, &x)) BENCH_THR(fn, fn(&r_##T[k], &a_##T[k]))
+// T fn(T*, float), T fn(T, float), void fn(T* dst, T*, float)
+#define BENCH_SCALE(T, fn)   BENCH_LAT(fn, T, x = fn(&x, a_float[k])) BENCH_THR(fn, r_##T[k] = fn(&a_##T[k], a_float[k]))
+#define BENCH_SCALEV(T, fn)  BENCH_LAT(fn, T, x = fn(x, a_float[k])) BENCH_THR(fn, r_##T[k] = fn(a_##T[k], a_float[k]))
+#define BENCH_SCALETO(T, fn) BENCH_LAT(fn, T, fn(&x, &x, a_float[k])) BENCH_THR(fn, fn(&r_##T[k], &a_##T[k], a_float[k]))
+// float or bool fn(T*), fn(T), fn(T*, T*), fn(T, T)
+#define BENCH_RED(T, fn)   BENCH_LAT(fn, T, BENCH_FEED(x, fn(&x))) BENCH_THR(fn, r_float[k] = (float)fn(&a_##T[k]))
+#define BENCH_REDV(T, fn)  BENCH_LAT(fn, T, BENCH_FEED(x, fn(x))) BENCH_THR(fn, r_float[k] = (float)fn(a_##T[k]))
+#define BENCH_RED2(T, fn)  BENCH_LAT(fn, T, BENCH_FEED(x, fn(&x, &b_##T[k]))) BENCH_THR(fn, r_float[k] = (float)fn(&a_##T[k], &b_##T[k]))
+#define BENCH_RED2V(T, fn) BENCH_LAT(fn, T, BENCH_FEED(x, fn(x, b_##T[k]))) BENCH_THR(fn, r_float[k] = (float)fn(a_##T[k], b_##T[k]))
+// void fn(T*, float), float fn(unsigned int col, unsigned int row, T*)
+#define BENCH_SET(T, fn) BENCH_LAT(fn, T, fn(&x, a_float[k])) BENCH_THR(fn, fn(&r_##T[k], a_float[k]))
+#define BENCH_GET(T, fn) BENCH_LAT(fn, T, BENCH_FEED(x, fn(1, 1, &x))) BENCH_THR(fn, r_float[k] = fn(1, 1, &a_##T[k]))
+// V fn(M*, V*), V fn(M, V), void fn(V* dst, M*, V*)
+#define BENCH_MATVEC(M, V, fn)   BENCH_LAT(fn, V, x = fn(&a_##M[k], &x)) BENCH_THR(fn, r_##V[k] = fn(&a_##M[k], &a_##V[k]))
+#define BENCH_MATVECV(M, V, fn)  BENCH_LAT(fn, V, x = fn(a_##M[k], x)) BENCH_THR(fn, r_##V[k] = fn(a_##M[k], a_##V[k]))
+#define BENCH_MATVECTO(M, V, fn) BENCH_LAT(fn, V, fn(&x, &a_##M[k], &x)) BENCH_THR(fn, fn(&r_##V[k], &a_##M[k], &a_##V[k]))
+// Array functions, one call per BENCH_N elements
+#define BENCH_ARRAY(T, U, fn)       BENCH_THR(fn, if (k == 0) { fn(r_##U, a_##T, BENCH_N); })
+#define BENCH_ARRAY2(T, fn)         BENCH_THR(fn, if (k == 0) { fn(r_##T, a_##T, b_##T, BENCH_N); })
+#define BENCH_TRANSFORM(M, V, fn)   BENCH_THR(fn, if (k == 0) { fn(r_##V, &a_##M[0], a_##V, BENCH_N); })
+
+/* Every benchmarked function */
+#define BENCH_LIST \
+  /* vec2 */ \
+  BENCH_MAKE(vec2, vec2_make, (a_float[k], a_float[(k + 1) & BENCH_MASK])) \
+  BENCH_MAKE(vec2, vec2_makez, ()) \
+  BENCH_RED(vec2, vec2_getx) \
+  BENCH_RED(vec2, vec2_gety) \
+  BENCH_SET(vec2, vec2_setx) \
+  BENCH_SET(vec2, vec2_sety) \
+  BENCH_RED2(vec2, vec2_equal) \
+  BENCH_RED(vec2, vec2_equalz) \
+  BENCH_BIN(vec2, vec2_add) \
+  BENCH_BIN(vec2, vec2_sub) \
+  BENCH_BIN(vec2, vec2_mul) \
+  BENCH_BIN(vec2, vec2_div) \
+  BENCH_RED(vec2, vec2_mag) \
+  BENCH_SCALE(vec2, vec2_scale) \
+  BENCH_UN(vec2, vec2_norm) \
+  BENCH_RED2(vec2, vec2_dist) \
+  BENCH_BINV(vec2, vec2_addv) \
+  BENCH_BINV(vec2, vec2_subv) \
+  BENCH_BINV(vec2, vec2_mulv) \
+  BENCH_BINV(vec2, vec2_divv) \
+  BENCH_SCALEV(vec2, vec2_scalev) \
+  BENCH_REDV(vec2, vec2_magv) \
+  BENCH_UNV(vec2, vec2_normv) \
+  BENCH_RED2V(vec2, vec2_distv) \
+  BENCH_BINTO(vec2, vec2_add_to) \
+  BENCH_BINTO(vec2, vec2_sub_to) \
+  BENCH_BINTO(vec2, vec2_mul_to) \
+  BENCH_BINTO(vec2, vec2_div_to) \
+  BENCH_SCALETO(vec2, vec2_scale_to) \
+  BENCH_UNTO(vec2, vec2_norm_to) \
+  BENCH_RED(vec2, vec2_mag_fast) \
+  BENCH_UN(vec2, vec2_norm_fast) \
+  BENCH_UN(vec2, vec2_rcp_fast) \
+  BENCH_ARRAY(vec2, float, vec2_mag_fast_n) \
+  BENCH_ARRAY(vec2, vec2, vec2_norm_fast_n) \
+  BENCH_ARRAY(vec2, vec2, vec2_rcp_fast_n) \
+  /* vec3 */ \
+  BENCH_MAKE(vec3, vec3_make, (a_float[k], a_float[(k + 1) & BENCH_MASK], a_float[(k + 2) & BENCH_MASK])) \
+  BENCH_MAKE(vec3, vec3_makez, ()) \
+  BENCH_RED(vec3, vec3_getx) \
+  BENCH_RED(vec3, vec3_gety) \
+  BENCH_RED(vec3, vec3_getz) \
+  BENCH_SET(vec3, vec3_setx) \
+  BENCH_SET(vec3, vec3_sety) \
+  BENCH_SET(vec3, vec3_setz) \
+  BENCH_RED2(vec3, vec3_equal) \
+  BENCH_RED(vec3, vec3_equalz) \
+  BENCH_BIN(vec3, vec3_add) \
+  BENCH_BIN(vec3, vec3_sub) \
+  BENCH_BIN(vec3, vec3_mul) \
+  BENCH_BIN(vec3, vec3_div) \
+  BENCH_RED(vec3, vec3_mag) \
+  BENCH_SCALE(vec3, vec3_scale) \
+  BENCH_UN(vec3, vec3_norm) \
+  BENCH_RED2(vec3, vec3_dist) \
+  BENCH_BINV(vec3, vec3_addv) \
+  BENCH_BINV(vec3, vec3_subv) \
+  BENCH_BINV(vec3, vec3_mulv) \
+  BENCH_BINV(vec3, vec3_divv) \
+  BENCH_SCALEV(vec3, vec3_scalev) \
+  BENCH_REDV(vec3, vec3_magv) \
+  BENCH_UNV(vec3, vec3_normv) \
+  BENCH_RED2V(vec3, vec3_distv) \
+  BENCH_BINTO(vec3, vec3_add_to) \
+  BENCH_BINTO(vec3, vec3_sub_to) \
+  BENCH_BINTO(vec3, vec3_mul_to) \
+  BENCH_BINTO(vec3, vec3_div_to) \
+  BENCH_SCALETO(vec3, vec3_scale_to) \
+  BENCH_UNTO(vec3, vec3_norm_to) \
+  BENCH_RED(vec3, vec3_mag_fast) \
+  BENCH_UN(vec3, vec3_norm_fast) \
+  BENCH_UN(vec3, vec3_rcp_fast) \
+  BENCH_ARRAY(vec3, float, vec3_mag_fast_n) \
+  BENCH_ARRAY(vec3, vec3, vec3_norm_fast_n) \
+  BENCH_ARRAY(vec3, vec3, vec3_rcp_fast_n) \
+  /* vec4 */ \
+  BENCH_MAKE(vec4, vec4_make, (a_float[k], a_float[(k + 1) & BENCH_MASK], a_float[(k + 2) & BENCH_MASK], a_float[(k + 3) & BENCH_MASK])) \
+  BENCH_MAKE(vec4, vec4_makez, ()) \
+  BENCH_RED(vec4, vec4_getx) \
+  BENCH_RED(vec4, vec4_gety) \
+  BENCH_RED(vec4, vec4_getw) \
+  BENCH_RED(vec4, vec4_getz) \
+  BENCH_SET(vec4, vec4_setx) \
+  BENCH_SET(vec4, vec4_sety) \
+  BENCH_SET(vec4, vec4_setz) \
+  BENCH_SET(vec4, vec4_setw) \
+  BENCH_RED2(vec4, vec4_equal) \
+  BENCH_RED(vec4, vec4_equalz) \
+  BENCH_BIN(vec4, vec4_add) \
+  BENCH_BIN(vec4, vec4_sub) \
+  BENCH_BIN(vec4, vec4_mul) \
+  BENCH_BIN(vec4, vec4_div) \
+  BENCH_RED(vec4, vec4_mag) \
+  BENCH_SCALE(vec4, vec4_scale) \
+  BENCH_UN(vec4, vec4_norm) \
+  BENCH_RED2(vec4, vec4_dist) \
+  BENCH_BINV(vec4, vec4_addv) \
+  BENCH_BINV(vec4, vec4_subv) \
+  BENCH_BINV(vec4, vec4_mulv) \
+  BENCH_BINV(vec4, vec4_divv) \
+  BENCH_SCALEV(vec4, vec4_scalev) \
+  BENCH_REDV(vec4, vec4_magv) \
+  BENCH_UNV(vec4, vec4_normv) \
+  BENCH_RED2V(vec4, vec4_distv) \
+  BENCH_BINTO(vec4, vec4_add_to) \
+  BENCH_BINTO(vec4, vec4_sub_to) \
+  BENCH_BINTO(vec4, vec4_mul_to) \
+  BENCH_BINTO(vec4, vec4_div_to) \
+  BENCH_SCALETO(vec4, vec4_scale_to) \
+  BENCH_UNTO(vec4, vec4_norm_to) \
+  BENCH_RED(vec4, vec4_mag_fast) \
+  BENCH_UN(vec4, vec4_norm_fast) \
+  BENCH_UN(vec4, vec4_rcp_fast) \
+  BENCH_ARRAY(vec4, float, vec4_mag_fast_n) \
+  BENCH_ARRAY(vec4, vec4, vec4_norm_fast_n) \
+  BENCH_ARRAY(vec4, vec4, vec4_rcp_fast_n) \
+  /* mat2x2 */ \
+  BENCH_MAKE(mat2x2, mat2x2_make, (a_float[k], a_float[(k + 1) & BENCH_MASK], a_float[(k + 2) & BENCH_MASK], a_float[(k + 3) & BENCH_MASK])) \
+  BENCH_MAKE(mat2x2, mat2x2_makeid, ()) \
+  BENCH_RED2(mat2x2, mat2x2_equal) \
+  BENCH_RED(mat2x2, mat2x2_equalid) \
+  BENCH_GET(mat2x2, mat2x2_get) \
+  BENCH_BIN(mat2x2, mat2x2_add) \
+  BENCH_BIN(mat2x2, mat2x2_sub) \
+  BENCH_SCALE(mat2x2, mat2x2_scale) \
+  BENCH_BIN(mat2x2, mat2x2_mul) \
+  BENCH_ARRAY2(mat2x2, mat2x2_mul_n) \
+  BENCH_MATVEC(mat2x2, vec2, mat2x2_vec2_mul) \
+  BENCH_UN(mat2x2, mat2x2_transpose) \
+  BENCH_RED(mat2x2, mat2x2_det) \
+  BENCH_BINV(mat2x2, mat2x2_addv) \
+  BENCH_BINV(mat2x2, mat2x2_subv) \
+  BENCH_SCALEV(mat2x2, mat2x2_scalev) \
+  BENCH_BINV(mat2x2, mat2x2_mulv) \
+  BENCH_MATVECV(mat2x2, vec2, mat2x2_vec2_mulv) \
+  BENCH_UNV(mat2x2, mat2x2_transposev) \
+  BENCH_REDV(mat2x2, mat2x2_detv) \
+  BENCH_BINTO(mat2x2, mat2x2_add_to) \
+  BENCH_BINTO(mat2x2, mat2x2_sub_to) \
+  BENCH_SCALETO(mat2x2, mat2x2_scale_to) \
+  BENCH_BINTO(mat2x2, mat2x2_mul_to) \
+  BENCH_MATVECTO(mat2x2, vec2, mat2x2_vec2_mul_to) \
+  BENCH_UNTO(mat2x2, mat2x2_transpose_to) \
+  /* mat3x3 */ \
+  BENCH_MAKE(mat3x3, mat3x3_make, (a_float[k], a_float[(k + 1) & BENCH_MASK], a_float[(k + 2) & BENCH_MASK], a_float[(k + 3) & BENCH_MASK], a_float[(k + 4) & BENCH_MASK], a_float[(k + 5) & BENCH_MASK], a_float[(k + 6) & BENCH_MASK], a_float[(k + 7) & BENCH_MASK], a_float[(k + 8) & BENCH_MASK])) \
+  BENCH_MAKE(mat3x3, mat3x3_makeid, ()) \
+  BENCH_RED2(mat3x3, mat3x3_equal) \
+  BENCH_RED(mat3x3, mat3x3_equalid) \
+  BENCH_GET(mat3x3, mat3x3_get) \
+  BENCH_BIN(mat3x3, mat3x3_add) \
+  BENCH_BIN(mat3x3, mat3x3_sub) \
+  BENCH_SCALE(mat3x3, mat3x3_scale) \
+  BENCH_BIN(mat3x3, mat3x3_mul) \
+  BENCH_ARRAY2(mat3x3, mat3x3_mul_n) \
+  BENCH_MATVEC(mat3x3, vec3, mat3x3_vec3_mul) \
+  BENCH_UN(mat3x3, mat3x3_transpose) \
+  BENCH_RED(mat3x3, mat3x3_det) \
+  BENCH_UN(mat3x3, mat3x3_inverse) \
+  BENCH_UN(mat3x3, mat3x3_inverse_rigid) \
+  BENCH_BINV(mat3x3, mat3x3_addv) \
+  BENCH_BINV(mat3x3, mat3x3_subv) \
+  BENCH_SCALEV(mat3x3, mat3x3_scalev) \
+  BENCH_BINV(mat3x3, mat3x3_mulv) \
+  BENCH_MATVECV(mat3x3, vec3, mat3x3_vec3_mulv) \
+  BENCH_UNV(mat3x3, mat3x3_transposev) \
+  BENCH_REDV(mat3x3, mat3x3_detv) \
+  BENCH_UNV(mat3x3, mat3x3_inversev) \
+  BENCH_UNV(mat3x3, mat3x3_inverse_rigidv) \
+  BENCH_BINTO(mat3x3, mat3x3_add_to) \
+  BENCH_BINTO(mat3x3, mat3x3_sub_to) \
+  BENCH_SCALETO(mat3x3, mat3x3_scale_to) \
+  BENCH_BINTO(mat3x3, mat3x3_mul_to) \
+  BENCH_MATVECTO(mat3x3, vec3, mat3x3_vec3_mul_to) \
+  BENCH_UNTO(mat3x3, mat3x3_transpose_to) \
+  BENCH_UNTO(mat3x3, mat3x3_inverse_to) \
+  BENCH_UNTO(mat3x3, mat3x3_inverse_rigid_to) \
+  /* mat4x4 */ \
+  BENCH_MAKE(mat4x4, mat4x4_make, (a_float[k], a_float[(k + 1) & BENCH_MASK], a_float[(k + 2) & BENCH_MASK], a_float[(k + 3) & BENCH_MASK], a_float[(k + 4) & BENCH_MASK], a_float[(k + 5) & BENCH_MASK], a_float[(k + 6) & BENCH_MASK], a_float[(k + 7) & BENCH_MASK], a_float[(k + 8) & BENCH_MASK], a_float[(k + 9) & BENCH_MASK], a_float[(k + 10) & BENCH_MASK], a_float[(k + 11) & BENCH_MASK], a_float[(k + 12) & BENCH_MASK], a_float[(k + 13) & BENCH_MASK], a_float[(k + 14) & BENCH_MASK], a_float[(k + 15) & BENCH_MASK])) \
+  BENCH_MAKE(mat4x4, mat4x4_makeid, ()) \
+  BENCH_RED2(mat4x4, mat4x4_equal) \
+  BENCH_RED(mat4x4, mat4x4_equalid) \
+  BENCH_GET(mat4x4, mat4x4_get) \
+  BENCH_BIN(mat4x4, mat4x4_add) \
+  BENCH_BIN(mat4x4, mat4x4_sub) \
+  BENCH_SCALE(mat4x4, mat4x4_scale) \
+  BENCH_BIN(mat4x4, mat4x4_mul) \
+  BENCH_MATVEC(mat4x4, vec4, mat4x4_vec4_mul) \
+  BENCH_TRANSFORM(mat4x4, vec4, mat4x4_transform_vec4_array) \
+  BENCH_UN(mat4x4, mat4x4_transpose) \
+  BENCH_RED(mat4x4, mat4x4_det) \
+  BENCH_UN(mat4x4, mat4x4_inverse) \
+  BENCH_UN(mat4x4, mat4x4_inverse_rigid) \
+  BENCH_BINV(mat4x4, mat4x4_addv) \
+  BENCH_BINV(mat4x4, mat4x4_subv) \
+  BENCH_SCALEV(mat4x4, mat4x4_scalev) \
+  BENCH_BINV(mat4x4, mat4x4_mulv) \
+  BENCH_MATVECV(mat4x4, vec4, mat4x4_vec4_mulv) \
+  BENCH_UNV(mat4x4, mat4x4_transposev) \
+  BENCH_REDV(mat4x4, mat4x4_detv) \
+  BENCH_UNV(mat4x4, mat4x4_inversev) \
+  BENCH_UNV(mat4x4, mat4x4_inverse_rigidv) \
+  BENCH_BINTO(mat4x4, mat4x4_add_to) \
+  BENCH_BINTO(mat4x4, mat4x4_sub_to) \
+  BENCH_SCALETO(mat4x4, mat4x4_scale_to) \
+  BENCH_BINTO(mat4x4, mat4x4_mul_to) \
+  BENCH_MATVECTO(mat4x4, vec4, mat4x4_vec4_mul_to) \
+  BENCH_UNTO(mat4x4, mat4x4_transpose_to) \
+  BENCH_UNTO(mat4x4, mat4x4_inverse_to) \
+  BENCH_UNTO(mat4x4, mat4x4_inverse_rigid_to)
+
+BENCH_LIST
+
+/* Table of kernels, built by expanding the list again */
+#undef BENCH_MAKE
+#undef BENCH_BIN
+#undef BENCH_BINV
+#undef BENCH_BINTO
+#undef BENCH_UN
+#undef BENCH_UNV
+#undef BENCH_UNTO
+#undef BENCH_SCALE
+#undef BENCH_SCALEV
+#undef BENCH_SCALETO
+#undef BENCH_RED
+#undef BENCH_REDV
+#undef BENCH_RED2
+#undef BENCH_RED2V
+#undef BENCH_SET
+#undef BENCH_GET
+#undef BENCH_MATVEC
+#undef BENCH_MATVECV
+#undef BENCH_MATVECTO
+#undef BENCH_ARRAY
+#undef BENCH_ARRAY2
+#undef BENCH_TRANSFORM
+
+#define BENCH_ENTRY(fn)      { #fn, lat_##fn, thr_##fn },
+#define BENCH_ENTRY_THR(fn)  { #fn, NULL, thr_##fn },
+#define BENCH_MAKE(T, fn, args)    BENCH_ENTRY_THR(fn)
+#define BENCH_BIN(T, fn)           BENCH_ENTRY(fn)
+#define BENCH_BINV(T, fn)          BENCH_ENTRY(fn)
+#define BENCH_BINTO(T, fn)         BENCH_ENTRY(fn)
+#define BENCH_UN(T, fn)            BENCH_ENTRY(fn)
+#define BENCH_UNV(T, fn)           BENCH_ENTRY(fn)
+#define BENCH_UNTO(T, fn)          BENCH_ENTRY(fn)
+#define BENCH_SCALE(T, fn)         BENCH_ENTRY(fn)
+#define BENCH_SCALEV(T, fn)        BENCH_ENTRY(fn)
+#define BENCH_SCALETO(T, fn)       BENCH_ENTRY(fn)
+#define BENCH_RED(T, fn)           BENCH_ENTRY(fn)
+#define BENCH_REDV(T, fn)          BENCH_ENTRY(fn)
+#define BENCH_RED2(T, fn)          BENCH_ENTRY(fn)
+#define BENCH_RED2V(T, fn)         BENCH_ENTRY(fn)
+#define BENCH_SET(T, fn)           BENCH_ENTRY(fn)
+#define BENCH_GET(T, fn)           BENCH_ENTRY(fn)
+#define BENCH_MATVEC(M, V, fn)     BENCH_ENTRY(fn)
+#define BENCH_MATVECV(M, V, fn)    BENCH_ENTRY(fn)
+#define BENCH_MATVECTO(M, V, fn)   BENCH_ENTRY(fn)
+#define BENCH_ARRAY(T, U, fn)      BENCH_ENTRY_THR(fn)
+#define BENCH_ARRAY2(T, fn)        BENCH_ENTRY_THR(fn)
+#define BENCH_TRANSFORM(M, V, fn)  BENCH_ENTRY_THR(fn)
+
+typedef struct {
+  const char* name;
+  void (*latency)(size_t n);
+  void (*throughput)(size_t n);
+} bench_case;
+
+static const bench_case cases[] = {
+  BENCH_LIST
+};
+
+/* Operands away from zero and close to identity, so chains stay finite for long */
+static void fill_operands() {
+  uint32_t seed = 12345u;
+  for (size_t i = 0; i < BENCH_N; ++i) {
+    float f[16];
+    for (int j = 0; j < 16; ++j) { f[j] = bench_randf(&seed, 0.5f, 1.5f); }
+    a_vec2[i] = vec2_make(f[0], f[1]);
+    b_vec2[i] = vec2_make(f[2], f[3]);
+    a_vec3[i] = vec3_make(f[4], f[5], f[6]);
+    b_vec3[i] = vec3_make(f[7], f[8], f[9]);
+    a_vec4[i] = vec4_make(f[10], f[11], f[12], f[13]);
+    b_vec4[i] = vec4_make(f[13], f[12], f[11], f[10]);
+    a_float[i] = bench_randf(&seed, 0.9f, 1.1f);
+    b_float[i] = bench_randf(&seed, 0.9f, 1.1f);
+
+    for (int j = 0; j < 16; ++j) { f[j] = ((j % 5) == 0 ? 1.0f : 0.0f) + bench_randf(&seed, -0.1f, 0.1f); }
+    a_mat4x4[i] = mat4x4_make(f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7],
+                              f[8], f[9], f[10], f[11], f[12], f[13], f[14], f[15]);
+    b_mat4x4[i] = mat4x4_transpose(&a_mat4x4[i]);
+    a_mat3x3[i] = mat3x3_make(f[0], f[1], f[2], f[4], f[5], f[6], f[8], f[9], f[10]);
+    b_mat3x3[i] = mat3x3_make(f[0], f[4], f[8], f[1], f[5], f[9], f[2], f[6], f[10]);
+    a_mat2x2[i] = mat2x2_make(f[0], f[1], f[4], f[5]);
+    b_mat2x2[i] = mat2x2_make(f[0], f[4], f[1], f[5]);
+  }
+}
+
+/* Fastest of several runs of n calls, in nanoseconds and reference cycles per call */
+static void time_kernel(void (*fn)(size_t), double* ns, double* cycles) {
+  fill_operands();
+  fn(BENCH_CALLS);  // Warm up
+  double best_ns = 1e300, best_cycles = 1e300;
+  for (int r = 0; r < BENCH_REPS; ++r) {
+    fill_operands();
+    double t0 = bench_now_ns();
+    uint64_t c0 = bench_cycles();
+    fn(BENCH_CALLS);
+    uint64_t c1 = bench_cycles();
+    double t = bench_now_ns() - t0;
+    if (t < best_ns) { best_ns = t; }
+    if ((double)(c1 - c0) < best_cycles) { best_cycles = (double)(c1 - c0); }
+  }
+  bench_keep_streams();
+  *ns = best_ns / BENCH_CALLS;
+  *cycles = best_cycles / BENCH_CALLS;
+}
+
+/* Reference cycles per nanosecond, from a short busy wait */
+static double tsc_ghz() {
+  double t0 = bench_now_ns();
+  uint64_t c0 = bench_cycles();
+  while (bench_now_ns() - t0 < 2e7) {}
+  return (double)(bench_cycles() - c0) / (bench_now_ns() - t0);
+}
+
+static void print_time(FILE* out, const char* key, double ns, double cycles, bool has_tsc) {
+  fprintf(out, "\"%s_ns\": %.4f, \"%s_cycles\": ", key, ns, key);
+  if (has_tsc) { fprintf(out, "%.3f", cycles); }
+  else { fprintf(out, "null"); }
+}
+
+int main(int argc, char** argv) {
+  const char* path = NULL;
+  const char* filter = NULL;
+  int only_tier = -1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) { path = argv[++i]; }
+    else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) { filter = argv[++i]; }
+    else if (strcmp(argv[i], "--tier") == 0 && i + 1 < argc) {
+      ++i;
+      for (int t = 0; t < CAM_TIER_COUNT; ++t) {
+        if (strcmp(argv[i], cam_tier_name((cam_tier)t)) == 0) { only_tier = t; }
+      }
+      if (only_tier < 0) { fprintf(stderr, "unknown tier %s\n", argv[i]); return 1; }
+    }
+    else {
+      fprintf(stderr, "usage: %s [-o file.json] [--tier scalar|sse41|avx2] [--filter substring]\n", argv[0]);
+      return 1;
+    }
+  }
+  FILE* out = path ? fopen(path, "w") : stdout;
+  if (!out) { fprintf(stderr, "cannot open %s\n", path); return 1; }
+
+#if defined(CAM_SIMD_AVX)
+  // Flush denormals so long chains cannot fall onto the slow path
+  _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
+
+  bool has_tsc = bench_cycles() != 0;
+  cam_tier initial = cam_get_tier();
+  fprintf(out, "{\n  \"cpu_tier\": \"%s\",\n", cam_tier_name(cam_cpu_tier()));
+  fprintf(out, "  \"calls_per_run\": %d,\n  \"runs\": %d,\n", BENCH_CALLS, BENCH_REPS);
+  if (has_tsc) { fprintf(out, "  \"tsc_ghz\": %.4f,\n", tsc_ghz()); }
+  else { fprintf(out, "  \"tsc_ghz\": null,\n"); }
+  fprintf(out, "  \"results\": [");
+
+  // Without runtime dispatch only the compiled tier binds
+  bool first = true;
+  for (int t = 0; t < CAM_TIER_COUNT; ++t) {
+    if (only_tier >= 0 && t != only_tier) { continue; }
+    if (cam_set_tier((cam_tier)t) != (cam_tier)t) { continue; }
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+      if (filter && !strstr(cases[c].name, filter)) { continue; }
+      fprintf(out, "%s\n    { \"tier\": \"%s\", \"function\": \"%s\", ", first ? "" : ",", cam_tier_name((cam_tier)t), cases[c].name);
+      first = false;
+      double ns, cycles;
+      if (cases[c].latency) {
+        time_kernel(cases[c].latency, &ns, &cycles);
+        print_time(out, "latency", ns, cycles, has_tsc);
+      }
+      else {
+        fprintf(out, "\"latency_ns\": null, \"latency_cycles\": null");
+      }
+      fprintf(out, ", ");
+      time_kernel(cases[c].throughput, &ns, &cycles);
+      print_time(out, "throughput", ns, cycles, has_tsc);
+      fprintf(out, " }");
+    }
+  }
+  fprintf(out, "\n  ]\n}\n");
+  cam_set_tier(initial);
+
+  if (path) { fclose(out); }
+  return 0;
+}
@@ -7,6 +7,11 @@
 #define CAM_H
 
 #include "cam/common.h"
+#include "cam/cpu.h"
+#include "cam/thread.h"
 #include "cam/linear/linear.h"
+#include "cam/complex/complex.h"
+#include "cam/fourier/fourier.h"
+#include "cam/integration/integration.h"
 
 #endif
@@ -11,6 +11,8 @@
 #include <stdbool.h>  // Boolean values
 #include <limits.h>   // Numeric limits
 #include <stdint.h>   // Regular sized integers
+#include <stddef.h>   // Size types
+#include <stdlib.h>   // Memory allocation
 
 
 /* Detect compiler */
@@ -53,11 +55,18 @@
 
 
 /* SIMD Definitions */
-#if defined(CAM_ARCH_X86) || defined(CAM_ARCH_X64) && !defined(CAM_LEGACY) && !defined(CAM_CMP_UNKNOWN)
+// CAM_SIMD_AVX selects the SSE register storage layout for x86 targets. Which
+// instructions operate on it is decided per translation unit: CAM_SIMD_AVX2 is
+// added when AVX2 is enabled, and the runtime dispatch build (CAM_DISPATCH)
+// compiles the linear algebra functions once per tier (see cam/cpu.h).
+#if (defined(CAM_ARCH_X86) || defined(CAM_ARCH_X64)) && !defined(CAM_LEGACY) && !defined(CAM_CMP_UNKNOWN)
 # define CAM_SIMD_AVX
 #include <immintrin.h>
+# if defined(__AVX2__)
+#  define CAM_SIMD_AVX2
+# endif
 
-#elif defined(CAM_ARCH_ARM) || defined(CAM_ARCH_ARM64) && !defined(CAM_LEGACY) && !defined(CAM_CMP_UNKNOWN)
+#elif (defined(CAM_ARCH_ARM) || defined(CAM_ARCH_ARM64)) && !defined(CAM_LEGACY) && !defined(CAM_CMP_UNKNOWN)
 # define CAM_SIMD_NEON
 #include <arm_neon.h>
 
@@ -67,6 +76,15 @@
 #endif
 
 
+/* Library version */
+// Stamped into the files the library writes, such as FFT wisdom, so files written by
+// another version are rebuilt rather than misread
+#define CAM_VERSION_MAJOR 0
+#define CAM_VERSION_MINOR 1
+#define CAM_VERSION_PATCH 0
+#define CAM_VERSION ((CAM_VERSION_MAJOR * 10000) + (CAM_VERSION_MINOR * 100) + CAM_VERSION_PATCH)
+
+
 /* Useful definitions */
 #ifndef CAM_EXCLUDE_DEFINES
 // Ensure std math lib doesnt include its definitions as well
@@ -108,4 +126,23 @@
 #endif
 
 
+/* Aligned memory */
+#define CAM_SIMD_ALIGN 32   // Alignment satisfying the widest supported vector register
+
+// Inline in CAM_HEADER_ONLY builds so the linear algebra module needs no library
+#if defined(CAM_HEADER_ONLY)
+#define CAM_COMMON_API static inline
+#else
+#define CAM_COMMON_API CAM_API
+#endif
+
+CAM_COMMON_API void* cam_aligned_alloc(size_t size, size_t alignment);
+
+CAM_COMMON_API void cam_aligned_free(void* ptr);
+
+#if defined(CAM_HEADER_ONLY)
+#include "cam/common.inl"
+#endif
+
+
 #endif
@@ -0,0 +1,31 @@
+/*
+ * common.inl
+ * Definitions for functionality shared across the project.
+ * Compiled by src/common.c, or included by common.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMMON_INL
+#define CAM_COMMON_INL
+
+#include "cam/common.h"
+
+void* cam_aligned_alloc(size_t size, size_t alignment) {
+  if (size == 0) { return NULL; }
+#if defined(CAM_CMP_MSVC)
+  return _aligned_malloc(size, alignment);
+#else
+  // aligned_alloc requires the size to be a multiple of the alignment
+  size = (size + alignment - 1) & ~(alignment - 1);
+  return aligned_alloc(alignment, size);
+#endif
+}
+
+void cam_aligned_free(void* ptr) {
+#if defined(CAM_CMP_MSVC)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+#endif
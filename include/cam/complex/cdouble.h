@@ -0,0 +1,69 @@
+/*
+ * cdouble.h
+ * Declaration for complex numbers of doubles and interleaved arrays of them.
+ */
+
+#ifndef CAM_COMPLEX_CDOUBLE_H
+#define CAM_COMPLEX_CDOUBLE_H
+
+#include "cam/complex/complex_common.h"
+
+/* Define cdouble struct */
+// Same layout as double[2] and C99 double _Complex, so existing interleaved
+// (re, im, re, im, ...) buffers can be passed to the *_n functions by casting.
+typedef struct {
+  double re;
+  double im;
+} cdouble;
+
+
+/* cdouble functions */
+CAM_COMPLEX_API cdouble cdouble_make(double re, double im);
+
+CAM_COMPLEX_API bool cdouble_equal(cdouble* a, cdouble* b);
+
+CAM_COMPLEX_API cdouble cdouble_add(cdouble* a, cdouble* b);
+
+CAM_COMPLEX_API cdouble cdouble_sub(cdouble* a, cdouble* b);
+
+CAM_COMPLEX_API cdouble cdouble_mul(cdouble* a, cdouble* b);
+
+CAM_COMPLEX_API cdouble cdouble_conj(cdouble* a);
+
+// a * conj(b), as in correlations and cross spectra
+CAM_COMPLEX_API cdouble cdouble_conjmul(cdouble* a, cdouble* b);
+
+CAM_COMPLEX_API cdouble cdouble_scale(cdouble* a, double s);
+
+// sqrt(re^2 + im^2), without the overflow guard of hypot
+CAM_COMPLEX_API double cdouble_mag(cdouble* a);
+
+// atan2(im, re), in [-pi, pi]
+CAM_COMPLEX_API double cdouble_phase(cdouble* a);
+
+// e^a = e^re (cos(im) + i sin(im))
+CAM_COMPLEX_API cdouble cdouble_exp(cdouble* a);
+
+
+/* cdouble array functions */
+// Element-wise over count values; dst may alias an operand. Only mul, conjmul,
+// scale and mag are vectorized, phase and exp call libm for each value.
+CAM_COMPLEX_API void cdouble_mul_n(cdouble* dst, cdouble* a, cdouble* b, size_t count);
+
+CAM_COMPLEX_API void cdouble_conjmul_n(cdouble* dst, cdouble* a, cdouble* b, size_t count);
+
+CAM_COMPLEX_API void cdouble_scale_n(cdouble* dst, cdouble* a, double s, size_t count);
+
+CAM_COMPLEX_API void cdouble_mag_n(double* dst, cdouble* a, size_t count);
+
+CAM_COMPLEX_API void cdouble_phase_n(double* dst, cdouble* a, size_t count);
+
+CAM_COMPLEX_API void cdouble_exp_n(cdouble* dst, cdouble* a, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/cdouble.inl"
+#endif
+
+#endif
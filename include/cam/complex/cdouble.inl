@@ -0,0 +1,148 @@
+/*
+ * cdouble.inl
+ * Definitions for complex numbers of doubles and interleaved arrays of them.
+ * Compiled by src/complex/cdouble.c, or included by cdouble.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_CDOUBLE_INL
+#define CAM_COMPLEX_CDOUBLE_INL
+
+#include "cam/complex/cdouble.h"
+#include <math.h>
+
+/* cdouble functions */
+cdouble cdouble_make(double re, double im) {
+  cdouble c = { re, im };
+  return c;
+}
+
+bool cdouble_equal(cdouble* a, cdouble* b) {
+  return (a->re == b->re) && (a->im == b->im);
+}
+
+cdouble cdouble_add(cdouble* a, cdouble* b) {
+  return cdouble_make(a->re + b->re, a->im + b->im);
+}
+
+cdouble cdouble_sub(cdouble* a, cdouble* b) {
+  return cdouble_make(a->re - b->re, a->im - b->im);
+}
+
+cdouble cdouble_mul(cdouble* a, cdouble* b) {
+  return cdouble_make((a->re * b->re) - (a->im * b->im), (a->re * b->im) + (a->im * b->re));
+}
+
+cdouble cdouble_conj(cdouble* a) {
+  return cdouble_make(a->re, -a->im);
+}
+
+cdouble cdouble_conjmul(cdouble* a, cdouble* b) {
+  return cdouble_make((a->re * b->re) + (a->im * b->im), (a->im * b->re) - (a->re * b->im));
+}
+
+cdouble cdouble_scale(cdouble* a, double s) {
+  return cdouble_make(a->re * s, a->im * s);
+}
+
+double cdouble_mag(cdouble* a) {
+  return sqrt((a->re * a->re) + (a->im * a->im));
+}
+
+double cdouble_phase(cdouble* a) {
+  return atan2(a->im, a->re);
+}
+
+cdouble cdouble_exp(cdouble* a) {
+  double e = exp(a->re);
+  return cdouble_make(e * cos(a->im), e * sin(a->im));
+}
+
+
+/* cdouble array functions */
+void cdouble_mul_n(cdouble* dst, cdouble* a, cdouble* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Element-wise on the interleaved doubles, __SOAD_WIDTH / 2 values per register
+  size_t n = count * 2;
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_vec va = __soad_load((double*)a + i, k, tail);
+    __soad_vec vb = __soad_load((double*)b + i, k, tail);
+    __soad_store((double*)dst + i, __complexd_mul(va, vb), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_mul(&a[i], &b[i]);
+  }
+#endif
+}
+
+void cdouble_conjmul_n(cdouble* dst, cdouble* a, cdouble* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  size_t n = count * 2;
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_vec va = __soad_load((double*)a + i, k, tail);
+    __soad_vec vb = __soad_load((double*)b + i, k, tail);
+    __soad_store((double*)dst + i, __complexd_mul(va, __complexd_conj(vb)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_conjmul(&a[i], &b[i]);
+  }
+#endif
+}
+
+void cdouble_scale_n(cdouble* dst, cdouble* a, double s, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  size_t n = count * 2;
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  __soad_vec vs = __soad_set1(s);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_store((double*)dst + i, __soad_mul(__soad_load((double*)a + i, k, tail), vs), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_scale(&a[i], s);
+  }
+#endif
+}
+
+void cdouble_mag_n(double* dst, cdouble* a, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(count % __SOAD_WIDTH);
+  for (size_t i = 0; i < count; i += __SOAD_WIDTH) {
+    __soad_vec re, im;
+    __complexd_load((double*)(a + i), count - i, &re, &im);
+    __soad_store(dst + i, __soad_sqrt(__soad_fmadd(re, re, __soad_mul(im, im))), count - i, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_mag(&a[i]);
+  }
+#endif
+}
+
+void cdouble_phase_n(double* dst, cdouble* a, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_phase(&a[i]);
+  }
+}
+
+void cdouble_exp_n(cdouble* dst, cdouble* a, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cdouble_exp(&a[i]);
+  }
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * cdouble_soa.h
+ * Declaration for arrays of double complex numbers in split (re[] / im[]) order.
+ */
+
+#ifndef CAM_COMPLEX_CDOUBLE_SOA_H
+#define CAM_COMPLEX_CDOUBLE_SOA_H
+
+#include "cam/complex/complex_common.h"
+#include "cam/complex/cdouble.h"
+
+/* Define cdouble_soa struct */
+typedef struct {
+  double* re;      // Component arrays, aligned to CAM_SIMD_ALIGN bytes when made by cdouble_soa_make
+  double* im;
+  size_t count;   // Number of values in the array
+} cdouble_soa;
+
+
+/* cdouble_soa functions */
+// Batch operations process a->count elements. Every other operand (including the
+// destination) must hold at least that many. Destinations may alias sources.
+CAM_COMPLEX_API cdouble_soa cdouble_soa_make(size_t count);
+
+CAM_COMPLEX_API void cdouble_soa_free(cdouble_soa* s);
+
+// Wraps existing component arrays without copying. The view does not own them,
+// so it is never passed to cdouble_soa_free, and needs no particular alignment.
+CAM_COMPLEX_API cdouble_soa cdouble_soa_view(double* re, double* im, size_t count);
+
+CAM_COMPLEX_API cdouble cdouble_soa_get(cdouble_soa* s, size_t i);
+
+CAM_COMPLEX_API void cdouble_soa_set(cdouble_soa* s, size_t i, cdouble* c);
+
+// Splits dst->count interleaved values from src
+CAM_COMPLEX_API void cdouble_soa_from_interleaved(cdouble_soa* dst, cdouble* src);
+
+// Interleaves src->count values into dst
+CAM_COMPLEX_API void cdouble_soa_to_interleaved(cdouble* dst, cdouble_soa* src);
+
+// Same as cdouble_mul for every pair
+CAM_COMPLEX_API void cdouble_soa_mul(cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b);
+
+CAM_COMPLEX_API void cdouble_soa_conjmul(cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b);
+
+CAM_COMPLEX_API void cdouble_soa_scale(cdouble_soa* dst, cdouble_soa* a, double s);
+
+CAM_COMPLEX_API void cdouble_soa_mag(double* dst, cdouble_soa* a);
+
+// Computed with libm for each value, as cdouble_phase_n
+CAM_COMPLEX_API void cdouble_soa_phase(double* dst, cdouble_soa* a);
+
+// Computed with libm for each value, as cdouble_exp_n
+CAM_COMPLEX_API void cdouble_soa_exp(cdouble_soa* dst, cdouble_soa* a);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/cdouble_soa.inl"
+#endif
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * cdouble_soa.inl
+ * Definitions for arrays of double complex numbers in split (re[] / im[]) order.
+ * Compiled by src/complex/cdouble_soa.c, or included by cdouble_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_CDOUBLE_SOA_INL
+#define CAM_COMPLEX_CDOUBLE_SOA_INL
+
+#include "cam/complex/cdouble_soa.h"
+#include <string.h>
+
+cdouble_soa cdouble_soa_make(size_t count) {
+  cdouble_soa s = { NULL, NULL, 0 };
+  if (count == 0) { return s; }
+
+  // Round each array up to a whole register so the padding is always readable
+  size_t bytes = ((count + 3) & ~(size_t)3) * sizeof(double);
+  s.re = (double*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.im = (double*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  if (!s.re || !s.im) {
+    cdouble_soa_free(&s);
+    return s;
+  }
+  memset(s.re, 0, bytes);
+  memset(s.im, 0, bytes);
+  s.count = count;
+  return s;
+}
+
+void cdouble_soa_free(cdouble_soa* s) {
+  cam_aligned_free(s->re);
+  cam_aligned_free(s->im);
+  s->re = NULL;
+  s->im = NULL;
+  s->count = 0;
+}
+
+cdouble_soa cdouble_soa_view(double* re, double* im, size_t count) {
+  cdouble_soa s = { re, im, count };
+  return s;
+}
+
+cdouble cdouble_soa_get(cdouble_soa* s, size_t i) {
+  return cdouble_make(s->re[i], s->im[i]);
+}
+
+void cdouble_soa_set(cdouble_soa* s, size_t i, cdouble* c) {
+  s->re[i] = c->re;
+  s->im[i] = c->im;
+}
+
+void cdouble_soa_from_interleaved(cdouble_soa* dst, cdouble* src) {
+  size_t n = dst->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    __soad_vec re, im;
+    __complexd_load((double*)(src + i), n - i, &re, &im);
+    __soad_store(dst->re + i, re, n - i, tail);
+    __soad_store(dst->im + i, im, n - i, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cdouble_soa_set(dst, i, &src[i]);
+  }
+#endif
+}
+
+void cdouble_soa_to_interleaved(cdouble* dst, cdouble_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    __soad_vec re = __soad_load(src->re + i, n - i, tail);
+    __soad_vec im = __soad_load(src->im + i, n - i, tail);
+    __complexd_store((double*)(dst + i), n - i, re, im);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = cdouble_soa_get(src, i);
+  }
+#endif
+}
+
+void cdouble_soa_mul(cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_vec ar = __soad_load(a->re + i, k, tail);
+    __soad_vec ai = __soad_load(a->im + i, k, tail);
+    __soad_vec br = __soad_load(b->re + i, k, tail);
+    __soad_vec bi = __soad_load(b->im + i, k, tail);
+    __soad_store(dst->re + i, __soad_fmadd(ar, br, __soad_xor(__soad_mul(ai, bi), __soad_set1(-0.0))), k, tail);
+    __soad_store(dst->im + i, __soad_fmadd(ar, bi, __soad_mul(ai, br)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cdouble ca = cdouble_soa_get(a, i);
+    cdouble cb = cdouble_soa_get(b, i);
+    cdouble r = cdouble_mul(&ca, &cb);
+    cdouble_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void cdouble_soa_conjmul(cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_vec ar = __soad_load(a->re + i, k, tail);
+    __soad_vec ai = __soad_load(a->im + i, k, tail);
+    __soad_vec br = __soad_load(b->re + i, k, tail);
+    __soad_vec bi = __soad_load(b->im + i, k, tail);
+    __soad_store(dst->re + i, __soad_fmadd(ar, br, __soad_mul(ai, bi)), k, tail);
+    __soad_store(dst->im + i, __soad_fmadd(ai, br, __soad_xor(__soad_mul(ar, bi), __soad_set1(-0.0))), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cdouble ca = cdouble_soa_get(a, i);
+    cdouble cb = cdouble_soa_get(b, i);
+    cdouble r = cdouble_conjmul(&ca, &cb);
+    cdouble_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void cdouble_soa_scale(cdouble_soa* dst, cdouble_soa* a, double s) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  __soad_vec vs = __soad_set1(s);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_store(dst->re + i, __soad_mul(__soad_load(a->re + i, k, tail), vs), k, tail);
+    __soad_store(dst->im + i, __soad_mul(__soad_load(a->im + i, k, tail), vs), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->re[i] = a->re[i] * s;
+    dst->im[i] = a->im[i] * s;
+  }
+#endif
+}
+
+void cdouble_soa_mag(double* dst, cdouble_soa* a) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soad_mask tail = __soad_tail_mask(n % __SOAD_WIDTH);
+  for (size_t i = 0; i < n; i += __SOAD_WIDTH) {
+    size_t k = n - i;
+    __soad_vec re = __soad_load(a->re + i, k, tail);
+    __soad_vec im = __soad_load(a->im + i, k, tail);
+    __soad_store(dst + i, __soad_sqrt(__soad_fmadd(re, re, __soad_mul(im, im))), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cdouble c = cdouble_soa_get(a, i);
+    dst[i] = cdouble_mag(&c);
+  }
+#endif
+}
+
+void cdouble_soa_phase(double* dst, cdouble_soa* a) {
+  for (size_t i = 0; i < a->count; ++i) {
+    cdouble c = cdouble_soa_get(a, i);
+    dst[i] = cdouble_phase(&c);
+  }
+}
+
+void cdouble_soa_exp(cdouble_soa* dst, cdouble_soa* a) {
+  for (size_t i = 0; i < a->count; ++i) {
+    cdouble c = cdouble_soa_get(a, i);
+    cdouble r = cdouble_exp(&c);
+    cdouble_soa_set(dst, i, &r);
+  }
+}
+
+#endif
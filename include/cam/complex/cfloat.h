@@ -0,0 +1,70 @@
+/*
+ * cfloat.h
+ * Declaration for complex numbers of floats and interleaved arrays of them.
+ */
+
+#ifndef CAM_COMPLEX_CFLOAT_H
+#define CAM_COMPLEX_CFLOAT_H
+
+#include "cam/complex/complex_common.h"
+
+/* Define cfloat struct */
+// Same layout as float[2] and C99 float _Complex, so existing interleaved
+// (re, im, re, im, ...) buffers can be passed to the *_n functions by casting.
+typedef struct {
+  float re;
+  float im;
+} cfloat;
+
+
+/* cfloat functions */
+CAM_COMPLEX_API cfloat cfloat_make(float re, float im);
+
+CAM_COMPLEX_API bool cfloat_equal(cfloat* a, cfloat* b);
+
+CAM_COMPLEX_API cfloat cfloat_add(cfloat* a, cfloat* b);
+
+CAM_COMPLEX_API cfloat cfloat_sub(cfloat* a, cfloat* b);
+
+CAM_COMPLEX_API cfloat cfloat_mul(cfloat* a, cfloat* b);
+
+CAM_COMPLEX_API cfloat cfloat_conj(cfloat* a);
+
+// a * conj(b), as in correlations and cross spectra
+CAM_COMPLEX_API cfloat cfloat_conjmul(cfloat* a, cfloat* b);
+
+CAM_COMPLEX_API cfloat cfloat_scale(cfloat* a, float s);
+
+// sqrt(re^2 + im^2), without the overflow guard of hypot
+CAM_COMPLEX_API float cfloat_mag(cfloat* a);
+
+// atan2(im, re), in [-pi, pi]
+CAM_COMPLEX_API float cfloat_phase(cfloat* a);
+
+// e^a = e^re (cos(im) + i sin(im))
+CAM_COMPLEX_API cfloat cfloat_exp(cfloat* a);
+
+
+/* cfloat array functions */
+// Element-wise over count values; dst may alias an operand. The SIMD versions of
+// phase and exp use polynomial approximations within a few ulps of libm (see
+// complex_common.h), and exp is accurate for |im| up to about 8192.
+CAM_COMPLEX_API void cfloat_mul_n(cfloat* dst, cfloat* a, cfloat* b, size_t count);
+
+CAM_COMPLEX_API void cfloat_conjmul_n(cfloat* dst, cfloat* a, cfloat* b, size_t count);
+
+CAM_COMPLEX_API void cfloat_scale_n(cfloat* dst, cfloat* a, float s, size_t count);
+
+CAM_COMPLEX_API void cfloat_mag_n(float* dst, cfloat* a, size_t count);
+
+CAM_COMPLEX_API void cfloat_phase_n(float* dst, cfloat* a, size_t count);
+
+CAM_COMPLEX_API void cfloat_exp_n(cfloat* dst, cfloat* a, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/cfloat.inl"
+#endif
+
+#endif
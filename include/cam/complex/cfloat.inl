@@ -0,0 +1,171 @@
+/*
+ * cfloat.inl
+ * Definitions for complex numbers of floats and interleaved arrays of them.
+ * Compiled by src/complex/cfloat.c, or included by cfloat.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_CFLOAT_INL
+#define CAM_COMPLEX_CFLOAT_INL
+
+#include "cam/complex/cfloat.h"
+#include <math.h>
+
+/* cfloat functions */
+cfloat cfloat_make(float re, float im) {
+  cfloat c = { re, im };
+  return c;
+}
+
+bool cfloat_equal(cfloat* a, cfloat* b) {
+  return (a->re == b->re) && (a->im == b->im);
+}
+
+cfloat cfloat_add(cfloat* a, cfloat* b) {
+  return cfloat_make(a->re + b->re, a->im + b->im);
+}
+
+cfloat cfloat_sub(cfloat* a, cfloat* b) {
+  return cfloat_make(a->re - b->re, a->im - b->im);
+}
+
+cfloat cfloat_mul(cfloat* a, cfloat* b) {
+  return cfloat_make((a->re * b->re) - (a->im * b->im), (a->re * b->im) + (a->im * b->re));
+}
+
+cfloat cfloat_conj(cfloat* a) {
+  return cfloat_make(a->re, -a->im);
+}
+
+cfloat cfloat_conjmul(cfloat* a, cfloat* b) {
+  return cfloat_make((a->re * b->re) + (a->im * b->im), (a->im * b->re) - (a->re * b->im));
+}
+
+cfloat cfloat_scale(cfloat* a, float s) {
+  return cfloat_make(a->re * s, a->im * s);
+}
+
+float cfloat_mag(cfloat* a) {
+  return sqrtf((a->re * a->re) + (a->im * a->im));
+}
+
+float cfloat_phase(cfloat* a) {
+  return atan2f(a->im, a->re);
+}
+
+cfloat cfloat_exp(cfloat* a) {
+  float e = expf(a->re);
+  return cfloat_make(e * cosf(a->im), e * sinf(a->im));
+}
+
+
+/* cfloat array functions */
+void cfloat_mul_n(cfloat* dst, cfloat* a, cfloat* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Element-wise on the interleaved floats, __SOA_WIDTH / 2 values per register
+  size_t n = count * 2;
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec va = __soa_load((float*)a + i, k, tail);
+    __soa_vec vb = __soa_load((float*)b + i, k, tail);
+    __soa_store((float*)dst + i, __complex_mul(va, vb), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_mul(&a[i], &b[i]);
+  }
+#endif
+}
+
+void cfloat_conjmul_n(cfloat* dst, cfloat* a, cfloat* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  size_t n = count * 2;
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec va = __soa_load((float*)a + i, k, tail);
+    __soa_vec vb = __soa_load((float*)b + i, k, tail);
+    __soa_store((float*)dst + i, __complex_mul(va, __complex_conj(vb)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_conjmul(&a[i], &b[i]);
+  }
+#endif
+}
+
+void cfloat_scale_n(cfloat* dst, cfloat* a, float s, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  size_t n = count * 2;
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  __soa_vec vs = __soa_set1(s);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store((float*)dst + i, __soa_mul(__soa_load((float*)a + i, k, tail), vs), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_scale(&a[i], s);
+  }
+#endif
+}
+
+void cfloat_mag_n(float* dst, cfloat* a, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(count % __SOA_WIDTH);
+  for (size_t i = 0; i < count; i += __SOA_WIDTH) {
+    __soa_vec re, im;
+    __complex_load((float*)(a + i), count - i, &re, &im);
+    __soa_store(dst + i, __soa_sqrt(__soa_fmadd(re, re, __soa_mul(im, im))), count - i, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_mag(&a[i]);
+  }
+#endif
+}
+
+void cfloat_phase_n(float* dst, cfloat* a, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(count % __SOA_WIDTH);
+  for (size_t i = 0; i < count; i += __SOA_WIDTH) {
+    __soa_vec re, im;
+    __complex_load((float*)(a + i), count - i, &re, &im);
+    __soa_store(dst + i, __complex_atan2(im, re), count - i, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_phase(&a[i]);
+  }
+#endif
+}
+
+void cfloat_exp_n(cfloat* dst, cfloat* a, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (size_t i = 0; i < count; i += __SOA_WIDTH) {
+    __soa_vec re, im, s, c;
+    __complex_load((float*)(a + i), count - i, &re, &im);
+    __soa_vec e = __complex_exp(re);
+    __complex_sincos(im, &s, &c);
+    __complex_store((float*)(dst + i), count - i, __soa_mul(e, c), __soa_mul(e, s));
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cfloat_exp(&a[i]);
+  }
+#endif
+}
+
+#endif
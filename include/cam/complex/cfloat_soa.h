@@ -0,0 +1,61 @@
+/*
+ * cfloat_soa.h
+ * Declaration for arrays of float complex numbers in split (re[] / im[]) order.
+ */
+
+#ifndef CAM_COMPLEX_CFLOAT_SOA_H
+#define CAM_COMPLEX_CFLOAT_SOA_H
+
+#include "cam/complex/complex_common.h"
+#include "cam/complex/cfloat.h"
+
+/* Define cfloat_soa struct */
+typedef struct {
+  float* re;      // Component arrays, aligned to CAM_SIMD_ALIGN bytes when made by cfloat_soa_make
+  float* im;
+  size_t count;   // Number of values in the array
+} cfloat_soa;
+
+
+/* cfloat_soa functions */
+// Batch operations process a->count elements. Every other operand (including the
+// destination) must hold at least that many. Destinations may alias sources.
+CAM_COMPLEX_API cfloat_soa cfloat_soa_make(size_t count);
+
+CAM_COMPLEX_API void cfloat_soa_free(cfloat_soa* s);
+
+// Wraps existing component arrays without copying. The view does not own them,
+// so it is never passed to cfloat_soa_free, and needs no particular alignment.
+CAM_COMPLEX_API cfloat_soa cfloat_soa_view(float* re, float* im, size_t count);
+
+CAM_COMPLEX_API cfloat cfloat_soa_get(cfloat_soa* s, size_t i);
+
+CAM_COMPLEX_API void cfloat_soa_set(cfloat_soa* s, size_t i, cfloat* c);
+
+// Splits dst->count interleaved values from src
+CAM_COMPLEX_API void cfloat_soa_from_interleaved(cfloat_soa* dst, cfloat* src);
+
+// Interleaves src->count values into dst
+CAM_COMPLEX_API void cfloat_soa_to_interleaved(cfloat* dst, cfloat_soa* src);
+
+// Same as cfloat_mul for every pair
+CAM_COMPLEX_API void cfloat_soa_mul(cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b);
+
+CAM_COMPLEX_API void cfloat_soa_conjmul(cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b);
+
+CAM_COMPLEX_API void cfloat_soa_scale(cfloat_soa* dst, cfloat_soa* a, float s);
+
+CAM_COMPLEX_API void cfloat_soa_mag(float* dst, cfloat_soa* a);
+
+// Same approximation as cfloat_phase_n
+CAM_COMPLEX_API void cfloat_soa_phase(float* dst, cfloat_soa* a);
+
+// Same approximation as cfloat_exp_n
+CAM_COMPLEX_API void cfloat_soa_exp(cfloat_soa* dst, cfloat_soa* a);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/cfloat_soa.inl"
+#endif
+
+#endif
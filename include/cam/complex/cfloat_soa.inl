@@ -0,0 +1,223 @@
+/*
+ * cfloat_soa.inl
+ * Definitions for arrays of float complex numbers in split (re[] / im[]) order.
+ * Compiled by src/complex/cfloat_soa.c, or included by cfloat_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_CFLOAT_SOA_INL
+#define CAM_COMPLEX_CFLOAT_SOA_INL
+
+#include "cam/complex/cfloat_soa.h"
+#include <string.h>
+
+cfloat_soa cfloat_soa_make(size_t count) {
+  cfloat_soa s = { NULL, NULL, 0 };
+  if (count == 0) { return s; }
+
+  // Round each array up to a whole register so the padding is always readable
+  size_t bytes = ((count + 7) & ~(size_t)7) * sizeof(float);
+  s.re = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.im = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  if (!s.re || !s.im) {
+    cfloat_soa_free(&s);
+    return s;
+  }
+  memset(s.re, 0, bytes);
+  memset(s.im, 0, bytes);
+  s.count = count;
+  return s;
+}
+
+void cfloat_soa_free(cfloat_soa* s) {
+  cam_aligned_free(s->re);
+  cam_aligned_free(s->im);
+  s->re = NULL;
+  s->im = NULL;
+  s->count = 0;
+}
+
+cfloat_soa cfloat_soa_view(float* re, float* im, size_t count) {
+  cfloat_soa s = { re, im, count };
+  return s;
+}
+
+cfloat cfloat_soa_get(cfloat_soa* s, size_t i) {
+  return cfloat_make(s->re[i], s->im[i]);
+}
+
+void cfloat_soa_set(cfloat_soa* s, size_t i, cfloat* c) {
+  s->re[i] = c->re;
+  s->im[i] = c->im;
+}
+
+void cfloat_soa_from_interleaved(cfloat_soa* dst, cfloat* src) {
+  size_t n = dst->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    __soa_vec re, im;
+    __complex_load((float*)(src + i), n - i, &re, &im);
+    __soa_store(dst->re + i, re, n - i, tail);
+    __soa_store(dst->im + i, im, n - i, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat_soa_set(dst, i, &src[i]);
+  }
+#endif
+}
+
+void cfloat_soa_to_interleaved(cfloat* dst, cfloat_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    __soa_vec re = __soa_load(src->re + i, n - i, tail);
+    __soa_vec im = __soa_load(src->im + i, n - i, tail);
+    __complex_store((float*)(dst + i), n - i, re, im);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst[i] = cfloat_soa_get(src, i);
+  }
+#endif
+}
+
+void cfloat_soa_mul(cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec ar = __soa_load(a->re + i, k, tail);
+    __soa_vec ai = __soa_load(a->im + i, k, tail);
+    __soa_vec br = __soa_load(b->re + i, k, tail);
+    __soa_vec bi = __soa_load(b->im + i, k, tail);
+    __soa_store(dst->re + i, __soa_fmadd(ar, br, __soa_xor(__soa_mul(ai, bi), __soa_set1(-0.0f))), k, tail);
+    __soa_store(dst->im + i, __soa_fmadd(ar, bi, __soa_mul(ai, br)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat ca = cfloat_soa_get(a, i);
+    cfloat cb = cfloat_soa_get(b, i);
+    cfloat r = cfloat_mul(&ca, &cb);
+    cfloat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void cfloat_soa_conjmul(cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec ar = __soa_load(a->re + i, k, tail);
+    __soa_vec ai = __soa_load(a->im + i, k, tail);
+    __soa_vec br = __soa_load(b->re + i, k, tail);
+    __soa_vec bi = __soa_load(b->im + i, k, tail);
+    __soa_store(dst->re + i, __soa_fmadd(ar, br, __soa_mul(ai, bi)), k, tail);
+    __soa_store(dst->im + i, __soa_fmadd(ai, br, __soa_xor(__soa_mul(ar, bi), __soa_set1(-0.0f))), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat ca = cfloat_soa_get(a, i);
+    cfloat cb = cfloat_soa_get(b, i);
+    cfloat r = cfloat_conjmul(&ca, &cb);
+    cfloat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void cfloat_soa_scale(cfloat_soa* dst, cfloat_soa* a, float s) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  __soa_vec vs = __soa_set1(s);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->re + i, __soa_mul(__soa_load(a->re + i, k, tail), vs), k, tail);
+    __soa_store(dst->im + i, __soa_mul(__soa_load(a->im + i, k, tail), vs), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->re[i] = a->re[i] * s;
+    dst->im[i] = a->im[i] * s;
+  }
+#endif
+}
+
+void cfloat_soa_mag(float* dst, cfloat_soa* a) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec re = __soa_load(a->re + i, k, tail);
+    __soa_vec im = __soa_load(a->im + i, k, tail);
+    __soa_store(dst + i, __soa_sqrt(__soa_fmadd(re, re, __soa_mul(im, im))), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat c = cfloat_soa_get(a, i);
+    dst[i] = cfloat_mag(&c);
+  }
+#endif
+}
+
+void cfloat_soa_phase(float* dst, cfloat_soa* a) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec re = __soa_load(a->re + i, k, tail);
+    __soa_vec im = __soa_load(a->im + i, k, tail);
+    __soa_store(dst + i, __complex_atan2(im, re), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat c = cfloat_soa_get(a, i);
+    dst[i] = cfloat_phase(&c);
+  }
+#endif
+}
+
+void cfloat_soa_exp(cfloat_soa* dst, cfloat_soa* a) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec s, c;
+    __soa_vec e = __complex_exp(__soa_load(a->re + i, k, tail));
+    __complex_sincos(__soa_load(a->im + i, k, tail), &s, &c);
+    __soa_store(dst->re + i, __soa_mul(e, c), k, tail);
+    __soa_store(dst->im + i, __soa_mul(e, s), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    cfloat c = cfloat_soa_get(a, i);
+    cfloat r = cfloat_exp(&c);
+    cfloat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+#endif
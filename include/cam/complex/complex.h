@@ -6,4 +6,12 @@
 #ifndef CAM_COMPLEX_H
 #define CAM_COMPLEX_H
 
+#include "cam/complex/complex_common.h"
+#include "cam/complex/quat.h"
+#include "cam/complex/quat_soa.h"
+#include "cam/complex/cfloat.h"
+#include "cam/complex/cfloat_soa.h"
+#include "cam/complex/cdouble.h"
+#include "cam/complex/cdouble_soa.h"
+
 #endif
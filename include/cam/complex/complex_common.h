@@ -0,0 +1,419 @@
+/*
+ * complex_common.h
+ * Declarations common to all objects in the complex & quaternion algebra module.
+ */
+
+#ifndef CAM_COMPLEX_COMMON_H
+#define CAM_COMPLEX_COMMON_H
+
+#include "cam/common.h"
+#include "cam/linear/linear_common.h"
+#include <string.h>
+
+/* Linkage of the complex & quaternion functions */
+// Follows CAM_LINEAR_API: inline in CAM_HEADER_ONLY builds, and compiled once per
+// SIMD tier with internal linkage by the runtime dispatch build (see
+// src/complex/complex_tier.h), which overrides this.
+#ifndef CAM_COMPLEX_API
+#if defined(CAM_HEADER_ONLY)
+#define CAM_COMPLEX_API static inline
+#else
+#define CAM_COMPLEX_API CAM_API
+#endif
+#endif
+
+/* Slerp weights */
+// Eberly, "A Fast and Accurate Algorithm for Computing SLERP": the weights
+// sin((1 - t)A) / sin(A) and sin(tA) / sin(A), with cos(A) = d, are evaluated as
+// polynomials in (d - 1) with no division or trigonometry, so the quaternion and
+// batch versions share one branch-free formula. Twelve terms, with the last pair
+// scaled by mu to balance the truncation error, keep the weights within 1e-6 of
+// the exact ones in float arithmetic for t in [0, 1] and angles up to 90 degrees
+// (d >= 0, which slerp guarantees by flipping the sign of one input).
+#define __COMPLEX_SLERP_TERMS 12
+
+// u[i] = 1 / (n(2n + 1)) and v[i] = n / (2n + 1) for n = i + 1, the last pair times mu = 1.89372
+static const float __complex_slerp_u[__COMPLEX_SLERP_TERMS] = {
+  0.333333333f, 0.1f, 0.0476190476f, 0.0277777778f, 0.0181818182f, 0.0128205128f,
+  0.00952380952f, 0.00735294118f, 0.00584795322f, 0.00476190476f, 0.00395256917f, 0.0063124f
+};
+static const float __complex_slerp_v[__COMPLEX_SLERP_TERMS] = {
+  0.333333333f, 0.4f, 0.428571429f, 0.444444444f, 0.454545455f, 0.461538462f,
+  0.466666667f, 0.470588235f, 0.473684211f, 0.476190476f, 0.47826087f, 0.9089856f
+};
+
+// Coefficients of the weight for interpolation parameter s (t for b, 1 - t for a)
+static inline void __complex_slerp_coeffs(float s, float k[__COMPLEX_SLERP_TERMS]) {
+  float ss = s * s;
+  for (int i = 0; i < __COMPLEX_SLERP_TERMS; ++i) {
+    k[i] = (__complex_slerp_u[i] * ss) - __complex_slerp_v[i];
+  }
+}
+
+// Weight from the coefficients for s and dm1 = d - 1
+static inline float __complex_slerp_weight(float s, const float k[__COMPLEX_SLERP_TERMS], float dm1) {
+  float w = 1.0f;
+  for (int i = __COMPLEX_SLERP_TERMS - 1; i >= 0; --i) {
+    w = 1.0f + (k[i] * dm1 * w);
+  }
+  return s * w;
+}
+
+/* Double precision batch kernel helpers */
+// The __soa_* wrappers of linear_common.h for double lanes: 4-wide AVX2 or 2-wide SSE.
+#if defined(CAM_SIMD_AVX2)
+typedef __m256d __soad_vec;
+typedef __m256i __soad_mask;
+#define __SOAD_WIDTH 4
+#define __soad_set1 _mm256_set1_pd
+#define __soad_loadu _mm256_loadu_pd
+#define __soad_storeu _mm256_storeu_pd
+#define __soad_add _mm256_add_pd
+#define __soad_sub _mm256_sub_pd
+#define __soad_mul _mm256_mul_pd
+#define __soad_div _mm256_div_pd
+#define __soad_sqrt _mm256_sqrt_pd
+#define __soad_xor _mm256_xor_pd
+
+static inline __m256d __soad_fmadd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__) || defined(CAM_CMP_MSVC)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+// Mask enabling the first n (< 4) lanes, used for tail elements
+static inline __soad_mask __soad_tail_mask(size_t n) {
+  return _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)n), _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+static inline __soad_vec __soad_load(const double* p, size_t remain, __soad_mask mask) {
+  return (remain >= 4) ? _mm256_loadu_pd(p) : _mm256_maskload_pd(p, mask);
+}
+
+static inline void __soad_store(double* p, __soad_vec v, size_t remain, __soad_mask mask) {
+  if (remain >= 4) { _mm256_storeu_pd(p, v); }
+  else { _mm256_maskstore_pd(p, mask, v); }
+}
+
+#elif defined(CAM_SIMD_AVX)
+typedef __m128d __soad_vec;
+typedef size_t __soad_mask;
+#define __SOAD_WIDTH 2
+#define __soad_set1 _mm_set1_pd
+#define __soad_loadu _mm_loadu_pd
+#define __soad_storeu _mm_storeu_pd
+#define __soad_add _mm_add_pd
+#define __soad_sub _mm_sub_pd
+#define __soad_mul _mm_mul_pd
+#define __soad_div _mm_div_pd
+#define __soad_sqrt _mm_sqrt_pd
+#define __soad_xor _mm_xor_pd
+
+static inline __m128d __soad_fmadd(__m128d a, __m128d b, __m128d c) {
+#if defined(__FMA__) || (defined(CAM_CMP_MSVC) && defined(__AVX2__))
+  return _mm_fmadd_pd(a, b, c);
+#else
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+}
+
+static inline __soad_mask __soad_tail_mask(size_t n) {
+  return n;
+}
+
+// A tail is a single lane, loaded with the upper lane zeroed
+static inline __soad_vec __soad_load(const double* p, size_t remain, __soad_mask mask) {
+  (void)mask;
+  return (remain >= 2) ? _mm_loadu_pd(p) : _mm_load_sd(p);
+}
+
+static inline void __soad_store(double* p, __soad_vec v, size_t remain, __soad_mask mask) {
+  (void)mask;
+  if (remain >= 2) { _mm_storeu_pd(p, v); }
+  else { _mm_store_sd(p, v); }
+}
+#endif
+
+/* Interleaved complex helpers */
+// An interleaved register holds (re, im) pairs, so __SOA_WIDTH / 2 values. The load
+// and store helpers move __SOA_WIDTH values between interleaved memory and one
+// register of real parts plus one of imaginary parts, in order; remain is the number
+// of values left in the array, and lanes past it read as zero and are not written.
+#if defined(CAM_SIMD_AVX2)
+#define __complex_dupre _mm256_moveldup_ps
+#define __complex_dupim _mm256_movehdup_ps
+#define __complex_swap(v) _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1))
+#define __complexd_dupre _mm256_movedup_pd
+#define __complexd_dupim(v) _mm256_permute_pd(v, 0xF)
+#define __complexd_swap(v) _mm256_permute_pd(v, 0x5)
+
+// a * b - c in the even (real) lanes and a * b + c in the odd (imaginary) lanes
+static inline __m256 __complex_fmaddsub(__m256 a, __m256 b, __m256 c) {
+#if defined(__FMA__) || defined(CAM_CMP_MSVC)
+  return _mm256_fmaddsub_ps(a, b, c);
+#else
+  return _mm256_addsub_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+static inline __m256d __complexd_fmaddsub(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__) || defined(CAM_CMP_MSVC)
+  return _mm256_fmaddsub_pd(a, b, c);
+#else
+  return _mm256_addsub_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+// Negates the imaginary lanes
+static inline __m256 __complex_conj(__m256 v) {
+  return _mm256_xor_ps(v, _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f));
+}
+
+static inline __m256d __complexd_conj(__m256d v) {
+  return _mm256_xor_pd(v, _mm256_setr_pd(0.0, -0.0, 0.0, -0.0));
+}
+
+// Swaps the middle 64-bit quarters; the in-lane shuffles below leave values in order 0 1 4 5 2 3 6 7
+static inline __m256 __complex_order(__m256 v) {
+  return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+static inline __m256d __complexd_order(__m256d v) {
+  return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static inline void __complex_load(const float* p, size_t remain, __m256* re, __m256* im) {
+  __m256 v0, v1;
+  if (remain >= 8) {
+    v0 = _mm256_loadu_ps(p);
+    v1 = _mm256_loadu_ps(p + 8);
+  }
+  else {
+    float buff[16] = { 0.0f };
+    memcpy(buff, p, remain * 2 * sizeof(float));
+    v0 = _mm256_loadu_ps(buff);
+    v1 = _mm256_loadu_ps(buff + 8);
+  }
+  *re = __complex_order(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+  *im = __complex_order(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+static inline void __complex_store(float* p, size_t remain, __m256 re, __m256 im) {
+  re = __complex_order(re);
+  im = __complex_order(im);
+  __m256 v0 = _mm256_unpacklo_ps(re, im);
+  __m256 v1 = _mm256_unpackhi_ps(re, im);
+  if (remain >= 8) {
+    _mm256_storeu_ps(p, v0);
+    _mm256_storeu_ps(p + 8, v1);
+  }
+  else {
+    float buff[16];
+    _mm256_storeu_ps(buff, v0);
+    _mm256_storeu_ps(buff + 8, v1);
+    memcpy(p, buff, remain * 2 * sizeof(float));
+  }
+}
+
+static inline void __complexd_load(const double* p, size_t remain, __m256d* re, __m256d* im) {
+  __m256d v0, v1;
+  if (remain >= 4) {
+    v0 = _mm256_loadu_pd(p);
+    v1 = _mm256_loadu_pd(p + 4);
+  }
+  else {
+    double buff[8] = { 0.0 };
+    memcpy(buff, p, remain * 2 * sizeof(double));
+    v0 = _mm256_loadu_pd(buff);
+    v1 = _mm256_loadu_pd(buff + 4);
+  }
+  *re = __complexd_order(_mm256_unpacklo_pd(v0, v1));
+  *im = __complexd_order(_mm256_unpackhi_pd(v0, v1));
+}
+
+static inline void __complexd_store(double* p, size_t remain, __m256d re, __m256d im) {
+  re = __complexd_order(re);
+  im = __complexd_order(im);
+  __m256d v0 = _mm256_unpacklo_pd(re, im);
+  __m256d v1 = _mm256_unpackhi_pd(re, im);
+  if (remain >= 4) {
+    _mm256_storeu_pd(p, v0);
+    _mm256_storeu_pd(p + 4, v1);
+  }
+  else {
+    double buff[8];
+    _mm256_storeu_pd(buff, v0);
+    _mm256_storeu_pd(buff + 4, v1);
+    memcpy(p, buff, remain * 2 * sizeof(double));
+  }
+}
+
+#elif defined(CAM_SIMD_AVX)
+#define __complex_dupre _mm_moveldup_ps
+#define __complex_dupim _mm_movehdup_ps
+#define __complex_swap(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))
+#define __complexd_dupre _mm_movedup_pd
+#define __complexd_dupim(v) _mm_unpackhi_pd(v, v)
+#define __complexd_swap(v) _mm_shuffle_pd(v, v, 0x1)
+
+static inline __m128 __complex_fmaddsub(__m128 a, __m128 b, __m128 c) {
+#if defined(__FMA__) || (defined(CAM_CMP_MSVC) && defined(__AVX2__))
+  return _mm_fmaddsub_ps(a, b, c);
+#else
+  return _mm_addsub_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+static inline __m128d __complexd_fmaddsub(__m128d a, __m128d b, __m128d c) {
+#if defined(__FMA__) || (defined(CAM_CMP_MSVC) && defined(__AVX2__))
+  return _mm_fmaddsub_pd(a, b, c);
+#else
+  return _mm_addsub_pd(_mm_mul_pd(a, b), c);
+#endif
+}
+
+static inline __m128 __complex_conj(__m128 v) {
+  return _mm_xor_ps(v, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+}
+
+static inline __m128d __complexd_conj(__m128d v) {
+  return _mm_xor_pd(v, _mm_setr_pd(0.0, -0.0));
+}
+
+static inline void __complex_load(const float* p, size_t remain, __m128* re, __m128* im) {
+  __m128 v0, v1;
+  if (remain >= 4) {
+    v0 = _mm_loadu_ps(p);
+    v1 = _mm_loadu_ps(p + 4);
+  }
+  else {
+    float buff[8] = { 0.0f };
+    memcpy(buff, p, remain * 2 * sizeof(float));
+    v0 = _mm_loadu_ps(buff);
+    v1 = _mm_loadu_ps(buff + 4);
+  }
+  *re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+  *im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void __complex_store(float* p, size_t remain, __m128 re, __m128 im) {
+  __m128 v0 = _mm_unpacklo_ps(re, im);
+  __m128 v1 = _mm_unpackhi_ps(re, im);
+  if (remain >= 4) {
+    _mm_storeu_ps(p, v0);
+    _mm_storeu_ps(p + 4, v1);
+  }
+  else {
+    float buff[8];
+    _mm_storeu_ps(buff, v0);
+    _mm_storeu_ps(buff + 4, v1);
+    memcpy(p, buff, remain * 2 * sizeof(float));
+  }
+}
+
+static inline void __complexd_load(const double* p, size_t remain, __m128d* re, __m128d* im) {
+  __m128d v0 = _mm_loadu_pd(p);
+  __m128d v1 = (remain >= 2) ? _mm_loadu_pd(p + 2) : _mm_setzero_pd();
+  *re = _mm_unpacklo_pd(v0, v1);
+  *im = _mm_unpackhi_pd(v0, v1);
+}
+
+static inline void __complexd_store(double* p, size_t remain, __m128d re, __m128d im) {
+  _mm_storeu_pd(p, _mm_unpacklo_pd(re, im));
+  if (remain >= 2) { _mm_storeu_pd(p + 2, _mm_unpackhi_pd(re, im)); }
+}
+#endif
+
+#if defined(CAM_SIMD_AVX)
+// Products of interleaved values: (ar br - ai bi, ar bi + ai br) for each pair
+static inline __soa_vec __complex_mul(__soa_vec a, __soa_vec b) {
+  return __complex_fmaddsub(__complex_dupre(a), b, __soa_mul(__complex_dupim(a), __complex_swap(b)));
+}
+
+static inline __soad_vec __complexd_mul(__soad_vec a, __soad_vec b) {
+  return __complexd_fmaddsub(__complexd_dupre(a), b, __soad_mul(__complexd_dupim(a), __complexd_swap(b)));
+}
+
+/* Vector elementary functions */
+// Cephes polynomials for the batch exp and phase kernels, within a few float ulps
+// of the libm functions used by the scalar versions.
+
+// e^x, flushing to zero below about -103.9 and to infinity above about 88.72
+static inline __soa_vec __complex_exp(__soa_vec x) {
+  x = __soa_min(__soa_max(x, __soa_set1(-104.0f)), __soa_set1(89.0f));
+  // x = n ln(2) + r, with ln(2) split so n times the first part is exact
+  __soa_ivec n = __soa_cvti(__soa_mul(x, __soa_set1(1.44269504f)));
+  __soa_vec fn = __soa_cvtf(n);
+  __soa_vec r = __soa_fmadd(fn, __soa_set1(-0.693359375f), x);
+  r = __soa_fmadd(fn, __soa_set1(2.12194440e-4f), r);
+  __soa_vec p = __soa_set1(1.9875691500e-4f);
+  p = __soa_fmadd(p, r, __soa_set1(1.3981999507e-3f));
+  p = __soa_fmadd(p, r, __soa_set1(8.3334519073e-3f));
+  p = __soa_fmadd(p, r, __soa_set1(4.1665795894e-2f));
+  p = __soa_fmadd(p, r, __soa_set1(1.6666665459e-1f));
+  p = __soa_fmadd(p, r, __soa_set1(5.0000001201e-1f));
+  p = __soa_fmadd(__soa_mul(p, r), r, __soa_add(r, __soa_set1(1.0f)));
+  // Scale by 2^n in two steps so neither factor leaves the normal exponent range
+  __soa_ivec n1 = __soa_srai(n, 1);
+  __soa_ivec n2 = __soa_subi(n, n1);
+  p = __soa_mul(p, __soa_casti(__soa_slli(__soa_addi(n1, __soa_seti(127)), 23)));
+  return __soa_mul(p, __soa_casti(__soa_slli(__soa_addi(n2, __soa_seti(127)), 23)));
+}
+
+// sin(x) and cos(x), accurate for |x| up to about 8192
+static inline void __complex_sincos(__soa_vec x, __soa_vec* s, __soa_vec* c) {
+  // x = q pi/2 + r with |r| <= pi/4, with pi/2 split in three so q times each part is exact
+  __soa_ivec q = __soa_cvti(__soa_mul(x, __soa_set1(0.636619772f)));
+  __soa_vec fq = __soa_cvtf(q);
+  __soa_vec r = __soa_fmadd(fq, __soa_set1(-1.5703125f), x);
+  r = __soa_fmadd(fq, __soa_set1(-4.837512969970703125e-4f), r);
+  r = __soa_fmadd(fq, __soa_set1(-7.54978995489188216e-8f), r);
+  __soa_vec r2 = __soa_mul(r, r);
+  __soa_vec ps = __soa_set1(-1.9515295891e-4f);
+  ps = __soa_fmadd(ps, r2, __soa_set1(8.3321608736e-3f));
+  ps = __soa_fmadd(ps, r2, __soa_set1(-1.6666654611e-1f));
+  ps = __soa_fmadd(__soa_mul(ps, r2), r, r);
+  __soa_vec pc = __soa_set1(2.443315711809948e-5f);
+  pc = __soa_fmadd(pc, r2, __soa_set1(-1.388731625493765e-3f));
+  pc = __soa_fmadd(pc, r2, __soa_set1(4.166664568298827e-2f));
+  pc = __soa_fmadd(pc, r2, __soa_set1(-0.5f));
+  pc = __soa_fmadd(pc, r2, __soa_set1(1.0f));
+  // Odd quadrants swap sin and cos; bit 0 of q shifted into the sign bit drives the blend
+  __soa_vec odd = __soa_casti(__soa_slli(q, 31));
+  __soa_vec signbit = __soa_set1(-0.0f);
+  __soa_vec rs = __soa_blendv(ps, pc, odd);
+  __soa_vec rc = __soa_blendv(pc, ps, odd);
+  // sin is negative in quadrants 2 and 3, cos in quadrants 1 and 2
+  *s = __soa_xor(rs, __soa_and(__soa_casti(__soa_slli(q, 30)), signbit));
+  *c = __soa_xor(rc, __soa_and(__soa_casti(__soa_slli(__soa_addi(q, __soa_seti(1)), 30)), signbit));
+}
+
+// atan2(y, x), with the signed zero conventions of libm
+static inline __soa_vec __complex_atan2(__soa_vec y, __soa_vec x) {
+  __soa_vec signbit = __soa_set1(-0.0f);
+  __soa_vec ax = __soa_andnot(signbit, x);
+  __soa_vec ay = __soa_andnot(signbit, y);
+  __soa_vec mn = __soa_min(ax, ay);
+  __soa_vec mx = __soa_max(ax, ay);
+  // atan(mn / mx) on [0, 1], reduced to [0, tan(pi/8)] by atan(a) = pi/4 + atan((a - 1) / (a + 1))
+  __soa_vec big = __soa_cmpgt(mn, __soa_mul(mx, __soa_set1(0.414213562f)));
+  __soa_vec num = __soa_blendv(mn, __soa_sub(mn, mx), big);
+  __soa_vec den = __soa_blendv(mx, __soa_add(mn, mx), big);
+  __soa_vec a = __soa_and(__soa_div(num, den), __soa_cmpgt(den, __soa_set1(0.0f)));
+  __soa_vec z = __soa_mul(a, a);
+  __soa_vec p = __soa_set1(8.05374449538e-2f);
+  p = __soa_fmadd(p, z, __soa_set1(-1.38776856032e-1f));
+  p = __soa_fmadd(p, z, __soa_set1(1.99777106478e-1f));
+  p = __soa_fmadd(p, z, __soa_set1(-3.33329491539e-1f));
+  p = __soa_fmadd(__soa_mul(p, z), a, a);
+  p = __soa_add(p, __soa_and(big, __soa_set1(0.785398163f)));
+  // Undo the folding: reflect about pi/4 when |y| > |x|, then about pi/2 for negative x
+  p = __soa_blendv(p, __soa_sub(__soa_set1(1.57079633f), p), __soa_cmpgt(ay, ax));
+  p = __soa_blendv(p, __soa_sub(__soa_set1(3.14159265f), p), x);
+  return __soa_xor(p, __soa_and(y, signbit));
+}
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * quat.h
+ * Declaration for quaternions of floats.
+ */
+
+#ifndef CAM_COMPLEX_QUAT_H
+#define CAM_COMPLEX_QUAT_H
+
+#include "cam/complex/complex_common.h"
+#include "cam/linear/vec3.h"
+#include "cam/linear/mat3x3.h"
+
+/* Define quat struct */
+// x, y, z hold the vector part and w the scalar part, so q = w + xi + yj + zk.
+// Rotation functions expect unit quaternions.
+typedef struct {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 data;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  float32x4_t data;
+#else
+  // No SIMD intrinsics
+  float data[4];
+#endif
+} quat;
+
+
+/* quat functions */
+CAM_COMPLEX_API quat quat_make(float x, float y, float z, float w);
+
+CAM_COMPLEX_API quat quat_makeid();
+
+// Rotation of angle radians about a unit axis
+CAM_COMPLEX_API quat quat_make_axis_angle(vec3* axis, float angle);
+
+CAM_COMPLEX_API float quat_getx(quat* q);
+
+CAM_COMPLEX_API float quat_gety(quat* q);
+
+CAM_COMPLEX_API float quat_getz(quat* q);
+
+CAM_COMPLEX_API float quat_getw(quat* q);
+
+CAM_COMPLEX_API bool quat_equal(quat* a, quat* b);
+
+// Hamilton product; rotating by the result rotates by b, then by a
+CAM_COMPLEX_API quat quat_mul(quat* a, quat* b);
+
+CAM_COMPLEX_API quat quat_conj(quat* q);
+
+CAM_COMPLEX_API float quat_dot(quat* a, quat* b);
+
+CAM_COMPLEX_API quat quat_norm(quat* q);
+
+CAM_COMPLEX_API vec3 quat_rotate(quat* q, vec3* v);
+
+// Rotation matrix of a unit quaternion
+CAM_COMPLEX_API mat3x3 quat_to_mat3x3(quat* q);
+
+// Unit quaternion of a rotation matrix (Shepperd's method)
+CAM_COMPLEX_API quat quat_from_mat3x3(mat3x3* m);
+
+// Normalized linear interpolation along the shorter arc
+CAM_COMPLEX_API quat quat_nlerp(quat* a, quat* b, float t);
+
+// Spherical linear interpolation along the shorter arc. The weights come from a
+// polynomial approximation accurate to 1e-6 (see complex_common.h).
+CAM_COMPLEX_API quat quat_slerp(quat* a, quat* b, float t);
+
+
+/* quat functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_mulv(quat a, quat b);
+
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_conjv(quat q);
+
+CAM_COMPLEX_API float CAM_VECTORCALL quat_dotv(quat a, quat b);
+
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_normv(quat q);
+
+CAM_COMPLEX_API vec3 CAM_VECTORCALL quat_rotatev(quat q, vec3 v);
+
+CAM_COMPLEX_API mat3x3 CAM_VECTORCALL quat_to_mat3x3v(quat q);
+
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_from_mat3x3v(mat3x3 m);
+
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_nlerpv(quat a, quat b, float t);
+
+CAM_COMPLEX_API quat CAM_VECTORCALL quat_slerpv(quat a, quat b, float t);
+
+
+/* quat functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_COMPLEX_API void quat_mul_to(quat* dst, quat* a, quat* b);
+
+CAM_COMPLEX_API void quat_conj_to(quat* dst, quat* q);
+
+CAM_COMPLEX_API void quat_norm_to(quat* dst, quat* q);
+
+CAM_COMPLEX_API void quat_rotate_to(vec3* dst, quat* q, vec3* v);
+
+CAM_COMPLEX_API void quat_nlerp_to(quat* dst, quat* a, quat* b, float t);
+
+CAM_COMPLEX_API void quat_slerp_to(quat* dst, quat* a, quat* b, float t);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/quat.inl"
+#endif
+
+#endif
@@ -0,0 +1,366 @@
+/*
+ * quat.inl
+ * Definitions for quaternions of floats.
+ * Compiled by src/complex/quat.c, or included by quat.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_QUAT_INL
+#define CAM_COMPLEX_QUAT_INL
+
+#include "cam/complex/quat.h"
+#include <math.h>
+#include <string.h>
+
+/* quat helpers */
+#if defined(CAM_SIMD_AVX)
+// Lane selection in natural (x, y, z, w) order
+#define __quat_swizzle(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// a x b of the vector parts; the w lane stays zero when both inputs have zero w lanes
+static inline __m128 __quat_cross(__m128 a, __m128 b) {
+  __m128 c = _mm_sub_ps(_mm_mul_ps(a, __quat_swizzle(b, 1, 2, 0, 3)), _mm_mul_ps(__quat_swizzle(a, 1, 2, 0, 3), b));
+  return __quat_swizzle(c, 1, 2, 0, 3);
+}
+#endif
+
+
+/* quat functions */
+quat quat_make(float x, float y, float z, float w) {
+  quat q;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  q.data = _mm_setr_ps(x, y, z, w);
+#else
+  // No SIMD intrinsics
+  q.data[0] = x;
+  q.data[1] = y;
+  q.data[2] = z;
+  q.data[3] = w;
+#endif
+  return q;
+}
+
+quat quat_makeid() {
+  return quat_make(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+quat quat_make_axis_angle(vec3* axis, float angle) {
+  float s = (float)sin(angle * 0.5f);
+  float c = (float)cos(angle * 0.5f);
+  quat q;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  q.data = _mm_mul_ps(axis->data, _mm_set1_ps(s));
+  q.data = _mm_blend_ps(q.data, _mm_set1_ps(c), 0x8);
+#else
+  // No SIMD intrinsics
+  q.data[0] = axis->data[0] * s;
+  q.data[1] = axis->data[1] * s;
+  q.data[2] = axis->data[2] * s;
+  q.data[3] = c;
+#endif
+  return q;
+}
+
+float quat_getx(quat* q) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(q->data);
+#else
+  // No SIMD intrinsics
+  return q->data[0];
+#endif
+}
+
+float quat_gety(quat* q) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(__quat_swizzle(q->data, 1, 1, 1, 1));
+#else
+  // No SIMD intrinsics
+  return q->data[1];
+#endif
+}
+
+float quat_getz(quat* q) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(__quat_swizzle(q->data, 2, 2, 2, 2));
+#else
+  // No SIMD intrinsics
+  return q->data[2];
+#endif
+}
+
+float quat_getw(quat* q) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(__quat_swizzle(q->data, 3, 3, 3, 3));
+#else
+  // No SIMD intrinsics
+  return q->data[3];
+#endif
+}
+
+bool quat_equal(quat* a, quat* b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_movemask_ps(_mm_cmpeq_ps(a->data, b->data)) == 0xF;
+#else
+  // No SIMD intrinsics
+  return (a->data[0] == b->data[0]) && (a->data[1] == b->data[1]) &&
+         (a->data[2] == b->data[2]) && (a->data[3] == b->data[3]);
+#endif
+}
+
+quat CAM_VECTORCALL quat_mulv(quat a, quat b) {
+  quat r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Each lane of a scales a signed permutation of b
+  __m128 t = _mm_mul_ps(__quat_swizzle(a.data, 3, 3, 3, 3), b.data);
+  t = __linear_fmadd(__quat_swizzle(a.data, 0, 0, 0, 0),
+                     _mm_xor_ps(__quat_swizzle(b.data, 3, 2, 1, 0), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)), t);
+  t = __linear_fmadd(__quat_swizzle(a.data, 1, 1, 1, 1),
+                     _mm_xor_ps(__quat_swizzle(b.data, 2, 3, 0, 1), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f)), t);
+  r.data = __linear_fmadd(__quat_swizzle(a.data, 2, 2, 2, 2),
+                          _mm_xor_ps(__quat_swizzle(b.data, 1, 0, 3, 2), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f)), t);
+#else
+  // No SIMD intrinsics
+  float ax = a.data[0], ay = a.data[1], az = a.data[2], aw = a.data[3];
+  float bx = b.data[0], by = b.data[1], bz = b.data[2], bw = b.data[3];
+  r.data[0] = (aw * bx) + (ax * bw) + (ay * bz) - (az * by);
+  r.data[1] = (aw * by) - (ax * bz) + (ay * bw) + (az * bx);
+  r.data[2] = (aw * bz) + (ax * by) - (ay * bx) + (az * bw);
+  r.data[3] = (aw * bw) - (ax * bx) - (ay * by) - (az * bz);
+#endif
+  return r;
+}
+
+quat quat_mul(quat* a, quat* b) {
+  return quat_mulv(*a, *b);
+}
+
+void quat_mul_to(quat* dst, quat* a, quat* b) {
+  *dst = quat_mulv(*a, *b);
+}
+
+quat CAM_VECTORCALL quat_conjv(quat q) {
+  quat r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_xor_ps(q.data, _mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f));
+#else
+  // No SIMD intrinsics
+  r.data[0] = -q.data[0];
+  r.data[1] = -q.data[1];
+  r.data[2] = -q.data[2];
+  r.data[3] = q.data[3];
+#endif
+  return r;
+}
+
+quat quat_conj(quat* q) {
+  return quat_conjv(*q);
+}
+
+void quat_conj_to(quat* dst, quat* q) {
+  *dst = quat_conjv(*q);
+}
+
+float CAM_VECTORCALL quat_dotv(quat a, quat b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(_mm_dp_ps(a.data, b.data, 0xFF));
+#else
+  // No SIMD intrinsics
+  return (a.data[0] * b.data[0]) + (a.data[1] * b.data[1]) + (a.data[2] * b.data[2]) + (a.data[3] * b.data[3]);
+#endif
+}
+
+float quat_dot(quat* a, quat* b) {
+  return quat_dotv(*a, *b);
+}
+
+quat CAM_VECTORCALL quat_normv(quat q) {
+  quat r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_div_ps(q.data, _mm_sqrt_ps(_mm_dp_ps(q.data, q.data, 0xFF)));
+#else
+  // No SIMD intrinsics
+  float mag = (float)sqrt(quat_dotv(q, q));
+  r.data[0] = q.data[0] / mag;
+  r.data[1] = q.data[1] / mag;
+  r.data[2] = q.data[2] / mag;
+  r.data[3] = q.data[3] / mag;
+#endif
+  return r;
+}
+
+quat quat_norm(quat* q) {
+  return quat_normv(*q);
+}
+
+void quat_norm_to(quat* dst, quat* q) {
+  *dst = quat_normv(*q);
+}
+
+vec3 CAM_VECTORCALL quat_rotatev(quat q, vec3 v) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // v + w t + u x t with t = 2 (u x v), u the vector part of q
+  __m128 u = _mm_blend_ps(q.data, _mm_setzero_ps(), 0x8);
+  __m128 t = __quat_cross(u, v.data);
+  t = _mm_add_ps(t, t);
+  r.data = __linear_fmadd(__quat_swizzle(q.data, 3, 3, 3, 3), t, v.data);
+  r.data = _mm_add_ps(r.data, __quat_cross(u, t));
+#else
+  // No SIMD intrinsics
+  float ux = q.data[0], uy = q.data[1], uz = q.data[2], w = q.data[3];
+  float vx = v.data[0], vy = v.data[1], vz = v.data[2];
+  float tx = 2.0f * ((uy * vz) - (uz * vy));
+  float ty = 2.0f * ((uz * vx) - (ux * vz));
+  float tz = 2.0f * ((ux * vy) - (uy * vx));
+  r.data[0] = vx + (w * tx) + ((uy * tz) - (uz * ty));
+  r.data[1] = vy + (w * ty) + ((uz * tx) - (ux * tz));
+  r.data[2] = vz + (w * tz) + ((ux * ty) - (uy * tx));
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 quat_rotate(quat* q, vec3* v) {
+  return quat_rotatev(*q, *v);
+}
+
+void quat_rotate_to(vec3* dst, quat* q, vec3* v) {
+  *dst = quat_rotatev(*q, *v);
+}
+
+mat3x3 CAM_VECTORCALL quat_to_mat3x3v(quat q) {
+  mat3x3 m;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Each column is a unit vector plus two signed products of q and 2q; the sign
+  // vectors also clear the padding lane
+  __m128 q2 = _mm_add_ps(q.data, q.data);
+  __m128 t0 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 1, 0, 0, 3), __quat_swizzle(q2, 1, 1, 2, 3)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f));
+  __m128 t1 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 2, 3, 3, 3), __quat_swizzle(q2, 2, 2, 1, 3)), _mm_setr_ps(-1.0f, 1.0f, -1.0f, 0.0f));
+  m.data[0] = _mm_add_ps(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_add_ps(t0, t1));
+  t0 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 0, 0, 1, 3), __quat_swizzle(q2, 1, 0, 2, 3)), _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f));
+  t1 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 3, 2, 3, 3), __quat_swizzle(q2, 2, 2, 0, 3)), _mm_setr_ps(-1.0f, -1.0f, 1.0f, 0.0f));
+  m.data[1] = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_add_ps(t0, t1));
+  t0 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 0, 1, 0, 3), __quat_swizzle(q2, 2, 2, 0, 3)), _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f));
+  t1 = _mm_mul_ps(_mm_mul_ps(__quat_swizzle(q.data, 3, 3, 1, 3), __quat_swizzle(q2, 1, 0, 1, 3)), _mm_setr_ps(1.0f, -1.0f, -1.0f, 0.0f));
+  m.data[2] = _mm_add_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_add_ps(t0, t1));
+#else
+  // No SIMD intrinsics
+  float x = q.data[0], y = q.data[1], z = q.data[2], w = q.data[3];
+  m.data[0][0] = 1.0f - 2.0f * ((y * y) + (z * z));
+  m.data[0][1] = 2.0f * ((x * y) + (w * z));
+  m.data[0][2] = 2.0f * ((x * z) - (w * y));
+  m.data[0][3] = 0.0f;
+  m.data[1][0] = 2.0f * ((x * y) - (w * z));
+  m.data[1][1] = 1.0f - 2.0f * ((x * x) + (z * z));
+  m.data[1][2] = 2.0f * ((y * z) + (w * x));
+  m.data[1][3] = 0.0f;
+  m.data[2][0] = 2.0f * ((x * z) + (w * y));
+  m.data[2][1] = 2.0f * ((y * z) - (w * x));
+  m.data[2][2] = 1.0f - 2.0f * ((x * x) + (y * y));
+  m.data[2][3] = 0.0f;
+#endif
+  return m;
+}
+
+mat3x3 quat_to_mat3x3(quat* q) {
+  return quat_to_mat3x3v(*q);
+}
+
+quat CAM_VECTORCALL quat_from_mat3x3v(mat3x3 m) {
+  // Branches on the largest diagonal combination for stability, so every tier
+  // reads the elements out and works in scalar floats; c[col][row]
+  float c[3][4];
+  memcpy(c, &m.data, sizeof(c));
+  float trace = c[0][0] + c[1][1] + c[2][2];
+  if (trace > 0.0f) {
+    float s = (float)sqrt(trace + 1.0f) * 2.0f;
+    return quat_make((c[1][2] - c[2][1]) / s, (c[2][0] - c[0][2]) / s, (c[0][1] - c[1][0]) / s, 0.25f * s);
+  }
+  else if ((c[0][0] > c[1][1]) && (c[0][0] > c[2][2])) {
+    float s = (float)sqrt(1.0f + c[0][0] - c[1][1] - c[2][2]) * 2.0f;
+    return quat_make(0.25f * s, (c[1][0] + c[0][1]) / s, (c[2][0] + c[0][2]) / s, (c[1][2] - c[2][1]) / s);
+  }
+  else if (c[1][1] > c[2][2]) {
+    float s = (float)sqrt(1.0f + c[1][1] - c[0][0] - c[2][2]) * 2.0f;
+    return quat_make((c[1][0] + c[0][1]) / s, 0.25f * s, (c[2][1] + c[1][2]) / s, (c[2][0] - c[0][2]) / s);
+  }
+  else {
+    float s = (float)sqrt(1.0f + c[2][2] - c[0][0] - c[1][1]) * 2.0f;
+    return quat_make((c[2][0] + c[0][2]) / s, (c[2][1] + c[1][2]) / s, 0.25f * s, (c[0][1] - c[1][0]) / s);
+  }
+}
+
+quat quat_from_mat3x3(mat3x3* m) {
+  return quat_from_mat3x3v(*m);
+}
+
+quat CAM_VECTORCALL quat_nlerpv(quat a, quat b, float t) {
+  quat r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Negate b when the dot product is negative to take the shorter arc
+  __m128 sign = _mm_and_ps(_mm_dp_ps(a.data, b.data, 0xFF), _mm_set1_ps(-0.0f));
+  __m128 d = _mm_sub_ps(_mm_xor_ps(b.data, sign), a.data);
+  __m128 tmp = __linear_fmadd(_mm_set1_ps(t), d, a.data);
+  r.data = _mm_div_ps(tmp, _mm_sqrt_ps(_mm_dp_ps(tmp, tmp, 0xFF)));
+#else
+  // No SIMD intrinsics
+  float s = (quat_dotv(a, b) < 0.0f) ? -t : t;
+  for (int i = 0; i < 4; ++i) {
+    r.data[i] = (a.data[i] * (1.0f - t)) + (b.data[i] * s);
+  }
+  r = quat_normv(r);
+#endif
+  return r;
+}
+
+quat quat_nlerp(quat* a, quat* b, float t) {
+  return quat_nlerpv(*a, *b, t);
+}
+
+void quat_nlerp_to(quat* dst, quat* a, quat* b, float t) {
+  *dst = quat_nlerpv(*a, *b, t);
+}
+
+quat CAM_VECTORCALL quat_slerpv(quat a, quat b, float t) {
+  quat r;
+  float kt[__COMPLEX_SLERP_TERMS], kd[__COMPLEX_SLERP_TERMS];
+  __complex_slerp_coeffs(t, kt);
+  __complex_slerp_coeffs(1.0f - t, kd);
+  float d = quat_dotv(a, b);
+  float dm1 = (float)fabs(d) - 1.0f;
+  float wa = __complex_slerp_weight(1.0f - t, kd, dm1);
+  float wb = (float)copysign(__complex_slerp_weight(t, kt, dm1), d);
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = __linear_fmadd(_mm_set1_ps(wb), b.data, _mm_mul_ps(_mm_set1_ps(wa), a.data));
+#else
+  // No SIMD intrinsics
+  for (int i = 0; i < 4; ++i) {
+    r.data[i] = (wa * a.data[i]) + (wb * b.data[i]);
+  }
+#endif
+  return r;
+}
+
+quat quat_slerp(quat* a, quat* b, float t) {
+  return quat_slerpv(*a, *b, t);
+}
+
+void quat_slerp_to(quat* dst, quat* a, quat* b, float t) {
+  *dst = quat_slerpv(*a, *b, t);
+}
+
+#endif
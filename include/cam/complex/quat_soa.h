@@ -0,0 +1,49 @@
+/*
+ * quat_soa.h
+ * Declaration for batches of float quaternions in structure-of-arrays order.
+ */
+
+#ifndef CAM_COMPLEX_QUAT_SOA_H
+#define CAM_COMPLEX_QUAT_SOA_H
+
+#include "cam/complex/complex_common.h"
+#include "cam/complex/quat.h"
+
+/* Define quat_soa struct */
+typedef struct {
+  float* x;       // Component arrays, each aligned to CAM_SIMD_ALIGN bytes
+  float* y;
+  float* z;
+  float* w;
+  size_t count;   // Number of quaternions in the batch
+} quat_soa;
+
+
+/* quat_soa functions */
+// Batch operations process a->count (or q->count) elements. Every other operand
+// (including the destination) must hold at least that many. Destinations may alias sources.
+CAM_COMPLEX_API quat_soa quat_soa_make(size_t count);
+
+CAM_COMPLEX_API void quat_soa_free(quat_soa* s);
+
+CAM_COMPLEX_API quat quat_soa_get(quat_soa* s, size_t i);
+
+CAM_COMPLEX_API void quat_soa_set(quat_soa* s, size_t i, quat* q);
+
+// Same as quat_mul for every pair
+CAM_COMPLEX_API void quat_soa_mul(quat_soa* dst, quat_soa* a, quat_soa* b);
+
+CAM_COMPLEX_API void quat_soa_norm(quat_soa* dst, quat_soa* q);
+
+// Same as quat_nlerp for every pair, with one t for the batch
+CAM_COMPLEX_API void quat_soa_nlerp(quat_soa* dst, quat_soa* a, quat_soa* b, float t);
+
+// Same as quat_slerp for every pair, with one t for the batch
+CAM_COMPLEX_API void quat_soa_slerp(quat_soa* dst, quat_soa* a, quat_soa* b, float t);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/complex/quat_soa.inl"
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ * quat_soa.inl
+ * Definitions for batches of float quaternions in structure-of-arrays order.
+ * Compiled by src/complex/quat_soa.c, or included by quat_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_COMPLEX_QUAT_SOA_INL
+#define CAM_COMPLEX_QUAT_SOA_INL
+
+#include "cam/complex/quat_soa.h"
+#include <string.h>
+
+quat_soa quat_soa_make(size_t count) {
+  quat_soa s = { NULL, NULL, NULL, NULL, 0 };
+  if (count == 0) { return s; }
+
+  // Round each array up to a whole register so the padding is always readable
+  size_t bytes = ((count + 7) & ~(size_t)7) * sizeof(float);
+  s.x = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.y = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.z = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.w = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  if (!s.x || !s.y || !s.z || !s.w) {
+    quat_soa_free(&s);
+    return s;
+  }
+  memset(s.x, 0, bytes);
+  memset(s.y, 0, bytes);
+  memset(s.z, 0, bytes);
+  memset(s.w, 0, bytes);
+  s.count = count;
+  return s;
+}
+
+void quat_soa_free(quat_soa* s) {
+  cam_aligned_free(s->x);
+  cam_aligned_free(s->y);
+  cam_aligned_free(s->z);
+  cam_aligned_free(s->w);
+  s->x = NULL;
+  s->y = NULL;
+  s->z = NULL;
+  s->w = NULL;
+  s->count = 0;
+}
+
+quat quat_soa_get(quat_soa* s, size_t i) {
+  return quat_make(s->x[i], s->y[i], s->z[i], s->w[i]);
+}
+
+void quat_soa_set(quat_soa* s, size_t i, quat* q) {
+  s->x[i] = quat_getx(q);
+  s->y[i] = quat_gety(q);
+  s->z[i] = quat_getz(q);
+  s->w[i] = quat_getw(q);
+}
+
+void quat_soa_mul(quat_soa* dst, quat_soa* a, quat_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec ax = __soa_load(a->x + i, k, tail);
+    __soa_vec ay = __soa_load(a->y + i, k, tail);
+    __soa_vec az = __soa_load(a->z + i, k, tail);
+    __soa_vec aw = __soa_load(a->w + i, k, tail);
+    __soa_vec bx = __soa_load(b->x + i, k, tail);
+    __soa_vec by = __soa_load(b->y + i, k, tail);
+    __soa_vec bz = __soa_load(b->z + i, k, tail);
+    __soa_vec bw = __soa_load(b->w + i, k, tail);
+    __soa_vec rx = __soa_fmadd(aw, bx, __soa_fmadd(ax, bw, __soa_sub(__soa_mul(ay, bz), __soa_mul(az, by))));
+    __soa_vec ry = __soa_fmadd(aw, by, __soa_fmadd(ay, bw, __soa_sub(__soa_mul(az, bx), __soa_mul(ax, bz))));
+    __soa_vec rz = __soa_fmadd(aw, bz, __soa_fmadd(az, bw, __soa_sub(__soa_mul(ax, by), __soa_mul(ay, bx))));
+    __soa_vec rw = __soa_sub(__soa_mul(aw, bw), __soa_fmadd(ax, bx, __soa_fmadd(ay, by, __soa_mul(az, bz))));
+    __soa_store(dst->x + i, rx, k, tail);
+    __soa_store(dst->y + i, ry, k, tail);
+    __soa_store(dst->z + i, rz, k, tail);
+    __soa_store(dst->w + i, rw, k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    quat r = quat_mulv(quat_soa_get(a, i), quat_soa_get(b, i));
+    quat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void quat_soa_norm(quat_soa* dst, quat_soa* q) {
+  size_t n = q->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec x = __soa_load(q->x + i, k, tail);
+    __soa_vec y = __soa_load(q->y + i, k, tail);
+    __soa_vec z = __soa_load(q->z + i, k, tail);
+    __soa_vec w = __soa_load(q->w + i, k, tail);
+    __soa_vec mag = __soa_sqrt(__soa_fmadd(x, x, __soa_fmadd(y, y, __soa_fmadd(z, z, __soa_mul(w, w)))));
+    __soa_store(dst->x + i, __soa_div(x, mag), k, tail);
+    __soa_store(dst->y + i, __soa_div(y, mag), k, tail);
+    __soa_store(dst->z + i, __soa_div(z, mag), k, tail);
+    __soa_store(dst->w + i, __soa_div(w, mag), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    quat r = quat_normv(quat_soa_get(q, i));
+    quat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void quat_soa_nlerp(quat_soa* dst, quat_soa* a, quat_soa* b, float t) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  __soa_vec wa = __soa_set1(1.0f - t);
+  __soa_vec wt = __soa_set1(t);
+  __soa_vec signbit = __soa_set1(-0.0f);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec ax = __soa_load(a->x + i, k, tail);
+    __soa_vec ay = __soa_load(a->y + i, k, tail);
+    __soa_vec az = __soa_load(a->z + i, k, tail);
+    __soa_vec aw = __soa_load(a->w + i, k, tail);
+    __soa_vec bx = __soa_load(b->x + i, k, tail);
+    __soa_vec by = __soa_load(b->y + i, k, tail);
+    __soa_vec bz = __soa_load(b->z + i, k, tail);
+    __soa_vec bw = __soa_load(b->w + i, k, tail);
+
+    // Negate the weight of b where the dot product is negative to take the shorter arc
+    __soa_vec d = __soa_fmadd(ax, bx, __soa_fmadd(ay, by, __soa_fmadd(az, bz, __soa_mul(aw, bw))));
+    __soa_vec wb = __soa_xor(wt, __soa_and(d, signbit));
+    __soa_vec rx = __soa_fmadd(wb, bx, __soa_mul(wa, ax));
+    __soa_vec ry = __soa_fmadd(wb, by, __soa_mul(wa, ay));
+    __soa_vec rz = __soa_fmadd(wb, bz, __soa_mul(wa, az));
+    __soa_vec rw = __soa_fmadd(wb, bw, __soa_mul(wa, aw));
+    __soa_vec mag = __soa_sqrt(__soa_fmadd(rx, rx, __soa_fmadd(ry, ry, __soa_fmadd(rz, rz, __soa_mul(rw, rw)))));
+    __soa_store(dst->x + i, __soa_div(rx, mag), k, tail);
+    __soa_store(dst->y + i, __soa_div(ry, mag), k, tail);
+    __soa_store(dst->z + i, __soa_div(rz, mag), k, tail);
+    __soa_store(dst->w + i, __soa_div(rw, mag), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    quat r = quat_nlerpv(quat_soa_get(a, i), quat_soa_get(b, i), t);
+    quat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+void quat_soa_slerp(quat_soa* dst, quat_soa* a, quat_soa* b, float t) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // t is shared by the batch, so the polynomial coefficients are broadcast once
+  float kt[__COMPLEX_SLERP_TERMS], kd[__COMPLEX_SLERP_TERMS];
+  __complex_slerp_coeffs(t, kt);
+  __complex_slerp_coeffs(1.0f - t, kd);
+  __soa_vec vt[__COMPLEX_SLERP_TERMS], vd[__COMPLEX_SLERP_TERMS];
+  for (int j = 0; j < __COMPLEX_SLERP_TERMS; ++j) {
+    vt[j] = __soa_set1(kt[j]);
+    vd[j] = __soa_set1(kd[j]);
+  }
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  __soa_vec one = __soa_set1(1.0f);
+  __soa_vec signbit = __soa_set1(-0.0f);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec ax = __soa_load(a->x + i, k, tail);
+    __soa_vec ay = __soa_load(a->y + i, k, tail);
+    __soa_vec az = __soa_load(a->z + i, k, tail);
+    __soa_vec aw = __soa_load(a->w + i, k, tail);
+    __soa_vec bx = __soa_load(b->x + i, k, tail);
+    __soa_vec by = __soa_load(b->y + i, k, tail);
+    __soa_vec bz = __soa_load(b->z + i, k, tail);
+    __soa_vec bw = __soa_load(b->w + i, k, tail);
+
+    // Weights as in __complex_slerp_weight, on |d| with the sign moved onto b's weight
+    __soa_vec d = __soa_fmadd(ax, bx, __soa_fmadd(ay, by, __soa_fmadd(az, bz, __soa_mul(aw, bw))));
+    __soa_vec sign = __soa_and(d, signbit);
+    __soa_vec dm1 = __soa_sub(__soa_xor(d, sign), one);
+    __soa_vec wa = one;
+    __soa_vec wb = one;
+    for (int j = __COMPLEX_SLERP_TERMS - 1; j >= 0; --j) {
+      wa = __soa_fmadd(__soa_mul(vd[j], dm1), wa, one);
+      wb = __soa_fmadd(__soa_mul(vt[j], dm1), wb, one);
+    }
+    wa = __soa_mul(wa, __soa_set1(1.0f - t));
+    wb = __soa_xor(__soa_mul(wb, __soa_set1(t)), sign);
+    __soa_store(dst->x + i, __soa_fmadd(wb, bx, __soa_mul(wa, ax)), k, tail);
+    __soa_store(dst->y + i, __soa_fmadd(wb, by, __soa_mul(wa, ay)), k, tail);
+    __soa_store(dst->z + i, __soa_fmadd(wb, bz, __soa_mul(wa, az)), k, tail);
+    __soa_store(dst->w + i, __soa_fmadd(wb, bw, __soa_mul(wa, aw)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    quat r = quat_slerpv(quat_soa_get(a, i), quat_soa_get(b, i), t);
+    quat_soa_set(dst, i, &r);
+  }
+#endif
+}
+
+#endif
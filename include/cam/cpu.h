@@ -0,0 +1,51 @@
+/*
+ * cpu.h
+ * CPU feature detection and selection of the SIMD tier used by the library.
+ */
+
+#ifndef CAM_CPU_H
+#define CAM_CPU_H
+
+#include "cam/common.h"
+
+/* SIMD instruction tiers, in increasing order of capability */
+typedef enum {
+  CAM_TIER_SCALAR = 0,  // Portable C, no SIMD intrinsics
+  CAM_TIER_SSE41,       // 128-bit SSE up to SSE4.1
+  CAM_TIER_AVX2,        // 256-bit AVX2 with FMA
+  CAM_TIER_COUNT
+} cam_tier;
+
+
+/* Tier functions */
+// With runtime dispatch the library probes CPUID once at startup and binds every
+// linear algebra, complex, fourier and integration function to the best supported tier.
+// The environment variable CAM_SIMD_TIER (scalar, sse41 or avx2) lowers that choice, e.g.
+// for benchmarking.
+// Without dispatch the tier is fixed at compile time. CAM_HEADER_ONLY builds report the
+// tier the including translation unit is compiled for, and cam_set_tier changes nothing.
+
+// Inline in CAM_HEADER_ONLY builds, which link no library
+#if defined(CAM_HEADER_ONLY)
+#define CAM_CPU_API static inline
+#else
+#define CAM_CPU_API CAM_API
+#endif
+
+// Highest tier supported by both this CPU and this build of the library
+CAM_CPU_API cam_tier cam_cpu_tier();
+
+// Tier the library functions are currently bound to
+CAM_CPU_API cam_tier cam_get_tier();
+
+// Rebinds the library functions, clamped to cam_cpu_tier(). Returns the bound tier.
+// Not safe to call while other threads are using the library.
+CAM_CPU_API cam_tier cam_set_tier(cam_tier tier);
+
+CAM_CPU_API const char* cam_tier_name(cam_tier tier);
+
+#if defined(CAM_HEADER_ONLY)
+#include "cam/cpu.inl"
+#endif
+
+#endif
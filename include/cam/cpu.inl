@@ -0,0 +1,49 @@
+/*
+ * cpu.inl
+ * Definitions of the tier functions for CAM_HEADER_ONLY builds, which have no runtime
+ * dispatch. Included by cpu.h in CAM_HEADER_ONLY builds; library builds compile src/cpu.c.
+ */
+
+#ifndef CAM_CPU_INL
+#define CAM_CPU_INL
+
+#include "cam/cpu.h"
+
+/* cpu helpers */
+// Tier the including translation unit is compiled for, as __CPU_BUILD_TIER in src/cpu.c
+static inline cam_tier __cpu_compiled_tier() {
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  return CAM_TIER_AVX2;
+#elif defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return CAM_TIER_SSE41;
+#else
+  // No SIMD intrinsics
+  return CAM_TIER_SCALAR;
+#endif
+}
+
+
+/* Tier functions */
+cam_tier cam_cpu_tier() {
+  return __cpu_compiled_tier();
+}
+
+cam_tier cam_get_tier() {
+  return __cpu_compiled_tier();
+}
+
+cam_tier cam_set_tier(cam_tier tier) {
+  // Fixed at compile time
+  (void)tier;
+  return __cpu_compiled_tier();
+}
+
+const char* cam_tier_name(cam_tier tier) {
+  static const char* names[CAM_TIER_COUNT] = { "scalar", "sse41", "avx2" };
+  if (tier < 0 || tier >= CAM_TIER_COUNT) { return "unknown"; }
+  return names[tier];
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * convolve.h
+ * Declaration for single precision convolution and correlation.
+ */
+
+#ifndef CAM_FOURIER_CONVOLVE_H
+#define CAM_FOURIER_CONVOLVE_H
+
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/fft.h"
+#include "cam/fourier/rfft.h"
+
+/* Method selection */
+// Each convolution runs one of two ways, picked by a cost model of the SIMD tier
+// fitted to bench/fourier_convolve.c: sums of products over the shorter array for
+// short filters, or for long ones overlap-save, which transforms blocks of the
+// longer array with power of two FFTs of a size chosen for the filter length and
+// multiplies them by the transformed filter. The second allocates working space
+// and plans, and rounds like one forward and one inverse transform.
+
+
+/* Define cam_fir struct */
+// A fixed real filter applied to a stream in blocks of a fixed size. Everything is
+// allocated and the filter spectrum computed by cam_fir_make, so running a block
+// allocates nothing. Correlating a stream with a fixed template is filtering it by
+// the template reversed.
+typedef struct {
+  size_t taps;           // Filter length
+  size_t block;          // Samples per cam_fir_run
+  size_t n;              // Overlap-save transform size, or 0 to sum products directly
+  cam_rfft_plan* plan;   // Transform of size n, or NULL
+  float* filter;         // The taps, in order
+  cfloat* response;      // Transform of the taps zero padded to n, n / 2 + 1 values, or NULL
+  float* buffer;         // The last taps - 1 input samples, then room for the next ones:
+                         // a block, or the n - taps + 1 an overlap-save transform takes
+  float* out;            // Inverse transform of n samples, or NULL
+  cfloat* spectrum;      // Transform of the buffer, n / 2 + 1 values, or NULL
+} cam_fir;
+
+
+/* Convolution functions */
+// dst[k] = sum over j of a[j] b[k - j] for k in [0, na + nb - 1), over the indices
+// in range. dst holds na + nb - 1 values and must not overlap a or b. Returns false,
+// leaving dst unchanged, if na or nb is 0 or allocation fails.
+CAM_FOURIER_API bool cam_convolve(float* dst, float* a, size_t na, float* b, size_t nb);
+
+CAM_FOURIER_API bool cam_cconvolve(cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb);
+
+// dst[k] = sum over j of a[j + k - (nb - 1)] conj(b[j]) for k in [0, na + nb - 1):
+// dst[k] is the correlation at lag k - (nb - 1), where b lines up with a shifted by
+// that many values. Otherwise as cam_convolve.
+CAM_FOURIER_API bool cam_correlate(float* dst, float* a, size_t na, float* b, size_t nb);
+
+CAM_FOURIER_API bool cam_ccorrelate(cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb);
+
+
+/* cam_fir functions */
+// Filters blocks of block samples by the count taps of filter, which are copied.
+// Returns NULL if count or block is 0 or allocation fails.
+CAM_FOURIER_API cam_fir* cam_fir_make(float* filter, size_t count, size_t block);
+
+CAM_FOURIER_API void cam_fir_free(cam_fir* f);
+
+// Clears the history, as if the stream had been silent
+CAM_FOURIER_API void cam_fir_reset(cam_fir* f);
+
+// dst[k] = sum over j of filter[j] x[k - j] for the next block samples of the
+// stream x, which src holds; samples before the first block are zero. dst may be src.
+CAM_FOURIER_API void cam_fir_run(cam_fir* f, float* dst, float* src);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/convolve.inl"
+#endif
+
+#endif
@@ -0,0 +1,400 @@
+/*
+ * convolve.inl
+ * Definitions for single precision convolution and correlation.
+ * Compiled by src/fourier/convolve.c, or included by convolve.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_CONVOLVE_INL
+#define CAM_FOURIER_CONVOLVE_INL
+
+#include "cam/fourier/convolve.h"
+#include <math.h>
+#include <string.h>
+
+/* convolve helpers */
+// Direct sums run over the outputs for which every product is in range, x holding
+// count + taps - 1 values:
+//   dst[t] = sum over j < taps of h[j] x[t + taps - 1 - j],
+// a register of outputs taking one load and one multiply-add per tap. Full
+// convolutions sum the taps - 1 outputs at each end, where the filter hangs over
+// the signal, separately.
+//
+// Overlap-save transforms blocks of n inputs, the taps - 1 before the block then
+// the n - taps + 1 it contributes, and multiplies by the transformed filter. The
+// first taps - 1 values of the circular convolution wrap around and are dropped;
+// the rest are the outputs of the block.
+
+// Cost model in ns, fitted to bench/fourier_convolve.c: per product of the direct
+// sums, and per n (log2(n) + 1) of a transform of n points, real or complex. Past
+// __CONV_FFT_CACHE points the transforms leave the cache and cost grows with n.
+#if defined(CAM_SIMD_AVX2)
+#define __CONV_DIRECT_NS 0.05
+#define __CONV_CDIRECT_NS 0.19
+#define __CONV_FFT_NS 0.4
+#define __CONV_CFFT_NS 0.6
+#elif defined(CAM_SIMD_AVX)
+#define __CONV_DIRECT_NS 0.12
+#define __CONV_CDIRECT_NS 0.52
+#define __CONV_FFT_NS 0.62
+#define __CONV_CFFT_NS 1.0
+#else
+#define __CONV_DIRECT_NS 0.7
+#define __CONV_CDIRECT_NS 1.8
+#define __CONV_FFT_NS 1.6
+#define __CONV_CFFT_NS 2.9
+#endif
+#define __CONV_FFT_CACHE 32768.0
+
+// Largest transform overlap-save uses
+#define __CONV_MAX_N ((size_t)1 << 22)
+
+// Transform size for overlap-save over count outputs of a filter of taps values,
+// or 0 when the direct sums are cheaper
+static size_t __conv_size(size_t count, size_t taps, bool complex) {
+  double best = (complex ? __CONV_CDIRECT_NS : __CONV_DIRECT_NS) * (double)count * (double)taps;
+  size_t pick = 0, n = 2, log2n = 1;
+  while (n < taps) {
+    n *= 2;
+    ++log2n;
+  }
+  for (; n <= __CONV_MAX_N; n *= 2, ++log2n) {
+    // Blocks, plus half of one for the filter
+    size_t span = n - taps + 1;
+    double blocks = (double)((count + span - 1) / span) + 0.5;
+    double unit = (complex ? __CONV_CFFT_NS : __CONV_FFT_NS) * (1.0 + ((double)n / __CONV_FFT_CACHE));
+    double cost = unit * blocks * (double)n * (double)(log2n + 1);
+    if (cost < best) {
+      best = cost;
+      pick = n;
+    }
+    if (span >= count) { break; }
+  }
+  return pick;
+}
+
+static void __conv_direct(float* dst, const float* x, size_t count, const float* h, size_t taps) {
+  size_t t = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (; t + (4 * __SOA_WIDTH) <= count; t += 4 * __SOA_WIDTH) {
+    const float* p = x + t + taps - 1;
+    __soa_vec s0 = __soa_set1(0.0f), s1 = s0, s2 = s0, s3 = s0;
+    for (size_t j = 0; j < taps; ++j) {
+      __soa_vec k = __soa_set1(h[j]);
+      s0 = __soa_fmadd(__soa_loadu(p - j), k, s0);
+      s1 = __soa_fmadd(__soa_loadu(p - j + __SOA_WIDTH), k, s1);
+      s2 = __soa_fmadd(__soa_loadu(p - j + (2 * __SOA_WIDTH)), k, s2);
+      s3 = __soa_fmadd(__soa_loadu(p - j + (3 * __SOA_WIDTH)), k, s3);
+    }
+    __soa_storeu(dst + t, s0);
+    __soa_storeu(dst + t + __SOA_WIDTH, s1);
+    __soa_storeu(dst + t + (2 * __SOA_WIDTH), s2);
+    __soa_storeu(dst + t + (3 * __SOA_WIDTH), s3);
+  }
+  for (; t + __SOA_WIDTH <= count; t += __SOA_WIDTH) {
+    const float* p = x + t + taps - 1;
+    __soa_vec s0 = __soa_set1(0.0f);
+    for (size_t j = 0; j < taps; ++j) { s0 = __soa_fmadd(__soa_loadu(p - j), __soa_set1(h[j]), s0); }
+    __soa_storeu(dst + t, s0);
+  }
+#endif
+  // No SIMD intrinsics
+  for (; t < count; ++t) {
+    const float* p = x + t + taps - 1;
+    float s = 0.0f;
+    for (size_t j = 0; j < taps; ++j) { s += h[j] * p[-(ptrdiff_t)j]; }
+    dst[t] = s;
+  }
+}
+
+// The interleaved registers hold __SOA_WIDTH / 2 values. Their products with the
+// real and the imaginary part of each tap are summed apart and combined at the end:
+// (a + bi)(c + di) = (ac - bd) + (bc + ad)i.
+static void __conv_cdirect(cfloat* dst, const cfloat* x, size_t count, const cfloat* h, size_t taps) {
+  size_t t = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  const size_t w = __SOA_WIDTH / 2;
+  __soa_vec one = __soa_set1(1.0f);
+  for (; t + (2 * w) <= count; t += 2 * w) {
+    const float* p = (const float*)(x + t + taps - 1);
+    __soa_vec r0 = __soa_set1(0.0f), i0 = r0, r1 = r0, i1 = r0;
+    for (size_t j = 0; j < taps; ++j) {
+      __soa_vec kr = __soa_set1(h[j].re), ki = __soa_set1(h[j].im);
+      __soa_vec v0 = __soa_loadu(p - (2 * j));
+      __soa_vec v1 = __soa_loadu(p - (2 * j) + __SOA_WIDTH);
+      r0 = __soa_fmadd(v0, kr, r0);
+      i0 = __soa_fmadd(v0, ki, i0);
+      r1 = __soa_fmadd(v1, kr, r1);
+      i1 = __soa_fmadd(v1, ki, i1);
+    }
+    __soa_storeu((float*)(dst + t), __complex_fmaddsub(r0, one, __complex_swap(i0)));
+    __soa_storeu((float*)(dst + t + w), __complex_fmaddsub(r1, one, __complex_swap(i1)));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; t < count; ++t) {
+    const cfloat* p = x + t + taps - 1;
+    float re = 0.0f, im = 0.0f;
+    for (size_t j = 0; j < taps; ++j) {
+      cfloat v = p[-(ptrdiff_t)j];
+      re += (h[j].re * v.re) - (h[j].im * v.im);
+      im += (h[j].re * v.im) + (h[j].im * v.re);
+    }
+    dst[t].re = re;
+    dst[t].im = im;
+  }
+}
+
+// dst[i] *= h[i] for count values
+static void __conv_spectrum_mul(cfloat* dst, const cfloat* h, size_t count) {
+  size_t i = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (; i + (__SOA_WIDTH / 2) <= count; i += __SOA_WIDTH / 2) {
+    __soa_storeu((float*)(dst + i), __complex_mul(__soa_loadu((const float*)(dst + i)), __soa_loadu((const float*)(h + i))));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; i < count; ++i) {
+    cfloat v = dst[i];
+    dst[i].re = (v.re * h[i].re) - (v.im * h[i].im);
+    dst[i].im = (v.re * h[i].im) + (v.im * h[i].re);
+  }
+}
+
+// Full convolution by direct sums, nx >= nh
+static void __conv_full(float* dst, const float* x, size_t nx, const float* h, size_t nh) {
+  for (size_t k = 0; k + 1 < nh; ++k) {
+    float s = 0.0f;
+    for (size_t j = 0; j <= k; ++j) { s += h[j] * x[k - j]; }
+    dst[k] = s;
+  }
+  __conv_direct(dst + nh - 1, x, nx - nh + 1, h, nh);
+  for (size_t k = nx; k < nx + nh - 1; ++k) {
+    float s = 0.0f;
+    for (size_t j = k - nx + 1; j < nh; ++j) { s += h[j] * x[k - j]; }
+    dst[k] = s;
+  }
+}
+
+static void __conv_cfull(cfloat* dst, const cfloat* x, size_t nx, const cfloat* h, size_t nh) {
+  for (size_t k = 0; k < nx + nh - 1; ++k) {
+    if (k == nh - 1 && nx >= nh) {
+      // Every product in range
+      __conv_cdirect(dst + k, x, nx - nh + 1, h, nh);
+      k = nx - 1;
+      continue;
+    }
+    size_t j0 = (k >= nx) ? k - nx + 1 : 0, j1 = (k < nh) ? k + 1 : nh;
+    float re = 0.0f, im = 0.0f;
+    for (size_t j = j0; j < j1; ++j) {
+      re += (h[j].re * x[k - j].re) - (h[j].im * x[k - j].im);
+      im += (h[j].re * x[k - j].im) + (h[j].im * x[k - j].re);
+    }
+    dst[k].re = re;
+    dst[k].im = im;
+  }
+}
+
+// Full convolution by overlap-save with transforms of n points, nx >= nh
+static bool __conv_fft(float* dst, const float* x, size_t nx, const float* h, size_t nh, size_t n) {
+  size_t bins = (n / 2) + 1, span = n - nh + 1, count = nx + nh - 1;
+  cam_rfft_plan* plan = cam_rfft_plan_make(n);
+  float* seg = (float*)cam_aligned_alloc((2 * n * sizeof(float)) + (2 * bins * sizeof(cfloat)), CAM_SIMD_ALIGN);
+  if (!plan || !seg) {
+    cam_rfft_plan_free(plan);
+    cam_aligned_free(seg);
+    return false;
+  }
+  float* out = seg + n;
+  cfloat* response = (cfloat*)(out + n);
+  cfloat* spectrum = response + bins;
+
+  memcpy(seg, h, nh * sizeof(float));
+  memset(seg + nh, 0, (n - nh) * sizeof(float));
+  cam_rfft(plan, response, seg);
+
+  // Block b covers x[b span - (nh - 1), b span + span), zero outside [0, nx)
+  for (size_t k = 0; k < count; k += span) {
+    for (size_t i = 0; i < n; ++i) {
+      size_t at = k + i - (nh - 1);   // Wraps past zero before the signal
+      seg[i] = (k + i >= nh - 1 && at < nx) ? x[at] : 0.0f;
+    }
+    cam_rfft(plan, spectrum, seg);
+    __conv_spectrum_mul(spectrum, response, bins);
+    cam_irfft(plan, out, spectrum);
+    size_t m = (count - k < span) ? count - k : span;
+    memcpy(dst + k, out + nh - 1, m * sizeof(float));
+  }
+  cam_rfft_plan_free(plan);
+  cam_aligned_free(seg);
+  return true;
+}
+
+static bool __conv_cfft(cfloat* dst, const cfloat* x, size_t nx, const cfloat* h, size_t nh, size_t n) {
+  size_t span = n - nh + 1, count = nx + nh - 1;
+  cam_fft_plan* plan = cam_fft_plan_make(n);
+  cfloat* seg = (cfloat*)cam_aligned_alloc(3 * n * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!plan || !seg) {
+    cam_fft_plan_free(plan);
+    cam_aligned_free(seg);
+    return false;
+  }
+  cfloat* spectrum = seg + n;
+  cfloat* response = spectrum + n;
+
+  memcpy(seg, h, nh * sizeof(cfloat));
+  memset(seg + nh, 0, (n - nh) * sizeof(cfloat));
+  cam_fft_forward(plan, response, seg);
+
+  for (size_t k = 0; k < count; k += span) {
+    for (size_t i = 0; i < n; ++i) {
+      size_t at = k + i - (nh - 1);
+      if (k + i >= nh - 1 && at < nx) { seg[i] = x[at]; }
+      else { seg[i].re = seg[i].im = 0.0f; }
+    }
+    cam_fft_forward(plan, spectrum, seg);
+    __conv_spectrum_mul(spectrum, response, n);
+    cam_fft_inverse(plan, seg, spectrum);
+    size_t m = (count - k < span) ? count - k : span;
+    memcpy(dst + k, seg + nh - 1, m * sizeof(cfloat));
+  }
+  cam_fft_plan_free(plan);
+  cam_aligned_free(seg);
+  return true;
+}
+
+// Convolution commutes, so the shorter array is the filter
+static bool __conv_real(float* dst, float* a, size_t na, float* b, size_t nb) {
+  if (na == 0 || nb == 0) { return false; }
+  float* x = (na >= nb) ? a : b;
+  float* h = (na >= nb) ? b : a;
+  size_t nx = (na >= nb) ? na : nb, nh = (na >= nb) ? nb : na;
+  size_t n = __conv_size(nx + nh - 1, nh, false);
+  if (n == 0) {
+    __conv_full(dst, x, nx, h, nh);
+    return true;
+  }
+  return __conv_fft(dst, x, nx, h, nh, n);
+}
+
+static bool __conv_complex(cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb) {
+  if (na == 0 || nb == 0) { return false; }
+  cfloat* x = (na >= nb) ? a : b;
+  cfloat* h = (na >= nb) ? b : a;
+  size_t nx = (na >= nb) ? na : nb, nh = (na >= nb) ? nb : na;
+  size_t n = __conv_size(nx + nh - 1, nh, true);
+  if (n == 0) {
+    __conv_cfull(dst, x, nx, h, nh);
+    return true;
+  }
+  return __conv_cfft(dst, x, nx, h, nh, n);
+}
+
+
+/* Convolution functions */
+bool cam_convolve(float* dst, float* a, size_t na, float* b, size_t nb) {
+  return __conv_real(dst, a, na, b, nb);
+}
+
+bool cam_cconvolve(cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb) {
+  return __conv_complex(dst, a, na, b, nb);
+}
+
+// Correlation is convolution with b reversed and conjugated
+bool cam_correlate(float* dst, float* a, size_t na, float* b, size_t nb) {
+  if (na == 0 || nb == 0) { return false; }
+  float* r = (float*)cam_aligned_alloc(nb * sizeof(float), CAM_SIMD_ALIGN);
+  if (!r) { return false; }
+  for (size_t j = 0; j < nb; ++j) { r[j] = b[nb - 1 - j]; }
+  bool ok = __conv_real(dst, a, na, r, nb);
+  cam_aligned_free(r);
+  return ok;
+}
+
+bool cam_ccorrelate(cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb) {
+  if (na == 0 || nb == 0) { return false; }
+  cfloat* r = (cfloat*)cam_aligned_alloc(nb * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!r) { return false; }
+  for (size_t j = 0; j < nb; ++j) {
+    r[j].re = b[nb - 1 - j].re;
+    r[j].im = -b[nb - 1 - j].im;
+  }
+  bool ok = __conv_complex(dst, a, na, r, nb);
+  cam_aligned_free(r);
+  return ok;
+}
+
+
+/* cam_fir functions */
+cam_fir* cam_fir_make(float* filter, size_t count, size_t block) {
+  if (count == 0 || block == 0) { return NULL; }
+  size_t n = __conv_size(block, count, false);
+  size_t bins = (n / 2) + 1;
+
+  // One allocation holds the filter and its arrays
+  size_t head = (sizeof(cam_fir) + 63) & ~(size_t)63;
+  size_t taps = ((count * sizeof(float)) + 63) & ~(size_t)63;
+  size_t buffer = ((((n != 0) ? n : count - 1 + block) * sizeof(float)) + 63) & ~(size_t)63;
+  size_t extra = (n != 0) ? (((n * sizeof(float)) + 63) & ~(size_t)63) + (2 * (((bins * sizeof(cfloat)) + 63) & ~(size_t)63)) : 0;
+  cam_fir* f = (cam_fir*)cam_aligned_alloc(head + taps + buffer + extra, 64);
+  if (!f) { return NULL; }
+  memset(f, 0, sizeof(cam_fir));
+  f->taps = count;
+  f->block = block;
+  f->n = n;
+  f->filter = (float*)((char*)f + head);
+  f->buffer = (float*)((char*)f + head + taps);
+  memcpy(f->filter, filter, count * sizeof(float));
+  if (n != 0) {
+    f->plan = cam_rfft_plan_make(n);
+    if (!f->plan) {
+      cam_aligned_free(f);
+      return NULL;
+    }
+    f->out = (float*)((char*)f->buffer + buffer);
+    f->response = (cfloat*)((char*)f->out + (((n * sizeof(float)) + 63) & ~(size_t)63));
+    f->spectrum = (cfloat*)((char*)f->response + (((bins * sizeof(cfloat)) + 63) & ~(size_t)63));
+    memcpy(f->buffer, filter, count * sizeof(float));
+    memset(f->buffer + count, 0, (n - count) * sizeof(float));
+    cam_rfft(f->plan, f->response, f->buffer);
+  }
+  cam_fir_reset(f);
+  return f;
+}
+
+void cam_fir_free(cam_fir* f) {
+  if (!f) { return; }
+  cam_rfft_plan_free(f->plan);
+  cam_aligned_free(f);
+}
+
+void cam_fir_reset(cam_fir* f) {
+  memset(f->buffer, 0, (f->taps - 1) * sizeof(float));
+}
+
+void cam_fir_run(cam_fir* f, float* dst, float* src) {
+  size_t keep = f->taps - 1;
+  if (f->n == 0) {
+    memcpy(f->buffer + keep, src, f->block * sizeof(float));
+    __conv_direct(dst, f->buffer, f->block, f->filter, f->taps);
+    memmove(f->buffer, f->buffer + f->block, keep * sizeof(float));
+    return;
+  }
+
+  // The buffer past the new samples of a short last block only reaches outputs
+  // that wrap around, so it needs no clearing
+  size_t span = f->n - keep;
+  for (size_t k = 0; k < f->block; k += span) {
+    size_t m = (f->block - k < span) ? f->block - k : span;
+    memcpy(f->buffer + keep, src + k, m * sizeof(float));
+    cam_rfft(f->plan, f->spectrum, f->buffer);
+    memmove(f->buffer, f->buffer + m, keep * sizeof(float));
+    __conv_spectrum_mul(f->spectrum, f->response, (f->n / 2) + 1);
+    cam_irfft(f->plan, f->out, f->spectrum);
+    memcpy(dst + k, f->out + keep, m * sizeof(float));
+  }
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * dct.h
+ * Declaration for single precision discrete cosine transforms.
+ */
+
+#ifndef CAM_FOURIER_DCT_H
+#define CAM_FOURIER_DCT_H
+
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/fft.h"
+
+/* Define cam_dct_plan struct */
+// The n samples are reordered, evens ascending then odds descending, read as n / 2
+// complex values and run through a complex transform of half the size. One pass
+// pairing bins k and n / 2 - k then gives the spectrum of the reordered samples,
+// and rotating bin k by e^(-i pi k / 2n) gives DCT coefficients k and n - k.
+typedef struct {
+  size_t n;              // Transform size, even
+  cam_fft_plan* half;    // Complex plan of size n / 2
+  cfloat* pair;          // -i e^(-2 pi i k / n) / 2 for k in [0, n / 4]
+  cfloat* twiddle;       // e^(-i pi k / 2n) for k in [0, n / 2]
+} cam_dct_plan;
+
+
+/* Define cam_mdct_plan struct */
+// The 2n samples fold into the n of a DCT-IV, whose even and reversed odd inputs
+// are read as n / 2 complex values, rotated, run through a complex transform of half
+// the size and rotated again.
+typedef struct {
+  size_t n;              // Coefficients per transform, even; each reads 2n samples
+  cam_fft_plan* half;    // Complex plan of size n / 2
+  cfloat* pre;           // e^(-i pi (4j + 1) / 4n) for j in [0, n / 2)
+  cfloat* post;          // e^(-i pi k / n) for k in [0, n / 2)
+} cam_mdct_plan;
+
+
+/* cam_dct_plan functions */
+// Returns NULL if n is odd or not in [2, 2^32], or allocation fails. Sizes whose half
+// has only the prime factors 2, 3, 5 and 7 run fastest, as for cam_fft_plan_make.
+CAM_FOURIER_API cam_dct_plan* cam_dct_plan_make(size_t n);
+
+CAM_FOURIER_API void cam_dct_plan_free(cam_dct_plan* plan);
+
+// Returns NULL if n is odd or not in [2, 2^32], or allocation fails
+CAM_FOURIER_API cam_mdct_plan* cam_mdct_plan_make(size_t n);
+
+CAM_FOURIER_API void cam_mdct_plan_free(cam_mdct_plan* plan);
+
+
+/* Transform functions */
+// Transforms up to 2048 points work on the stack; larger ones allocate working space
+// of n floats per call, without which dst is filled with NaN. dst may be src.
+
+// DCT-II: dst[k] = sum over j of src[j] cos(pi (2j + 1) k / 2n), n = plan->n values each
+CAM_FOURIER_API void cam_dct(cam_dct_plan* plan, float* dst, float* src);
+
+// DCT-III: dst[j] = (1 / n) (src[0] + 2 sum over k >= 1 of src[k] cos(pi (2j + 1) k / 2n)),
+// undoing cam_dct
+CAM_FOURIER_API void cam_idct(cam_dct_plan* plan, float* dst, float* src);
+
+// dst[k] = sum over j of src[j] cos(pi (j + 1/2 + n/2) (k + 1/2) / n) for the 2n
+// values of src, writing n = plan->n values
+CAM_FOURIER_API void cam_mdct(cam_mdct_plan* plan, float* dst, float* src);
+
+// dst[j] = (2 / n) sum over k of src[k] cos(pi (j + 1/2 + n/2) (k + 1/2) / n) for the n
+// values of src, writing 2n. Frames taken every n samples under a window w of 2n
+// values with w[j]^2 + w[j + n]^2 = 1, such as sin(pi (j + 1/2) / 2n), transformed
+// by cam_mdct and back, windowed again and overlap-added give back the signal.
+CAM_FOURIER_API void cam_imdct(cam_mdct_plan* plan, float* dst, float* src);
+
+
+/* Batch functions */
+// Two dimensional DCT-II of count blocks of 8 x 8 values, each 64 values in row major
+// order, one after another: the 8 point cam_dct of every row, then of every column.
+// Image codecs usually scale coefficient (u, v) by c_u c_v / 4 with c_0 = 1 / sqrt(2)
+// and c_k = 1 otherwise. dst may be src.
+CAM_FOURIER_API void cam_dct8x8_many(float* dst, float* src, size_t count);
+
+// Two dimensional DCT-III, cam_idct of every row and column, undoing cam_dct8x8_many
+CAM_FOURIER_API void cam_idct8x8_many(float* dst, float* src, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/dct.inl"
+#endif
+
+#endif
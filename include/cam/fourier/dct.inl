@@ -0,0 +1,416 @@
+/*
+ * dct.inl
+ * Definitions for single precision discrete cosine transforms.
+ * Compiled by src/fourier/dct.c, or included by dct.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_DCT_INL
+#define CAM_FOURIER_DCT_INL
+
+#include "cam/fourier/dct.h"
+#include <math.h>
+#include <string.h>
+
+/* dct helpers */
+// With m = n / 2, v the samples reordered as v[j] = x[2j], v[n - 1 - j] = x[2j + 1],
+// and V its real spectrum,
+//   X[k] = Re(w_k V[k]),   X[n - k] = -Im(w_k V[k]),   w_k = e^(-i pi k / 2n).
+// V comes from the transform Z of v read as m complex values by the pairing of
+// cam_rfft: A = Z[k], B = conj(Z[m - k]), E = (A + B) / 2, T = c_k (A - B) give
+// V[k] = E + T and V[m - k] = conj(E - T). The inverse runs every step backwards:
+// V[k] = conj(w_k) (X[k] - i X[n - k]), paired with conj(c_k) into Z, transformed
+// back and reordered.
+//
+// The MDCT of x = (a, b, c, d), quarters of n / 2 values, is the DCT-IV of the n
+// values (-c_r - d, a - b_r), _r reversing, and the DCT-IV of u is
+//   z[j] = (u[2j] + i u[n - 1 - 2j]) pre[j],   Y[k] = post[k] Z[k],
+//   X[2k] = Re(Y[k]),   X[n - 1 - 2k] = -Im(Y[k])
+// for j, k in [0, n / 2). The DCT-IV is its own inverse up to 2 / n, and unfolding
+// its output w = (w1, w2) into (w2, -w2_r, -w1_r, -w1) gives the IMDCT.
+
+// Transforms this size or smaller work in a buffer on the stack
+#define __DCT_STACK 2048
+
+// Working space of n floats: buf when it holds them, else allocated
+static inline cfloat* __dct_work(cfloat* buf, size_t n) {
+  if (n <= __DCT_STACK) { return buf; }
+  return (cfloat*)cam_aligned_alloc(n * sizeof(float), CAM_SIMD_ALIGN);
+}
+
+static inline void __dct_release(cfloat* buf, cfloat* z) {
+  if (z != buf) { cam_aligned_free(z); }
+}
+
+static void __dct_fail(float* dst, size_t n) {
+  for (size_t k = 0; k < n; ++k) { dst[k] = NAN; }
+}
+
+// w z for one complex value of each
+static inline cfloat __dct_rotate(cfloat z, cfloat w) {
+  cfloat r = { (z.re * w.re) - (z.im * w.im), (z.re * w.im) + (z.im * w.re) };
+  return r;
+}
+
+#if defined(CAM_SIMD_AVX2)
+// Lane orders for _mm256_permutevar8x32_ps. Split takes four interleaved values to
+// their real parts then their imaginary parts reversed, and takes the samples of
+// the reordering to the evens then the odds reversed; merge undoes it.
+#define __DCT_SPLIT _mm256_setr_epi32(0, 2, 4, 6, 7, 5, 3, 1)
+#define __DCT_MERGE _mm256_setr_epi32(0, 7, 1, 6, 2, 5, 3, 4)
+#define __dct_reverse(v) _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(0, 1, 2, 3)))
+
+// Stores the first half of v at lo and the second at hi
+static inline void __dct_store_halves(float* lo, float* hi, __m256 v) {
+  _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+  _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+// Four values at lo then four at hi
+static inline __m256 __dct_load_halves(const float* lo, const float* hi) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+#endif
+
+// Sample j of the DCT-IV input folded from the 2n values of x
+static inline float __mdct_fold(const float* x, size_t n, size_t j) {
+  size_t h = n / 2;
+  return ((j < h) ? -x[n + h + j] : x[j - h]) - x[n + h - 1 - j];
+}
+
+// cos(pi (2j + 1) k / 16), row k
+static const float __dct8_cos[8][8] = {
+  { 1.000000000f, 1.000000000f, 1.000000000f, 1.000000000f, 1.000000000f, 1.000000000f, 1.000000000f, 1.000000000f },
+  { 0.980785280f, 0.831469612f, 0.555570233f, 0.195090322f, -0.195090322f, -0.555570233f, -0.831469612f, -0.980785280f },
+  { 0.923879533f, 0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f, 0.382683432f, 0.923879533f },
+  { 0.831469612f, -0.195090322f, -0.980785280f, -0.555570233f, 0.555570233f, 0.980785280f, 0.195090322f, -0.831469612f },
+  { 0.707106781f, -0.707106781f, -0.707106781f, 0.707106781f, 0.707106781f, -0.707106781f, -0.707106781f, 0.707106781f },
+  { 0.555570233f, -0.980785280f, 0.195090322f, 0.831469612f, -0.831469612f, -0.195090322f, 0.980785280f, -0.555570233f },
+  { 0.382683432f, -0.923879533f, 0.923879533f, -0.382683432f, -0.382683432f, 0.923879533f, -0.923879533f, 0.382683432f },
+  { 0.195090322f, -0.555570233f, 0.831469612f, -0.980785280f, 0.980785280f, -0.831469612f, 0.555570233f, -0.195090322f }
+};
+
+// Blocks of 8 x 8 values x to M x M^T. The row pass multiplies row j of rows = M^T
+// by each x[r][j] and sums over j, leaving a block t = x M^T in registers; the column
+// pass multiplies row r of t by each cols[k][r] = M[k][r] and sums over r.
+static void __dct8x8(float* dst, const float* src, size_t count, const float* rows, const float* cols) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  enum { R = 8 / __SOA_WIDTH };   // Registers per row
+  __soa_vec m[8 * R];
+  for (size_t i = 0; i < 8 * R; ++i) { m[i] = __soa_loadu(rows + (i * __SOA_WIDTH)); }
+  for (size_t b = 0; b < count; ++b) {
+    const float* x = src + (64 * b);
+    float* y = dst + (64 * b);
+    __soa_vec t[8 * R];
+    for (size_t r = 0; r < 8; ++r) {
+      for (size_t h = 0; h < R; ++h) {
+        __soa_vec s = __soa_mul(__soa_set1(x[8 * r]), m[h]);
+        for (size_t j = 1; j < 8; ++j) { s = __soa_fmadd(__soa_set1(x[(8 * r) + j]), m[(j * R) + h], s); }
+        t[(r * R) + h] = s;
+      }
+    }
+    for (size_t k = 0; k < 8; ++k) {
+      for (size_t h = 0; h < R; ++h) {
+        __soa_vec s = __soa_mul(__soa_set1(cols[8 * k]), t[h]);
+        for (size_t r = 1; r < 8; ++r) { s = __soa_fmadd(__soa_set1(cols[(8 * k) + r]), t[(r * R) + h], s); }
+        __soa_storeu(y + (8 * k) + (h * __SOA_WIDTH), s);
+      }
+    }
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t b = 0; b < count; ++b) {
+    const float* x = src + (64 * b);
+    float* y = dst + (64 * b);
+    float t[64];
+    for (size_t r = 0; r < 8; ++r) {
+      for (size_t c = 0; c < 8; ++c) {
+        float s = 0.0f;
+        for (size_t j = 0; j < 8; ++j) { s += x[(8 * r) + j] * rows[(8 * j) + c]; }
+        t[(8 * r) + c] = s;
+      }
+    }
+    for (size_t k = 0; k < 8; ++k) {
+      for (size_t c = 0; c < 8; ++c) {
+        float s = 0.0f;
+        for (size_t r = 0; r < 8; ++r) { s += cols[(8 * k) + r] * t[(8 * r) + c]; }
+        y[(8 * k) + c] = s;
+      }
+    }
+  }
+#endif
+}
+
+
+/* cam_dct_plan functions */
+cam_dct_plan* cam_dct_plan_make(size_t n) {
+  if (n < 2 || (n & 1) != 0 || n > ((size_t)1 << 32)) { return NULL; }
+  size_t m = n / 2;
+
+  // One allocation holds the plan and both tables; the half size plan is its own
+  size_t head = (sizeof(cam_dct_plan) + 63) & ~(size_t)63;
+  size_t pair = (((m / 2 + 1) * sizeof(cfloat)) + 63) & ~(size_t)63;
+  cam_dct_plan* plan = (cam_dct_plan*)cam_aligned_alloc(head + pair + ((m + 1) * sizeof(cfloat)), 64);
+  if (!plan) { return NULL; }
+  plan->n = n;
+  plan->pair = (cfloat*)((char*)plan + head);
+  plan->twiddle = (cfloat*)((char*)plan + head + pair);
+  plan->half = cam_fft_plan_make(m);
+  if (!plan->half) {
+    cam_aligned_free(plan);
+    return NULL;
+  }
+
+  // Evaluated in double
+  for (size_t k = 0; k <= m / 2; ++k) {
+    double a = 2.0 * C_PI * (double)k / (double)n;
+    plan->pair[k] = cfloat_make((float)(-0.5 * sin(a)), (float)(-0.5 * cos(a)));
+  }
+  for (size_t k = 0; k <= m; ++k) {
+    double a = C_PI * (double)k / (double)(2 * n);
+    plan->twiddle[k] = cfloat_make((float)cos(a), (float)-sin(a));
+  }
+  return plan;
+}
+
+void cam_dct_plan_free(cam_dct_plan* plan) {
+  if (!plan) { return; }
+  cam_fft_plan_free(plan->half);
+  cam_aligned_free(plan);
+}
+
+cam_mdct_plan* cam_mdct_plan_make(size_t n) {
+  if (n < 2 || (n & 1) != 0 || n > ((size_t)1 << 32)) { return NULL; }
+  size_t m = n / 2;
+
+  size_t head = (sizeof(cam_mdct_plan) + 63) & ~(size_t)63;
+  size_t pre = ((m * sizeof(cfloat)) + 63) & ~(size_t)63;
+  cam_mdct_plan* plan = (cam_mdct_plan*)cam_aligned_alloc(head + (2 * pre), 64);
+  if (!plan) { return NULL; }
+  plan->n = n;
+  plan->pre = (cfloat*)((char*)plan + head);
+  plan->post = (cfloat*)((char*)plan + head + pre);
+  plan->half = cam_fft_plan_make(m);
+  if (!plan->half) {
+    cam_aligned_free(plan);
+    return NULL;
+  }
+
+  for (size_t j = 0; j < m; ++j) {
+    double a = C_PI * (double)((4 * j) + 1) / (double)(4 * n);
+    double b = C_PI * (double)j / (double)n;
+    plan->pre[j] = cfloat_make((float)cos(a), (float)-sin(a));
+    plan->post[j] = cfloat_make((float)cos(b), (float)-sin(b));
+  }
+  return plan;
+}
+
+void cam_mdct_plan_free(cam_mdct_plan* plan) {
+  if (!plan) { return; }
+  cam_fft_plan_free(plan->half);
+  cam_aligned_free(plan);
+}
+
+
+/* Transform functions */
+void cam_dct(cam_dct_plan* plan, float* dst, float* src) {
+  size_t n = plan->n, m = n / 2, q = m / 2;
+  cfloat buf[__DCT_STACK / 2];
+  cfloat* z = __dct_work(buf, n);
+  if (!z) {
+    __dct_fail(dst, n);
+    return;
+  }
+  float* v = (float*)z;
+  size_t j = 0;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  for (; j + 4 <= m; j += 4) {
+    __m256 x = _mm256_permutevar8x32_ps(_mm256_loadu_ps(src + (2 * j)), __DCT_SPLIT);
+    __dct_store_halves(v + j, v + n - 4 - j, x);
+  }
+#endif
+  // No SIMD intrinsics
+  for (; j < m; ++j) {
+    v[j] = src[2 * j];
+    v[n - 1 - j] = src[(2 * j) + 1];
+  }
+  cam_fft_forward(plan->half, z, z);
+
+  // Bins 0 and m pair with each other, and are real
+  const cfloat* w = plan->twiddle;
+  dst[0] = z[0].re + z[0].im;
+  dst[m] = (z[0].re - z[0].im) * w[m].re;
+  size_t k = 1;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  __m256 half = _mm256_set1_ps(0.5f);
+  __m256 neg = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, -0.0f, -0.0f, -0.0f, -0.0f);
+  for (; k + 4 <= q; k += 4) {
+    size_t r = m - k - 3;
+    __m256 a = _mm256_loadu_ps((const float*)(z + k));
+    __m256 b = __complex_conj(__dct_reverse(_mm256_loadu_ps((const float*)(z + r))));
+    __m256 e = _mm256_mul_ps(_mm256_add_ps(a, b), half);
+    __m256 t = __complex_mul(_mm256_sub_ps(a, b), _mm256_loadu_ps((const float*)(plan->pair + k)));
+    __m256 p = __complex_mul(_mm256_add_ps(e, t), _mm256_loadu_ps((const float*)(w + k)));
+    __m256 u = __complex_mul(__complex_conj(__dct_reverse(_mm256_sub_ps(e, t))), _mm256_loadu_ps((const float*)(w + r)));
+    __dct_store_halves(dst + k, dst + n - k - 3, _mm256_xor_ps(_mm256_permutevar8x32_ps(p, __DCT_SPLIT), neg));
+    __dct_store_halves(dst + r, dst + n - r - 3, _mm256_xor_ps(_mm256_permutevar8x32_ps(u, __DCT_SPLIT), neg));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; k <= q; ++k) {
+    cfloat a = z[k];
+    cfloat b = { z[m - k].re, -z[m - k].im };
+    cfloat e = { 0.5f * (a.re + b.re), 0.5f * (a.im + b.im) };
+    cfloat d = { a.re - b.re, a.im - b.im };
+    cfloat t = __dct_rotate(d, plan->pair[k]);
+    cfloat p = { e.re + t.re, e.im + t.im };
+    cfloat u = { e.re - t.re, t.im - e.im };
+    p = __dct_rotate(p, w[k]);
+    u = __dct_rotate(u, w[m - k]);
+    dst[k] = p.re;
+    dst[n - k] = -p.im;
+    dst[m - k] = u.re;
+    dst[m + k] = -u.im;
+  }
+  __dct_release(buf, z);
+}
+
+void cam_idct(cam_dct_plan* plan, float* dst, float* src) {
+  size_t n = plan->n, m = n / 2, q = m / 2;
+  cfloat buf[__DCT_STACK / 2];
+  cfloat* z = __dct_work(buf, n);
+  if (!z) {
+    __dct_fail(dst, n);
+    return;
+  }
+
+  // V[0] = X[0] and V[m] = sqrt(2) X[m] are real
+  const cfloat* w = plan->twiddle;
+  float v0 = src[0], vm = 2.0f * src[m] * w[m].re;
+  z[0] = cfloat_make(0.5f * (v0 + vm), 0.5f * (v0 - vm));
+  size_t k = 1;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  __m256 half = _mm256_set1_ps(0.5f);
+  for (; k + 4 <= q; k += 4) {
+    // Registers of X[k] + i X[n - k], and the same from r
+    size_t r = m - k - 3;
+    __m256 c = _mm256_permutevar8x32_ps(__dct_load_halves(src + k, src + n - k - 3), __DCT_MERGE);
+    __m256 d = _mm256_permutevar8x32_ps(__dct_load_halves(src + r, src + n - r - 3), __DCT_MERGE);
+    __m256 a = __complex_conj(__complex_mul(c, _mm256_loadu_ps((const float*)(w + k))));
+    __m256 b = __dct_reverse(__complex_mul(d, _mm256_loadu_ps((const float*)(w + r))));
+    __m256 e = _mm256_mul_ps(_mm256_add_ps(a, b), half);
+    __m256 t = __complex_mul(_mm256_sub_ps(a, b), __complex_conj(_mm256_loadu_ps((const float*)(plan->pair + k))));
+    _mm256_storeu_ps((float*)(z + k), _mm256_add_ps(e, t));
+    _mm256_storeu_ps((float*)(z + r), __complex_conj(__dct_reverse(_mm256_sub_ps(e, t))));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; k <= q; ++k) {
+    cfloat a = { (src[k] * w[k].re) - (src[n - k] * w[k].im), -(src[k] * w[k].im) - (src[n - k] * w[k].re) };
+    cfloat b = { (src[m - k] * w[m - k].re) - (src[m + k] * w[m - k].im), (src[m - k] * w[m - k].im) + (src[m + k] * w[m - k].re) };
+    cfloat c = { plan->pair[k].re, -plan->pair[k].im };
+    cfloat e = { 0.5f * (a.re + b.re), 0.5f * (a.im + b.im) };
+    cfloat d = { a.re - b.re, a.im - b.im };
+    cfloat t = __dct_rotate(d, c);
+    z[k].re = e.re + t.re;
+    z[k].im = e.im + t.im;
+    z[m - k].re = e.re - t.re;
+    z[m - k].im = t.im - e.im;
+  }
+  cam_fft_inverse(plan->half, z, z);
+
+  const float* v = (const float*)z;
+  size_t j = 0;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  for (; j + 4 <= m; j += 4) {
+    _mm256_storeu_ps(dst + (2 * j), _mm256_permutevar8x32_ps(__dct_load_halves(v + j, v + n - 4 - j), __DCT_MERGE));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; j < m; ++j) {
+    dst[2 * j] = v[j];
+    dst[(2 * j) + 1] = v[n - 1 - j];
+  }
+  __dct_release(buf, z);
+}
+
+void cam_mdct(cam_mdct_plan* plan, float* dst, float* src) {
+  size_t n = plan->n, m = n / 2;
+  cfloat buf[__DCT_STACK / 2];
+  cfloat* z = __dct_work(buf, n);
+  if (!z) {
+    __dct_fail(dst, n);
+    return;
+  }
+  for (size_t j = 0; j < m; ++j) {
+    cfloat u = { __mdct_fold(src, n, 2 * j), __mdct_fold(src, n, n - 1 - (2 * j)) };
+    z[j] = __dct_rotate(u, plan->pre[j]);
+  }
+  cam_fft_forward(plan->half, z, z);
+  for (size_t k = 0; k < m; ++k) {
+    cfloat y = __dct_rotate(z[k], plan->post[k]);
+    dst[2 * k] = y.re;
+    dst[n - 1 - (2 * k)] = -y.im;
+  }
+  __dct_release(buf, z);
+}
+
+// Output value i of the DCT-IV lands at n + h - 1 - i negated, and at n + h + i
+// negated or i - h as is
+void cam_imdct(cam_mdct_plan* plan, float* dst, float* src) {
+  size_t n = plan->n, m = n / 2, h = n / 2;
+  cfloat buf[__DCT_STACK / 2];
+  cfloat* z = __dct_work(buf, n);
+  if (!z) {
+    __dct_fail(dst, 2 * n);
+    return;
+  }
+  for (size_t j = 0; j < m; ++j) {
+    cfloat u = { src[2 * j], src[n - 1 - (2 * j)] };
+    z[j] = __dct_rotate(u, plan->pre[j]);
+  }
+  cam_fft_forward(plan->half, z, z);
+  float scale = 2.0f / (float)n;
+  for (size_t k = 0; k < m; ++k) {
+    cfloat y = __dct_rotate(z[k], plan->post[k]);
+    size_t i0 = 2 * k, i1 = n - 1 - (2 * k);
+    float w0 = scale * y.re, w1 = -scale * y.im;
+    dst[n + h - 1 - i0] = -w0;
+    dst[n + h - 1 - i1] = -w1;
+    if (i0 < h) { dst[n + h + i0] = -w0; }
+    else { dst[i0 - h] = w0; }
+    if (i1 < h) { dst[n + h + i1] = -w1; }
+    else { dst[i1 - h] = w1; }
+  }
+  __dct_release(buf, z);
+}
+
+
+/* Batch functions */
+void cam_dct8x8_many(float* dst, float* src, size_t count) {
+  float rows[64];
+  for (size_t j = 0; j < 8; ++j) {
+    for (size_t k = 0; k < 8; ++k) { rows[(8 * j) + k] = __dct8_cos[k][j]; }
+  }
+  __dct8x8(dst, src, count, rows, (const float*)__dct8_cos);
+}
+
+// M is the DCT-III matrix, M[j][k] = s_k cos(pi (2j + 1) k / 16) with s_0 = 1 / 8
+// and s_k = 2 / 8 otherwise
+void cam_idct8x8_many(float* dst, float* src, size_t count) {
+  float rows[64], cols[64];
+  for (size_t j = 0; j < 8; ++j) {
+    float s = (j == 0) ? 0.125f : 0.25f;
+    for (size_t k = 0; k < 8; ++k) {
+      rows[(8 * j) + k] = s * __dct8_cos[j][k];
+      cols[(8 * k) + j] = s * __dct8_cos[j][k];
+    }
+  }
+  __dct8x8(dst, src, count, rows, cols);
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * fft.h
+ * Declaration for complex single precision fast fourier transforms.
+ */
+
+#ifndef CAM_FOURIER_FFT_H
+#define CAM_FOURIER_FFT_H
+
+#include "cam/fourier/fourier_common.h"
+
+/* Six-step threshold */
+// Transforms of 2^CAM_FFT_SIX_STEP_LOG2 points and more, sizes whose data no longer fits
+// in cache, use the six-step decomposition n = n1 n2: blocked transposes around two
+// rounds of short transforms that each fit in cache, spread over the threads of
+// cam/thread.h. Smaller values than 16 are raised to 16.
+#ifndef CAM_FFT_SIX_STEP_LOG2
+#define CAM_FFT_SIX_STEP_LOG2 20
+#endif
+
+
+/* Define cam_fft_strategy enum */
+// How a plan computes its transform, chosen by cam_fft_plan_make from the size
+typedef enum {
+  CAM_FFT_RADIX4 = 0,    // Powers of two: radix-4 passes, and one radix-2 pass for odd powers
+  CAM_FFT_SIX_STEP,      // Powers of two from 2^CAM_FFT_SIX_STEP_LOG2: the six-step decomposition
+  CAM_FFT_MIXED_RADIX,   // Other sizes whose prime factors are all 2, 3, 5 or 7: a pass per factor
+  CAM_FFT_BLUESTEIN,     // Sizes with a prime factor above 7: a chirp-z convolution of
+                         // power of two transforms of at least 2n - 1 points
+  CAM_FFT_CODELET        // Small sizes in library builds: a straight-line transform generated
+                         // at build time, for every size up to 64 whose prime factors are at most 7
+} cam_fft_strategy;
+
+
+/* Define cam_fft_plan struct */
+// Everything a transform of one size needs, computed once by cam_fft_plan_make.
+// Transforms only read the plan, so one plan can be shared by any number of threads.
+typedef struct cam_fft_plan {
+  size_t n;                   // Transform size
+  cam_fft_strategy strategy;  // How the transform is computed
+  uint32_t* perm;             // Input permutation (bit or digit reversal), NULL for six-step and Bluestein
+  uint32_t* cycles;           // Mixed-radix permutation as cycles for in place transforms, else NULL
+  cfloat* twiddle;            // Twiddle factors of every pass, in the order the passes read them,
+                              // or the two tables the six-step twiddles are products of,
+                              // or the Bluestein chirp followed by the transformed filter
+  struct cam_fft_plan* cols;  // Six-step plans for the n1 point transforms of the columns
+  struct cam_fft_plan* rows;  // and the n2 point transforms of the rows, NULL below the threshold
+  struct cam_fft_plan* sub;   // Bluestein plan of the convolution size, else NULL
+  size_t passes;              // Mixed-radix passes, and the radix of each in the order they run
+  unsigned char radix[32];
+} cam_fft_plan;
+
+
+/* Define cam_fft_wisdom struct */
+// A wisdom file mapped read-only into memory. Plans taken from it point into the
+// mapping instead of building their tables, so they must be freed before it is closed.
+typedef struct {
+  const unsigned char* data;  // File contents
+  size_t size;                // File size in bytes
+  void* handle;               // Mapping handle, where the platform has one
+} cam_fft_wisdom;
+
+
+/* cam_fft_plan functions */
+// Plans a transform of any size from 1 to 2^31, picking the strategy from the size and
+// the SIMD tier: codelets run every size they cover on the scalar tier, and below 16
+// points on the others, where the vectorized passes are faster from there up.
+// Returns NULL if n is out of range, n has a prime factor above 7 and is over 2^30,
+// or allocation fails.
+CAM_FOURIER_API cam_fft_plan* cam_fft_plan_make(size_t n);
+
+CAM_FOURIER_API void cam_fft_plan_free(cam_fft_plan* plan);
+
+// Writes a description of the strategy of plan, such as "mixed-radix 4 x 2 x 5 x 5 x 5",
+// to buf like snprintf, returning the length the full description needs
+CAM_FOURIER_API int cam_fft_plan_describe(cam_fft_plan* plan, char* buf, size_t size);
+
+
+/* Transform functions */
+// dst[k] = sum over j of src[j] e^(-2 pi i jk / n). src and dst hold plan->n values;
+// dst == src transforms in place, otherwise src is left unchanged and the two must not overlap.
+// Neither evaluates trigonometric functions, and only Bluestein plans allocate memory:
+// working space of cam_fft_plan_scratch_size values per call, without which dst is
+// filled with NaN. The _scratch variants below take that space from the caller instead.
+// Six-step sizes, and Bluestein sizes whose convolution is six-step, run on the thread pool.
+CAM_FOURIER_API void cam_fft_forward(cam_fft_plan* plan, cfloat* dst, cfloat* src);
+
+// dst[j] = (1 / n) sum over k of src[k] e^(2 pi i jk / n), undoing cam_fft_forward
+CAM_FOURIER_API void cam_fft_inverse(cam_fft_plan* plan, cfloat* dst, cfloat* src);
+
+// Values of working space the transforms of plan need: up to twice the convolution
+// size for Bluestein plans, 0 for every other strategy
+CAM_FOURIER_API size_t cam_fft_plan_scratch_size(cam_fft_plan* plan);
+
+// cam_fft_forward and cam_fft_inverse with work, CAM_SIMD_ALIGN aligned and holding
+// cam_fft_plan_scratch_size(plan) values, as working space, so they never allocate.
+// work may be NULL when the size is 0. A thread may reuse its work for any number of
+// calls, but threads transforming at the same time each need their own.
+CAM_FOURIER_API void cam_fft_forward_scratch(cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work);
+CAM_FOURIER_API void cam_fft_inverse_scratch(cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work);
+
+
+/* Batch functions */
+// Transforms src->count / plan->n signals of plan->n values, stored interleaved by
+// signal so that value k of signal s is at index k * signals + s and consecutive
+// signals fill a vector register. dst holds as many values as src and may be src.
+// Sizes with a codelet run it on 8 signals at a time with AVX2 (4 with SSE4.1),
+// whatever the plan's strategy. Other sizes, and CAM_HEADER_ONLY builds, copy the
+// signals out to transform them, allocating working space of cam_fft_many_scratch_size
+// values per call, without which dst is filled with NaN.
+CAM_FOURIER_API void cam_fft_many(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src);
+
+// cam_fft_inverse of every signal, undoing cam_fft_many
+CAM_FOURIER_API void cam_ifft_many(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src);
+
+// Values of working space the batches of plan need: 64 plan->n plus
+// cam_fft_plan_scratch_size(plan) when signals are copied out, 0 with a codelet
+CAM_FOURIER_API size_t cam_fft_many_scratch_size(cam_fft_plan* plan);
+
+// cam_fft_many and cam_ifft_many with work, CAM_SIMD_ALIGN aligned and holding
+// cam_fft_many_scratch_size(plan) values, as working space, so they never allocate.
+// work may be NULL when the size is 0.
+CAM_FOURIER_API void cam_fft_many_scratch(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work);
+CAM_FOURIER_API void cam_ifft_many_scratch(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work);
+
+
+/* Wisdom functions */
+// Wisdom files hold the strategy and every table of a set of plans, stamped with
+// CAM_VERSION and the SIMD tier the transforms run on, so short-lived programs can
+// map them at startup rather than time strategies and evaluate twiddles again.
+
+// Builds each strategy able to transform n points (the direct or mixed-radix passes,
+// the codelet for sizes that have one, and the six-step path from 2^16 up), times a
+// few transforms of each and returns the fastest. Other sizes have one strategy,
+// so this is cam_fft_plan_make for them.
+CAM_FOURIER_API cam_fft_plan* cam_fft_plan_tune(size_t n);
+
+// Writes count plans to a wisdom file at path, replacing it. Only radix-4 and six-step
+// plans are stored; the others are cheap to make and are skipped. Returns false if the
+// file cannot be written.
+CAM_FOURIER_API bool cam_fft_wisdom_save(const char* path, cam_fft_plan** plans, size_t count);
+
+// Maps the wisdom file at path. Returns NULL if it is missing or damaged, or was
+// written by another library version or for another SIMD tier.
+CAM_FOURIER_API cam_fft_wisdom* cam_fft_wisdom_load(const char* path);
+
+// Plan for n from the wisdom when it holds one, without copying or computing any
+// table; otherwise, or when w is NULL, cam_fft_plan_make(n).
+CAM_FOURIER_API cam_fft_plan* cam_fft_wisdom_plan(cam_fft_wisdom* w, size_t n);
+
+// Unmaps the wisdom; every plan taken from it must already be freed
+CAM_FOURIER_API void cam_fft_wisdom_close(cam_fft_wisdom* w);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/fft.inl"
+#endif
+
+#endif
@@ -0,0 +1,1683 @@
+/*
+ * fft.inl
+ * Definitions for complex single precision fast fourier transforms.
+ * Compiled by src/fourier/fft.c, or included by fft.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_FFT_INL
+#define CAM_FOURIER_FFT_INL
+
+#include "cam/fourier/fft.h"
+#include "cam/cpu.h"
+#include "cam/thread.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// Wisdom files are mapped into memory
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* fft helpers */
+// The transform is decimation in time over bit reversed input. Pairs of radix-2
+// passes are merged into radix-4 passes: a pass with quarter span h combines blocks
+// of 4h values, the value at j + qh of a block taking twiddle w^(t_q j) with
+// w = e^(-2 pi i / 4h) and t = (0, 2, 1, 3), the order the bit reversal leaves them
+// in. Odd powers of two end with one radix-2 pass of span n / 2.
+//
+// Twiddles of a radix-4 pass are stored in groups of four j: w^2j for the group,
+// then w^j, then w^3j, so a register of 2 or 4 values loads each from one place.
+// The first pass (h = 1) needs none.
+
+// Sizes below this run the scalar passes, which have no minimum
+#define __FFT_MIN_SIMD 16
+
+static inline size_t __fft_twiddle_index(size_t j) {
+  return ((j >> 2) * 12) + (j & 3);
+}
+
+static inline cfloat __fft_cmul(cfloat a, cfloat b) {
+  cfloat r = { (a.re * b.re) - (a.im * b.im), (a.re * b.im) + (a.im * b.re) };
+  return r;
+}
+
+// One radix-4 butterfly over p[0], p[h], p[2h], p[3h]. rs is -1 going forward and
+// 1 going backward, the sign of i in the rotation applied to the odd difference.
+static inline void __fft_bfly4(cfloat* p, size_t h, cfloat t1, cfloat t2, cfloat t3, float rs, float scale) {
+  cfloat x0 = { p[0].re * scale, p[0].im * scale };
+  cfloat x1 = { p[h].re * scale, p[h].im * scale };
+  cfloat x2 = { p[2 * h].re * scale, p[2 * h].im * scale };
+  cfloat x3 = { p[3 * h].re * scale, p[3 * h].im * scale };
+  x1 = __fft_cmul(x1, t1);
+  x2 = __fft_cmul(x2, t2);
+  x3 = __fft_cmul(x3, t3);
+  cfloat s0 = { x0.re + x1.re, x0.im + x1.im };
+  cfloat d0 = { x0.re - x1.re, x0.im - x1.im };
+  cfloat s1 = { x2.re + x3.re, x2.im + x3.im };
+  cfloat d1 = { -rs * (x2.im - x3.im), rs * (x2.re - x3.re) };
+  p[0].re = s0.re + s1.re;
+  p[0].im = s0.im + s1.im;
+  p[h].re = d0.re + d1.re;
+  p[h].im = d0.im + d1.im;
+  p[2 * h].re = s0.re - s1.re;
+  p[2 * h].im = s0.im - s1.im;
+  p[3 * h].re = d0.re - d1.re;
+  p[3 * h].im = d0.im - d1.im;
+}
+
+// Radix-4 pass of quarter span h over x[0 .. n), scaling the inputs by scale
+static void __fft_pass4_scalar(cfloat* x, size_t n, size_t h, const cfloat* tw, bool inverse, float scale) {
+  float rs = inverse ? 1.0f : -1.0f;
+  float ts = inverse ? -1.0f : 1.0f;
+  cfloat one = { 1.0f, 0.0f };
+  for (size_t b = 0; b < n; b += 4 * h) {
+    for (size_t j = 0; j < h; ++j) {
+      cfloat t1 = one, t2 = one, t3 = one;
+      if (tw) {
+        const cfloat* t = tw + __fft_twiddle_index(j);
+        t1.re = t[0].re;
+        t1.im = ts * t[0].im;
+        t2.re = t[4].re;
+        t2.im = ts * t[4].im;
+        t3.re = t[8].re;
+        t3.im = ts * t[8].im;
+      }
+      __fft_bfly4(x + b + j, h, t1, t2, t3, rs, scale);
+    }
+  }
+}
+
+// Radix-2 pass of span h = n / 2
+static void __fft_pass2_scalar(cfloat* x, size_t n, const cfloat* tw, bool inverse, float scale) {
+  size_t h = n / 2;
+  float ts = inverse ? -1.0f : 1.0f;
+  for (size_t j = 0; j < h; ++j) {
+    cfloat t = { tw[j].re, ts * tw[j].im };
+    cfloat a = { x[j].re * scale, x[j].im * scale };
+    cfloat b = { x[j + h].re * scale, x[j + h].im * scale };
+    b = __fft_cmul(b, t);
+    x[j].re = a.re + b.re;
+    x[j].im = a.im + b.im;
+    x[j + h].re = a.re - b.re;
+    x[j + h].im = a.im - b.im;
+  }
+}
+
+#if defined(CAM_SIMD_AVX)
+// Registers hold __FFT_V interleaved values
+#if defined(CAM_SIMD_AVX2)
+#define __FFT_V 4
+#else
+#define __FFT_V 2
+#endif
+#define __fft_load(p) __soa_loadu((const float*)(p))
+#define __fft_store(p, v) __soa_storeu((float*)(p), v)
+
+// Copies of the value at p in every position of a register
+#if defined(CAM_SIMD_AVX2)
+#define __fft_splat(p) _mm256_castpd_ps(_mm256_broadcast_sd((const double*)(p)))
+#else
+#define __fft_splat(p) _mm_castpd_ps(_mm_loaddup_pd((const double*)(p)))
+#endif
+
+// Masks conjugating the twiddles and rotating by -i (forward) or i (inverse)
+static inline void __fft_masks(bool inverse, __soa_vec* conj, __soa_vec* rot) {
+  __soa_vec negim = __complex_conj(__soa_set1(0.0f));
+  *conj = inverse ? negim : __soa_set1(0.0f);
+  *rot = inverse ? __complex_swap(negim) : negim;
+}
+
+// Exchanges value k of register r for value r of register k, treating the
+// registers as a square of values; the same shuffle undoes itself
+#if defined(CAM_SIMD_AVX2)
+static inline void __fft_transpose(__m256* v0, __m256* v1, __m256* v2, __m256* v3) {
+  __m256d t0 = _mm256_unpacklo_pd(_mm256_castps_pd(*v0), _mm256_castps_pd(*v1));
+  __m256d t1 = _mm256_unpackhi_pd(_mm256_castps_pd(*v0), _mm256_castps_pd(*v1));
+  __m256d t2 = _mm256_unpacklo_pd(_mm256_castps_pd(*v2), _mm256_castps_pd(*v3));
+  __m256d t3 = _mm256_unpackhi_pd(_mm256_castps_pd(*v2), _mm256_castps_pd(*v3));
+  *v0 = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x20));
+  *v1 = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x20));
+  *v2 = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x31));
+  *v3 = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x31));
+}
+#else
+static inline void __fft_transpose(__m128* v0, __m128* v1) {
+  __m128d t0 = _mm_unpacklo_pd(_mm_castps_pd(*v0), _mm_castps_pd(*v1));
+  __m128d t1 = _mm_unpackhi_pd(_mm_castps_pd(*v0), _mm_castps_pd(*v1));
+  *v0 = _mm_castpd_ps(t0);
+  *v1 = _mm_castpd_ps(t1);
+}
+#endif
+
+// Radix-4 butterfly on registers, outputs replacing inputs in order
+static inline void __fft_bfly4v(__soa_vec* x0, __soa_vec* x1, __soa_vec* x2, __soa_vec* x3, __soa_vec rot) {
+  __soa_vec s0 = __soa_add(*x0, *x1);
+  __soa_vec d0 = __soa_sub(*x0, *x1);
+  __soa_vec s1 = __soa_add(*x2, *x3);
+  __soa_vec d1 = __soa_xor(__complex_swap(__soa_sub(*x2, *x3)), rot);
+  *x0 = __soa_add(s0, s1);
+  *x1 = __soa_add(d0, d1);
+  *x2 = __soa_sub(s0, s1);
+  *x3 = __soa_sub(d0, d1);
+}
+
+// First radix-4 pass (h = 1), which needs no twiddles. __FFT_V blocks of four are
+// transposed so each register holds the same position of every block.
+static void __fft_pass4_first(cfloat* x, size_t n, bool inverse, float scale) {
+  __soa_vec conj, rot;
+  __fft_masks(inverse, &conj, &rot);
+  __soa_vec s = __soa_set1(scale);
+  for (size_t b = 0; b < n; b += 4 * __FFT_V) {
+#if defined(CAM_SIMD_AVX2)
+    __soa_vec x0 = __soa_mul(__fft_load(x + b), s);
+    __soa_vec x1 = __soa_mul(__fft_load(x + b + 4), s);
+    __soa_vec x2 = __soa_mul(__fft_load(x + b + 8), s);
+    __soa_vec x3 = __soa_mul(__fft_load(x + b + 12), s);
+    __fft_transpose(&x0, &x1, &x2, &x3);
+    __fft_bfly4v(&x0, &x1, &x2, &x3, rot);
+    __fft_transpose(&x0, &x1, &x2, &x3);
+    __fft_store(x + b, x0);
+    __fft_store(x + b + 4, x1);
+    __fft_store(x + b + 8, x2);
+    __fft_store(x + b + 12, x3);
+#else
+    // Two blocks: a0 a1 | a2 a3 and b0 b1 | b2 b3
+    __soa_vec x0 = __soa_mul(__fft_load(x + b), s);
+    __soa_vec x2 = __soa_mul(__fft_load(x + b + 2), s);
+    __soa_vec x1 = __soa_mul(__fft_load(x + b + 4), s);
+    __soa_vec x3 = __soa_mul(__fft_load(x + b + 6), s);
+    __fft_transpose(&x0, &x1);
+    __fft_transpose(&x2, &x3);
+    __fft_bfly4v(&x0, &x1, &x2, &x3, rot);
+    __fft_transpose(&x0, &x1);
+    __fft_transpose(&x2, &x3);
+    __fft_store(x + b, x0);
+    __fft_store(x + b + 2, x2);
+    __fft_store(x + b + 4, x1);
+    __fft_store(x + b + 6, x3);
+#endif
+  }
+}
+
+// Radix-4 pass of quarter span h >= 4
+static void __fft_pass4(cfloat* x, size_t n, size_t h, const cfloat* tw, bool inverse) {
+  __soa_vec conj, rot;
+  __fft_masks(inverse, &conj, &rot);
+  for (size_t b = 0; b < n; b += 4 * h) {
+    for (size_t j = 0; j < h; j += __FFT_V) {
+      cfloat* p = x + b + j;
+      const cfloat* t = tw + __fft_twiddle_index(j);
+      __soa_vec x0 = __fft_load(p);
+      __soa_vec x1 = __complex_mul(__fft_load(p + h), __soa_xor(__fft_load(t), conj));
+      __soa_vec x2 = __complex_mul(__fft_load(p + 2 * h), __soa_xor(__fft_load(t + 4), conj));
+      __soa_vec x3 = __complex_mul(__fft_load(p + 3 * h), __soa_xor(__fft_load(t + 8), conj));
+      __fft_bfly4v(&x0, &x1, &x2, &x3, rot);
+      __fft_store(p, x0);
+      __fft_store(p + h, x1);
+      __fft_store(p + 2 * h, x2);
+      __fft_store(p + 3 * h, x3);
+    }
+  }
+}
+
+// Radix-2 pass of span h = n / 2
+static void __fft_pass2(cfloat* x, size_t n, const cfloat* tw, bool inverse) {
+  __soa_vec conj, rot;
+  __fft_masks(inverse, &conj, &rot);
+  size_t h = n / 2;
+  for (size_t j = 0; j < h; j += __FFT_V) {
+    __soa_vec a = __fft_load(x + j);
+    __soa_vec b = __complex_mul(__fft_load(x + j + h), __soa_xor(__fft_load(tw + j), conj));
+    __fft_store(x + j, __soa_add(a, b));
+    __fft_store(x + j + h, __soa_sub(a, b));
+  }
+}
+#endif
+
+// Reorders src into dst by the bit reversal permutation, then runs every pass in dst,
+// scaling the values by scale
+static void __fft_direct(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, float scale) {
+  size_t n = plan->n;
+  const uint32_t* perm = plan->perm;
+  if (dst == src) {
+    // Selects rather than branches: whether i < perm[i] is unpredictable, and when
+    // it is not, both values are written back unchanged
+    for (size_t i = 0; i < n; ++i) {
+      size_t j = perm[i];
+      cfloat a = dst[i], b = dst[j];
+      bool swap = i < j;
+      dst[i] = swap ? b : a;
+      dst[j] = swap ? a : b;
+    }
+  }
+  else {
+    for (size_t i = 0; i < n; ++i) {
+      dst[i] = src[perm[i]];
+    }
+  }
+
+  // The scale is folded into the first pass
+  const cfloat* tw = plan->twiddle;
+  size_t h = 1;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  if (n >= __FFT_MIN_SIMD) {
+    __fft_pass4_first(dst, n, inverse, scale);
+    for (h = 4; 4 * h <= n; h *= 4) {
+      __fft_pass4(dst, n, h, tw, inverse);
+      tw += 3 * h;
+    }
+    if (h < n) { __fft_pass2(dst, n, tw, inverse); }
+    return;
+  }
+#endif
+  // No SIMD intrinsics
+  for (; 4 * h <= n; h *= 4) {
+    __fft_pass4_scalar(dst, n, h, (h == 1) ? NULL : tw, inverse, scale);
+    if (h > 1) { tw += 3 * h; }
+    scale = 1.0f;
+  }
+  if (h < n) { __fft_pass2_scalar(dst, n, tw, inverse, scale); }
+}
+
+
+/* six-step helpers */
+// With n = n1 n2, x[j1 n2 + j2] read as an n1 x n2 matrix A and k = k1 + n1 k2,
+//   X[k] = sum over j2 of w_n2^(j2 k2) w_n^(j2 k1) (sum over j1 of A[j1][j2] w_n1^(j1 k1)).
+// The columns are transposed into rows, each row j2 transformed and scaled by
+// w_n^(j2 k1), the result transposed back and its rows transformed, and a last
+// transpose puts X in order. n1 is n2 or 2 n2, so every transpose is of a square or
+// of two stacked squares, and all of it runs in place in dst.
+//
+// The twiddle w_n^t, t = j2 k1 < n, is the product of table entries w_n^(t mod s) and
+// w_n^(s floor(t / s)) for s = 2^ceil(log2(n) / 2), keeping the tables small.
+
+#define __FFT_TILE 8    // Transposes move tiles of __FFT_TILE x __FFT_TILE values
+#define __FFT_BAND 64   // Rows written by one task of an out of place transpose
+
+// Arguments shared by the six-step tasks
+typedef struct {
+  const cam_fft_plan* plan;   // Plan of the rows being transformed
+  const cfloat* lo;           // Six-step twiddle tables, NULL to skip the twiddles
+  const cfloat* hi;
+  size_t lo_bits;
+  cfloat* x;                  // Matrix worked on, in place
+  const cfloat* src;          // Source of an out of place transpose
+  size_t rows, cols;          // Matrix shape; squares are cols x cols
+  size_t mul;                 // Block shuffle: block b moves to b mul mod (2 cols - 1)
+  bool inverse;
+  float scale;
+} __fft_six_job;
+
+#if defined(CAM_SIMD_AVX)
+// Register block of __FFT_V x __FFT_V values, spelled out so the registers never
+// go through memory
+typedef struct {
+#if defined(CAM_SIMD_AVX2)
+  __soa_vec r0, r1, r2, r3;
+#else
+  __soa_vec r0, r1;
+#endif
+} __fft_block;
+
+// Loads the block at p, rows ld apart, as the registers of its transpose
+static inline __fft_block __fft_block_load(const cfloat* p, size_t ld) {
+  __fft_block v;
+  v.r0 = __fft_load(p);
+  v.r1 = __fft_load(p + ld);
+#if defined(CAM_SIMD_AVX2)
+  v.r2 = __fft_load(p + (2 * ld));
+  v.r3 = __fft_load(p + (3 * ld));
+  __fft_transpose(&v.r0, &v.r1, &v.r2, &v.r3);
+#else
+  __fft_transpose(&v.r0, &v.r1);
+#endif
+  return v;
+}
+
+static inline void __fft_block_store(cfloat* p, size_t ld, __fft_block v) {
+  __fft_store(p, v.r0);
+  __fft_store(p + ld, v.r1);
+#if defined(CAM_SIMD_AVX2)
+  __fft_store(p + (2 * ld), v.r2);
+  __fft_store(p + (3 * ld), v.r3);
+#endif
+}
+#endif
+
+// Exchanges the tile at a with the transpose of the tile at b; a == b transposes one tile
+static inline void __fft_tile_swap(cfloat* a, cfloat* b, size_t ld) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (size_t i = 0; i < __FFT_TILE; i += __FFT_V) {
+    for (size_t j = (a == b) ? i : 0; j < __FFT_TILE; j += __FFT_V) {
+      __fft_block va = __fft_block_load(a + (i * ld) + j, ld);
+      __fft_block vb = __fft_block_load(b + (j * ld) + i, ld);
+      __fft_block_store(a + (i * ld) + j, ld, vb);
+      __fft_block_store(b + (j * ld) + i, ld, va);
+    }
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < __FFT_TILE; ++i) {
+    for (size_t j = (a == b) ? i + 1 : 0; j < __FFT_TILE; ++j) {
+      cfloat t = a[(i * ld) + j];
+      a[(i * ld) + j] = b[(j * ld) + i];
+      b[(j * ld) + i] = t;
+    }
+  }
+#endif
+}
+
+// Writes the transpose of the tile at src, rows lds apart, to dst, rows ldd apart
+static inline void __fft_tile_copy(cfloat* dst, size_t ldd, const cfloat* src, size_t lds) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (size_t i = 0; i < __FFT_TILE; i += __FFT_V) {
+    for (size_t j = 0; j < __FFT_TILE; j += __FFT_V) {
+      __fft_block_store(dst + (j * ldd) + i, ldd, __fft_block_load(src + (i * lds) + j, lds));
+    }
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t j = 0; j < __FFT_TILE; ++j) {
+    for (size_t i = 0; i < __FFT_TILE; ++i) {
+      dst[(j * ldd) + i] = src[(i * lds) + j];
+    }
+  }
+#endif
+}
+
+// Transposes cols x cols squares in place, one tile row per task index. Matrices of
+// two squares stack them one after the other.
+static void __fft_square_task(void* arg, size_t begin, size_t end) {
+  __fft_six_job* job = (__fft_six_job*)arg;
+  size_t s = job->cols;
+  size_t tiles = s / __FFT_TILE;
+  for (size_t t = begin; t < end; ++t) {
+    cfloat* m = job->x + ((t / tiles) * s * s);
+    size_t i = (t % tiles) * __FFT_TILE;
+    for (size_t j = i; j < s; j += __FFT_TILE) {
+      __fft_tile_swap(m + (i * s) + j, m + (j * s) + i, s);
+    }
+  }
+}
+
+// Moves the 2 cols blocks of cols values each to position b mul mod (2 cols - 1).
+// Multiplying by 2 modulo 2^k - 1 has order dividing k, so the cycles are short; each
+// is rotated by its smallest block, with block swaps so no buffer is needed.
+static void __fft_shuffle_task(void* arg, size_t begin, size_t end) {
+  __fft_six_job* job = (__fft_six_job*)arg;
+  size_t s = job->cols;
+  size_t mod = (2 * s) - 1;
+  for (size_t b = begin + 1; b < end + 1; ++b) {
+    size_t c = (b * job->mul) % mod;
+    while (c > b) { c = (c * job->mul) % mod; }
+    if (c < b) { continue; }
+
+    // Swapping block b with each later member of its cycle in turn rotates it
+    cfloat* lead = job->x + (b * s);
+    for (c = (b * job->mul) % mod; c != b; c = (c * job->mul) % mod) {
+      cfloat* other = job->x + (c * s);
+      for (size_t i = 0; i < s; ++i) {
+        cfloat t = lead[i];
+        lead[i] = other[i];
+        other[i] = t;
+      }
+    }
+  }
+}
+
+// Transposes the rows x cols matrix src into dst, one band of __FFT_BAND rows of dst
+// per task index, so each task writes one contiguous range
+static void __fft_copy_task(void* arg, size_t begin, size_t end) {
+  __fft_six_job* job = (__fft_six_job*)arg;
+  size_t rows = job->rows, cols = job->cols;
+  for (size_t j = begin * __FFT_BAND; j < end * __FFT_BAND; j += __FFT_TILE) {
+    for (size_t i = 0; i < rows; i += __FFT_TILE) {
+      __fft_tile_copy(job->x + (j * rows) + i, rows, job->src + (i * cols) + j, cols);
+    }
+  }
+}
+
+// Transforms rows of job->cols values in place, then scales row r by w_n^(r k) when
+// job->lo is set
+static void __fft_rows_task(void* arg, size_t begin, size_t end) {
+  __fft_six_job* job = (__fft_six_job*)arg;
+  size_t len = job->cols;
+  size_t mask = ((size_t)1 << job->lo_bits) - 1;
+  float cs = job->inverse ? -1.0f : 1.0f;
+  for (size_t r = begin; r < end; ++r) {
+    cfloat* x = job->x + (r * len);
+    __fft_direct(job->plan, x, x, job->inverse, 1.0f);
+    if (!job->lo) { continue; }
+    size_t k = 0;
+#if defined(CAM_SIMD_AVX)
+    // Intel AVX
+    // w^(r k) for k = 0 .. __FFT_V - 1, times the scale, then one scalar table
+    // product per register for w^(r k) at the start of each
+    cfloat steps[__FFT_V];
+    for (size_t l = 0; l < __FFT_V; ++l) {
+      size_t t = r * l;
+      cfloat w = __fft_cmul(job->lo[t & mask], job->hi[t >> job->lo_bits]);
+      steps[l] = cfloat_make(w.re * job->scale, w.im * job->scale);
+    }
+    __soa_vec conj = job->inverse ? __complex_conj(__soa_set1(0.0f)) : __soa_set1(0.0f);
+    __soa_vec step = __soa_xor(__fft_load(steps), conj);
+    for (; k < len; k += __FFT_V) {
+      size_t t = r * k;
+      cfloat w = __fft_cmul(job->lo[t & mask], job->hi[t >> job->lo_bits]);
+      __soa_vec tw = __complex_mul(__soa_xor(__fft_splat(&w), conj), step);
+      __fft_store(x + k, __complex_mul(__fft_load(x + k), tw));
+    }
+#endif
+    // No SIMD intrinsics
+    for (; k < len; ++k) {
+      size_t t = r * k;
+      cfloat w = __fft_cmul(job->lo[t & mask], job->hi[t >> job->lo_bits]);
+      w.re *= job->scale;
+      w.im *= cs * job->scale;
+      x[k] = __fft_cmul(x[k], w);
+    }
+  }
+}
+
+// Transposes the rows x cols matrix x in place, for rows and cols a square's side
+// or twice it. Two stacked squares are transposed each and their rows interleaved;
+// two squares side by side are first separated and then transposed.
+static void __fft_transpose_matrix(cfloat* x, size_t rows, size_t cols) {
+  __fft_six_job job;
+  memset(&job, 0, sizeof(job));
+  size_t s = (rows < cols) ? rows : cols;
+  job.x = x;
+  job.cols = s;
+  if (rows < cols) {
+    job.mul = s;
+    cam_parallel_for((2 * s) - 2, __fft_shuffle_task, &job);
+  }
+  cam_parallel_for(((rows == cols) ? 1 : 2) * (s / __FFT_TILE), __fft_square_task, &job);
+  if (rows > cols) {
+    job.mul = 2;
+    cam_parallel_for((2 * s) - 2, __fft_shuffle_task, &job);
+  }
+}
+
+// Six-step transform of plan->n values of src into dst, scaling them by scale
+static void __fft_six_step(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, float scale) {
+  size_t n1 = plan->cols->n, n2 = plan->rows->n;
+  __fft_six_job job;
+  memset(&job, 0, sizeof(job));
+  job.x = dst;
+  job.inverse = inverse;
+  job.scale = scale;
+
+  // Columns of the n1 x n2 input become rows
+  if (dst == src) {
+    __fft_transpose_matrix(dst, n1, n2);
+  }
+  else {
+    job.src = src;
+    job.rows = n1;
+    job.cols = n2;
+    cam_parallel_for(n2 / __FFT_BAND, __fft_copy_task, &job);
+  }
+
+  // n2 transforms of n1 values, with the twiddles
+  size_t bits = 0;
+  while (((size_t)1 << bits) < n1) { ++bits; }
+  job.plan = plan->cols;
+  job.lo = plan->twiddle;
+  job.hi = plan->twiddle + ((size_t)1 << bits);
+  job.lo_bits = bits;
+  job.cols = n1;
+  cam_parallel_for(n2, __fft_rows_task, &job);
+  __fft_transpose_matrix(dst, n2, n1);
+
+  // n1 transforms of n2 values
+  job.plan = plan->rows;
+  job.lo = NULL;
+  job.cols = n2;
+  cam_parallel_for(n1, __fft_rows_task, &job);
+  __fft_transpose_matrix(dst, n1, n2);
+}
+
+/* mixed-radix helpers */
+// Sizes n = p_0 p_1 ... p_(S-1) with every factor 2, 3, 4, 5 or 7 run the same
+// decimation in time as powers of two, one pass per factor. Pass s has radix p = p_s
+// and span h = p_0 ... p_(s-1); it takes the values at j + qh of each block of ph
+// values, multiplies them by w^(qj) with w = e^(-2 pi i / ph), and replaces them by
+// their p point transform. The input is first put in digit reversed order, the
+// mixed-radix analogue of bit reversal. Factors of 4 and 2 run first so the spans of
+// the odd passes are multiples of the register width.
+//
+// Twiddles of a pass with h > 1 are stored as w^(qj) at (q - 1) h + j, so a register
+// of consecutive j loads each from one place.
+
+#define __FFT_MAX_RADIX 7
+
+// cos and sin of 2 pi r / p for the odd radices
+static const float __fft_odd_cos[8][7] = {
+  { 0 }, { 0 }, { 0 },
+  { 1.000000000f, -0.500000000f, -0.500000000f },
+  { 0 },
+  { 1.000000000f, 0.309016994f, -0.809016994f, -0.809016994f, 0.309016994f },
+  { 0 },
+  { 1.000000000f, 0.623489802f, -0.222520934f, -0.900968868f, -0.900968868f, -0.222520934f, 0.623489802f }
+};
+static const float __fft_odd_sin[8][7] = {
+  { 0 }, { 0 }, { 0 },
+  { 0.000000000f, 0.866025404f, -0.866025404f },
+  { 0 },
+  { 0.000000000f, 0.951056516f, 0.587785252f, -0.587785252f, -0.951056516f },
+  { 0 },
+  { 0.000000000f, 0.781831482f, 0.974927912f, 0.433883739f, -0.433883739f, -0.974927912f, -0.781831482f }
+};
+
+// p point transform of v in place. rs is -1 going forward and 1 going backward, as
+// in __fft_bfly4. Odd p pair x_m with x_(p - m), so that for k in [1, (p - 1) / 2]
+//   y_k, y_(p - k) = x_0 + sum over m of (x_m + x_(p - m)) cos(2 pi km / p)
+//                    -/+ i sum over m of (x_m - x_(p - m)) sin(2 pi km / p).
+static inline void __fft_radix_scalar(cfloat* v, size_t p, float rs) {
+  if (p == 2) {
+    cfloat a = v[0], b = v[1];
+    v[0].re = a.re + b.re;
+    v[0].im = a.im + b.im;
+    v[1].re = a.re - b.re;
+    v[1].im = a.im - b.im;
+    return;
+  }
+  if (p == 4) {
+    cfloat s0 = { v[0].re + v[2].re, v[0].im + v[2].im };
+    cfloat d0 = { v[0].re - v[2].re, v[0].im - v[2].im };
+    cfloat s1 = { v[1].re + v[3].re, v[1].im + v[3].im };
+    cfloat d1 = { -rs * (v[1].im - v[3].im), rs * (v[1].re - v[3].re) };
+    v[0].re = s0.re + s1.re;
+    v[0].im = s0.im + s1.im;
+    v[1].re = d0.re + d1.re;
+    v[1].im = d0.im + d1.im;
+    v[2].re = s0.re - s1.re;
+    v[2].im = s0.im - s1.im;
+    v[3].re = d0.re - d1.re;
+    v[3].im = d0.im - d1.im;
+    return;
+  }
+  size_t s = (p - 1) / 2;
+  cfloat a[(__FFT_MAX_RADIX - 1) / 2], d[(__FFT_MAX_RADIX - 1) / 2];
+  cfloat x0 = v[0], y0 = v[0];
+  for (size_t m = 1; m <= s; ++m) {
+    a[m - 1].re = v[m].re + v[p - m].re;
+    a[m - 1].im = v[m].im + v[p - m].im;
+    d[m - 1].re = v[m].re - v[p - m].re;
+    d[m - 1].im = v[m].im - v[p - m].im;
+    y0.re += a[m - 1].re;
+    y0.im += a[m - 1].im;
+  }
+  for (size_t k = 1; k <= s; ++k) {
+    cfloat c = x0, t = { 0.0f, 0.0f };
+    for (size_t m = 1; m <= s; ++m) {
+      float cs = __fft_odd_cos[p][(k * m) % p], sn = __fft_odd_sin[p][(k * m) % p];
+      c.re += a[m - 1].re * cs;
+      c.im += a[m - 1].im * cs;
+      t.re += d[m - 1].re * sn;
+      t.im += d[m - 1].im * sn;
+    }
+    cfloat r = { -rs * t.im, rs * t.re };
+    v[k].re = c.re + r.re;
+    v[k].im = c.im + r.im;
+    v[p - k].re = c.re - r.re;
+    v[p - k].im = c.im - r.im;
+  }
+  v[0] = y0;
+}
+
+// Mixed-radix pass of radix p and span h over x[0 .. n), for j in [j0, h) of each block,
+// scaling the inputs by scale. tw is NULL for the first pass, whose twiddles are all 1.
+static inline void __fft_mixed_pass_scalar(cfloat* x, size_t n, size_t p, size_t h, size_t j0, const cfloat* tw, bool inverse, float scale) {
+  float rs = inverse ? 1.0f : -1.0f;
+  float ts = inverse ? -1.0f : 1.0f;
+  cfloat v[__FFT_MAX_RADIX];
+  for (size_t b = 0; b < n; b += p * h) {
+    for (size_t j = j0; j < h; ++j) {
+      cfloat* x0 = x + b + j;
+      for (size_t q = 0; q < p; ++q) {
+        v[q].re = x0[q * h].re * scale;
+        v[q].im = x0[q * h].im * scale;
+      }
+      if (tw) {
+        for (size_t q = 1; q < p; ++q) {
+          cfloat t = { tw[((q - 1) * h) + j].re, ts * tw[((q - 1) * h) + j].im };
+          v[q] = __fft_cmul(v[q], t);
+        }
+      }
+      __fft_radix_scalar(v, p, rs);
+      for (size_t q = 0; q < p; ++q) { x0[q * h] = v[q]; }
+    }
+  }
+}
+
+#if defined(CAM_SIMD_AVX)
+// __fft_radix_scalar on registers of __FFT_V independent transforms
+static inline void __fft_radix_vec(__soa_vec* v, size_t p, __soa_vec rot) {
+  if (p == 2) {
+    __soa_vec a = v[0];
+    v[0] = __soa_add(a, v[1]);
+    v[1] = __soa_sub(a, v[1]);
+    return;
+  }
+  if (p == 4) {
+    __soa_vec s0 = __soa_add(v[0], v[2]);
+    __soa_vec d0 = __soa_sub(v[0], v[2]);
+    __soa_vec s1 = __soa_add(v[1], v[3]);
+    __soa_vec d1 = __soa_xor(__complex_swap(__soa_sub(v[1], v[3])), rot);
+    v[0] = __soa_add(s0, s1);
+    v[1] = __soa_add(d0, d1);
+    v[2] = __soa_sub(s0, s1);
+    v[3] = __soa_sub(d0, d1);
+    return;
+  }
+  size_t s = (p - 1) / 2;
+  __soa_vec a[(__FFT_MAX_RADIX - 1) / 2], d[(__FFT_MAX_RADIX - 1) / 2];
+  __soa_vec x0 = v[0], y0 = v[0];
+  for (size_t m = 1; m <= s; ++m) {
+    a[m - 1] = __soa_add(v[m], v[p - m]);
+    d[m - 1] = __soa_sub(v[m], v[p - m]);
+    y0 = __soa_add(y0, a[m - 1]);
+  }
+  for (size_t k = 1; k <= s; ++k) {
+    __soa_vec c = x0, t = __soa_set1(0.0f);
+    for (size_t m = 1; m <= s; ++m) {
+      c = __soa_fmadd(a[m - 1], __soa_set1(__fft_odd_cos[p][(k * m) % p]), c);
+      t = __soa_fmadd(d[m - 1], __soa_set1(__fft_odd_sin[p][(k * m) % p]), t);
+    }
+    __soa_vec r = __soa_xor(__complex_swap(t), rot);
+    v[k] = __soa_add(c, r);
+    v[p - k] = __soa_sub(c, r);
+  }
+  v[0] = y0;
+}
+
+// Mixed-radix pass of radix p and span h with its twiddles, for j below the
+// multiple of __FFT_V hv <= h of each block
+static inline void __fft_mixed_pass_vec(cfloat* x, size_t n, size_t p, size_t h, size_t hv, const cfloat* tw, bool inverse) {
+  __soa_vec conj, rot;
+  __fft_masks(inverse, &conj, &rot);
+  __soa_vec v[__FFT_MAX_RADIX];
+  for (size_t b = 0; b < n; b += p * h) {
+    for (size_t j = 0; j < hv; j += __FFT_V) {
+      cfloat* x0 = x + b + j;
+      v[0] = __fft_load(x0);
+      for (size_t q = 1; q < p; ++q) {
+        v[q] = __complex_mul(__fft_load(x0 + (q * h)), __soa_xor(__fft_load(tw + ((q - 1) * h) + j), conj));
+      }
+      __fft_radix_vec(v, p, rot);
+      for (size_t q = 0; q < p; ++q) { __fft_store(x0 + (q * h), v[q]); }
+    }
+  }
+}
+#endif
+
+// Runs one mixed-radix pass, with p spelled out so each radix gets its own unrolled copy.
+// Registers cover as much of each span as they can, the scalar code the rest.
+static void __fft_mixed_pass(cfloat* x, size_t n, size_t p, size_t h, const cfloat* tw, bool inverse, float scale) {
+  size_t hv = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  if (tw) {
+    hv = h - (h % __FFT_V);
+    switch (p) {
+      case 2: __fft_mixed_pass_vec(x, n, 2, h, hv, tw, inverse); break;
+      case 3: __fft_mixed_pass_vec(x, n, 3, h, hv, tw, inverse); break;
+      case 4: __fft_mixed_pass_vec(x, n, 4, h, hv, tw, inverse); break;
+      case 5: __fft_mixed_pass_vec(x, n, 5, h, hv, tw, inverse); break;
+      default: __fft_mixed_pass_vec(x, n, 7, h, hv, tw, inverse); break;
+    }
+    if (hv == h) { return; }
+  }
+#endif
+  // No SIMD intrinsics
+  switch (p) {
+    case 2: __fft_mixed_pass_scalar(x, n, 2, h, hv, tw, inverse, scale); return;
+    case 3: __fft_mixed_pass_scalar(x, n, 3, h, hv, tw, inverse, scale); return;
+    case 4: __fft_mixed_pass_scalar(x, n, 4, h, hv, tw, inverse, scale); return;
+    case 5: __fft_mixed_pass_scalar(x, n, 5, h, hv, tw, inverse, scale); return;
+    default: __fft_mixed_pass_scalar(x, n, 7, h, hv, tw, inverse, scale); return;
+  }
+}
+
+// Reorders src into dst by the digit reversal, following the cycles of the
+// permutation when in place, then runs every pass in dst
+static void __fft_mixed(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, float scale) {
+  size_t n = plan->n;
+  if (dst == src) {
+    // Each cycle is its length, then its positions: every value moves to the one before
+    for (const uint32_t* c = plan->cycles; *c; c += *c + 1) {
+      const uint32_t* at = c + 1;
+      cfloat first = dst[at[0]];
+      for (uint32_t i = 1; i < *c; ++i) { dst[at[i - 1]] = dst[at[i]]; }
+      dst[at[*c - 1]] = first;
+    }
+  }
+  else {
+    for (size_t i = 0; i < n; ++i) {
+      dst[i] = src[plan->perm[i]];
+    }
+  }
+
+  // The scale is folded into the first pass, which needs no twiddles
+  const cfloat* tw = plan->twiddle;
+  size_t h = 1;
+  for (size_t s = 0; s < plan->passes; ++s) {
+    size_t p = plan->radix[s];
+    __fft_mixed_pass(dst, n, p, h, (h == 1) ? NULL : tw, inverse, scale);
+    if (h > 1) { tw += (p - 1) * h; }
+    scale = 1.0f;
+    h *= p;
+  }
+}
+
+
+/* Bluestein helpers */
+// With the chirp c_k = e^(-pi i k^2 / n), jk = (j^2 + k^2 - (k - j)^2) / 2 turns the
+// transform into a convolution,
+//   X[k] = c_k sum over j of (x_j c_j) conj(c_(k - j)),
+// which runs as a cyclic convolution of m >= 2n - 1 points, m a power of two: the
+// filter conj(c) wrapped around m is transformed once by the plan, the chirped input
+// each call. The filter holds the 1 / m of the inverse convolution transform. The
+// inverse transform is conj(forward(conj(x))) / n.
+
+// Power of two transform of the convolution, unscaled both ways
+static void __fft_convolve_pass(const cam_fft_plan* sub, cfloat* dst, const cfloat* src, bool inverse) {
+  if (sub->strategy == CAM_FFT_SIX_STEP) {
+    __fft_six_step(sub, dst, src, inverse, 1.0f);
+  }
+  else {
+    __fft_direct(sub, dst, src, inverse, 1.0f);
+  }
+}
+
+// The convolution ping-pongs between two buffers of m values, since the direct
+// transforms run faster out of place. Six-step transforms run as fast in place, and
+// sizes that large spend less time on one buffer than on faulting in a second.
+static inline size_t __fft_bluestein_scratch(const cam_fft_plan* plan) {
+  return (plan->sub->strategy == CAM_FFT_SIX_STEP) ? plan->sub->n : 2 * plan->sub->n;
+}
+
+static void __fft_bluestein(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, float scale, cfloat* work) {
+  size_t n = plan->n, m = plan->sub->n;
+  const cfloat* chirp = plan->twiddle;
+  const cfloat* filter = plan->twiddle + (((n * sizeof(cfloat)) + 63) & ~(size_t)63) / sizeof(cfloat);
+  cfloat* a = work;
+  cfloat* b = (plan->sub->strategy == CAM_FFT_SIX_STEP) ? a : a + m;
+
+  float cs = inverse ? -1.0f : 1.0f;
+  for (size_t k = 0; k < n; ++k) {
+    cfloat x = { src[k].re, cs * src[k].im };
+    a[k] = __fft_cmul(x, chirp[k]);
+  }
+  memset(a + n, 0, (m - n) * sizeof(cfloat));
+  __fft_convolve_pass(plan->sub, b, a, false);
+  size_t k = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (; k + __FFT_V <= m; k += __FFT_V) {
+    __fft_store(b + k, __complex_mul(__fft_load(b + k), __fft_load(filter + k)));
+  }
+#endif
+  // No SIMD intrinsics
+  for (; k < m; ++k) { b[k] = __fft_cmul(b[k], filter[k]); }
+  __fft_convolve_pass(plan->sub, a, b, true);
+  for (k = 0; k < n; ++k) {
+    cfloat y = __fft_cmul(a[k], chirp[k]);
+    dst[k].re = scale * y.re;
+    dst[k].im = cs * scale * y.im;
+  }
+}
+
+/* codelet helpers */
+// Library builds define CAM_FFT_CODELETS to the largest size tools/fft_codegen.c
+// generated straight-line transforms for, at build time. Every size up to it whose
+// prime factors are at most 7 has one: no loops, no tables, twiddles folded into
+// constants, and no value stored between loading the input and storing the output,
+// so dst may be src. A codelet reads separate real and imaginary arrays at a stride,
+// which lets one instantiation on floats transform an interleaved signal (stride 2)
+// and one on vectors transform __SOA_WIDTH signals of a batch side by side. Swapping
+// the real and imaginary parts in and out turns it into the unscaled inverse.
+#if defined(CAM_FFT_CODELETS)
+typedef void (*__fft_codelet_fn)(const float* xr, const float* xi, float* yr, float* yi, size_t is, size_t os);
+
+#define __cl_t float
+#define __cl_load(p) (*(p))
+#define __cl_store(p, v) (*(p) = (v))
+#define __cl_add(a, b) ((a) + (b))
+#define __cl_sub(a, b) ((a) - (b))
+#define __cl_neg(a) (-(a))
+#define __cl_mul(a, k) ((a) * (k))
+#define __cl_fma(a, k, b) (((a) * (k)) + (b))
+#define __cl_fms(a, k, b) (((a) * (k)) - (b))
+#define __cl_fnma(a, k, b) ((b) - ((a) * (k)))
+#define __CL_FN(n) __fft_codelet_##n
+#define __CL_TABLE __fft_codelets
+#include "fft_codelets.inl"
+#undef __cl_t
+#undef __cl_load
+#undef __cl_store
+#undef __cl_add
+#undef __cl_sub
+#undef __cl_neg
+#undef __cl_mul
+#undef __cl_fma
+#undef __cl_fms
+#undef __cl_fnma
+#undef __CL_FN
+#undef __CL_TABLE
+
+#if defined(CAM_SIMD_AVX)
+// Intel AVX
+#define __cl_t __soa_vec
+#define __cl_load(p) __soa_loadu(p)
+#define __cl_store(p, v) __soa_storeu(p, v)
+#define __cl_add(a, b) __soa_add(a, b)
+#define __cl_sub(a, b) __soa_sub(a, b)
+#define __cl_neg(a) __soa_xor(a, __soa_set1(-0.0f))
+#define __cl_mul(a, k) __soa_mul(a, __soa_set1(k))
+#define __cl_fma(a, k, b) __soa_fmadd(a, __soa_set1(k), b)
+#define __cl_fms(a, k, b) __soa_sub(__soa_mul(a, __soa_set1(k)), b)
+#define __cl_fnma(a, k, b) __soa_sub(b, __soa_mul(a, __soa_set1(k)))
+#define __CL_FN(n) __fft_codelet_vec_##n
+#define __CL_TABLE __fft_codelets_vec
+#include "fft_codelets.inl"
+#undef __cl_t
+#undef __cl_load
+#undef __cl_store
+#undef __cl_add
+#undef __cl_sub
+#undef __cl_neg
+#undef __cl_mul
+#undef __cl_fma
+#undef __cl_fms
+#undef __cl_fnma
+#undef __CL_FN
+#undef __CL_TABLE
+
+// Single transforms from this size up run faster through the SIMD passes
+#define __FFT_CODELET_SINGLE 16
+#else
+// No SIMD intrinsics
+#define __FFT_CODELET_SINGLE (CAM_FFT_CODELETS + 1)
+#endif
+
+static inline __fft_codelet_fn __fft_codelet_find(size_t n) {
+  return (n <= CAM_FFT_CODELETS) ? __fft_codelets[n] : NULL;
+}
+
+static void __fft_codelet(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, float scale) {
+  const float* x = (const float*)src;
+  float* y = (float*)dst;
+  if (!inverse) {
+    __fft_codelets[plan->n](x, x + 1, y, y + 1, 2, 2);
+    return;
+  }
+  __fft_codelets[plan->n](x + 1, x, y + 1, y, 2, 2);
+  for (size_t k = 0; k < 2 * plan->n; ++k) { y[k] *= scale; }
+}
+#endif
+
+// work holds __fft_scratch(plan) values, which only Bluestein plans use
+static inline size_t __fft_scratch(const cam_fft_plan* plan) {
+  return (plan->strategy == CAM_FFT_BLUESTEIN) ? __fft_bluestein_scratch(plan) : 0;
+}
+
+static void __fft_execute(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse, cfloat* work) {
+  // The inverse scale is folded into the first pass, or the six-step twiddles
+  float scale = inverse ? 1.0f / (float)plan->n : 1.0f;
+  switch (plan->strategy) {
+    case CAM_FFT_SIX_STEP: __fft_six_step(plan, dst, src, inverse, scale); break;
+    case CAM_FFT_MIXED_RADIX: __fft_mixed(plan, dst, src, inverse, scale); break;
+    case CAM_FFT_BLUESTEIN: __fft_bluestein(plan, dst, src, inverse, scale, work); break;
+#if defined(CAM_FFT_CODELETS)
+    case CAM_FFT_CODELET: __fft_codelet(plan, dst, src, inverse, scale); break;
+#endif
+    default: __fft_direct(plan, dst, src, inverse, scale); break;
+  }
+}
+
+// Batched transforms run on blocks of __FFT_MANY_BLOCK signals, two cache lines of
+// each value, copied into a contiguous buffer: every line of the batch is then read
+// and written once whatever the stride, which as a multiple of 4096 bytes would
+// otherwise map every value of a signal to the same cache set. With a codelet for n
+// the block runs __SOA_WIDTH signals at a time where the tier has vectors, then one
+// at a time. Other sizes are laid out one signal after another to run the plan.
+#define __FFT_MANY_BLOCK 32
+
+// work holds __fft_many_scratch(plan) values: the block copied out, its transforms,
+// and the plan's own working space
+static inline size_t __fft_many_scratch(const cam_fft_plan* plan) {
+#if defined(CAM_FFT_CODELETS)
+  if (__fft_codelet_find(plan->n)) { return 0; }
+#endif
+  return (2 * __FFT_MANY_BLOCK * plan->n) + __fft_scratch(plan);
+}
+
+static void __fft_many(const cam_fft_plan* plan, cfloat_soa* dst, const cfloat_soa* src, bool inverse, cfloat* work) {
+  size_t n = plan->n, count = src->count / n;
+#if defined(CAM_FFT_CODELETS)
+  __fft_codelet_fn fn = __fft_codelet_find(n);
+  if (fn) {
+    float scale = inverse ? 1.0f / (float)n : 1.0f;
+    const float* xr = inverse ? src->im : src->re;
+    const float* xi = inverse ? src->re : src->im;
+    float* yr = inverse ? dst->im : dst->re;
+    float* yi = inverse ? dst->re : dst->im;
+    float br[CAM_FFT_CODELETS * __FFT_MANY_BLOCK], bi[CAM_FFT_CODELETS * __FFT_MANY_BLOCK];
+    for (size_t s = 0; s < count; s += __FFT_MANY_BLOCK) {
+      size_t b = (count - s < __FFT_MANY_BLOCK) ? count - s : __FFT_MANY_BLOCK;
+      for (size_t k = 0; k < n; ++k) {
+        for (size_t j = 0; j < b; ++j) {
+          br[(k * __FFT_MANY_BLOCK) + j] = xr[(k * count) + s + j];
+          bi[(k * __FFT_MANY_BLOCK) + j] = xi[(k * count) + s + j];
+        }
+      }
+      size_t j = 0;
+#if defined(CAM_SIMD_AVX)
+      // Intel AVX
+      for (; j + __SOA_WIDTH <= b; j += __SOA_WIDTH) {
+        __fft_codelets_vec[n](br + j, bi + j, br + j, bi + j, __FFT_MANY_BLOCK, __FFT_MANY_BLOCK);
+      }
+#endif
+      // No SIMD intrinsics
+      for (; j < b; ++j) {
+        fn(br + j, bi + j, br + j, bi + j, __FFT_MANY_BLOCK, __FFT_MANY_BLOCK);
+      }
+      for (size_t k = 0; k < n; ++k) {
+        for (j = 0; j < b; ++j) {
+          yr[(k * count) + s + j] = scale * br[(k * __FFT_MANY_BLOCK) + j];
+          yi[(k * count) + s + j] = scale * bi[(k * __FFT_MANY_BLOCK) + j];
+        }
+      }
+    }
+    return;
+  }
+#endif
+  cfloat* a = work;
+  cfloat* y = a + (__FFT_MANY_BLOCK * n);
+  work = y + (__FFT_MANY_BLOCK * n);
+  for (size_t s = 0; s < count; s += __FFT_MANY_BLOCK) {
+    size_t b = (count - s < __FFT_MANY_BLOCK) ? count - s : __FFT_MANY_BLOCK;
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t j = 0; j < b; ++j) {
+        a[(j * n) + k].re = src->re[(k * count) + s + j];
+        a[(j * n) + k].im = src->im[(k * count) + s + j];
+      }
+    }
+    for (size_t j = 0; j < b; ++j) {
+      __fft_execute(plan, y + (j * n), a + (j * n), inverse, work);
+    }
+    for (size_t k = 0; k < n; ++k) {
+      for (size_t j = 0; j < b; ++j) {
+        dst->re[(k * count) + s + j] = y[(j * n) + k].re;
+        dst->im[(k * count) + s + j] = y[(j * n) + k].im;
+      }
+    }
+  }
+}
+
+
+/* cam_fft_plan functions */
+static size_t __fft_log2(size_t n) {
+  size_t log2n = 0;
+  while (((size_t)1 << log2n) < n) { ++log2n; }
+  return log2n;
+}
+
+// Twiddles held by a plan: those of the radix-4 passes past the first, then of the
+// radix-2 pass, or the two six-step tables
+static size_t __fft_twiddle_count(size_t n, bool six_step) {
+  size_t log2n = __fft_log2(n);
+  if (six_step) { return ((size_t)1 << ((log2n + 1) / 2)) + (n >> ((log2n + 1) / 2)); }
+  size_t count = 0;
+  for (size_t h = 4; 4 * h <= n; h *= 4) { count += 3 * h; }
+  if ((log2n & 1) && n > 1) { count += n / 2; }
+  return count;
+}
+
+// Bytes of a plan head, which its tables follow in the same allocation
+#define __FFT_HEAD ((sizeof(cam_fft_plan) + 63) & ~(size_t)63)
+
+// Plan with every field clear and room for tables of the given size after the head
+static cam_fft_plan* __fft_plan_alloc(size_t n, cam_fft_strategy strategy, size_t table_bytes) {
+  cam_fft_plan* plan = (cam_fft_plan*)cam_aligned_alloc(__FFT_HEAD + table_bytes, 64);
+  if (!plan) { return NULL; }
+  memset(plan, 0, sizeof(cam_fft_plan));
+  plan->n = n;
+  plan->strategy = strategy;
+  return plan;
+}
+
+// Plan for the radix-2/4 passes alone
+static cam_fft_plan* __fft_plan_direct(size_t n, size_t log2n) {
+  size_t count = __fft_twiddle_count(n, false);
+
+  // One allocation holds the plan, the permutation and the twiddles
+  size_t perm_bytes = ((n * sizeof(uint32_t)) + 63) & ~(size_t)63;
+  cam_fft_plan* plan = __fft_plan_alloc(n, CAM_FFT_RADIX4, perm_bytes + (count * sizeof(cfloat)));
+  if (!plan) { return NULL; }
+  plan->perm = (uint32_t*)((char*)plan + __FFT_HEAD);
+  plan->twiddle = (cfloat*)((char*)plan + __FFT_HEAD + perm_bytes);
+
+  for (size_t i = 0; i < n; ++i) {
+    size_t r = 0;
+    for (size_t b = 0; b < log2n; ++b) { r |= ((i >> b) & 1) << (log2n - 1 - b); }
+    plan->perm[i] = (uint32_t)r;
+  }
+
+  // Twiddles are evaluated in double so every factor is correctly rounded
+  cfloat* tw = plan->twiddle;
+  for (size_t h = 4; 4 * h <= n; h *= 4) {
+    for (size_t j = 0; j < h; ++j) {
+      cfloat* t = tw + __fft_twiddle_index(j);
+      double a = -2.0 * C_PI * (double)j / (double)(4 * h);
+      t[0] = cfloat_make((float)cos(2.0 * a), (float)sin(2.0 * a));
+      t[4] = cfloat_make((float)cos(a), (float)sin(a));
+      t[8] = cfloat_make((float)cos(3.0 * a), (float)sin(3.0 * a));
+    }
+    tw += 3 * h;
+  }
+  if ((log2n & 1) && n > 1) {
+    for (size_t j = 0; j < n / 2; ++j) {
+      double a = -2.0 * C_PI * (double)j / (double)n;
+      tw[j] = cfloat_make((float)cos(a), (float)sin(a));
+    }
+  }
+  return plan;
+}
+
+// Six-step plan, for log2n of at least 16: the twiddle tables, sized s and n / s,
+// and direct plans for the columns and rows
+static cam_fft_plan* __fft_plan_six(size_t n, size_t log2n) {
+  size_t bits = (log2n + 1) / 2;
+  size_t lo = (size_t)1 << bits, hi = n >> bits;
+  cam_fft_plan* plan = __fft_plan_alloc(n, CAM_FFT_SIX_STEP, (lo + hi) * sizeof(cfloat));
+  if (!plan) { return NULL; }
+  plan->twiddle = (cfloat*)((char*)plan + __FFT_HEAD);
+  plan->cols = __fft_plan_direct((size_t)1 << bits, bits);
+  plan->rows = __fft_plan_direct((size_t)1 << (log2n - bits), log2n - bits);
+  if (!plan->cols || !plan->rows) {
+    cam_fft_plan_free(plan);
+    return NULL;
+  }
+  for (size_t t = 0; t < lo; ++t) {
+    double a = -2.0 * C_PI * (double)t / (double)n;
+    plan->twiddle[t] = cfloat_make((float)cos(a), (float)sin(a));
+  }
+  for (size_t t = 0; t < hi; ++t) {
+    double a = -2.0 * C_PI * (double)(t << bits) / (double)n;
+    plan->twiddle[lo + t] = cfloat_make((float)cos(a), (float)sin(a));
+  }
+  return plan;
+}
+
+// Plan for a power of two by the table driven strategies, the direct passes below
+// the six-step threshold
+static cam_fft_plan* __fft_plan_pow2(size_t n) {
+  size_t log2n = __fft_log2(n);
+  size_t six_min = (CAM_FFT_SIX_STEP_LOG2 < 16) ? 16 : CAM_FFT_SIX_STEP_LOG2;
+  return (log2n < six_min) ? __fft_plan_direct(n, log2n) : __fft_plan_six(n, log2n);
+}
+
+// Factors n into the radices of its mixed-radix passes, 4s then a 2, 3s, 5s and 7s.
+// Returns false if n has another prime factor.
+static bool __fft_factor(size_t n, cam_fft_plan* plan) {
+  static const size_t radices[] = { 4, 2, 3, 5, 7 };
+  plan->passes = 0;
+  for (size_t r = 0; r < sizeof(radices) / sizeof(radices[0]); ++r) {
+    while (n % radices[r] == 0) {
+      plan->radix[plan->passes++] = (unsigned char)radices[r];
+      n /= radices[r];
+    }
+  }
+  return n == 1;
+}
+
+// Mixed-radix plan: the digit reversal, its cycles and the twiddles of every pass
+static cam_fft_plan* __fft_plan_mixed(size_t n) {
+  cam_fft_plan probe;
+  if (!__fft_factor(n, &probe)) { return NULL; }
+
+  // One allocation holds the plan, the twiddles (n - 1 of them over every pass), the
+  // permutation and at most n + n / 2 + 1 values of cycles
+  size_t tw_bytes = ((n * sizeof(cfloat)) + 63) & ~(size_t)63;
+  size_t perm_bytes = ((n * sizeof(uint32_t)) + 63) & ~(size_t)63;
+  cam_fft_plan* plan = __fft_plan_alloc(n, CAM_FFT_MIXED_RADIX, tw_bytes + perm_bytes + ((n + (n / 2) + 1) * sizeof(uint32_t)));
+  unsigned char* seen = (unsigned char*)calloc(n, 1);
+  if (!plan || !seen) {
+    cam_aligned_free(plan);
+    free(seen);
+    return NULL;
+  }
+  plan->twiddle = (cfloat*)((char*)plan + __FFT_HEAD);
+  plan->perm = (uint32_t*)((char*)plan + __FFT_HEAD + tw_bytes);
+  plan->cycles = (uint32_t*)((char*)plan + __FFT_HEAD + tw_bytes + perm_bytes);
+  plan->passes = probe.passes;
+  memcpy(plan->radix, probe.radix, sizeof(plan->radix));
+
+  // The last pass splits the input by its radix first, so digits are read from the
+  // last pass back
+  for (size_t i = 0; i < n; ++i) {
+    size_t pos = i, size = n, index = 0, stride = 1;
+    for (size_t s = plan->passes; s-- > 0;) {
+      size /= plan->radix[s];
+      index += (pos / size) * stride;
+      pos %= size;
+      stride *= plan->radix[s];
+    }
+    plan->perm[i] = (uint32_t)index;
+  }
+  uint32_t* c = plan->cycles;
+  for (size_t i = 0; i < n; ++i) {
+    if (seen[i] || plan->perm[i] == i) { continue; }
+    uint32_t* length = c++;
+    *length = 0;
+    for (size_t j = i; !seen[j]; j = plan->perm[j]) {
+      seen[j] = 1;
+      *c++ = (uint32_t)j;
+      ++*length;
+    }
+  }
+  *c = 0;
+  free(seen);
+
+  // Twiddles are evaluated in double so every factor is correctly rounded
+  cfloat* tw = plan->twiddle;
+  size_t h = plan->radix[0];
+  for (size_t s = 1; s < plan->passes; ++s) {
+    size_t p = plan->radix[s];
+    for (size_t q = 1; q < p; ++q) {
+      for (size_t j = 0; j < h; ++j) {
+        double a = -2.0 * C_PI * (double)(q * j) / (double)(p * h);
+        tw[((q - 1) * h) + j] = cfloat_make((float)cos(a), (float)sin(a));
+      }
+    }
+    tw += (p - 1) * h;
+    h *= p;
+  }
+  return plan;
+}
+
+// Bluestein plan: the chirp, the transformed filter and the plan of the convolution
+static cam_fft_plan* __fft_plan_bluestein(size_t n) {
+  size_t m = 1;
+  while (m < (2 * n) - 1) { m *= 2; }
+  size_t chirp_bytes = ((n * sizeof(cfloat)) + 63) & ~(size_t)63;
+  cam_fft_plan* plan = __fft_plan_alloc(n, CAM_FFT_BLUESTEIN, chirp_bytes + (m * sizeof(cfloat)));
+  if (!plan) { return NULL; }
+  plan->twiddle = (cfloat*)((char*)plan + __FFT_HEAD);
+  plan->sub = __fft_plan_pow2(m);
+  if (!plan->sub) {
+    cam_fft_plan_free(plan);
+    return NULL;
+  }
+
+  // k^2 is taken mod 2n, the period of the chirp, so the angles stay exact in double
+  cfloat* chirp = plan->twiddle;
+  cfloat* filter = (cfloat*)((char*)plan->twiddle + chirp_bytes);
+  for (size_t k = 0; k < n; ++k) {
+    double a = -C_PI * (double)(((uint64_t)k * k) % (2 * (uint64_t)n)) / (double)n;
+    chirp[k] = cfloat_make((float)cos(a), (float)sin(a));
+  }
+  float s = 1.0f / (float)m;
+  memset(filter, 0, m * sizeof(cfloat));
+  filter[0] = cfloat_make(s, 0.0f);
+  for (size_t k = 1; k < n; ++k) {
+    filter[k] = cfloat_make(s * chirp[k].re, -s * chirp[k].im);
+    filter[m - k] = filter[k];
+  }
+  __fft_convolve_pass(plan->sub, filter, filter, false);
+  return plan;
+}
+
+static bool __fft_valid_size(size_t n) {
+  return n != 0 && (n & (n - 1)) == 0 && n <= ((size_t)1 << 31);
+}
+
+cam_fft_plan* cam_fft_plan_make(size_t n) {
+  if (n == 0 || n > ((size_t)1 << 31)) { return NULL; }
+#if defined(CAM_FFT_CODELETS)
+  if (n < __FFT_CODELET_SINGLE && __fft_codelet_find(n)) { return __fft_plan_alloc(n, CAM_FFT_CODELET, 0); }
+#endif
+  if (!__fft_valid_size(n)) {
+    cam_fft_plan* plan = __fft_plan_mixed(n);
+    if (plan || n > ((size_t)1 << 30)) { return plan; }
+    return __fft_plan_bluestein(n);
+  }
+  return __fft_plan_pow2(n);
+}
+
+void cam_fft_plan_free(cam_fft_plan* plan) {
+  if (!plan) { return; }
+  cam_fft_plan_free(plan->cols);
+  cam_fft_plan_free(plan->rows);
+  cam_fft_plan_free(plan->sub);
+  cam_aligned_free(plan);
+}
+
+int cam_fft_plan_describe(cam_fft_plan* plan, char* buf, size_t size) {
+  switch (plan->strategy) {
+    case CAM_FFT_SIX_STEP:
+      return snprintf(buf, size, "six-step %zu x %zu", plan->cols->n, plan->rows->n);
+    case CAM_FFT_BLUESTEIN:
+      return snprintf(buf, size, "bluestein over %zu points", plan->sub->n);
+    case CAM_FFT_CODELET:
+      return snprintf(buf, size, "codelet");
+    case CAM_FFT_MIXED_RADIX: {
+      int length = snprintf(buf, size, "mixed-radix");
+      for (size_t s = 0; s < plan->passes; ++s) {
+        size_t at = ((size_t)length < size) ? (size_t)length : size;
+        length += snprintf(buf ? buf + at : NULL, size - at, (s == 0) ? " %d" : " x %d", (int)plan->radix[s]);
+      }
+      return length;
+    }
+    default:
+      return snprintf(buf, size, (__fft_log2(plan->n) & 1) ? "radix-4 and radix-2" : "radix-4");
+  }
+}
+
+
+/* Transform functions */
+// Runs the transform with working space allocated for the call when the plan needs any
+static void __fft_transform(const cam_fft_plan* plan, cfloat* dst, const cfloat* src, bool inverse) {
+  size_t size = __fft_scratch(plan);
+  if (size == 0) {
+    __fft_execute(plan, dst, src, inverse, NULL);
+    return;
+  }
+  cfloat* work = (cfloat*)cam_aligned_alloc(size * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!work) {
+    for (size_t k = 0; k < plan->n; ++k) {
+      dst[k].re = NAN;
+      dst[k].im = NAN;
+    }
+    return;
+  }
+  __fft_execute(plan, dst, src, inverse, work);
+  cam_aligned_free(work);
+}
+
+size_t cam_fft_plan_scratch_size(cam_fft_plan* plan) {
+  return __fft_scratch(plan);
+}
+
+void cam_fft_forward(cam_fft_plan* plan, cfloat* dst, cfloat* src) {
+  __fft_transform(plan, dst, src, false);
+}
+
+void cam_fft_inverse(cam_fft_plan* plan, cfloat* dst, cfloat* src) {
+  __fft_transform(plan, dst, src, true);
+}
+
+void cam_fft_forward_scratch(cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work) {
+  __fft_execute(plan, dst, src, false, work);
+}
+
+void cam_fft_inverse_scratch(cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work) {
+  __fft_execute(plan, dst, src, true, work);
+}
+
+// Runs the batch with working space allocated for the call when the plan needs any
+static void __fft_transform_many(const cam_fft_plan* plan, cfloat_soa* dst, const cfloat_soa* src, bool inverse) {
+  size_t size = __fft_many_scratch(plan);
+  if (size == 0) {
+    __fft_many(plan, dst, src, inverse, NULL);
+    return;
+  }
+  cfloat* work = (cfloat*)cam_aligned_alloc(size * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!work) {
+    for (size_t k = 0; k < (src->count / plan->n) * plan->n; ++k) {
+      dst->re[k] = NAN;
+      dst->im[k] = NAN;
+    }
+    return;
+  }
+  __fft_many(plan, dst, src, inverse, work);
+  cam_aligned_free(work);
+}
+
+size_t cam_fft_many_scratch_size(cam_fft_plan* plan) {
+  return __fft_many_scratch(plan);
+}
+
+void cam_fft_many(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src) {
+  __fft_transform_many(plan, dst, src, false);
+}
+
+void cam_ifft_many(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src) {
+  __fft_transform_many(plan, dst, src, true);
+}
+
+void cam_fft_many_scratch(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work) {
+  __fft_many(plan, dst, src, false, work);
+}
+
+void cam_ifft_many_scratch(cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work) {
+  __fft_many(plan, dst, src, true, work);
+}
+
+
+/* Wisdom functions */
+// A wisdom file is a header, one record per plan (six-step plans followed by their
+// two direct sub-plans), then the permutations and twiddles, each 64 byte aligned.
+// Everything is in the writer's byte order; the header's order mark rejects others.
+
+#define __FFT_WISDOM_MAGIC "CAMFFTW"
+#define __FFT_WISDOM_FORMAT 1
+#define __FFT_WISDOM_ORDER 0x0102030405060708ull
+#define __FFT_WISDOM_NONE 0xffffffffu
+#define __FFT_TUNE_NS 2e7   // Time spent timing each strategy, at least 3 transforms
+
+typedef struct {
+  char magic[8];      // __FFT_WISDOM_MAGIC
+  uint32_t format;    // __FFT_WISDOM_FORMAT
+  uint32_t version;   // CAM_VERSION
+  uint32_t tier;      // cam_tier the strategies were chosen on
+  uint32_t count;     // Records following the header
+  uint64_t size;      // File size in bytes
+  uint64_t order;     // __FFT_WISDOM_ORDER
+  uint64_t reserved[3];
+} __fft_wisdom_header;
+
+typedef struct {
+  uint64_t n;
+  uint64_t perm;      // File offset of the permutation, 0 for six-step plans
+  uint64_t twiddle;   // File offset of the twiddles
+  uint64_t twiddles;  // Number of twiddles
+  uint32_t cols;      // Records of the six-step sub-plans, or __FFT_WISDOM_NONE
+  uint32_t rows;
+  uint32_t saved;     // 1 for the plans given to cam_fft_wisdom_save, 0 for sub-plans
+  uint32_t reserved;
+} __fft_wisdom_record;
+
+// Tier this code was compiled for, which with runtime dispatch is the bound tier
+static uint32_t __fft_wisdom_tier() {
+#if defined(CAM_SIMD_AVX2)
+  return CAM_TIER_AVX2;
+#elif defined(CAM_SIMD_AVX)
+  return CAM_TIER_SSE41;
+#else
+  return CAM_TIER_SCALAR;
+#endif
+}
+
+static double __fft_now_ns() {
+#if defined(_WIN32)
+  LARGE_INTEGER freq, t;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return ((double)t.tv_sec * 1e9) + (double)t.tv_nsec;
+#endif
+}
+
+// Best time of forward transforms from src to dst
+static double __fft_tune_time(cam_fft_plan* plan, cfloat* dst, cfloat* src) {
+  cam_fft_forward(plan, dst, src);
+  double best = 1e300, spent = 0.0;
+  for (int r = 0; r < 3 || spent < __FFT_TUNE_NS; ++r) {
+    double t0 = __fft_now_ns();
+    cam_fft_forward(plan, dst, src);
+    double t = __fft_now_ns() - t0;
+    if (t < best) { best = t; }
+    spent += t;
+  }
+  return best;
+}
+
+// The faster of two plans for the same size, freeing the other; either may be NULL
+static cam_fft_plan* __fft_tune_pick(cam_fft_plan* a, cam_fft_plan* b) {
+  size_t n = a ? a->n : 0;
+  cfloat* src = (cfloat*)cam_aligned_alloc(n * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cfloat* dst = (cfloat*)cam_aligned_alloc(n * sizeof(cfloat), CAM_SIMD_ALIGN);
+  cam_fft_plan* best = a ? a : b;
+  if (a && b && src && dst) {
+    for (size_t i = 0; i < n; ++i) { src[i] = cfloat_make((float)(i & 15), (float)(i & 7)); }
+    if (__fft_tune_time(b, dst, src) < __fft_tune_time(a, dst, src)) { best = b; }
+  }
+  cam_aligned_free(src);
+  cam_aligned_free(dst);
+  if (best != a) { cam_fft_plan_free(a); }
+  if (best != b) { cam_fft_plan_free(b); }
+  return best;
+}
+
+cam_fft_plan* cam_fft_plan_tune(size_t n) {
+#if defined(CAM_FFT_CODELETS)
+  if (n != 0 && __fft_codelet_find(n)) {
+    cam_fft_plan* passes = __fft_valid_size(n) ? __fft_plan_direct(n, __fft_log2(n)) : __fft_plan_mixed(n);
+    return __fft_tune_pick(passes, __fft_plan_alloc(n, CAM_FFT_CODELET, 0));
+  }
+#endif
+  if (!__fft_valid_size(n)) { return cam_fft_plan_make(n); }
+  size_t log2n = __fft_log2(n);
+  if (log2n < 16) { return __fft_plan_direct(n, log2n); }
+  return __fft_tune_pick(__fft_plan_direct(n, log2n), __fft_plan_six(n, log2n));
+}
+
+// Appends the record of a direct plan, sizing its tables from offset on
+static void __fft_wisdom_direct(__fft_wisdom_record* r, const cam_fft_plan* plan, uint64_t* offset) {
+  memset(r, 0, sizeof(*r));
+  r->n = plan->n;
+  r->perm = *offset;
+  *offset += ((plan->n * sizeof(uint32_t)) + 63) & ~(uint64_t)63;
+  r->twiddle = *offset;
+  r->twiddles = __fft_twiddle_count(plan->n, false);
+  *offset += ((r->twiddles * sizeof(cfloat)) + 63) & ~(uint64_t)63;
+  r->cols = __FFT_WISDOM_NONE;
+  r->rows = __FFT_WISDOM_NONE;
+}
+
+static bool __fft_wisdom_write(FILE* f, const void* p, size_t bytes, uint64_t* at) {
+  static const unsigned char zero[64] = { 0 };
+  size_t pad = (size_t)((64 - ((*at + bytes) & 63)) & 63);
+  *at += bytes + pad;
+  return fwrite(p, 1, bytes, f) == bytes && fwrite(zero, 1, pad, f) == pad;
+}
+
+bool cam_fft_wisdom_save(const char* path, cam_fft_plan** plans, size_t count) {
+  // Six-step plans take three records, other sizes none
+  size_t records = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (plans[i]->strategy == CAM_FFT_SIX_STEP) { records += 3; }
+    else if (plans[i]->strategy == CAM_FFT_RADIX4) { records += 1; }
+  }
+  __fft_wisdom_record* r = (__fft_wisdom_record*)calloc(records ? records : 1, sizeof(__fft_wisdom_record));
+  if (!r) { return false; }
+  uint64_t offset = (sizeof(__fft_wisdom_header) + (records * sizeof(__fft_wisdom_record)) + 63) & ~(uint64_t)63;
+  size_t k = 0;
+  for (size_t i = 0; i < count; ++i) {
+    cam_fft_plan* plan = plans[i];
+    if (plan->strategy == CAM_FFT_SIX_STEP) {
+      r[k].n = plan->n;
+      r[k].twiddle = offset;
+      r[k].twiddles = __fft_twiddle_count(plan->n, true);
+      offset += ((r[k].twiddles * sizeof(cfloat)) + 63) & ~(uint64_t)63;
+      r[k].cols = (uint32_t)(k + 1);
+      r[k].rows = (uint32_t)(k + 2);
+      r[k].saved = 1;
+      __fft_wisdom_direct(&r[k + 1], plan->cols, &offset);
+      __fft_wisdom_direct(&r[k + 2], plan->rows, &offset);
+      k += 3;
+    }
+    else if (plan->strategy == CAM_FFT_RADIX4) {
+      __fft_wisdom_direct(&r[k], plan, &offset);
+      r[k].saved = 1;
+      k += 1;
+    }
+  }
+
+  __fft_wisdom_header h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, __FFT_WISDOM_MAGIC, sizeof(__FFT_WISDOM_MAGIC));
+  h.format = __FFT_WISDOM_FORMAT;
+  h.version = CAM_VERSION;
+  h.tier = __fft_wisdom_tier();
+  h.count = (uint32_t)records;
+  h.size = offset;
+  h.order = __FFT_WISDOM_ORDER;
+
+  // Tables in record order, matching the offsets above
+  FILE* f = fopen(path, "wb");
+  bool ok = f != NULL;
+  uint64_t at = 0;
+  if (ok) {
+    ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    at = sizeof(h);
+    ok = ok && __fft_wisdom_write(f, r, records * sizeof(__fft_wisdom_record), &at);
+  }
+  k = 0;
+  for (size_t i = 0; ok && i < count; ++i) {
+    if (plans[i]->strategy != CAM_FFT_SIX_STEP && plans[i]->strategy != CAM_FFT_RADIX4) { continue; }
+    cam_fft_plan* parts[3] = { plans[i], plans[i]->cols, plans[i]->rows };
+    for (size_t p = 0; ok && p < (plans[i]->cols ? 3u : 1u); ++p, ++k) {
+      if (r[k].perm) { ok = __fft_wisdom_write(f, parts[p]->perm, parts[p]->n * sizeof(uint32_t), &at); }
+      ok = ok && __fft_wisdom_write(f, parts[p]->twiddle, r[k].twiddles * sizeof(cfloat), &at);
+    }
+  }
+  if (f && fclose(f) != 0) { ok = false; }
+  free(r);
+  return ok && at == offset;
+}
+
+// Checks that a record describes a plan the transforms can run without reading
+// past the file
+static bool __fft_wisdom_check(const cam_fft_wisdom* w, uint32_t index, bool sub) {
+  const __fft_wisdom_header* h = (const __fft_wisdom_header*)w->data;
+  if (index >= h->count) { return false; }
+  const __fft_wisdom_record* r = (const __fft_wisdom_record*)(h + 1) + index;
+  if (!__fft_valid_size((size_t)r->n)) { return false; }
+  bool six = r->cols != __FFT_WISDOM_NONE;
+  if (r->twiddles != __fft_twiddle_count((size_t)r->n, six)) { return false; }
+  if ((r->twiddle & 63) || r->twiddle > w->size || (w->size - r->twiddle) / sizeof(cfloat) < r->twiddles) { return false; }
+  if (six) {
+    if (sub || __fft_log2((size_t)r->n) < 16 || !__fft_wisdom_check(w, r->cols, true) || !__fft_wisdom_check(w, r->rows, true)) { return false; }
+    const __fft_wisdom_record* c = (const __fft_wisdom_record*)(h + 1) + r->cols;
+    const __fft_wisdom_record* o = (const __fft_wisdom_record*)(h + 1) + r->rows;
+    size_t bits = (__fft_log2((size_t)r->n) + 1) / 2;
+    return c->n == ((uint64_t)1 << bits) && o->n == (r->n >> bits);
+  }
+  return r->perm != 0 && !(r->perm & 63) && r->perm <= w->size && (w->size - r->perm) / sizeof(uint32_t) >= r->n;
+}
+
+cam_fft_wisdom* cam_fft_wisdom_load(const char* path) {
+  cam_fft_wisdom* w = (cam_fft_wisdom*)calloc(1, sizeof(cam_fft_wisdom));
+  if (!w) { return NULL; }
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  LARGE_INTEGER size;
+  if (file == INVALID_HANDLE_VALUE) {
+    free(w);
+    return NULL;
+  }
+  if (GetFileSizeEx(file, &size) && (uint64_t)size.QuadPart >= sizeof(__fft_wisdom_header) && (uint64_t)size.QuadPart <= (uint64_t)SIZE_MAX) {
+    HANDLE map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (map) {
+      w->data = (const unsigned char*)MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+      w->size = (size_t)size.QuadPart;
+      w->handle = map;
+      if (!w->data) { CloseHandle(map); }
+    }
+  }
+  CloseHandle(file);
+#else
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0) {
+    free(w);
+    return NULL;
+  }
+  if (fstat(fd, &st) == 0 && (uint64_t)st.st_size >= sizeof(__fft_wisdom_header) && (uint64_t)st.st_size <= (uint64_t)SIZE_MAX) {
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      w->data = (const unsigned char*)p;
+      w->size = (size_t)st.st_size;
+    }
+  }
+  close(fd);
+#endif
+  if (!w->data) {
+    free(w);
+    return NULL;
+  }
+
+  // Anything written differently is rebuilt rather than trusted
+  const __fft_wisdom_header* h = (const __fft_wisdom_header*)w->data;
+  bool ok = memcmp(h->magic, __FFT_WISDOM_MAGIC, sizeof(__FFT_WISDOM_MAGIC)) == 0 && h->order == __FFT_WISDOM_ORDER &&
+    h->format == __FFT_WISDOM_FORMAT && h->version == CAM_VERSION && h->tier == __fft_wisdom_tier() &&
+    h->size == w->size && (w->size - sizeof(*h)) / sizeof(__fft_wisdom_record) >= h->count;
+  const __fft_wisdom_record* r = (const __fft_wisdom_record*)(h + 1);
+  for (uint32_t i = 0; ok && i < h->count; ++i) {
+    if (r[i].saved) { ok = __fft_wisdom_check(w, i, false); }
+  }
+  if (!ok) {
+    cam_fft_wisdom_close(w);
+    return NULL;
+  }
+  return w;
+}
+
+// Plan head whose tables point into the mapping
+static cam_fft_plan* __fft_wisdom_plan(cam_fft_wisdom* w, uint32_t index) {
+  const __fft_wisdom_record* r = (const __fft_wisdom_record*)((const __fft_wisdom_header*)w->data + 1) + index;
+  cam_fft_plan* plan = __fft_plan_alloc((size_t)r->n, (r->cols != __FFT_WISDOM_NONE) ? CAM_FFT_SIX_STEP : CAM_FFT_RADIX4, 0);
+  if (!plan) { return NULL; }
+  plan->perm = r->perm ? (uint32_t*)(w->data + r->perm) : NULL;
+  plan->twiddle = (cfloat*)(w->data + r->twiddle);
+  if (r->cols != __FFT_WISDOM_NONE) {
+    plan->cols = __fft_wisdom_plan(w, r->cols);
+    plan->rows = __fft_wisdom_plan(w, r->rows);
+    if (!plan->cols || !plan->rows) {
+      cam_fft_plan_free(plan);
+      return NULL;
+    }
+  }
+  return plan;
+}
+
+cam_fft_plan* cam_fft_wisdom_plan(cam_fft_wisdom* w, size_t n) {
+  if (w) {
+    const __fft_wisdom_header* h = (const __fft_wisdom_header*)w->data;
+    const __fft_wisdom_record* r = (const __fft_wisdom_record*)(h + 1);
+    for (uint32_t i = 0; i < h->count; ++i) {
+      if (r[i].saved && r[i].n == n) {
+        cam_fft_plan* plan = __fft_wisdom_plan(w, i);
+        if (plan) { return plan; }
+        break;
+      }
+    }
+  }
+  return cam_fft_plan_make(n);
+}
+
+void cam_fft_wisdom_close(cam_fft_wisdom* w) {
+  if (!w) { return; }
+#if defined(_WIN32)
+  if (w->data) {
+    UnmapViewOfFile(w->data);
+    CloseHandle((HANDLE)w->handle);
+  }
+#else
+  if (w->data) { munmap((void*)w->data, w->size); }
+#endif
+  free(w);
+}
+
+#endif
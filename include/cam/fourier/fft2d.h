@@ -0,0 +1,65 @@
+/*
+ * fft2d.h
+ * Declaration for two dimensional single precision fast fourier transforms.
+ */
+
+#ifndef CAM_FOURIER_FFT2D_H
+#define CAM_FOURIER_FFT2D_H
+
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/fft.h"
+
+/* Define cam_fft2d_plan struct */
+// Transforms of a rows x cols matrix in row major order: every row, then every column.
+// Rows are transformed in place, spread over the threads of cam/thread.h. Columns are
+// taken in bands of 8, each transposed tile by tile into a contiguous buffer,
+// transformed there and transposed back, so no pass strides through the matrix a row
+// at a time. Bands are spread over the threads like rows.
+//
+// Real transforms pack two rows into one complex row, the first as the real parts
+// and the second as the imaginary parts, and split the spectra of the two apart.
+// They keep the cols / 2 + 1 columns the spectrum of a real matrix is determined by.
+typedef struct {
+  size_t rows, cols;        // Matrix shape
+  cam_fft_plan* row;        // Plan of cols points
+  cam_fft_plan* col;        // Plan of rows points, the row plan when the two are equal
+} cam_fft2d_plan;
+
+
+/* cam_fft2d_plan functions */
+// Returns NULL if cam_fft_plan_make fails for rows or cols
+CAM_FOURIER_API cam_fft2d_plan* cam_fft2d_plan_make(size_t rows, size_t cols);
+
+CAM_FOURIER_API void cam_fft2d_plan_free(cam_fft2d_plan* plan);
+
+
+/* Transform functions */
+// Each task of the column pass allocates working space of 8 columns, without which
+// dst is filled with NaN.
+
+// dst[r][c] = sum over j, k of src[j][k] e^(-2 pi i (jr / rows + kc / cols)), rows x cols
+// values each. dst == src transforms in place, otherwise the two must not overlap.
+CAM_FOURIER_API void cam_fft2d_forward(cam_fft2d_plan* plan, cfloat* dst, cfloat* src);
+
+// The inverse, scaled by 1 / (rows cols), undoing cam_fft2d_forward
+CAM_FOURIER_API void cam_fft2d_inverse(cam_fft2d_plan* plan, cfloat* dst, cfloat* src);
+
+// Columns [0, cols / 2] of the transform of the real rows x cols matrix src, written to
+// dst as rows x (cols / 2 + 1) values; the others are conj(X[(rows - r) % rows][cols - c]).
+// src is left unchanged and must not overlap dst.
+CAM_FOURIER_API void cam_rfft2d(cam_fft2d_plan* plan, cfloat* dst, float* src);
+
+// Rebuilds the real rows x cols matrix whose transform has the columns in src, laid out
+// as cam_rfft2d writes them, scaled by 1 / (rows cols). Imaginary parts left in column
+// 0, and in column cols / 2 for even cols, after the column transforms are ignored.
+// src is left unchanged and must not overlap dst; working space of its size is
+// allocated, without which dst is filled with NaN.
+CAM_FOURIER_API void cam_irfft2d(cam_fft2d_plan* plan, float* dst, cfloat* src);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/fft2d.inl"
+#endif
+
+#endif
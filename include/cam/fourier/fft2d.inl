@@ -0,0 +1,293 @@
+/*
+ * fft2d.inl
+ * Definitions for two dimensional single precision fast fourier transforms.
+ * Compiled by src/fourier/fft2d.c, or included by fft2d.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_FFT2D_INL
+#define CAM_FOURIER_FFT2D_INL
+
+#include "cam/fourier/fft2d.h"
+#include "cam/thread.h"
+#include <math.h>
+#include <string.h>
+
+/* fft2d helpers */
+// A band of __FFT2D_BAND columns spans a cache line of every row it reads. The band
+// is gathered into rows of a buffer, one per column, by transposing blocks of
+// __FFT2D_TILE x __FFT2D_TILE values in registers (2 x 2 with 128 bit vectors), and
+// scattered back the same way.
+//
+// Packing real rows a and b as z = a + i b, the spectra come apart through
+//   A[k] = (Z[k] + conj(Z[-k])) / 2,   B[k] = -i (Z[k] - conj(Z[-k])) / 2,
+// indices modulo cols, and go back together as Z[k] = A[k] + i B[k] with
+// A[-k] = conj(A[k]) filling the columns past cols / 2.
+
+#define __FFT2D_BAND 8   // Columns transformed together
+#define __FFT2D_TILE 4   // Side of the blocks transposed in registers
+
+// Arguments shared by the tasks of a pass
+typedef struct {
+  const cam_fft2d_plan* plan;
+  cfloat* dst;              // Matrix written
+  const cfloat* src;        // Matrix read, dst for passes in place
+  float* real;              // Real matrix written or read by the row pass of a real transform
+  size_t width;             // Complex values per row of dst and src
+  bool inverse;
+  bool failed;              // Set by tasks that could not allocate working space
+} __fft2d_job;
+
+#if defined(CAM_SIMD_AVX2)
+// Transposes the 4 x 4 block of complex values in v0 .. v3, each value read as a double
+static inline void __fft2d_transpose(__m256* v0, __m256* v1, __m256* v2, __m256* v3) {
+  __m256d a0 = _mm256_castps_pd(*v0), a1 = _mm256_castps_pd(*v1);
+  __m256d a2 = _mm256_castps_pd(*v2), a3 = _mm256_castps_pd(*v3);
+  __m256d t0 = _mm256_unpacklo_pd(a0, a1), t1 = _mm256_unpackhi_pd(a0, a1);
+  __m256d t2 = _mm256_unpacklo_pd(a2, a3), t3 = _mm256_unpackhi_pd(a2, a3);
+  *v0 = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x20));
+  *v1 = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x20));
+  *v2 = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x31));
+  *v3 = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x31));
+}
+#endif
+
+// Writes the transpose of the count x width block at src, rows lds apart, to dst,
+// rows ldd apart
+static void __fft2d_move(cfloat* dst, size_t ldd, const cfloat* src, size_t lds, size_t count, size_t width) {
+  size_t i = 0;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  if (width % __FFT2D_TILE == 0) {
+    for (; i + __FFT2D_TILE <= count; i += __FFT2D_TILE) {
+      const float* p = (const float*)(src + (i * lds));
+      for (size_t j = 0; j < width; j += __FFT2D_TILE) {
+        __m256 v0 = _mm256_loadu_ps(p + (2 * j));
+        __m256 v1 = _mm256_loadu_ps(p + (2 * (lds + j)));
+        __m256 v2 = _mm256_loadu_ps(p + (2 * ((2 * lds) + j)));
+        __m256 v3 = _mm256_loadu_ps(p + (2 * ((3 * lds) + j)));
+        __fft2d_transpose(&v0, &v1, &v2, &v3);
+        float* q = (float*)(dst + (j * ldd) + i);
+        _mm256_storeu_ps(q, v0);
+        _mm256_storeu_ps(q + (2 * ldd), v1);
+        _mm256_storeu_ps(q + (4 * ldd), v2);
+        _mm256_storeu_ps(q + (6 * ldd), v3);
+      }
+    }
+  }
+#elif defined(CAM_SIMD_AVX)
+  // Intel AVX
+  if (width % 2 == 0) {
+    for (; i + 2 <= count; i += 2) {
+      const float* p = (const float*)(src + (i * lds));
+      for (size_t j = 0; j < width; j += 2) {
+        __m128 v0 = _mm_loadu_ps(p + (2 * j));
+        __m128 v1 = _mm_loadu_ps(p + (2 * (lds + j)));
+        float* q = (float*)(dst + (j * ldd) + i);
+        _mm_storeu_ps(q, _mm_movelh_ps(v0, v1));
+        _mm_storeu_ps(q + (2 * ldd), _mm_movehl_ps(v1, v0));
+      }
+    }
+  }
+#endif
+  // No SIMD intrinsics
+  for (; i < count; ++i) {
+    for (size_t j = 0; j < width; ++j) { dst[(j * ldd) + i] = src[(i * lds) + j]; }
+  }
+}
+
+static void __fft2d_fail(cfloat* dst, size_t count) {
+  for (size_t k = 0; k < count; ++k) {
+    dst[k].re = NAN;
+    dst[k].im = NAN;
+  }
+}
+
+// Transforms rows [begin, end) of job->dst in place
+static void __fft2d_rows_task(void* arg, size_t begin, size_t end) {
+  __fft2d_job* job = (__fft2d_job*)arg;
+  size_t cols = job->plan->cols;
+  for (size_t r = begin; r < end; ++r) {
+    cfloat* x = job->dst + (r * cols);
+    if (job->inverse) { cam_fft_inverse(job->plan->row, x, (cfloat*)job->src + (r * cols)); }
+    else { cam_fft_forward(job->plan->row, x, (cfloat*)job->src + (r * cols)); }
+  }
+}
+
+// Transforms the columns of bands [begin, end) of job->src into job->dst
+static void __fft2d_cols_task(void* arg, size_t begin, size_t end) {
+  __fft2d_job* job = (__fft2d_job*)arg;
+  size_t rows = job->plan->rows, width = job->width;
+  cfloat* buf = (cfloat*)cam_aligned_alloc(__FFT2D_BAND * rows * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!buf) {
+    job->failed = true;
+    return;
+  }
+  for (size_t b = begin; b < end; ++b) {
+    size_t c = b * __FFT2D_BAND;
+    size_t m = (width - c < __FFT2D_BAND) ? width - c : __FFT2D_BAND;
+    __fft2d_move(buf, rows, job->src + c, width, rows, m);
+    for (size_t j = 0; j < m; ++j) {
+      cfloat* x = buf + (j * rows);
+      if (job->inverse) { cam_fft_inverse(job->plan->col, x, x); }
+      else { cam_fft_forward(job->plan->col, x, x); }
+    }
+    __fft2d_move(job->dst + c, width, buf, rows, m, rows);
+  }
+  cam_aligned_free(buf);
+}
+
+// Transforms the real rows of job->real in pairs [begin, end) into the half spectra
+// of job->dst
+static void __fft2d_real_rows_task(void* arg, size_t begin, size_t end) {
+  __fft2d_job* job = (__fft2d_job*)arg;
+  size_t rows = job->plan->rows, cols = job->plan->cols, width = job->width;
+  cfloat* z = (cfloat*)cam_aligned_alloc(cols * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!z) {
+    job->failed = true;
+    return;
+  }
+  for (size_t p = begin; p < end; ++p) {
+    const float* a = job->real + (2 * p * cols);
+    const float* b = (2 * p + 1 < rows) ? a + cols : NULL;
+    for (size_t k = 0; k < cols; ++k) {
+      z[k].re = a[k];
+      z[k].im = b ? b[k] : 0.0f;
+    }
+    cam_fft_forward(job->plan->row, z, z);
+
+    cfloat* da = job->dst + (2 * p * width);
+    cfloat* db = da + width;
+    for (size_t k = 0; k < width; ++k) {
+      cfloat u = z[k], v = z[(cols - k) % cols];
+      da[k].re = 0.5f * (u.re + v.re);
+      da[k].im = 0.5f * (u.im - v.im);
+      if (b) {
+        db[k].re = 0.5f * (u.im + v.im);
+        db[k].im = 0.5f * (v.re - u.re);
+      }
+    }
+  }
+  cam_aligned_free(z);
+}
+
+// Rebuilds the real rows of job->real in pairs [begin, end) from the half spectra
+// of job->src
+static void __fft2d_real_inverse_task(void* arg, size_t begin, size_t end) {
+  __fft2d_job* job = (__fft2d_job*)arg;
+  size_t rows = job->plan->rows, cols = job->plan->cols, width = job->width;
+  cfloat* z = (cfloat*)cam_aligned_alloc(cols * sizeof(cfloat), CAM_SIMD_ALIGN);
+  if (!z) {
+    job->failed = true;
+    return;
+  }
+  for (size_t p = begin; p < end; ++p) {
+    const cfloat* sa = job->src + (2 * p * width);
+    const cfloat* sb = (2 * p + 1 < rows) ? sa + width : NULL;
+    for (size_t k = 0; k < width; ++k) {
+      cfloat a = sa[k];
+      cfloat b = sb ? sb[k] : cfloat_make(0.0f, 0.0f);
+      if (k == 0 || 2 * k == cols) { a.im = b.im = 0.0f; }
+      z[k].re = a.re - b.im;
+      z[k].im = a.im + b.re;
+      if (k != 0 && 2 * k != cols) {
+        z[cols - k].re = a.re + b.im;
+        z[cols - k].im = b.re - a.im;
+      }
+    }
+    cam_fft_inverse(job->plan->row, z, z);
+
+    float* xa = job->real + (2 * p * cols);
+    float* xb = xa + cols;
+    for (size_t k = 0; k < cols; ++k) { xa[k] = z[k].re; }
+    if (sb) {
+      for (size_t k = 0; k < cols; ++k) { xb[k] = z[k].im; }
+    }
+  }
+  cam_aligned_free(z);
+}
+
+static void __fft2d_complex(const cam_fft2d_plan* plan, cfloat* dst, const cfloat* src, bool inverse) {
+  __fft2d_job job;
+  memset(&job, 0, sizeof(job));
+  job.plan = plan;
+  job.dst = dst;
+  job.src = src;
+  job.width = plan->cols;
+  job.inverse = inverse;
+  cam_parallel_for(plan->rows, __fft2d_rows_task, &job);
+  job.src = dst;
+  cam_parallel_for((plan->cols + __FFT2D_BAND - 1) / __FFT2D_BAND, __fft2d_cols_task, &job);
+  if (job.failed) { __fft2d_fail(dst, plan->rows * plan->cols); }
+}
+
+
+/* cam_fft2d_plan functions */
+cam_fft2d_plan* cam_fft2d_plan_make(size_t rows, size_t cols) {
+  cam_fft2d_plan* plan = (cam_fft2d_plan*)cam_aligned_alloc(sizeof(cam_fft2d_plan), 64);
+  if (!plan) { return NULL; }
+  plan->rows = rows;
+  plan->cols = cols;
+  plan->row = cam_fft_plan_make(cols);
+  plan->col = (rows == cols) ? plan->row : cam_fft_plan_make(rows);
+  if (!plan->row || !plan->col) {
+    cam_fft2d_plan_free(plan);
+    return NULL;
+  }
+  return plan;
+}
+
+void cam_fft2d_plan_free(cam_fft2d_plan* plan) {
+  if (!plan) { return; }
+  if (plan->col != plan->row) { cam_fft_plan_free(plan->col); }
+  cam_fft_plan_free(plan->row);
+  cam_aligned_free(plan);
+}
+
+
+/* Transform functions */
+void cam_fft2d_forward(cam_fft2d_plan* plan, cfloat* dst, cfloat* src) {
+  __fft2d_complex(plan, dst, src, false);
+}
+
+void cam_fft2d_inverse(cam_fft2d_plan* plan, cfloat* dst, cfloat* src) {
+  __fft2d_complex(plan, dst, src, true);
+}
+
+void cam_rfft2d(cam_fft2d_plan* plan, cfloat* dst, float* src) {
+  size_t rows = plan->rows, width = (plan->cols / 2) + 1;
+  __fft2d_job job;
+  memset(&job, 0, sizeof(job));
+  job.plan = plan;
+  job.dst = dst;
+  job.src = dst;
+  job.real = src;
+  job.width = width;
+  cam_parallel_for((rows + 1) / 2, __fft2d_real_rows_task, &job);
+  cam_parallel_for((width + __FFT2D_BAND - 1) / __FFT2D_BAND, __fft2d_cols_task, &job);
+  if (job.failed) { __fft2d_fail(dst, rows * width); }
+}
+
+void cam_irfft2d(cam_fft2d_plan* plan, float* dst, cfloat* src) {
+  size_t rows = plan->rows, cols = plan->cols, width = (cols / 2) + 1;
+  cfloat* tmp = (cfloat*)cam_aligned_alloc(rows * width * sizeof(cfloat), CAM_SIMD_ALIGN);
+  __fft2d_job job;
+  memset(&job, 0, sizeof(job));
+  job.plan = plan;
+  job.dst = tmp;
+  job.src = src;
+  job.real = dst;
+  job.width = width;
+  job.inverse = true;
+  job.failed = !tmp;
+  if (tmp) {
+    cam_parallel_for((width + __FFT2D_BAND - 1) / __FFT2D_BAND, __fft2d_cols_task, &job);
+    job.src = tmp;
+  }
+  if (!job.failed) { cam_parallel_for((rows + 1) / 2, __fft2d_real_inverse_task, &job); }
+  if (job.failed) {
+    for (size_t k = 0; k < rows * cols; ++k) { dst[k] = NAN; }
+  }
+  cam_aligned_free(tmp);
+}
+
+#endif
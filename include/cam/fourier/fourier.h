@@ -6,4 +6,12 @@
 #ifndef CAM_FOURIER_H
 #define CAM_FOURIER_H
 
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/fft.h"
+#include "cam/fourier/rfft.h"
+#include "cam/fourier/stft.h"
+#include "cam/fourier/convolve.h"
+#include "cam/fourier/dct.h"
+#include "cam/fourier/fft2d.h"
+
 #endif
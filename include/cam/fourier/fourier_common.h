@@ -0,0 +1,24 @@
+/*
+ * fourier_common.h
+ * Declarations common to all objects in the fourier analysis module.
+ */
+
+#ifndef CAM_FOURIER_COMMON_H
+#define CAM_FOURIER_COMMON_H
+
+#include "cam/common.h"
+#include "cam/complex/complex.h"
+
+/* Linkage of the fourier functions */
+// Follows CAM_LINEAR_API: inline in CAM_HEADER_ONLY builds, and compiled once per
+// SIMD tier with internal linkage by the runtime dispatch build (see
+// src/fourier/fourier_tier.h), which overrides this.
+#ifndef CAM_FOURIER_API
+#if defined(CAM_HEADER_ONLY)
+#define CAM_FOURIER_API static inline
+#else
+#define CAM_FOURIER_API CAM_API
+#endif
+#endif
+
+#endif
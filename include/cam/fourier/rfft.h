@@ -0,0 +1,48 @@
+/*
+ * rfft.h
+ * Declaration for single precision fast fourier transforms of real signals.
+ */
+
+#ifndef CAM_FOURIER_RFFT_H
+#define CAM_FOURIER_RFFT_H
+
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/fft.h"
+
+/* Define cam_rfft_plan struct */
+// The n real samples are read as n / 2 complex values (even samples real, odd
+// samples imaginary) and run through a complex transform of half the size, which
+// one twiddle pass then splits into the spectrum of the real signal.
+typedef struct {
+  size_t n;              // Transform size, a power of two of at least 2
+  cam_fft_plan* half;    // Complex plan of size n / 2
+  cfloat* twiddle;       // -i e^(-2 pi i k / n) / 2 for k in [0, n / 4]
+} cam_rfft_plan;
+
+
+/* cam_rfft_plan functions */
+// Returns NULL if n is not a power of two from 2 to 2^32 or allocation fails
+CAM_FOURIER_API cam_rfft_plan* cam_rfft_plan_make(size_t n);
+
+CAM_FOURIER_API void cam_rfft_plan_free(cam_rfft_plan* plan);
+
+
+/* Transform functions */
+// dst[k] = sum over j of src[j] e^(-2 pi i jk / n) for k in [0, n / 2]; the other
+// bins are the conjugates of these. src holds plan->n values and is left unchanged,
+// dst holds n / 2 + 1 values and must not overlap src. dst[0] and dst[n / 2] are real.
+CAM_FOURIER_API void cam_rfft(cam_rfft_plan* plan, cfloat* dst, float* src);
+
+// dst[j] = (1 / n) sum over k of X[k] e^(2 pi i jk / n), where X is the conjugate
+// symmetric spectrum whose first n / 2 + 1 bins are src, undoing cam_rfft.
+// The imaginary parts of src[0] and src[n / 2] are ignored. src is left unchanged
+// and must not overlap dst, which holds plan->n values.
+CAM_FOURIER_API void cam_irfft(cam_rfft_plan* plan, float* dst, cfloat* src);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/rfft.inl"
+#endif
+
+#endif
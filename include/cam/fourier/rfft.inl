@@ -0,0 +1,122 @@
+/*
+ * rfft.inl
+ * Definitions for single precision fast fourier transforms of real signals.
+ * Compiled by src/fourier/rfft.c, or included by rfft.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_RFFT_INL
+#define CAM_FOURIER_RFFT_INL
+
+#include "cam/fourier/rfft.h"
+#include <math.h>
+
+/* rfft helpers */
+// With m = n / 2 and Z the transform of the packed samples, pairing bin k with
+// bin m - k through A = Z[k], B = conj(Z[m - k]), E = (A + B) / 2 and
+// T = c_k (A - B), c_k the plan twiddle, gives
+//   X[k] = E + T,   X[m - k] = conj(E - T).
+// The inverse runs the same pass over A = X[k], B = conj(X[m - k]) with conj(c_k),
+// which rebuilds Z from the spectrum.
+
+#if defined(CAM_SIMD_AVX)
+// Registers hold __RFFT_V interleaved values
+#if defined(CAM_SIMD_AVX2)
+#define __RFFT_V 4
+#define __rfft_reverse(v) _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(0, 1, 2, 3)))
+#else
+#define __RFFT_V 2
+#define __rfft_reverse(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2))
+#endif
+#endif
+
+// Runs the pairing pass for k in [1, m / 2] from src into dst, which may be the same.
+// The registers cover k below m / 2 and m - k above it, so no two iterations touch
+// the same values and the pass is safe in place.
+static void __rfft_pass(cfloat* dst, const cfloat* src, size_t m, const cfloat* tw, bool inverse) {
+  size_t q = m / 2;
+  size_t k = 1;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_vec half = __soa_set1(0.5f);
+  __soa_vec conj = inverse ? __complex_conj(__soa_set1(0.0f)) : __soa_set1(0.0f);
+  for (; k + __RFFT_V <= q; k += __RFFT_V) {
+    size_t r = m - k - (__RFFT_V - 1);
+    __soa_vec a = __soa_loadu((const float*)(src + k));
+    __soa_vec b = __complex_conj(__rfft_reverse(__soa_loadu((const float*)(src + r))));
+    __soa_vec c = __soa_xor(__soa_loadu((const float*)(tw + k)), conj);
+    __soa_vec e = __soa_mul(__soa_add(a, b), half);
+    __soa_vec t = __complex_mul(__soa_sub(a, b), c);
+    __soa_storeu((float*)(dst + k), __soa_add(e, t));
+    __soa_storeu((float*)(dst + r), __complex_conj(__rfft_reverse(__soa_sub(e, t))));
+  }
+#endif
+  // No SIMD intrinsics
+  float cs = inverse ? -1.0f : 1.0f;
+  for (; k <= q; ++k) {
+    cfloat a = src[k];
+    cfloat b = { src[m - k].re, -src[m - k].im };
+    cfloat c = { tw[k].re, cs * tw[k].im };
+    cfloat e = { 0.5f * (a.re + b.re), 0.5f * (a.im + b.im) };
+    cfloat d = { a.re - b.re, a.im - b.im };
+    cfloat t = { (d.re * c.re) - (d.im * c.im), (d.re * c.im) + (d.im * c.re) };
+    dst[k].re = e.re + t.re;
+    dst[k].im = e.im + t.im;
+    dst[m - k].re = e.re - t.re;
+    dst[m - k].im = t.im - e.im;
+  }
+}
+
+
+/* cam_rfft_plan functions */
+cam_rfft_plan* cam_rfft_plan_make(size_t n) {
+  if (n < 2 || (n & (n - 1)) != 0 || n > ((size_t)1 << 32)) { return NULL; }
+  size_t m = n / 2;
+
+  // One allocation holds the plan and the twiddles; the half size plan is its own
+  size_t head = (sizeof(cam_rfft_plan) + 63) & ~(size_t)63;
+  cam_rfft_plan* plan = (cam_rfft_plan*)cam_aligned_alloc(head + ((m / 2 + 1) * sizeof(cfloat)), 64);
+  if (!plan) { return NULL; }
+  plan->n = n;
+  plan->twiddle = (cfloat*)((char*)plan + head);
+  plan->half = cam_fft_plan_make(m);
+  if (!plan->half) {
+    cam_aligned_free(plan);
+    return NULL;
+  }
+
+  // -i e^(-i a) / 2 = (-sin a, -cos a) / 2, evaluated in double
+  for (size_t k = 0; k <= m / 2; ++k) {
+    double a = 2.0 * C_PI * (double)k / (double)n;
+    plan->twiddle[k] = cfloat_make((float)(-0.5 * sin(a)), (float)(-0.5 * cos(a)));
+  }
+  return plan;
+}
+
+void cam_rfft_plan_free(cam_rfft_plan* plan) {
+  if (!plan) { return; }
+  cam_fft_plan_free(plan->half);
+  cam_aligned_free(plan);
+}
+
+
+/* Transform functions */
+void cam_rfft(cam_rfft_plan* plan, cfloat* dst, float* src) {
+  size_t m = plan->n / 2;
+  cam_fft_forward(plan->half, dst, (cfloat*)src);
+  __rfft_pass(dst, dst, m, plan->twiddle, false);
+
+  // Bins 0 and m pair with each other
+  cfloat z = dst[0];
+  dst[0] = cfloat_make(z.re + z.im, 0.0f);
+  dst[m] = cfloat_make(z.re - z.im, 0.0f);
+}
+
+void cam_irfft(cam_rfft_plan* plan, float* dst, cfloat* src) {
+  size_t m = plan->n / 2;
+  cfloat* z = (cfloat*)dst;
+  __rfft_pass(z, src, m, plan->twiddle, true);
+  z[0] = cfloat_make(0.5f * (src[0].re + src[m].re), 0.5f * (src[0].re - src[m].re));
+  cam_fft_inverse(plan->half, z, z);
+}
+
+#endif
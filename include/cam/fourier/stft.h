@@ -0,0 +1,82 @@
+/*
+ * stft.h
+ * Declaration for streaming short-time fourier transforms of real signals.
+ */
+
+#ifndef CAM_FOURIER_STFT_H
+#define CAM_FOURIER_STFT_H
+
+#include "cam/fourier/fourier_common.h"
+#include "cam/fourier/rfft.h"
+
+/* Define cam_window enum */
+// Standard windows, in the periodic form suited to frames that overlap
+typedef enum {
+  CAM_WINDOW_RECT = 0,
+  CAM_WINDOW_HANN,
+  CAM_WINDOW_HAMMING,
+  CAM_WINDOW_BLACKMAN
+} cam_window;
+
+
+/* Define cam_stft struct */
+// A stream of real samples cut into frames of n samples every hop samples, each
+// windowed and transformed by cam_rfft, and the matching resynthesis. The stream
+// starts with n - hop zero samples, so the first frame ends hop samples in and
+// every sample is covered by the same number of frames. Everything a stream needs
+// is allocated by cam_stft_make; pushing samples or spectra allocates nothing.
+typedef struct {
+  size_t n;              // Frame and transform size, a power of two of at least 2
+  size_t hop;            // Samples between the starts of consecutive frames, from 1 to n
+  cam_rfft_plan* plan;   // Transform of every frame
+  float* window;         // Analysis window of n values
+  float* synth;          // Synthesis window: the analysis window over the sum of the squares
+                         // of every window value landing on the same sample
+  float* ring;           // Last n input samples, the oldest at ring[head]
+  size_t head;
+  size_t need;           // Input samples still missing from the next frame
+  float* frame;          // Windowed frame or resynthesized frame of n samples
+  float* ola;            // Overlap-add sums of the next n output samples, the first at ola[out]
+  size_t out;
+} cam_stft;
+
+
+/* Window functions */
+// Writes the n values of a window to dst
+CAM_FOURIER_API void cam_window_fill(float* dst, size_t n, cam_window window);
+
+
+/* cam_stft functions */
+// Streams frames of n samples every hop samples under window, copied from the n
+// values given, or a periodic Hann window when it is NULL. Returns NULL if n is not
+// a power of two from 2 to 2^32, hop is not in [1, n], or allocation fails.
+CAM_FOURIER_API cam_stft* cam_stft_make(size_t n, size_t hop, float* window);
+
+CAM_FOURIER_API void cam_stft_free(cam_stft* s);
+
+// Restarts both directions of the stream, as made
+CAM_FOURIER_API void cam_stft_reset(cam_stft* s);
+
+// Frames that pushing count more samples completes
+CAM_FOURIER_API size_t cam_stft_frames(cam_stft* s, size_t count);
+
+
+/* Transform functions */
+// Appends count samples from src to the stream, any count at a time, and writes the
+// spectrum of every frame they complete to dst: n / 2 + 1 bins per frame, one frame
+// after another. dst holds cam_stft_frames(s, count) frames. Returns the frames written.
+CAM_FOURIER_API size_t cam_stft_push(cam_stft* s, cfloat* dst, float* src, size_t count);
+
+// Resynthesizes frames spectra from src, laid out as cam_stft_push writes them, by
+// weighted overlap-add, writing hop samples per frame to dst. Fed the frames of
+// cam_stft_push, the output is its input delayed by n - hop samples, except where
+// no window value covers a sample. src is left unchanged. Returns the samples written.
+CAM_FOURIER_API size_t cam_istft_push(cam_stft* s, float* dst, cfloat* src, size_t frames);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/fourier/stft.inl"
+#endif
+
+#endif
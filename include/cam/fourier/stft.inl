@@ -0,0 +1,150 @@
+/*
+ * stft.inl
+ * Definitions for streaming short-time fourier transforms of real signals.
+ * Compiled by src/fourier/stft.c, or included by stft.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_FOURIER_STFT_INL
+#define CAM_FOURIER_STFT_INL
+
+#include "cam/fourier/stft.h"
+#include <math.h>
+#include <string.h>
+
+/* stft helpers */
+// Frame k covers samples [k hop, k hop + n) of the stream, counting the n - hop
+// leading zeros. Its resynthesis, weighted by the synthesis window, is added to the
+// same samples of the output, after which the first hop of them have every frame
+// covering them and are written out. The synthesis window makes the weights of
+// each sample sum to one: sample j of a frame meets the samples j + m hop of the
+// other frames covering it, so
+//   synth[j] = window[j] / (sum over i = j mod hop of window[i]^2).
+
+// Windows and transforms the frame ending at the newest sample of the ring
+static void __stft_analyze(cam_stft* s, cfloat* dst) {
+  size_t n = s->n, a = n - s->head;
+  const float* w = s->window;
+  const float* old = s->ring + s->head;
+  for (size_t j = 0; j < a; ++j) { s->frame[j] = w[j] * old[j]; }
+  for (size_t j = a; j < n; ++j) { s->frame[j] = w[j] * s->ring[j - a]; }
+  cam_rfft(s->plan, dst, s->frame);
+}
+
+// Adds a resynthesized frame to the overlap-add sums and moves the first hop of
+// them, now complete, to dst
+static void __stft_synthesize(cam_stft* s, float* dst, cfloat* src) {
+  size_t n = s->n, hop = s->hop, a = n - s->out;
+  const float* w = s->synth;
+  cam_irfft(s->plan, s->frame, src);
+  float* sum = s->ola + s->out;
+  for (size_t j = 0; j < a; ++j) { sum[j] += w[j] * s->frame[j]; }
+  for (size_t j = a; j < n; ++j) { s->ola[j - a] += w[j] * s->frame[j]; }
+
+  size_t first = (hop < a) ? hop : a;
+  memcpy(dst, sum, first * sizeof(float));
+  memcpy(dst + first, s->ola, (hop - first) * sizeof(float));
+  memset(sum, 0, first * sizeof(float));
+  memset(s->ola, 0, (hop - first) * sizeof(float));
+  s->out = (hop < a) ? s->out + hop : hop - a;
+}
+
+
+/* Window functions */
+void cam_window_fill(float* dst, size_t n, cam_window window) {
+  for (size_t j = 0; j < n; ++j) {
+    double c = cos(2.0 * C_PI * (double)j / (double)n);
+    switch (window) {
+      case CAM_WINDOW_HANN: dst[j] = (float)(0.5 - (0.5 * c)); break;
+      case CAM_WINDOW_HAMMING: dst[j] = (float)(0.54 - (0.46 * c)); break;
+      case CAM_WINDOW_BLACKMAN: dst[j] = (float)(0.42 - (0.5 * c) + (0.08 * ((2.0 * c * c) - 1.0))); break;
+      default: dst[j] = 1.0f; break;
+    }
+  }
+}
+
+
+/* cam_stft functions */
+cam_stft* cam_stft_make(size_t n, size_t hop, float* window) {
+  if (hop == 0 || hop > n) { return NULL; }
+  cam_rfft_plan* plan = cam_rfft_plan_make(n);
+  if (!plan) { return NULL; }
+
+  // One allocation holds the stream and its five arrays
+  size_t head = (sizeof(cam_stft) + 63) & ~(size_t)63;
+  size_t array = ((n * sizeof(float)) + 63) & ~(size_t)63;
+  cam_stft* s = (cam_stft*)cam_aligned_alloc(head + (5 * array), 64);
+  if (!s) {
+    cam_rfft_plan_free(plan);
+    return NULL;
+  }
+  s->n = n;
+  s->hop = hop;
+  s->plan = plan;
+  s->window = (float*)((char*)s + head);
+  s->synth = (float*)((char*)s + head + array);
+  s->ring = (float*)((char*)s + head + (2 * array));
+  s->frame = (float*)((char*)s + head + (3 * array));
+  s->ola = (float*)((char*)s + head + (4 * array));
+  if (window) { memcpy(s->window, window, n * sizeof(float)); }
+  else { cam_window_fill(s->window, n, CAM_WINDOW_HANN); }
+
+  // Samples no window value covers are left out of the resynthesis
+  for (size_t j = 0; j < n; ++j) {
+    double d = 0.0;
+    for (size_t i = j % hop; i < n; i += hop) { d += (double)s->window[i] * (double)s->window[i]; }
+    s->synth[j] = (d > 0.0) ? (float)((double)s->window[j] / d) : 0.0f;
+  }
+  cam_stft_reset(s);
+  return s;
+}
+
+void cam_stft_free(cam_stft* s) {
+  if (!s) { return; }
+  cam_rfft_plan_free(s->plan);
+  cam_aligned_free(s);
+}
+
+void cam_stft_reset(cam_stft* s) {
+  memset(s->ring, 0, s->n * sizeof(float));
+  memset(s->ola, 0, s->n * sizeof(float));
+  s->head = 0;
+  s->need = s->hop;
+  s->out = 0;
+}
+
+size_t cam_stft_frames(cam_stft* s, size_t count) {
+  return (count < s->need) ? 0 : 1 + ((count - s->need) / s->hop);
+}
+
+
+/* Transform functions */
+size_t cam_stft_push(cam_stft* s, cfloat* dst, float* src, size_t count) {
+  size_t n = s->n, frames = 0;
+  while (count > 0) {
+    // Never more than a hop, so the ring wraps at most once
+    size_t m = (count < s->need) ? count : s->need;
+    size_t first = (m < n - s->head) ? m : n - s->head;
+    memcpy(s->ring + s->head, src, first * sizeof(float));
+    memcpy(s->ring, src + first, (m - first) * sizeof(float));
+    s->head = (first < n - s->head) ? s->head + m : m - first;
+    s->need -= m;
+    src += m;
+    count -= m;
+    if (s->need == 0) {
+      __stft_analyze(s, dst + (frames * ((n / 2) + 1)));
+      s->need = s->hop;
+      ++frames;
+    }
+  }
+  return frames;
+}
+
+size_t cam_istft_push(cam_stft* s, float* dst, cfloat* src, size_t frames) {
+  size_t bins = (s->n / 2) + 1;
+  for (size_t f = 0; f < frames; ++f) {
+    __stft_synthesize(s, dst + (f * s->hop), src + (f * bins));
+  }
+  return frames * s->hop;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * gauss_apply.inl
+ * Definitions for applying Gauss rules to sampled values.
+ * Compiled by src/integration/gauss_apply.c, src/integration/integration_<tier>.c in runtime
+ * dispatch builds, or included by gauss_rule.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_INTEGRATION_GAUSS_APPLY_INL
+#define CAM_INTEGRATION_GAUSS_APPLY_INL
+
+#include "cam/integration/gauss_rule.h"
+
+/* gauss_apply helpers */
+#if defined(CAM_SIMD_AVX2)
+// Intel AVX2
+static inline __m256d __gauss_fmadd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__) || defined(CAM_CMP_MSVC)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+static inline double __gauss_hsum(__m256d v) {
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+#endif
+
+
+/* Integration functions */
+double cam_gauss_apply(const cam_gauss_rule* rule, const double* y) {
+  const double* w = rule->w;
+  size_t n = rule->n, i = 0;
+  double sum;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  // Four accumulators hide the FMA latency
+  __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+  __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+  for (; i + 16 <= n; i += 16) {
+    s0 = __gauss_fmadd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(y + i), s0);
+    s1 = __gauss_fmadd(_mm256_loadu_pd(w + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+    s2 = __gauss_fmadd(_mm256_loadu_pd(w + i + 8), _mm256_loadu_pd(y + i + 8), s2);
+    s3 = __gauss_fmadd(_mm256_loadu_pd(w + i + 12), _mm256_loadu_pd(y + i + 12), s3);
+  }
+  for (; i + 4 <= n; i += 4) {
+    s0 = __gauss_fmadd(_mm256_loadu_pd(w + i), _mm256_loadu_pd(y + i), s0);
+  }
+  sum = __gauss_hsum(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+#elif defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+  __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+  for (; i + 8 <= n; i += 8) {
+    s0 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(w + i), _mm_loadu_pd(y + i)), s0);
+    s1 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(w + i + 2), _mm_loadu_pd(y + i + 2)), s1);
+    s2 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(w + i + 4), _mm_loadu_pd(y + i + 4)), s2);
+    s3 = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(w + i + 6), _mm_loadu_pd(y + i + 6)), s3);
+  }
+  __m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+  sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+#else
+  // No SIMD intrinsics
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += w[i] * y[i];
+    s1 += w[i + 1] * y[i + 1];
+    s2 += w[i + 2] * y[i + 2];
+    s3 += w[i + 3] * y[i + 3];
+  }
+  sum = (s0 + s1) + (s2 + s3);
+#endif
+  for (; i < n; ++i) { sum += w[i] * y[i]; }
+  return sum;
+}
+
+void cam_gauss_apply_many(const cam_gauss_rule* rule, double* dst, const double* y, size_t count) {
+  size_t n = rule->n, j = 0;
+#if defined(CAM_SIMD_AVX2)
+  // Intel AVX2
+  // One accumulator per set, each weight vector loaded once for four sets
+  const double* w = rule->w;
+  for (; j + 4 <= count; j += 4) {
+    const double* y0 = y + (j * n);
+    const double* y1 = y0 + n;
+    const double* y2 = y1 + n;
+    const double* y3 = y2 + n;
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      __m256d wv = _mm256_loadu_pd(w + i);
+      s0 = __gauss_fmadd(wv, _mm256_loadu_pd(y0 + i), s0);
+      s1 = __gauss_fmadd(wv, _mm256_loadu_pd(y1 + i), s1);
+      s2 = __gauss_fmadd(wv, _mm256_loadu_pd(y2 + i), s2);
+      s3 = __gauss_fmadd(wv, _mm256_loadu_pd(y3 + i), s3);
+    }
+    double d0 = __gauss_hsum(s0), d1 = __gauss_hsum(s1), d2 = __gauss_hsum(s2), d3 = __gauss_hsum(s3);
+    for (; i < n; ++i) {
+      d0 += w[i] * y0[i];
+      d1 += w[i] * y1[i];
+      d2 += w[i] * y2[i];
+      d3 += w[i] * y3[i];
+    }
+    dst[j] = d0;
+    dst[j + 1] = d1;
+    dst[j + 2] = d2;
+    dst[j + 3] = d3;
+  }
+#endif
+  for (; j < count; ++j) { dst[j] = cam_gauss_apply(rule, y + (j * n)); }
+}
+
+#endif
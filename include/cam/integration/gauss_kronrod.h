@@ -0,0 +1,41 @@
+/*
+ * gauss_kronrod.h
+ * Declaration for adaptive Gauss-Kronrod quadrature.
+ */
+
+#ifndef CAM_INTEGRATION_GAUSS_KRONROD_H
+#define CAM_INTEGRATION_GAUSS_KRONROD_H
+
+#include "cam/integration/integration_common.h"
+
+/* Define cam_gk_rule enum */
+// Every interval is integrated by a Kronrod rule, and the difference from the Gauss
+// rule embedded in it estimates the error, scaled as QUADPACK does.
+typedef enum {
+  CAM_GK15 = 0,   // 7 point Gauss, 15 point Kronrod
+  CAM_GK21        // 10 point Gauss, 21 point Kronrod
+} cam_gk_rule;
+
+
+/* Integration functions */
+// Integrates f over [a, b], a > b flipping the sign, until the summed error estimate
+// is at most max(abs_tol, rel_tol |value|).
+//
+// Intervals wait in a priority queue on their error estimates. Each round takes the
+// worst ones off it, as many as needed for the error left on the queue to be within
+// tolerance, up to 16, and bisects them all. The nodes of every half go to f in a
+// single call of up to 32 x 21 abscissae, so f sees the whole round at once.
+//
+// At most limit intervals are held (at least 1). The result keeps the last estimate
+// when that runs out, when an interval gets too narrow to bisect, or when f returns
+// a value that is not finite, with the status saying which.
+CAM_INTEGRATION_API cam_quad_result cam_gk_integrate(cam_integrand f, void* arg, double a, double b, cam_gk_rule rule,
+  double abs_tol, double rel_tol, size_t limit);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/integration/gauss_kronrod.inl"
+#endif
+
+#endif
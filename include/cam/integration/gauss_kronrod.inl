@@ -0,0 +1,246 @@
+/*
+ * gauss_kronrod.inl
+ * Definitions for adaptive Gauss-Kronrod quadrature.
+ * Compiled by src/integration/gauss_kronrod.c, or included by gauss_kronrod.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_INTEGRATION_GAUSS_KRONROD_INL
+#define CAM_INTEGRATION_GAUSS_KRONROD_INL
+
+#include "cam/integration/gauss_kronrod.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/* gauss_kronrod helpers */
+// Rules are stored by half, the abscissae in (0, 1] falling with the center last. The
+// Gauss weights sit at the abscissae they share with the Kronrod rule and are zero
+// elsewhere. An interval's values are laid out as c - h x[j], c + h x[j] for every j,
+// then f(c).
+
+#define __GK_BATCH 16   // Most intervals bisected per call of the integrand
+#define __GK_MAX_NODES 21
+
+static const double __gk15_x[8] = {
+  0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+  0.741531185599394439863864773280788, 0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+  0.207784955007898467600689403773245, 0.0
+};
+static const double __gk15_wk[8] = {
+  0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+  0.140653259715525918745189590510238, 0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+  0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+static const double __gk15_wg[8] = {
+  0.0, 0.129484966168869693270611432679082, 0.0, 0.279705391489276667901467771423780,
+  0.0, 0.381830050505118944950369775488975, 0.0, 0.417959183673469387755102040816327
+};
+
+static const double __gk21_x[11] = {
+  0.995657163025808080735527280689003, 0.973906528517171720077964012084452, 0.930157491355708226001207180059508,
+  0.865063366688984510732096688423493, 0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+  0.562757134668604683339000099272694, 0.433395394129247190799265943165784, 0.294392862701460198131126603103866,
+  0.148874338981631210884826001129720, 0.0
+};
+static const double __gk21_wk[11] = {
+  0.011694638867371874278064396062192, 0.032558162307964727478818972459390, 0.054755896574351996031381300244580,
+  0.075039674810919952767043140916190, 0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+  0.123491976262065851077208056207242, 0.134709217311473325928054001771707, 0.142775938577060080797094273138717,
+  0.147739104901338491374841515972068, 0.149445554002916905664936468389821
+};
+static const double __gk21_wg[11] = {
+  0.0, 0.066671344308688137593568809893332, 0.0, 0.149451349150580593145776339657697,
+  0.0, 0.219086362515982043995534934228163, 0.0, 0.269266719309996355091226921569469,
+  0.0, 0.295524224714752870173892994651338, 0.0
+};
+
+typedef struct {
+  size_t half;        // Abscissae in (0, 1), the rule has 2 half + 1 nodes
+  const double* x;
+  const double* wk;   // Kronrod weights
+  const double* wg;   // Gauss weights
+} __gk_table;
+
+typedef struct {
+  double a, b;
+  double value, error;
+} __gk_interval;
+
+static inline void __gk_nodes(double* x, const __gk_table* t, double a, double b) {
+  double c = 0.5 * (a + b), h = 0.5 * (b - a);
+  for (size_t j = 0; j < t->half; ++j) {
+    x[2 * j] = c - (h * t->x[j]);
+    x[(2 * j) + 1] = c + (h * t->x[j]);
+  }
+  x[2 * t->half] = c;
+}
+
+// Integrates an interval from its values y, as QUADPACK's qk15 and qk21 do
+static void __gk_apply(__gk_interval* iv, const __gk_table* t, const double* y) {
+  size_t m = t->half;
+  double h = 0.5 * (iv->b - iv->a);
+  double fc = y[2 * m];
+  double rk = t->wk[m] * fc, rg = t->wg[m] * fc, rabs = fabs(rk);
+  for (size_t j = 0; j < m; ++j) {
+    double s = y[2 * j] + y[(2 * j) + 1];
+    rk += t->wk[j] * s;
+    rg += t->wg[j] * s;
+    rabs += t->wk[j] * (fabs(y[2 * j]) + fabs(y[(2 * j) + 1]));
+  }
+  double mean = 0.5 * rk;
+  double rasc = t->wk[m] * fabs(fc - mean);
+  for (size_t j = 0; j < m; ++j) { rasc += t->wk[j] * (fabs(y[2 * j] - mean) + fabs(y[(2 * j) + 1] - mean)); }
+
+  double ah = fabs(h), err = fabs((rk - rg) * h);
+  rabs *= ah;
+  rasc *= ah;
+  if (rasc != 0.0 && err != 0.0) { err = rasc * fmin(1.0, pow(200.0 * err / rasc, 1.5)); }
+  if (rabs > DBL_MIN / (50.0 * DBL_EPSILON)) { err = fmax(50.0 * DBL_EPSILON * rabs, err); }
+  iv->value = rk * h;
+  iv->error = err;
+}
+
+// Intervals whose midpoint is no longer distinct from their ends in double precision
+static inline bool __gk_narrow(const __gk_interval* iv) {
+  double w = fabs(iv->b - iv->a);
+  return w <= 100.0 * DBL_EPSILON * fmax(fabs(iv->a), fabs(iv->b)) || w <= 1000.0 * DBL_MIN;
+}
+
+// Max heap on error
+static void __gk_push(__gk_interval* heap, size_t* count, __gk_interval iv) {
+  size_t k = (*count)++;
+  while (k > 0) {
+    size_t p = (k - 1) / 2;
+    if (heap[p].error >= iv.error) { break; }
+    heap[k] = heap[p];
+    k = p;
+  }
+  heap[k] = iv;
+}
+
+static __gk_interval __gk_pop(__gk_interval* heap, size_t* count) {
+  __gk_interval top = heap[0], last = heap[--(*count)];
+  size_t n = *count, k = 0;
+  for (;;) {
+    size_t c = (2 * k) + 1;
+    if (c >= n) { break; }
+    if (c + 1 < n && heap[c + 1].error > heap[c].error) { ++c; }
+    if (heap[c].error <= last.error) { break; }
+    heap[k] = heap[c];
+    k = c;
+  }
+  if (n > 0) { heap[k] = last; }
+  return top;
+}
+
+
+/* Integration functions */
+cam_quad_result cam_gk_integrate(cam_integrand f, void* arg, double a, double b, cam_gk_rule rule,
+  double abs_tol, double rel_tol, size_t limit) {
+  __gk_table t;
+  t.half = (rule == CAM_GK15) ? 7 : 10;
+  t.x = (rule == CAM_GK15) ? __gk15_x : __gk21_x;
+  t.wk = (rule == CAM_GK15) ? __gk15_wk : __gk21_wk;
+  t.wg = (rule == CAM_GK15) ? __gk15_wg : __gk21_wg;
+  size_t n = (2 * t.half) + 1;
+  if (limit < 1) { limit = 1; }
+
+  cam_quad_result res;
+  memset(&res, 0, sizeof(res));
+  size_t heap_bytes = ((limit * sizeof(__gk_interval)) + 63) & ~(size_t)63;
+  size_t node_bytes = 2 * __GK_BATCH * __GK_MAX_NODES * sizeof(double);
+  char* mem = (char*)cam_aligned_alloc(heap_bytes + (2 * node_bytes), 64);
+  if (!mem) {
+    res.value = res.error = NAN;
+    res.status = CAM_QUAD_NOMEM;
+    return res;
+  }
+  __gk_interval* heap = (__gk_interval*)mem;
+  double* x = (double*)(mem + heap_bytes);
+  double* y = (double*)(mem + heap_bytes + node_bytes);
+  __gk_interval split[__GK_BATCH];
+  size_t count = 0;
+
+  __gk_interval whole = { a, b, 0.0, 0.0 };
+  __gk_nodes(x, &t, a, b);
+  f(arg, y, x, n);
+  res.evals = n;
+  res.calls = 1;
+  __gk_apply(&whole, &t, y);
+  __gk_push(heap, &count, whole);
+
+  // Running sums over the queue, and over intervals retired as too narrow
+  double value = whole.value, error = whole.error, kept_value = 0.0, kept_error = 0.0;
+  for (;;) {
+    if (!isfinite(value) || !isfinite(error)) {
+      res.status = CAM_QUAD_NONFINITE;
+      break;
+    }
+    double tol = fmax(abs_tol, rel_tol * fabs(value + kept_value));
+    if (error + kept_error <= tol) {
+      // Confirm against sums free of the drift of the running updates
+      value = error = 0.0;
+      for (size_t i = 0; i < count; ++i) {
+        value += heap[i].value;
+        error += heap[i].error;
+      }
+      if (error + kept_error <= tol) {
+        res.status = CAM_QUAD_OK;
+        break;
+      }
+    }
+
+    // Take the worst intervals until the error left behind is within tolerance
+    size_t k = 0;
+    double left = error + kept_error;
+    while (count > 0 && k < __GK_BATCH && count + (2 * k) + 1 <= limit) {
+      if (k > 0 && left <= tol) { break; }
+      __gk_interval iv = __gk_pop(heap, &count);
+      if (__gk_narrow(&iv)) {
+        value -= iv.value;
+        error -= iv.error;
+        kept_value += iv.value;
+        kept_error += iv.error;
+        continue;
+      }
+      left -= iv.error;
+      split[k++] = iv;
+    }
+    if (k == 0) {
+      res.status = (count > 0) ? CAM_QUAD_LIMIT : CAM_QUAD_ROUNDOFF;
+      break;
+    }
+
+    for (size_t i = 0; i < k; ++i) {
+      double mid = 0.5 * (split[i].a + split[i].b);
+      __gk_nodes(x + (2 * i * n), &t, split[i].a, mid);
+      __gk_nodes(x + (((2 * i) + 1) * n), &t, mid, split[i].b);
+    }
+    f(arg, y, x, 2 * k * n);
+    res.evals += 2 * k * n;
+    res.calls += 1;
+    for (size_t i = 0; i < k; ++i) {
+      double mid = 0.5 * (split[i].a + split[i].b);
+      __gk_interval lo = { split[i].a, mid, 0.0, 0.0 }, hi = { mid, split[i].b, 0.0, 0.0 };
+      __gk_apply(&lo, &t, y + (2 * i * n));
+      __gk_apply(&hi, &t, y + (((2 * i) + 1) * n));
+      value += lo.value + hi.value - split[i].value;
+      error += lo.error + hi.error - split[i].error;
+      __gk_push(heap, &count, lo);
+      __gk_push(heap, &count, hi);
+    }
+  }
+
+  value = kept_value;
+  error = kept_error;
+  for (size_t i = 0; i < count; ++i) {
+    value += heap[i].value;
+    error += heap[i].error;
+  }
+  res.value = value;
+  res.error = error;
+  cam_aligned_free(mem);
+  return res;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * gauss_rule.h
+ * Declaration for fixed order Gauss-Legendre and Gauss-Jacobi rules.
+ */
+
+#ifndef CAM_INTEGRATION_GAUSS_RULE_H
+#define CAM_INTEGRATION_GAUSS_RULE_H
+
+#include "cam/integration/integration_common.h"
+
+/* Define cam_gauss_rule struct */
+// An n point Gauss rule for the weight (1 - x)^alpha (1 + x)^beta on [-1, 1], exact for
+// polynomials up to degree 2n - 1 times the weight. Legendre rules have alpha = beta = 0.
+// Nodes are in ascending order; x and w are CAM_SIMD_ALIGN aligned.
+typedef struct {
+  size_t n;
+  double alpha;
+  double beta;
+  double* x;             // Nodes
+  double* w;             // Weights
+} cam_gauss_rule;
+
+
+/* Node functions */
+// Writes the nodes and weights of the n point Gauss-Legendre rule to x and w, in O(n).
+//
+// Nodes are found by Newton's method in theta = acos(x), which keeps its relative
+// precision up to the ends. The 10 nodes nearest each end use the three term
+// recurrence; every other node uses 20 terms of the Stieltjes asymptotic series of
+// P_n(cos theta), which costs the same for any n. Weights follow from the derivative at
+// each node and are scaled to sum to 2. Nodes come out within an ulp or so and weights
+// within about n ulps at the ends, a few ulps elsewhere. Returns false if n is 0.
+CAM_INTEGRATION_API bool cam_gauss_legendre_nodes(double* x, double* w, size_t n);
+
+// Writes the nodes and weights of the n point Gauss-Jacobi rule to x and w, in O(n).
+//
+// Nodes are found by Newton's method in theta from Gatteschi's estimate of their
+// position, the lower half from x = -1 by symmetry. The 10 nodes nearest each end use
+// the three term recurrence, as do the next few when alpha or beta is large enough
+// that the series has not converged there; every other node uses up to 20 terms of
+// the Hale-Townsend asymptotic expansion of P_n^(alpha, beta)(cos theta). Weights are
+// scaled to sum to the integral of the weight function. Returns false if n is 0 or
+// alpha or beta is not above -1.
+CAM_INTEGRATION_API bool cam_gauss_jacobi_nodes(double* x, double* w, size_t n, double alpha, double beta);
+
+
+/* Cache functions */
+// Rules made on first use and kept for the life of the process, one per order and
+// exponents, shared by every thread. Lookups take a lock, so fetch a rule once rather
+// than per integral. Return NULL if the arguments are out of range or memory runs out.
+// CAM_HEADER_ONLY builds keep one cache per translation unit.
+CAM_INTEGRATION_API const cam_gauss_rule* cam_gauss_legendre(size_t n);
+CAM_INTEGRATION_API const cam_gauss_rule* cam_gauss_jacobi(size_t n, double alpha, double beta);
+
+// Frees every cached rule. Rules fetched before must not be used after.
+CAM_INTEGRATION_API void cam_gauss_cache_clear();
+
+
+/* Integration functions */
+// Integrates f over [a, b] with rule, the weight taken in the variable mapped to [-1, 1],
+// in one call of f on the n mapped nodes. Returns NAN if memory runs out.
+CAM_INTEGRATION_API double cam_gauss_integrate(const cam_gauss_rule* rule, cam_integrand f, void* arg, double a, double b);
+
+// Sum of w[i] y[i] over the rule, for samples y taken at the rule's nodes.
+CAM_INTEGRATION_KERNEL_API double cam_gauss_apply(const cam_gauss_rule* rule, const double* y);
+
+// cam_gauss_apply for count sample sets, set j being the n values at y + j n, into dst[j].
+// Sets are taken four at a time so each weight is loaded once for all four.
+CAM_INTEGRATION_KERNEL_API void cam_gauss_apply_many(const cam_gauss_rule* rule, double* dst, const double* y, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/integration/gauss_rule.inl"
+#include "cam/integration/gauss_apply.inl"
+#endif
+
+#endif
@@ -0,0 +1,355 @@
+/*
+ * gauss_rule.inl
+ * Definitions for fixed order Gauss-Legendre and Gauss-Jacobi rules.
+ * Compiled by src/integration/gauss_rule.c, or included by gauss_rule.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_INTEGRATION_GAUSS_RULE_INL
+#define CAM_INTEGRATION_GAUSS_RULE_INL
+
+#include "cam/integration/gauss_rule.h"
+#include <math.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef SRWLOCK __gauss_lock;
+#define __GAUSS_LOCK_INIT SRWLOCK_INIT
+#define __gauss_lock(l) AcquireSRWLockExclusive(l)
+#define __gauss_unlock(l) ReleaseSRWLockExclusive(l)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t __gauss_lock;
+#define __GAUSS_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define __gauss_lock(l) pthread_mutex_lock(l)
+#define __gauss_unlock(l) pthread_mutex_unlock(l)
+#endif
+
+#define __GAUSS_ENDS 10        // Nodes at each end found on the recurrence
+#define __GAUSS_TERMS 20       // Most terms of the asymptotic series
+#define __GAUSS_NEWTON 30      // Most Newton steps per node
+#define __GAUSS_HEAD 64        // Bytes before the node arrays of a cached rule
+
+/* gauss_rule helpers */
+// P_n(cos theta) by the three term recurrence, and its derivative in theta in dp. Runs on
+// the differences P_k - P_(k-1) in u = 1 - cos theta (Reinsch), which stay accurate
+// near x = 1 where x itself has too few bits left to place the node.
+static double __gauss_legendre_recur(size_t n, double theta, double* dp) {
+  double sh = sin(0.5 * theta), u = 2.0 * sh * sh;
+  double p = 1.0, diff = -u;
+  for (size_t k = 1; k <= n; ++k) {
+    double kk = (double)k;
+    if (k > 1) { diff = (((kk - 1.0) * diff) - (((2.0 * kk) - 1.0) * u * p)) / kk; }
+    p += diff;
+  }
+  // (x P_n - P_(n-1)) = (P_n - P_(n-1)) - u P_n
+  *dp = (double)n * (diff - (u * p)) / sin(theta);
+  return p;
+}
+
+// P_n(cos theta) over C_n = (4 / pi) n! / (3/2)_n, and its derivative in theta in dp:
+// sum of h_m cos(a_m) / (2 sin theta)^(m + 1/2), a_m = (n + m + 1/2) theta - (m + 1/2) pi / 2.
+// h_m falls as m! / n^m while (2 sin theta)^m > 1 away from the ends, so the terms
+// shrink quickly for every node past the first few.
+static double __gauss_legendre_series(size_t n, double theta, double* dp) {
+  double s = sin(theta), c = cos(theta), cot = c / s;
+  double inv = 0.5 / s, f = sqrt(inv);
+  double a = (((double)n + 0.5) * theta) - C_PI_4;
+  double ca = cos(a), sa = sin(a);
+  double p = 0.0, d = 0.0;
+  for (int m = 0; m < __GAUSS_TERMS; ++m) {
+    double mm = (double)m;
+    if (m > 0) { f *= inv * (mm - 0.5) * (mm - 0.5) / (mm * ((double)n + mm + 0.5)); }
+    p += f * ca;
+    d -= f * ((((double)n + mm + 0.5) * sa) + ((mm + 0.5) * cot * ca));
+
+    // a_{m+1} = a_m + theta - pi/2
+    double t = (ca * s) + (sa * c);
+    sa = (sa * s) - (ca * c);
+    ca = t;
+  }
+  *dp = d;
+  return p;
+}
+
+// Q_n(cos theta) = P_n^(alpha, beta)(cos theta) / P_n^(alpha, beta)(1), and its derivative
+// in theta in dp: the Legendre recurrence above generalized, on the differences
+// Q_k - Q_(k-1) in u = 1 - cos theta.
+static double __gauss_jacobi_recur(size_t n, double alpha, double beta, double theta, double* dp) {
+  double sh = sin(0.5 * theta), u = 2.0 * sh * sh, ab = alpha + beta;
+  double q = 1.0, diff = -0.5 * (ab + 2.0) * u / (alpha + 1.0);
+  for (size_t k = 1; k <= n; ++k) {
+    double kk = (double)k, s = (2.0 * kk) + ab;
+    if (k > 1) {
+      double b = (kk + beta - 1.0) * s * (kk - 1.0) / ((kk + ab) * (s - 2.0) * (kk + alpha));
+      double e = (s - 1.0) * s / (2.0 * (kk + ab) * (kk + alpha));
+      diff = (b * diff) - (e * u * q);
+    }
+    q += diff;
+  }
+  double nn = (double)n, s = (2.0 * nn) + ab;
+  *dp = nn * ((2.0 * (nn + beta) * diff) - (s * u * q)) / (s * sin(theta));
+  return q;
+}
+
+// P_n^(alpha, beta)(cos theta) over K = 2^(2 rho) B(n + alpha + 1, n + beta + 1) / pi, and its
+// derivative in theta in dp, by the expansion of Hale and Townsend: the sum over m of
+//   sum over l <= m of c_l d_(m - l) cos(t_m - l pi / 2) / (sin(theta / 2)^l cos(theta / 2)^(m - l))
+// over 2^m (2 rho + 1)_m, times sin(theta / 2)^-(alpha + 1/2) cos(theta / 2)^-(beta + 1/2), with
+// rho = n + (alpha + beta + 1) / 2, t_m = (rho + m / 2) theta - (alpha + 1/2) pi / 2,
+// c_l = (1/2 + alpha)_l (1/2 - alpha)_l / l! and d_l the same in beta. Terms are summed
+// until they fall below the first by 1e-17; ok is set false if __GAUSS_TERMS are not
+// enough, which happens near the ends and sooner the larger alpha and beta.
+static double __gauss_jacobi_series(size_t n, double alpha, double beta, double theta, double* dp, bool* ok) {
+  double rho = (double)n + (0.5 * (alpha + beta + 1.0));
+  double sh = sin(0.5 * theta), ch = cos(0.5 * theta), cot = ch / sh, tn = sh / ch;
+  double cu[__GAUSS_TERMS], dv[__GAUSS_TERMS];
+  cu[0] = dv[0] = 1.0;
+  for (int l = 1; l < __GAUSS_TERMS; ++l) {
+    double ll = (double)l;
+    cu[l] = cu[l - 1] * (ll - 0.5 + alpha) * (ll - 0.5 - alpha) / (ll * sh);
+    dv[l] = dv[l - 1] * (ll - 0.5 + beta) * (ll - 0.5 - beta) / (ll * ch);
+  }
+  double t = (rho * theta) - ((alpha + 0.5) * C_PI_2);
+  double ct = cos(t), st = sin(t);
+  double p = 0.0, d = 0.0, h = 1.0;
+  *ok = false;
+  for (int m = 0; m < __GAUSS_TERMS; ++m) {
+    double mm = (double)m;
+    if (m > 0) { h /= 2.0 * ((2.0 * rho) + mm); }
+
+    // cos(t_m - l pi / 2) = cos(t_m) e_l + sin(t_m) o_l, e and o cycling 1, 0, -1, 0 and 0, 1, 0, -1;
+    // the l-weighted sums give the derivative of the sin and cos powers
+    double e = 0.0, o = 0.0, el = 0.0, ol = 0.0;
+    for (int l = 0; l <= m; ++l) {
+      double v = cu[l] * dv[m - l], sign = (l & 2) ? -1.0 : 1.0;
+      if (l & 1) {
+        o += sign * v;
+        ol += sign * (double)l * v;
+      } else {
+        e += sign * v;
+        el += sign * (double)l * v;
+      }
+    }
+    double c = (ct * e) + (st * o), g = (0.5 * (mm + beta + 0.5) * tn) - (0.5 * (alpha + 0.5) * cot);
+    p += h * c;
+    d += h * ((g * c) - ((rho + (0.5 * mm)) * ((st * e) - (ct * o))) - (0.5 * (cot + tn) * ((ct * el) + (st * ol))));
+    if (h * (fabs(e) + fabs(o)) < 1e-17) {
+      *ok = true;
+      break;
+    }
+
+    // t_(m+1) = t_m + theta / 2
+    double r = (ct * ch) - (st * sh);
+    st = (st * ch) + (ct * sh);
+    ct = r;
+  }
+  double f = pow(sh, -(alpha + 0.5)) * pow(ch, -(beta + 0.5));
+  *dp = f * d;
+  return f * p;
+}
+
+// Estimate of theta for node k from x = 1 of the Jacobi rule: j / nu, j the kth zero of the
+// Bessel function J_alpha by McMahon's expansion (Gatteschi)
+static double __gauss_jacobi_guess(size_t n, double alpha, double beta, size_t k) {
+  double rho = (double)n + (0.5 * (alpha + beta + 1.0));
+  double nu = sqrt((rho * rho) + ((1.0 - (alpha * alpha) - (3.0 * beta * beta)) / 12.0));
+  double b = ((double)k + (0.5 * alpha) - 0.25) * C_PI, mu = 4.0 * alpha * alpha, b8 = 8.0 * b;
+  double j = b - ((mu - 1.0) / b8) - (4.0 * (mu - 1.0) * ((7.0 * mu) - 31.0) / (3.0 * b8 * b8 * b8));
+  return j / nu;
+}
+
+// Scales w[0, n) to sum to total
+static void __gauss_normalize(double* w, size_t n, double total) {
+  double sum = 0.0, comp = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    // Neumaier summation, the weights being many and alike
+    double t = sum + w[i];
+    comp += (fabs(sum) >= fabs(w[i])) ? ((sum - t) + w[i]) : ((w[i] - t) + sum);
+    sum = t;
+  }
+  double scale = total / (sum + comp);
+  for (size_t i = 0; i < n; ++i) { w[i] *= scale; }
+}
+
+
+/* Node functions */
+bool cam_gauss_legendre_nodes(double* x, double* w, size_t n) {
+  if (n == 0) { return false; }
+  double nn = (double)n, cn = 4.0 / C_PI;
+  for (size_t j = 1; j <= n; ++j) { cn *= (double)j / ((double)j + 0.5); }
+  double shrink = 1.0 - ((nn - 1.0) / (8.0 * nn * nn * nn));
+
+  // Node k from the top is near cos((4k - 1) pi / (4n + 2)); the rule is symmetric
+  size_t half = n / 2;
+  for (size_t k = 1; k <= half; ++k) {
+    double guess = shrink * cos((double)((4 * k) - 1) * C_PI / ((4.0 * nn) + 2.0));
+    double theta = acos(guess), d;
+    double (*eval)(size_t, double, double*) = (k <= __GAUSS_ENDS) ? __gauss_legendre_recur : __gauss_legendre_series;
+    for (int it = 0; it < __GAUSS_NEWTON; ++it) {
+      double step = eval(n, theta, &d) / d;
+      theta -= step;
+      if (fabs(step) <= 1e-15 * theta) { break; }
+    }
+    // Series values carry a factor 1 / C_n
+    double xk = cos(theta), wk = 2.0 / (d * d);
+    if (k > __GAUSS_ENDS) { wk /= cn * cn; }
+    x[n - k] = xk;
+    x[k - 1] = -xk;
+    w[n - k] = w[k - 1] = wk;
+  }
+  if (n & 1) {
+    double d;
+    __gauss_legendre_recur(n, C_PI_2, &d);
+    x[half] = 0.0;
+    w[half] = 2.0 / (d * d);
+  }
+  __gauss_normalize(w, n, 2.0);
+  return true;
+}
+
+bool cam_gauss_jacobi_nodes(double* x, double* w, size_t n, double alpha, double beta) {
+  if (n == 0 || !(alpha > -1.0) || !(beta > -1.0)) { return false; }
+
+  // The upper half of the nodes from x = 1, the lower from x = -1 by
+  // P_n^(alpha, beta)(-x) = (-1)^n P_n^(beta, alpha)(x). The two sides are normalized
+  // at different ends, which scales the weights of the lower by
+  // (P_n^(alpha, beta)(1) / P_n^(beta, alpha)(1))^2.
+  double ratio = 1.0;
+  for (size_t j = 1; j <= n; ++j) { ratio *= ((double)j + alpha) / ((double)j + beta); }
+
+  // Series derivatives are scaled to the recurrence's at the first series node of each
+  // side, which costs one recurrence per side instead of K / P_n(1) from Gamma functions
+  double scale[2] = { 0.0, 0.0 };
+  size_t upper = (n + 1) / 2;
+  for (size_t k = 1; k <= n; ++k) {
+    bool top = k <= upper;
+    size_t j = top ? k : n + 1 - k;
+    double a = top ? alpha : beta, b = top ? beta : alpha;
+    double guess = __gauss_jacobi_guess(n, a, b, j), theta = guess, d;
+
+    // Nodes past the ends try the series first, falling back to the recurrence where it
+    // has not converged
+    bool series = j > __GAUSS_ENDS;
+    if (series) {
+      for (int it = 0; it < __GAUSS_NEWTON; ++it) {
+        double step = __gauss_jacobi_series(n, a, b, theta, &d, &series) / d;
+        theta -= step;
+        if (fabs(step) <= 1e-15 * theta) { break; }
+      }
+      if (!series) { theta = guess; }
+    }
+    if (series) {
+      if (scale[top] == 0.0) {
+        double dq;
+        __gauss_jacobi_recur(n, a, b, theta, &dq);
+        scale[top] = dq / d;
+      }
+      d *= scale[top];
+    } else {
+      for (int it = 0; it < __GAUSS_NEWTON; ++it) {
+        double step = __gauss_jacobi_recur(n, a, b, theta, &d) / d;
+        theta -= step;
+        if (fabs(step) <= 1e-15 * theta) { break; }
+      }
+    }
+    double xk = cos(theta), wk = 1.0 / (d * d);
+    if (top) {
+      x[n - k] = xk;
+      w[n - k] = wk;
+    } else {
+      x[n - k] = -xk;
+      w[n - k] = wk * ratio * ratio;
+    }
+  }
+
+  // Integral of the weight: 2^(alpha + beta + 1) B(alpha + 1, beta + 1)
+  double total = exp(((alpha + beta + 1.0) * C_LN2) + lgamma(alpha + 1.0) + lgamma(beta + 1.0) - lgamma(alpha + beta + 2.0));
+  __gauss_normalize(w, n, total);
+  return true;
+}
+
+
+/* Cache state, guarded by __gauss_mutex */
+static __gauss_lock __gauss_mutex = __GAUSS_LOCK_INIT;
+static cam_gauss_rule** __gauss_cache = NULL;
+static size_t __gauss_cache_count = 0;
+static size_t __gauss_cache_size = 0;
+
+// Finds or makes the rule, Legendre when alpha and beta are both 0
+static const cam_gauss_rule* __gauss_cached(size_t n, double alpha, double beta) {
+  if (n == 0 || !(alpha > -1.0) || !(beta > -1.0)) { return NULL; }
+  __gauss_lock(&__gauss_mutex);
+  for (size_t i = 0; i < __gauss_cache_count; ++i) {
+    cam_gauss_rule* r = __gauss_cache[i];
+    if (r->n == n && r->alpha == alpha && r->beta == beta) {
+      __gauss_unlock(&__gauss_mutex);
+      return r;
+    }
+  }
+
+  // Made under the lock, so threads asking for the same rule wait for one copy
+  // Weights start on a CAM_SIMD_ALIGN boundary too
+  cam_gauss_rule* rule = NULL;
+  size_t stride = (n + 3) & ~(size_t)3;
+  if (__gauss_cache_count == __gauss_cache_size) {
+    size_t size = (__gauss_cache_size == 0) ? 16 : 2 * __gauss_cache_size;
+    cam_gauss_rule** cache = (cam_gauss_rule**)realloc(__gauss_cache, size * sizeof(cam_gauss_rule*));
+    if (cache) {
+      __gauss_cache = cache;
+      __gauss_cache_size = size;
+    }
+  }
+  if (__gauss_cache_count < __gauss_cache_size) {
+    rule = (cam_gauss_rule*)cam_aligned_alloc(__GAUSS_HEAD + (2 * stride * sizeof(double)), 64);
+  }
+  if (rule) {
+    rule->n = n;
+    rule->alpha = alpha;
+    rule->beta = beta;
+    rule->x = (double*)((char*)rule + __GAUSS_HEAD);
+    rule->w = rule->x + stride;
+    if (alpha == 0.0 && beta == 0.0) { cam_gauss_legendre_nodes(rule->x, rule->w, n); }
+    else { cam_gauss_jacobi_nodes(rule->x, rule->w, n, alpha, beta); }
+    __gauss_cache[__gauss_cache_count++] = rule;
+  }
+  __gauss_unlock(&__gauss_mutex);
+  return rule;
+}
+
+
+/* Cache functions */
+const cam_gauss_rule* cam_gauss_legendre(size_t n) {
+  return __gauss_cached(n, 0.0, 0.0);
+}
+
+const cam_gauss_rule* cam_gauss_jacobi(size_t n, double alpha, double beta) {
+  return __gauss_cached(n, alpha, beta);
+}
+
+void cam_gauss_cache_clear() {
+  __gauss_lock(&__gauss_mutex);
+  for (size_t i = 0; i < __gauss_cache_count; ++i) { cam_aligned_free(__gauss_cache[i]); }
+  free(__gauss_cache);
+  __gauss_cache = NULL;
+  __gauss_cache_count = __gauss_cache_size = 0;
+  __gauss_unlock(&__gauss_mutex);
+}
+
+
+/* Integration functions */
+double cam_gauss_integrate(const cam_gauss_rule* rule, cam_integrand f, void* arg, double a, double b) {
+  size_t n = rule->n;
+  double* t = (double*)cam_aligned_alloc(2 * n * sizeof(double), CAM_SIMD_ALIGN);
+  if (!t) { return NAN; }
+  double* y = t + n;
+  double c = 0.5 * (a + b), h = 0.5 * (b - a);
+  for (size_t i = 0; i < n; ++i) { t[i] = c + (h * rule->x[i]); }
+  f(arg, y, t, n);
+  double value = h * cam_gauss_apply(rule, y);
+  cam_aligned_free(t);
+  return value;
+}
+
+#endif
@@ -6,4 +6,10 @@
 #ifndef CAM_INTEGRATION_H
 #define CAM_INTEGRATION_H
 
+#include "cam/integration/integration_common.h"
+#include "cam/integration/gauss_kronrod.h"
+#include "cam/integration/monte_carlo.h"
+#include "cam/integration/tanh_sinh.h"
+#include "cam/integration/gauss_rule.h"
+
 #endif
@@ -0,0 +1,61 @@
+/*
+ * integration_common.h
+ * Declarations common to all objects in the numerical integration module.
+ */
+
+#ifndef CAM_INTEGRATION_COMMON_H
+#define CAM_INTEGRATION_COMMON_H
+
+#include "cam/common.h"
+
+/* Linkage of the integration functions */
+// Inline in CAM_HEADER_ONLY builds. The cost of an integral is in the integrand, so
+// the integrators are compiled once rather than per SIMD tier.
+#ifndef CAM_INTEGRATION_API
+#if defined(CAM_HEADER_ONLY)
+#define CAM_INTEGRATION_API static inline
+#else
+#define CAM_INTEGRATION_API CAM_API
+#endif
+#endif
+
+// The kernels working on sample arrays themselves are compiled per tier in runtime
+// dispatch builds, like the other modules.
+#ifndef CAM_INTEGRATION_KERNEL_API
+#if defined(CAM_HEADER_ONLY)
+#define CAM_INTEGRATION_KERNEL_API static inline
+#else
+#define CAM_INTEGRATION_KERNEL_API CAM_API
+#endif
+#endif
+
+
+/* Define cam_integrand type */
+// Writes f(x[i]) to y[i] for i in [0, count). Integrators hand over every abscissa
+// they need at once, so one call covers several intervals and the loop inside it can
+// be vectorized. arg is passed through untouched.
+typedef void (*cam_integrand)(void* arg, double* y, const double* x, size_t count);
+
+// The same over dim dimensions: x holds count points of dim coordinates each.
+typedef void (*cam_integrand_nd)(void* arg, double* y, const double* x, size_t count, size_t dim);
+
+
+/* Define cam_quad_result struct */
+typedef enum {
+  CAM_QUAD_OK = 0,       // Error estimate within the tolerance asked for
+  CAM_QUAD_LIMIT,        // Evaluation budget spent first
+  CAM_QUAD_ROUNDOFF,     // Intervals too narrow to split further in double precision
+  CAM_QUAD_NONFINITE,    // Integrand returned an infinity or NaN
+  CAM_QUAD_NOMEM,        // Working space could not be allocated, value is NaN
+  CAM_QUAD_INVALID       // Arguments out of range, value is NaN
+} cam_quad_status;
+
+typedef struct {
+  double value;          // Estimate of the integral
+  double error;          // Estimate of the absolute error of value
+  size_t evals;          // Integrand values computed
+  size_t calls;          // Calls made to the integrand
+  cam_quad_status status;
+} cam_quad_result;
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * monte_carlo.h
+ * Declaration for Monte Carlo and quasi-Monte Carlo integration over boxes.
+ */
+
+#ifndef CAM_INTEGRATION_MONTE_CARLO_H
+#define CAM_INTEGRATION_MONTE_CARLO_H
+
+#include "cam/integration/integration_common.h"
+
+#define CAM_MC_MAX_DIM 64       // Largest dimension of pseudo-random sampling
+#define CAM_SOBOL_MAX_DIM 21    // Largest dimension of Sobol sampling
+
+/* Define cam_mc_method enum */
+typedef enum {
+  CAM_MC_PSEUDO = 0,   // Independent uniform points; the error falls as 1 / sqrt(n)
+  CAM_MC_SOBOL         // Sobol points under 8 random digital shifts; close to 1 / n for smooth integrands
+} cam_mc_method;
+
+
+/* Define cam_mc struct */
+// A running estimate of the integral of f over the box [lo, hi] of dim dimensions.
+//
+// Samples are taken in blocks of 1024 points, each block one call of f, and the blocks
+// of a round are spread over the threads of cam/thread.h. Every point is a function of
+// the seed and its index alone: pseudo-random points come from Philox4x32-10 with the
+// index as the counter, Sobol points from their index in Gray code order, shifted by
+// Philox values. Block sums are combined in block order, so the estimate is the same
+// bit for bit whatever the thread count.
+//
+// The error estimate is the standard error of the mean of the points, or for Sobol
+// points of the 8 shifted copies of the sequence, each made of every block's points.
+typedef struct {
+  size_t dim;
+  cam_mc_method method;
+  double* lo;            // Box corner of dim values
+  double* width;         // Box side lengths of dim values
+  double volume;
+  uint32_t key[2];       // Philox key, the seed
+  uint32_t* dirs;        // Sobol direction numbers, 32 per dimension
+  uint32_t* shifts;      // Sobol digital shifts, dim per copy
+  size_t blocks;         // Blocks sampled so far
+  double* stats;         // Mean and sum of squared deviations of the samples so far,
+                         // per copy for Sobol points
+  size_t evals, calls;
+} cam_mc;
+
+
+/* cam_mc functions */
+// Samples the box [lo, hi], or the unit cube when lo and hi are NULL. Returns NULL if
+// dim is 0 or above CAM_MC_MAX_DIM, or CAM_SOBOL_MAX_DIM for Sobol points, or
+// allocation fails.
+CAM_INTEGRATION_API cam_mc* cam_mc_make(size_t dim, const double* lo, const double* hi, cam_mc_method method, uint64_t seed);
+
+CAM_INTEGRATION_API void cam_mc_free(cam_mc* mc);
+
+// Samples f in rounds until the error estimate is at most max(abs_tol, rel_tol |value|)
+// or the integrand values of every call so far reach max_evals, and returns the estimate.
+// Calls continue from the samples of earlier calls, so repeated calls with a growing
+// max_evals report the running estimate. A round adds as many samples as the error
+// estimate suggests tolerance needs, at most doubling them; Sobol rounds always double,
+// keeping the sample count a power of two.
+CAM_INTEGRATION_API cam_quad_result cam_mc_run(cam_mc* mc, cam_integrand_nd f, void* arg, double abs_tol, double rel_tol,
+  size_t max_evals);
+
+// cam_mc_make, cam_mc_run and cam_mc_free in one
+CAM_INTEGRATION_API cam_quad_result cam_mc_integrate(cam_integrand_nd f, void* arg, size_t dim, const double* lo, const double* hi,
+  cam_mc_method method, uint64_t seed, double abs_tol, double rel_tol, size_t max_evals);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/integration/monte_carlo.inl"
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * monte_carlo.inl
+ * Definitions for Monte Carlo and quasi-Monte Carlo integration over boxes.
+ * Compiled by src/integration/monte_carlo.c, or included by monte_carlo.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_INTEGRATION_MONTE_CARLO_INL
+#define CAM_INTEGRATION_MONTE_CARLO_INL
+
+#include "cam/integration/monte_carlo.h"
+#include "cam/thread.h"
+#include <math.h>
+#include <string.h>
+
+/* monte_carlo helpers */
+#define __MC_BLOCK 1024   // Points per call of the integrand
+#define __MC_FIRST 16     // Blocks of the first round
+#define __MC_COPIES 8     // Shifted copies of the Sobol sequence
+#define __MC_SOBOL_BLOCK (__MC_BLOCK / __MC_COPIES)
+
+// Philox4x32-10 of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"
+static inline void __mc_philox(uint32_t out[4], const uint32_t ctr[4], const uint32_t key[2]) {
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3], k0 = key[0], k1 = key[1];
+  for (int r = 0; r < 10; ++r) {
+    uint64_t p0 = (uint64_t)0xD2511F53u * c0, p1 = (uint64_t)0xCD9E8D57u * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+// Uniform in (0, 1) from 53 of the bits of two words
+static inline double __mc_unit(uint32_t hi, uint32_t lo) {
+  uint64_t k = ((uint64_t)hi << 21) ^ (uint64_t)(lo >> 11);
+  return ((double)k + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// Degree, inner coefficients and initial direction numbers of the primitive polynomials
+// of Sobol dimensions 2 on, from Joe and Kuo's new-joe-kuo-6.21201
+static const uint8_t __sobol_s[CAM_SOBOL_MAX_DIM - 1] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7 };
+static const uint8_t __sobol_a[CAM_SOBOL_MAX_DIM - 1] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4 };
+static const uint8_t __sobol_m[CAM_SOBOL_MAX_DIM - 1][7] = {
+  { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 }, { 1, 3, 5, 13 }, { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 },
+  { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 }, { 1, 1, 1, 3, 11 }, { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 },
+  { 1, 1, 1, 15, 21, 21 }, { 1, 3, 1, 13, 27, 49 }, { 1, 1, 1, 15, 7, 5 }, { 1, 3, 1, 15, 13, 25 },
+  { 1, 1, 5, 5, 19, 61 }, { 1, 3, 7, 11, 23, 15, 103 }, { 1, 3, 7, 13, 13, 15, 69 }
+};
+
+static void __sobol_directions(uint32_t* v, size_t dim) {
+  for (size_t k = 0; k < 32; ++k) { v[k] = (uint32_t)1 << (31 - k); }
+  for (size_t d = 1; d < dim; ++d) {
+    uint32_t* w = v + (32 * d);
+    size_t s = __sobol_s[d - 1];
+    uint32_t a = __sobol_a[d - 1];
+    for (size_t k = 0; k < 32; ++k) {
+      if (k < s) {
+        w[k] = (uint32_t)__sobol_m[d - 1][k] << (31 - k);
+        continue;
+      }
+      uint32_t x = w[k - s] ^ (w[k - s] >> s);
+      for (size_t j = 1; j < s; ++j) {
+        if ((a >> (s - 1 - j)) & 1u) { x ^= w[k - j]; }
+      }
+      w[k] = x;
+    }
+  }
+}
+
+// Arguments shared by the tasks of a round
+typedef struct {
+  const cam_mc* mc;
+  cam_integrand_nd f;
+  void* arg;
+  size_t first;       // Index of the first block of the round
+  double* out;        // Per block: mean and sum of squared deviations, or the mean of every copy
+  bool failed;        // Set by tasks that could not allocate working space
+} __mc_job;
+
+// Writes the points of block b to x
+static void __mc_points(const cam_mc* mc, double* x, size_t b) {
+  size_t dim = mc->dim;
+  if (mc->method == CAM_MC_PSEUDO) {
+    for (size_t p = 0; p < __MC_BLOCK; ++p) {
+      uint64_t i = ((uint64_t)b * __MC_BLOCK) + p;
+      double* xp = x + (p * dim);
+      for (size_t j = 0; j < dim; j += 2) {
+        uint32_t ctr[4] = { (uint32_t)i, (uint32_t)(i >> 32), (uint32_t)j, 0 }, r[4];
+        __mc_philox(r, ctr, mc->key);
+        xp[j] = mc->lo[j] + (mc->width[j] * __mc_unit(r[0], r[1]));
+        if (j + 1 < dim) { xp[j + 1] = mc->lo[j + 1] + (mc->width[j + 1] * __mc_unit(r[2], r[3])); }
+      }
+    }
+    return;
+  }
+
+  // Point i of the sequence is the xor of the direction numbers of the bits of its Gray
+  // code; each next point changes the one bit of the Gray code that i + 1 sets lowest
+  uint32_t s[CAM_SOBOL_MAX_DIM];
+  uint32_t i = (uint32_t)(b * __MC_SOBOL_BLOCK), g = i ^ (i >> 1);
+  for (size_t j = 0; j < dim; ++j) {
+    s[j] = 0;
+    for (size_t k = 0; k < 32; ++k) {
+      if ((g >> k) & 1u) { s[j] ^= mc->dirs[(32 * j) + k]; }
+    }
+  }
+  for (size_t p = 0; p < __MC_SOBOL_BLOCK; ++p, ++i) {
+    for (size_t r = 0; r < __MC_COPIES; ++r) {
+      double* xp = x + (((r * __MC_SOBOL_BLOCK) + p) * dim);
+      const uint32_t* shift = mc->shifts + (r * dim);
+      for (size_t j = 0; j < dim; ++j) {
+        double u = ((double)(s[j] ^ shift[j]) + 0.5) * (1.0 / 4294967296.0);
+        xp[j] = mc->lo[j] + (mc->width[j] * u);
+      }
+    }
+    uint32_t c = ~i & (i + 1);
+    size_t k = 0;
+    while (c > 1) {
+      c >>= 1;
+      ++k;
+    }
+    for (size_t j = 0; j < dim; ++j) { s[j] ^= mc->dirs[(32 * j) + k]; }
+  }
+}
+
+// Samples blocks [begin, end) of the round
+static void __mc_task(void* arg, size_t begin, size_t end) {
+  __mc_job* job = (__mc_job*)arg;
+  const cam_mc* mc = job->mc;
+  double* x = (double*)cam_aligned_alloc(__MC_BLOCK * (mc->dim + 1) * sizeof(double), CAM_SIMD_ALIGN);
+  if (!x) {
+    job->failed = true;
+    return;
+  }
+  double* y = x + (__MC_BLOCK * mc->dim);
+  for (size_t b = begin; b < end; ++b) {
+    __mc_points(mc, x, job->first + b);
+    job->f(job->arg, y, x, __MC_BLOCK, mc->dim);
+    if (mc->method == CAM_MC_PSEUDO) {
+      double mean = 0.0, m2 = 0.0;
+      for (size_t p = 0; p < __MC_BLOCK; ++p) { mean += y[p]; }
+      mean *= 1.0 / __MC_BLOCK;
+      for (size_t p = 0; p < __MC_BLOCK; ++p) { m2 += (y[p] - mean) * (y[p] - mean); }
+      job->out[2 * b] = mean;
+      job->out[(2 * b) + 1] = m2;
+    }
+    else {
+      for (size_t r = 0; r < __MC_COPIES; ++r) {
+        double mean = 0.0;
+        for (size_t p = 0; p < __MC_SOBOL_BLOCK; ++p) { mean += y[(r * __MC_SOBOL_BLOCK) + p]; }
+        job->out[(__MC_COPIES * b) + r] = mean * (1.0 / __MC_SOBOL_BLOCK);
+      }
+    }
+  }
+  cam_aligned_free(x);
+}
+
+// Fills the estimate and error of res from the samples so far
+static void __mc_estimate(const cam_mc* mc, cam_quad_result* res) {
+  res->evals = mc->evals;
+  res->calls = mc->calls;
+  if (mc->method == CAM_MC_PSEUDO) {
+    double n = (double)(mc->blocks * __MC_BLOCK);
+    res->value = mc->volume * mc->stats[0];
+    res->error = fabs(mc->volume) * sqrt(mc->stats[1] / ((n - 1.0) * n));
+    return;
+  }
+  double mean = 0.0, var = 0.0;
+  for (size_t r = 0; r < __MC_COPIES; ++r) { mean += mc->stats[r]; }
+  mean *= 1.0 / __MC_COPIES;
+  for (size_t r = 0; r < __MC_COPIES; ++r) { var += (mc->stats[r] - mean) * (mc->stats[r] - mean); }
+  res->value = mc->volume * mean;
+  res->error = fabs(mc->volume) * sqrt(var / (double)(__MC_COPIES * (__MC_COPIES - 1)));
+}
+
+
+/* cam_mc functions */
+cam_mc* cam_mc_make(size_t dim, const double* lo, const double* hi, cam_mc_method method, uint64_t seed) {
+  if (dim == 0 || dim > CAM_MC_MAX_DIM || (method == CAM_MC_SOBOL && dim > CAM_SOBOL_MAX_DIM)) { return NULL; }
+
+  // One allocation: the struct, the box, then the Sobol tables
+  size_t base = (sizeof(cam_mc) + 63) & ~(size_t)63;
+  size_t box = ((2 * dim * sizeof(double)) + 63) & ~(size_t)63;
+  size_t stats = ((2 * __MC_COPIES * sizeof(double)) + 63) & ~(size_t)63;
+  size_t sobol = (method == CAM_MC_SOBOL) ? (32 + __MC_COPIES) * dim * sizeof(uint32_t) : 0;
+  char* mem = (char*)cam_aligned_alloc(base + box + stats + sobol, 64);
+  if (!mem) { return NULL; }
+  cam_mc* mc = (cam_mc*)mem;
+  memset(mc, 0, sizeof(cam_mc));
+  mc->dim = dim;
+  mc->method = method;
+  mc->lo = (double*)(mem + base);
+  mc->width = mc->lo + dim;
+  mc->stats = (double*)(mem + base + box);
+  mc->key[0] = (uint32_t)seed;
+  mc->key[1] = (uint32_t)(seed >> 32);
+  mc->volume = 1.0;
+  for (size_t j = 0; j < dim; ++j) {
+    mc->lo[j] = lo ? lo[j] : 0.0;
+    mc->width[j] = hi ? hi[j] - mc->lo[j] : 1.0;
+    mc->volume *= mc->width[j];
+  }
+  memset(mc->stats, 0, 2 * __MC_COPIES * sizeof(double));
+
+  if (method == CAM_MC_SOBOL) {
+    mc->dirs = (uint32_t*)(mem + base + box + stats);
+    mc->shifts = mc->dirs + (32 * dim);
+    __sobol_directions(mc->dirs, dim);
+    // Shifts come from counters the pseudo-random points never use, their fourth word set
+    for (size_t r = 0; r < __MC_COPIES; ++r) {
+      for (size_t j = 0; j < dim; ++j) {
+        uint32_t ctr[4] = { (uint32_t)r, 0, (uint32_t)j, 1 }, w[4];
+        __mc_philox(w, ctr, mc->key);
+        mc->shifts[(r * dim) + j] = w[0];
+      }
+    }
+  }
+  return mc;
+}
+
+void cam_mc_free(cam_mc* mc) {
+  cam_aligned_free(mc);
+}
+
+cam_quad_result cam_mc_run(cam_mc* mc, cam_integrand_nd f, void* arg, double abs_tol, double rel_tol, size_t max_evals) {
+  cam_quad_result res;
+  memset(&res, 0, sizeof(res));
+  // Sobol indices are 32 bits
+  size_t most = (mc->method == CAM_MC_SOBOL) ? ((size_t)1 << 25) : SIZE_MAX / __MC_BLOCK;
+  double* out = NULL;
+  size_t capacity = 0;
+  for (;;) {
+    if (mc->blocks > 0) {
+      __mc_estimate(mc, &res);
+      if (!isfinite(res.value) || !isfinite(res.error)) {
+        res.status = CAM_QUAD_NONFINITE;
+        break;
+      }
+      if (res.error <= fmax(abs_tol, rel_tol * fabs(res.value))) {
+        res.status = CAM_QUAD_OK;
+        break;
+      }
+    }
+
+    // Blocks of the round: enough to reach tolerance at the 1 / sqrt(n) rate, at least
+    // __MC_FIRST and at most as many as there are
+    size_t round = (mc->blocks > 0) ? mc->blocks : __MC_FIRST;
+    if (mc->method == CAM_MC_PSEUDO && mc->blocks > 0) {
+      double tol = fmax(abs_tol, rel_tol * fabs(res.value));
+      double need = (double)mc->blocks * ((res.error / tol) * (res.error / tol)) * 1.1;
+      if (need - (double)mc->blocks < (double)round) { round = (size_t)ceil(need - (double)mc->blocks); }
+      if (round < __MC_FIRST) { round = __MC_FIRST; }
+    }
+    size_t left = (mc->evals < max_evals) ? (max_evals - mc->evals) / __MC_BLOCK : 0;
+    if (mc->blocks + left > most) { left = (most > mc->blocks) ? most - mc->blocks : 0; }
+    if (round > left) { round = left; }
+    if (round == 0) {
+      res.status = CAM_QUAD_LIMIT;
+      break;
+    }
+
+    size_t per = (mc->method == CAM_MC_PSEUDO) ? 2 : __MC_COPIES;
+    if (round > capacity) {
+      cam_aligned_free(out);
+      out = (double*)cam_aligned_alloc(round * per * sizeof(double), CAM_SIMD_ALIGN);
+      capacity = out ? round : 0;
+    }
+    __mc_job job;
+    memset(&job, 0, sizeof(job));
+    job.mc = mc;
+    job.f = f;
+    job.arg = arg;
+    job.first = mc->blocks;
+    job.out = out;
+    job.failed = !out;
+    if (out) { cam_parallel_for(round, __mc_task, &job); }
+    if (job.failed) {
+      // The samples so far are kept, a later call may carry on from them
+      res.status = CAM_QUAD_NOMEM;
+      break;
+    }
+
+    // Merge the round in block order, as Chan et al. combine means and squared deviations
+    for (size_t b = 0; b < round; ++b) {
+      double na = (double)(mc->blocks * __MC_BLOCK), nb = (double)__MC_BLOCK, n = na + nb;
+      if (mc->method == CAM_MC_PSEUDO) {
+        double delta = out[2 * b] - mc->stats[0];
+        mc->stats[0] += delta * (nb / n);
+        mc->stats[1] += out[(2 * b) + 1] + (delta * delta * (na * nb / n));
+      }
+      else {
+        for (size_t r = 0; r < __MC_COPIES; ++r) { mc->stats[r] += (out[(__MC_COPIES * b) + r] - mc->stats[r]) * (nb / n); }
+      }
+      mc->blocks += 1;
+    }
+    mc->evals += round * __MC_BLOCK;
+    mc->calls += round;
+  }
+  if (mc->blocks == 0) { res.value = res.error = NAN; }
+  cam_aligned_free(out);
+  return res;
+}
+
+cam_quad_result cam_mc_integrate(cam_integrand_nd f, void* arg, size_t dim, const double* lo, const double* hi,
+  cam_mc_method method, uint64_t seed, double abs_tol, double rel_tol, size_t max_evals) {
+  cam_mc* mc = cam_mc_make(dim, lo, hi, method, seed);
+  if (!mc) {
+    cam_quad_result res;
+    memset(&res, 0, sizeof(res));
+    res.value = res.error = NAN;
+    bool valid = dim > 0 && dim <= ((method == CAM_MC_SOBOL) ? CAM_SOBOL_MAX_DIM : CAM_MC_MAX_DIM);
+    res.status = valid ? CAM_QUAD_NOMEM : CAM_QUAD_INVALID;
+    return res;
+  }
+  cam_quad_result res = cam_mc_run(mc, f, arg, abs_tol, rel_tol, max_evals);
+  cam_mc_free(mc);
+  return res;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * tanh_sinh.h
+ * Declaration for tanh-sinh (double exponential) quadrature.
+ */
+
+#ifndef CAM_INTEGRATION_TANH_SINH_H
+#define CAM_INTEGRATION_TANH_SINH_H
+
+#include "cam/integration/integration_common.h"
+
+/* Integration functions */
+// Integrates f over [a, b], a > b flipping the sign, by the substitution
+// x = tanh(pi/2 sinh t), which makes the integrand fall doubly exponentially in t and
+// so copes with integrable singularities at a and b. f is never evaluated at a or b.
+//
+// The trapezoid rule in t is refined level by level, the step halving from 1 to 1/128.
+// Every level adds only the nodes between those of the last one and sends them to f in
+// one call, so a level costs as many integrand values as the levels before it together.
+// Refinement stops once two levels agree within max(abs_tol, rel_tol |value|), their
+// difference being the error estimate, or with CAM_QUAD_LIMIT after the last level.
+// Nodes that round onto a or b are left out, each end on its own. Near a nonzero end x
+// only resolves the end's ulp, so the integral over the last few ulps before a
+// singularity there is lost, about 1e-8 for 1 / sqrt(x - 2) from 2; a singularity
+// moved to 0 keeps full precision.
+//
+// Library builds read the nodes from tables generated at build time; CAM_HEADER_ONLY
+// builds compute them as they go.
+CAM_INTEGRATION_API cam_quad_result cam_tanh_sinh_integrate(cam_integrand f, void* arg, double a, double b, double abs_tol,
+  double rel_tol);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/integration/tanh_sinh.inl"
+#endif
+
+#endif
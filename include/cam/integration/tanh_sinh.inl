@@ -0,0 +1,117 @@
+/*
+ * tanh_sinh.inl
+ * Definitions for tanh-sinh (double exponential) quadrature.
+ * Compiled by src/integration/tanh_sinh.c, or included by tanh_sinh.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_INTEGRATION_TANH_SINH_INL
+#define CAM_INTEGRATION_TANH_SINH_INL
+
+#include "cam/integration/tanh_sinh.h"
+#include <math.h>
+#include <string.h>
+
+/* tanh_sinh helpers */
+// Level 0 has the nodes t = 0, 1, ..., and level k > 0 the odd multiples of 2^-k, all up
+// to __TS_TMAX, beyond which weights and distances to the ends stop being normal
+// doubles. Negative t mirror positive t, so a node stands for the pair a + h d and
+// b - h d, d = 1 - x the distance from the end over the half width h; t = 0 is the
+// midpoint alone.
+
+#define __TS_LEVELS 8     // Keep in step with tools/tanh_sinh_gen.c
+#define __TS_TMAX 6.1
+#define __TS_MOST ((size_t)(__TS_TMAX * (1 << (__TS_LEVELS - 2))) + 2)   // Nodes of the largest level
+
+#if defined(CAM_TANH_SINH_TABLES)
+// Library builds: the tables generated by tools/tanh_sinh_gen.c
+#include "tanh_sinh_tables.inl"
+
+static size_t __ts_level(size_t k, const double** d, const double** w, double* scratch) {
+  (void)scratch;
+  *d = __ts_table_d + __ts_table_offset[k];
+  *w = __ts_table_w + __ts_table_offset[k];
+  return __ts_table_offset[k + 1] - __ts_table_offset[k];
+}
+#else
+// CAM_HEADER_ONLY builds: the same nodes in double precision, into scratch
+static size_t __ts_level(size_t k, const double** d, const double** w, double* scratch) {
+  double* dk = scratch;
+  double* wk = scratch + __TS_MOST;
+  size_t n = 0;
+  for (;; ++n) {
+    double t = (k == 0) ? (double)n : (double)((2 * n) + 1) / (double)((size_t)1 << k);
+    if (t > __TS_TMAX) { break; }
+    double u = C_PI_2 * sinh(t), c = cosh(u);
+    dk[n] = exp(-u) / c;
+    wk[n] = C_PI_2 * cosh(t) / (c * c);
+  }
+  *d = dk;
+  *w = wk;
+  return n;
+}
+#endif
+
+
+/* Integration functions */
+cam_quad_result cam_tanh_sinh_integrate(cam_integrand f, void* arg, double a, double b, double abs_tol,
+  double rel_tol) {
+  cam_quad_result res;
+  memset(&res, 0, sizeof(res));
+  double* x = (double*)cam_aligned_alloc(((6 * __TS_MOST) + 2) * sizeof(double), CAM_SIMD_ALIGN);
+  if (!x) {
+    res.value = res.error = NAN;
+    res.status = CAM_QUAD_NOMEM;
+    return res;
+  }
+  double* y = x + ((2 * __TS_MOST) + 1);
+  double* scratch = y + ((2 * __TS_MOST) + 1);
+
+  double c = 0.5 * (a + b), h = 0.5 * (b - a);
+  double sum = 0.0, value = 0.0, last = 0.0, error = INFINITY;
+  res.status = CAM_QUAD_LIMIT;
+  for (size_t k = 0; k < __TS_LEVELS; ++k) {
+    const double* d;
+    const double* w;
+    size_t n = __ts_level(k, &d, &w, scratch);
+
+    // Nodes fall toward the ends, so the first that rounds onto its end ends that side
+    size_t lo = 0, hi = 0, p = 0;
+    for (size_t j = (k == 0) ? 1 : 0; j < n; ++j, ++lo) {
+      x[p] = a + (h * d[j]);
+      if (x[p] == a) { break; }
+      ++p;
+    }
+    for (size_t j = (k == 0) ? 1 : 0; j < n; ++j, ++hi) {
+      x[p] = b - (h * d[j]);
+      if (x[p] == b) { break; }
+      ++p;
+    }
+    if (k == 0) { x[p++] = c; }
+    f(arg, y, x, p);
+    res.evals += p;
+    res.calls += 1;
+
+    size_t first = (k == 0) ? 1 : 0;
+    double s = (k == 0) ? w[0] * y[p - 1] : 0.0;
+    for (size_t j = 0; j < lo; ++j) { s += w[first + j] * y[j]; }
+    for (size_t j = 0; j < hi; ++j) { s += w[first + j] * y[lo + j]; }
+    sum += s;
+    value = h * sum / (double)((size_t)1 << k);
+    if (!isfinite(value)) {
+      res.status = CAM_QUAD_NONFINITE;
+      break;
+    }
+    if (k > 0) { error = fabs(value - last); }
+    if (k > 1 && error <= fmax(abs_tol, rel_tol * fabs(value))) {
+      res.status = CAM_QUAD_OK;
+      break;
+    }
+    last = value;
+  }
+  res.value = value;
+  res.error = error;
+  cam_aligned_free(x);
+  return res;
+}
+
+#endif
@@ -11,5 +11,11 @@
 #include "cam/linear/vec3.h"
 #include "cam/linear/vec4.h"
 #include "cam/linear/mat2x2.h"
+#include "cam/linear/mat3x3.h"
+#include "cam/linear/mat4x4.h"
+#include "cam/linear/vec3_soa.h"
+#include "cam/linear/vec4_soa.h"
+#include "cam/linear/mat3x3_soa.h"
+#include "cam/linear/mat4x4_soa.h"
 
 #endif
@@ -8,4 +8,311 @@
 
 #include "cam/common.h"
 
+/* Linkage of the linear algebra functions */
+// CAM_HEADER_ONLY defines every function inline in its header so calls can be
+// optimized across; the definitions then use the caller's SIMD switches. The
+// runtime dispatch build compiles every function once per SIMD tier with
+// internal linkage (see src/linear/linear_tier.h) and overrides this.
+#ifndef CAM_LINEAR_API
+#if defined(CAM_HEADER_ONLY)
+#define CAM_LINEAR_API static inline
+#else
+#define CAM_LINEAR_API CAM_API
+#endif
+#endif
+
+/* Calling convention of the by-value functions */
+// The *v functions take and return their operands by value so chained expressions
+// can stay in vector registers. The SysV ABI already passes a vector struct in one
+// xmm register; matrices are larger than 16 bytes and go through memory there
+// unless the call is inlined. MSVC needs __vectorcall to do either.
+#if defined(CAM_CMP_MSVC) && (defined(CAM_ARCH_X86) || defined(CAM_ARCH_X64))
+#define CAM_VECTORCALL __vectorcall
+#else
+#define CAM_VECTORCALL
+#endif
+
+/* SIMD arithmetic helpers */
+#if defined(CAM_SIMD_AVX)
+// a * b + c, fused into one instruction when the target supports FMA
+static inline __m128 __linear_fmadd(__m128 a, __m128 b, __m128 c) {
+#if defined(__FMA__) || (defined(CAM_CMP_MSVC) && defined(__AVX2__))
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+#if defined(CAM_SIMD_AVX2)
+static inline __m256 __linear_fmadd256(__m256 a, __m256 b, __m256 c) {
+#if defined(__FMA__) || defined(CAM_CMP_MSVC)
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+/* Approximate reciprocals */
+// The hardware estimates (_mm_rsqrt_ps, _mm_rcp_ps) have a maximum relative error
+// of 1.5 * 2^-12 (3.7e-4). Defining CAM_FAST_NEWTON adds one Newton-Raphson step to
+// every *_fast function, bringing the error down to a few float ulps (< 1e-6).
+// NEON estimates are only 8 bits, so one step is always taken there.
+#if defined(CAM_SIMD_AVX)
+static inline __m128 __linear_rsqrt_fast(__m128 x) {
+  __m128 y = _mm_rsqrt_ps(x);
+#if defined(CAM_FAST_NEWTON)
+  // y * (1.5 - 0.5 * x * y * y)
+  __m128 hxy = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y);
+  y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hxy, y)));
+#endif
+  return y;
+}
+
+static inline __m128 __linear_rcp_fast(__m128 x) {
+  __m128 y = _mm_rcp_ps(x);
+#if defined(CAM_FAST_NEWTON)
+  // y * (2 - x * y)
+  y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(x, y)));
+#endif
+  return y;
+}
+
+// Sum of the four lanes, broadcast to every lane
+static inline __m128 __linear_hsum(__m128 v) {
+  __m128 t = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_add_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// |v| in every lane; zero vectors give zero instead of 0 * inf
+static inline __m128 __linear_mag_fast(__m128 v) {
+  __m128 d = __linear_hsum(_mm_mul_ps(v, v));
+  __m128 m = _mm_mul_ps(d, __linear_rsqrt_fast(d));
+  return _mm_and_ps(m, _mm_cmpgt_ps(d, _mm_setzero_ps()));
+}
+
+static inline __m128 __linear_norm_fast(__m128 v) {
+  return _mm_mul_ps(v, __linear_rsqrt_fast(__linear_hsum(_mm_mul_ps(v, v))));
+}
+
+#elif defined(CAM_SIMD_NEON)
+static inline float32x4_t __linear_rsqrt_fast(float32x4_t x) {
+  float32x4_t y = vrsqrteq_f32(x);
+  y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+#if defined(CAM_FAST_NEWTON)
+  y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+#endif
+  return y;
+}
+
+static inline float32x4_t __linear_rcp_fast(float32x4_t x) {
+  float32x4_t y = vrecpeq_f32(x);
+  y = vmulq_f32(y, vrecpsq_f32(x, y));
+#if defined(CAM_FAST_NEWTON)
+  y = vmulq_f32(y, vrecpsq_f32(x, y));
+#endif
+  return y;
+}
+
+static inline float32x4_t __linear_hsum(float32x4_t v) {
+  return vdupq_n_f32(vaddvq_f32(v));
+}
+
+static inline float32x4_t __linear_mag_fast(float32x4_t v) {
+  float32x4_t d = __linear_hsum(vmulq_f32(v, v));
+  float32x4_t m = vmulq_f32(d, __linear_rsqrt_fast(d));
+  return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m), vcgtzq_f32(d)));
+}
+
+static inline float32x4_t __linear_norm_fast(float32x4_t v) {
+  return vmulq_f32(v, __linear_rsqrt_fast(__linear_hsum(vmulq_f32(v, v))));
+}
+#endif
+
+#if defined(CAM_SIMD_AVX2)
+static inline __m256 __linear_rsqrt_fast256(__m256 x) {
+  __m256 y = _mm256_rsqrt_ps(x);
+#if defined(CAM_FAST_NEWTON)
+  __m256 hxy = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), y);
+  y = _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(hxy, y)));
+#endif
+  return y;
+}
+
+static inline __m256 __linear_rcp_fast256(__m256 x) {
+  __m256 y = _mm256_rcp_ps(x);
+#if defined(CAM_FAST_NEWTON)
+  y = _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(x, y)));
+#endif
+  return y;
+}
+
+// Sum of each 128-bit half, broadcast within the half
+static inline __m256 __linear_hsum256(__m256 v) {
+  __m256 t = _mm256_add_ps(v, _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm256_add_ps(t, _mm256_permute_ps(t, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#endif
+
+/* Approximate array kernels */
+// Shared by the vec2/vec3/vec4 *_fast_n functions, which all store four floats per
+// element with the unused lanes zero. keep masks the lanes a reciprocal may write.
+#if defined(CAM_SIMD_AVX)
+static inline void __linear_mag_fast_n(float* dst, const __m128* src, size_t count) {
+  size_t i = 0;
+  size_t whole = count & ~(size_t)3;
+  for (; i < whole; i += 4) {
+    __m128 a = _mm_mul_ps(src[i], src[i]);
+    __m128 b = _mm_mul_ps(src[i + 1], src[i + 1]);
+    __m128 c = _mm_mul_ps(src[i + 2], src[i + 2]);
+    __m128 d = _mm_mul_ps(src[i + 3], src[i + 3]);
+    // Transpose so each lane holds the squares of one element, then sum the rows
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    __m128 dot = _mm_add_ps(_mm_add_ps(a, b), _mm_add_ps(c, d));
+    __m128 m = _mm_mul_ps(dot, __linear_rsqrt_fast(dot));
+    _mm_storeu_ps(dst + i, _mm_and_ps(m, _mm_cmpgt_ps(dot, _mm_setzero_ps())));
+  }
+  for (; i < count; ++i) {
+    dst[i] = _mm_cvtss_f32(__linear_mag_fast(src[i]));
+  }
+}
+
+static inline void __linear_norm_fast_n(__m128* dst, const __m128* src, size_t count) {
+  size_t i = 0;
+#if defined(CAM_SIMD_AVX2)
+  size_t whole = count & ~(size_t)1;
+  for (; i < whole; i += 2) {
+    __m256 v = _mm256_loadu_ps((const float*)(src + i));
+    __m256 d = __linear_hsum256(_mm256_mul_ps(v, v));
+    _mm256_storeu_ps((float*)(dst + i), _mm256_mul_ps(v, __linear_rsqrt_fast256(d)));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = __linear_norm_fast(src[i]);
+  }
+}
+
+static inline void __linear_rcp_fast_n(__m128* dst, const __m128* src, size_t count, __m128 keep) {
+  size_t i = 0;
+#if defined(CAM_SIMD_AVX2)
+  __m256 keep2 = _mm256_set_m128(keep, keep);
+  size_t whole = count & ~(size_t)1;
+  for (; i < whole; i += 2) {
+    __m256 v = _mm256_loadu_ps((const float*)(src + i));
+    _mm256_storeu_ps((float*)(dst + i), _mm256_and_ps(__linear_rcp_fast256(v), keep2));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = _mm_and_ps(__linear_rcp_fast(src[i]), keep);
+  }
+}
+#endif
+
+/* Batch kernel helpers */
+// The structure-of-arrays kernels are written once against these wrappers, which
+// map to 8-wide AVX2 or 4-wide SSE depending on the translation unit's target.
+#if defined(CAM_SIMD_AVX2)
+typedef __m256 __soa_vec;
+typedef __m256i __soa_mask;
+#define __SOA_WIDTH 8
+#define __soa_set1 _mm256_set1_ps
+#define __soa_loadu _mm256_loadu_ps
+#define __soa_storeu _mm256_storeu_ps
+#define __soa_add _mm256_add_ps
+#define __soa_sub _mm256_sub_ps
+#define __soa_mul _mm256_mul_ps
+#define __soa_div _mm256_div_ps
+#define __soa_sqrt _mm256_sqrt_ps
+#define __soa_and _mm256_and_ps
+#define __soa_xor _mm256_xor_ps
+#define __soa_or _mm256_or_ps
+#define __soa_andnot _mm256_andnot_ps
+#define __soa_min _mm256_min_ps
+#define __soa_max _mm256_max_ps
+#define __soa_blendv _mm256_blendv_ps
+#define __soa_cmpgt(a, b) _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define __soa_fmadd __linear_fmadd256
+
+// 32-bit integer lanes, for bit manipulation of the float lanes
+typedef __m256i __soa_ivec;
+#define __soa_cvti _mm256_cvtps_epi32
+#define __soa_cvtf _mm256_cvtepi32_ps
+#define __soa_seti _mm256_set1_epi32
+#define __soa_addi _mm256_add_epi32
+#define __soa_subi _mm256_sub_epi32
+#define __soa_slli _mm256_slli_epi32
+#define __soa_srai _mm256_srai_epi32
+#define __soa_casti _mm256_castsi256_ps
+
+// Mask enabling the first n (< 8) lanes, used for tail elements
+static inline __soa_mask __soa_tail_mask(size_t n) {
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+// Load 8 floats, or only the lanes in mask when fewer than 8 remain
+static inline __soa_vec __soa_load(const float* p, size_t remain, __soa_mask mask) {
+  return (remain >= 8) ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, mask);
+}
+
+// Store 8 floats, or only the lanes in mask when fewer than 8 remain
+static inline void __soa_store(float* p, __soa_vec v, size_t remain, __soa_mask mask) {
+  if (remain >= 8) { _mm256_storeu_ps(p, v); }
+  else { _mm256_maskstore_ps(p, mask, v); }
+}
+
+#elif defined(CAM_SIMD_AVX)
+typedef __m128 __soa_vec;
+typedef size_t __soa_mask;
+#define __SOA_WIDTH 4
+#define __soa_set1 _mm_set1_ps
+#define __soa_loadu _mm_loadu_ps
+#define __soa_storeu _mm_storeu_ps
+#define __soa_add _mm_add_ps
+#define __soa_sub _mm_sub_ps
+#define __soa_mul _mm_mul_ps
+#define __soa_div _mm_div_ps
+#define __soa_sqrt _mm_sqrt_ps
+#define __soa_and _mm_and_ps
+#define __soa_xor _mm_xor_ps
+#define __soa_or _mm_or_ps
+#define __soa_andnot _mm_andnot_ps
+#define __soa_min _mm_min_ps
+#define __soa_max _mm_max_ps
+#define __soa_blendv _mm_blendv_ps
+#define __soa_cmpgt _mm_cmpgt_ps
+#define __soa_fmadd __linear_fmadd
+
+typedef __m128i __soa_ivec;
+#define __soa_cvti _mm_cvtps_epi32
+#define __soa_cvtf _mm_cvtepi32_ps
+#define __soa_seti _mm_set1_epi32
+#define __soa_addi _mm_add_epi32
+#define __soa_subi _mm_sub_epi32
+#define __soa_slli _mm_slli_epi32
+#define __soa_srai _mm_srai_epi32
+#define __soa_casti _mm_castsi128_ps
+
+// SSE has no masked moves, so the tail "mask" is the lane count
+static inline __soa_mask __soa_tail_mask(size_t n) {
+  return n;
+}
+
+// Load 4 floats, or only the first mask lanes (zero filled) when fewer than 4 remain
+static inline __soa_vec __soa_load(const float* p, size_t remain, __soa_mask mask) {
+  if (remain >= 4) { return _mm_loadu_ps(p); }
+  float buff[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  for (size_t i = 0; i < mask; ++i) { buff[i] = p[i]; }
+  return _mm_loadu_ps(buff);
+}
+
+// Store 4 floats, or only the first mask lanes when fewer than 4 remain
+static inline void __soa_store(float* p, __soa_vec v, size_t remain, __soa_mask mask) {
+  if (remain >= 4) { _mm_storeu_ps(p, v); return; }
+  float buff[4];
+  _mm_storeu_ps(buff, v);
+  for (size_t i = 0; i < mask; ++i) { p[i] = buff[i]; }
+}
+#endif
+
 #endif
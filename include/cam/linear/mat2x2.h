@@ -18,39 +18,76 @@ typedef struct {
   // AMD NEON
 
 #else
-  // No SIMD intrinsics
-  float data[4];
+  // No SIMD intrinsics, columns padded like the SIMD layout
+  float data[2][4];
 #endif
 } mat2x2;
 
 
 /* mat2x2 functions */
-#if defined(CAM_SIMD_AVX)
-CAM_API __m128 __mat2x2_get_row(mat2x2* m, unsigned int row);
-#endif
+CAM_LINEAR_API mat2x2 mat2x2_make(float x1, float y1, float x2, float y2);
+
+CAM_LINEAR_API mat2x2 mat2x2_makeid();
+
+CAM_LINEAR_API bool mat2x2_equal(mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API bool mat2x2_equalid(mat2x2* m);
+
+CAM_LINEAR_API float mat2x2_get(unsigned int col, unsigned int row, mat2x2* m);
+
+CAM_LINEAR_API mat2x2 mat2x2_add(mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API mat2x2 mat2x2_sub(mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API mat2x2 mat2x2_scale(mat2x2* m, float s);
+
+CAM_LINEAR_API mat2x2 mat2x2_mul(mat2x2* a, mat2x2* b);
 
-CAM_API mat2x2 mat2x2_make(float x1, float y1, float x2, float y2);
+// Computes dst[i] = a[i] * b[i] for count pairs. dst may alias a or b.
+CAM_LINEAR_API void mat2x2_mul_n(mat2x2* dst, mat2x2* a, mat2x2* b, size_t count);
 
-CAM_API mat2x2 mat2x2_makeid();
+CAM_LINEAR_API vec2 mat2x2_vec2_mul(mat2x2* m, vec2* v);
 
-CAM_API bool mat2x2_equal(mat2x2* a, mat2x2* b);
+CAM_LINEAR_API mat2x2 mat2x2_transpose(mat2x2* m);
 
-CAM_API bool mat2x2_equalid(mat2x2* m);
+CAM_LINEAR_API float mat2x2_det(mat2x2* m);
 
-CAM_API float mat2x2_get(unsigned int col, unsigned int row, mat2x2* m);
 
-CAM_API mat2x2 mat2x2_add(mat2x2* a, mat2x2* b);
+/* mat2x2 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API mat2x2 CAM_VECTORCALL mat2x2_addv(mat2x2 a, mat2x2 b);
 
-CAM_API mat2x2 mat2x2_sub(mat2x2* a, mat2x2* b);
+CAM_LINEAR_API mat2x2 CAM_VECTORCALL mat2x2_subv(mat2x2 a, mat2x2 b);
 
-CAM_API mat2x2 mat2x2_scale(mat2x2* m, float s);
+CAM_LINEAR_API mat2x2 CAM_VECTORCALL mat2x2_scalev(mat2x2 m, float s);
 
-CAM_API mat2x2 mat2x2_mul(mat2x2* a, mat2x2* b);
+CAM_LINEAR_API mat2x2 CAM_VECTORCALL mat2x2_mulv(mat2x2 a, mat2x2 b);
 
-CAM_API vec2 mat2x2_vec2_mul(mat2x2* m, vec2* v);
+CAM_LINEAR_API vec2 CAM_VECTORCALL mat2x2_vec2_mulv(mat2x2 m, vec2 v);
 
-CAM_API mat2x2 mat2x2_transpose(mat2x2* m);
+CAM_LINEAR_API mat2x2 CAM_VECTORCALL mat2x2_transposev(mat2x2 m);
 
-CAM_API float mat2x2_det(mat2x2* m);
+CAM_LINEAR_API float CAM_VECTORCALL mat2x2_detv(mat2x2 m);
+
+
+/* mat2x2 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void mat2x2_add_to(mat2x2* dst, mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API void mat2x2_sub_to(mat2x2* dst, mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API void mat2x2_scale_to(mat2x2* dst, mat2x2* m, float s);
+
+CAM_LINEAR_API void mat2x2_mul_to(mat2x2* dst, mat2x2* a, mat2x2* b);
+
+CAM_LINEAR_API void mat2x2_vec2_mul_to(vec2* dst, mat2x2* m, vec2* v);
+
+CAM_LINEAR_API void mat2x2_transpose_to(mat2x2* dst, mat2x2* m);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/mat2x2.inl"
+#endif
 
 #endif
@@ -0,0 +1,345 @@
+/*
+ * mat2x2.inl
+ * Definitions for 2x2 matrix of floats in column-major order.
+ * Compiled by src/linear/mat2x2.c, or included by mat2x2.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_MAT2X2_INL
+#define CAM_LINEAR_MAT2X2_INL
+
+#include "cam/linear/mat2x2.h"
+
+ /* mat2x2 functions */
+#if defined(CAM_SIMD_AVX)
+// m * v as a combination of the columns of m, weighted by the broadcast lanes of v
+static inline __m128 __mat2x2_combine(__m128 c0, __m128 c1, __m128 v) {
+  __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+  return __linear_fmadd(c1, _mm_shuffle_ps(v, v, 0x55), r);
+}
+#endif
+
+mat2x2 mat2x2_make(float x1, float y1, float x2, float y2) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(0.0f, 0.0f, y1, x1);
+  n.data[1] = _mm_set_ps(0.0f, 0.0f, y2, x2);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  n.data[0][0] = x1;
+  n.data[0][1] = y1;
+  n.data[0][2] = 0.0f;
+  n.data[0][3] = 0.0f;
+  n.data[1][0] = x2;
+  n.data[1][1] = y2;
+  n.data[1][2] = 0.0f;
+  n.data[1][3] = 0.0f;
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_makeid() {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f);
+  n.data[1] = _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (col == row) ? 1.0f : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+bool mat2x2_equal(mat2x2* a, mat2x2* b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(a->data[0], b->data[0]);
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[1], b->data[1]);
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 2; ++row) {
+      if (a->data[col][row] != b->data[col][row]) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+bool mat2x2_equalid(mat2x2* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(m->data[0], _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[1], _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 2; ++row) {
+      if (m->data[col][row] != ((col == row) ? 1.0f : 0.0f)) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+float mat2x2_get(unsigned int col, unsigned int row, mat2x2* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 n = m->data[col];
+  __m128 tmp;
+  if (row == 0) { tmp = _mm_shuffle_ps(n, n, 0); }
+  else { tmp = _mm_shuffle_ps(n, n, 1); }
+  return _mm_cvtss_f32(tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  return m->data[col][row];
+#endif
+}
+
+mat2x2 CAM_VECTORCALL mat2x2_addv(mat2x2 a, mat2x2 b) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_add_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_add_ps(a.data[1], b.data[1]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] + b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_add(mat2x2* a, mat2x2* b) {
+  return mat2x2_addv(*a, *b);
+}
+
+void mat2x2_add_to(mat2x2* dst, mat2x2* a, mat2x2* b) {
+  *dst = mat2x2_addv(*a, *b);
+}
+
+mat2x2 CAM_VECTORCALL mat2x2_subv(mat2x2 a, mat2x2 b) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_sub_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_sub_ps(a.data[1], b.data[1]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] - b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_sub(mat2x2* a, mat2x2* b) {
+  return mat2x2_subv(*a, *b);
+}
+
+void mat2x2_sub_to(mat2x2* dst, mat2x2* a, mat2x2* b) {
+  *dst = mat2x2_subv(*a, *b);
+}
+
+mat2x2 CAM_VECTORCALL mat2x2_scalev(mat2x2 m, float s) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps1(s);
+  n.data[0] = _mm_mul_ps(m.data[0], tmp);
+  n.data[1] = _mm_mul_ps(m.data[1], tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = m.data[col][row] * s;
+    }
+  }
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_scale(mat2x2* m, float s) {
+  return mat2x2_scalev(*m, s);
+}
+
+void mat2x2_scale_to(mat2x2* dst, mat2x2* m, float s) {
+  *dst = mat2x2_scalev(*m, s);
+}
+
+mat2x2 CAM_VECTORCALL mat2x2_mulv(mat2x2 a, mat2x2 b) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Each column of the product is a combination of the columns of a
+  n.data[0] = __mat2x2_combine(a.data[0], a.data[1], b.data[0]);
+  n.data[1] = __mat2x2_combine(a.data[0], a.data[1], b.data[1]);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (a.data[0][row] * b.data[col][0]) +
+                         (a.data[1][row] * b.data[col][1]);
+    }
+  }
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_mul(mat2x2* a, mat2x2* b) {
+  return mat2x2_mulv(*a, *b);
+}
+
+void mat2x2_mul_to(mat2x2* dst, mat2x2* a, mat2x2* b) {
+  *dst = mat2x2_mulv(*a, *b);
+}
+
+void mat2x2_mul_n(mat2x2* dst, mat2x2* a, mat2x2* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (size_t i = 0; i < count; ++i) {
+    __m128 a0 = a[i].data[0];
+    __m128 a1 = a[i].data[1];
+    __m128 b0 = b[i].data[0];
+    __m128 b1 = b[i].data[1];
+    dst[i].data[0] = __mat2x2_combine(a0, a1, b0);
+    dst[i].data[1] = __mat2x2_combine(a0, a1, b1);
+  }
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = mat2x2_mul(&a[i], &b[i]);
+  }
+#endif
+}
+
+vec2 CAM_VECTORCALL mat2x2_vec2_mulv(mat2x2 m, vec2 v) {
+  vec2 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = __mat2x2_combine(m.data[0], m.data[1], v.data);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int row = 0; row < 4; ++row) {
+    r.data[row] = (m.data[0][row] * v.data[0]) +
+                  (m.data[1][row] * v.data[1]);
+  }
+#endif
+  return r;
+}
+
+vec2 mat2x2_vec2_mul(mat2x2* m, vec2* v) {
+  return mat2x2_vec2_mulv(*m, *v);
+}
+
+void mat2x2_vec2_mul_to(vec2* dst, mat2x2* m, vec2* v) {
+  *dst = mat2x2_vec2_mulv(*m, *v);
+}
+
+mat2x2 CAM_VECTORCALL mat2x2_transposev(mat2x2 m) {
+  mat2x2 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 t0 = _mm_unpacklo_ps(m.data[0], m.data[1]);
+  n.data[0] = _mm_movelh_ps(t0, _mm_setzero_ps());
+  n.data[1] = _mm_movehl_ps(_mm_setzero_ps(), t0);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 2; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (row < 2) ? m.data[row][col] : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+mat2x2 mat2x2_transpose(mat2x2* m) {
+  return mat2x2_transposev(*m);
+}
+
+void mat2x2_transpose_to(mat2x2* dst, mat2x2* m) {
+  *dst = mat2x2_transposev(*m);
+}
+
+float CAM_VECTORCALL mat2x2_detv(mat2x2 m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_unpacklo_ps(m.data[0], m.data[1]);
+  __m128 t0 = _mm_shuffle_ps(tmp, _mm_setzero_ps(), 0b00001000);
+  __m128 t1 = _mm_shuffle_ps(tmp, _mm_setzero_ps(), 0b00000111);
+  t1 = _mm_mul_ps(t1, _mm_set_ps(0.0f, 0.0f, -1.0f, 1.0f));
+  tmp = _mm_dp_ps(t0, t1, 0xFF);
+  return _mm_cvtss_f32(tmp);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  return ((m.data[0][0] * m.data[1][1]) - (m.data[0][1] * m.data[1][0]));
+
+#endif
+}
+
+float mat2x2_det(mat2x2* m) {
+  return mat2x2_detv(*m);
+}
+
+#endif
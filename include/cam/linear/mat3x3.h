@@ -18,39 +18,92 @@ typedef struct {
   // AMD NEON
 
 #else
-  // No SIMD intrinsics
-  float data[4];
+  // No SIMD intrinsics, columns padded like the SIMD layout
+  float data[3][4];
 #endif
 } mat3x3;
 
 
 /* mat3x3 functions */
-#if defined(CAM_SIMD_AVX)
-CAM_API __m128 __mat3x3_get_row(mat3x3* m, unsigned int row);
-#endif
+CAM_LINEAR_API mat3x3 mat3x3_make(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3);
+
+CAM_LINEAR_API mat3x3 mat3x3_makeid();
+
+CAM_LINEAR_API bool mat3x3_equal(mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API bool mat3x3_equalid(mat3x3* m);
+
+CAM_LINEAR_API float mat3x3_get(unsigned int col, unsigned int row, mat3x3* m);
+
+CAM_LINEAR_API mat3x3 mat3x3_add(mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API mat3x3 mat3x3_sub(mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API mat3x3 mat3x3_scale(mat3x3* m, float s);
+
+CAM_LINEAR_API mat3x3 mat3x3_mul(mat3x3* a, mat3x3* b);
+
+// Computes dst[i] = a[i] * b[i] for count pairs. dst may alias a or b.
+CAM_LINEAR_API void mat3x3_mul_n(mat3x3* dst, mat3x3* a, mat3x3* b, size_t count);
+
+CAM_LINEAR_API vec3 mat3x3_vec3_mul(mat3x3* m, vec3* v);
+
+CAM_LINEAR_API mat3x3 mat3x3_transpose(mat3x3* m);
 
-CAM_API mat3x3 mat3x3_make(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3);
+CAM_LINEAR_API float mat3x3_det(mat3x3* m);
 
-CAM_API mat3x3 mat3x3_makeid();
+// Result is undefined (non-finite) when the matrix is singular.
+CAM_LINEAR_API mat3x3 mat3x3_inverse(mat3x3* m);
 
-CAM_API bool mat3x3_equal(mat3x3* a, mat3x3* b);
+// Inverse of a 2D rigid transform (rotation in the upper 2x2 block, translation in the
+// third column, bottom row (0, 0, 1)): transposes the rotation and negates the rotated
+// translation. Other matrices give a meaningless result; use mat3x3_inverse for them.
+CAM_LINEAR_API mat3x3 mat3x3_inverse_rigid(mat3x3* m);
 
-CAM_API bool mat3x3_equalid(mat3x3* m);
 
-CAM_API float mat3x3_get(unsigned int col, unsigned int row, mat3x3* m);
+/* mat3x3 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_addv(mat3x3 a, mat3x3 b);
 
-CAM_API mat3x3 mat3x3_add(mat3x3* a, mat3x3* b);
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_subv(mat3x3 a, mat3x3 b);
 
-CAM_API mat3x3 mat3x3_sub(mat3x3* a, mat3x3* b);
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_scalev(mat3x3 m, float s);
 
-CAM_API mat3x3 mat3x3_scale(mat3x3* m, float s);
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_mulv(mat3x3 a, mat3x3 b);
 
-CAM_API mat3x3 mat3x3_mul(mat3x3* a, mat3x3* b);
+CAM_LINEAR_API vec3 CAM_VECTORCALL mat3x3_vec3_mulv(mat3x3 m, vec3 v);
 
-CAM_API vec2 mat3x3_vec3_mul(mat3x3* m, vec3* v);
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_transposev(mat3x3 m);
 
-CAM_API mat3x3 mat3x3_transpose(mat3x3* m);
+CAM_LINEAR_API float CAM_VECTORCALL mat3x3_detv(mat3x3 m);
 
-CAM_API float mat3x3_det(mat3x3* m);
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_inversev(mat3x3 m);
+
+CAM_LINEAR_API mat3x3 CAM_VECTORCALL mat3x3_inverse_rigidv(mat3x3 m);
+
+
+/* mat3x3 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void mat3x3_add_to(mat3x3* dst, mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API void mat3x3_sub_to(mat3x3* dst, mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API void mat3x3_scale_to(mat3x3* dst, mat3x3* m, float s);
+
+CAM_LINEAR_API void mat3x3_mul_to(mat3x3* dst, mat3x3* a, mat3x3* b);
+
+CAM_LINEAR_API void mat3x3_vec3_mul_to(vec3* dst, mat3x3* m, vec3* v);
+
+CAM_LINEAR_API void mat3x3_transpose_to(mat3x3* dst, mat3x3* m);
+
+CAM_LINEAR_API void mat3x3_inverse_to(mat3x3* dst, mat3x3* m);
+
+CAM_LINEAR_API void mat3x3_inverse_rigid_to(mat3x3* dst, mat3x3* m);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/mat3x3.inl"
+#endif
 
 #endif
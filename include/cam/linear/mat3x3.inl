@@ -0,0 +1,465 @@
+/*
+ * mat3x3.inl
+ * Definitions for 3x3 matrix of floats in column-major order.
+ * Compiled by src/linear/mat3x3.c, or included by mat3x3.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_MAT3X3_INL
+#define CAM_LINEAR_MAT3X3_INL
+
+#include "cam/linear/mat3x3.h"
+
+ /* mat3x3 functions */
+#if defined(CAM_SIMD_AVX)
+// m * v as a combination of the columns of m, weighted by the broadcast lanes of v
+static inline __m128 __mat3x3_combine(__m128 c0, __m128 c1, __m128 c2, __m128 v) {
+  __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+  r = __linear_fmadd(c1, _mm_shuffle_ps(v, v, 0x55), r);
+  return __linear_fmadd(c2, _mm_shuffle_ps(v, v, 0xAA), r);
+}
+
+// a x b; the w lane stays zero when both inputs have zero w lanes
+static inline __m128 __mat3x3_cross(__m128 a, __m128 b) {
+  __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+#elif !defined(CAM_SIMD_NEON)
+// a x b on the first three floats of each column
+static inline void __mat3x3_cross(const float* a, const float* b, float* r) {
+  r[0] = (a[1] * b[2]) - (a[2] * b[1]);
+  r[1] = (a[2] * b[0]) - (a[0] * b[2]);
+  r[2] = (a[0] * b[1]) - (a[1] * b[0]);
+}
+#endif
+
+mat3x3 mat3x3_make(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(0.0f, z1, y1, x1);
+  n.data[1] = _mm_set_ps(0.0f, z2, y2, x2);
+  n.data[2] = _mm_set_ps(0.0f, z3, y3, x3);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  n.data[0][0] = x1;
+  n.data[0][1] = y1;
+  n.data[0][2] = z1;
+  n.data[0][3] = 0.0f;
+  n.data[1][0] = x2;
+  n.data[1][1] = y2;
+  n.data[1][2] = z2;
+  n.data[1][3] = 0.0f;
+  n.data[2][0] = x3;
+  n.data[2][1] = y3;
+  n.data[2][2] = z3;
+  n.data[2][3] = 0.0f;
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_makeid() {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f);
+  n.data[1] = _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f);
+  n.data[2] = _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (col == row) ? 1.0f : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+bool mat3x3_equal(mat3x3* a, mat3x3* b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(a->data[0], b->data[0]);
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[1], b->data[1]);
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[2], b->data[2]);
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      if (a->data[col][row] != b->data[col][row]) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+bool mat3x3_equalid(mat3x3* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(m->data[0], _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[1], _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[2], _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      if (m->data[col][row] != ((col == row) ? 1.0f : 0.0f)) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+float mat3x3_get(unsigned int col, unsigned int row, mat3x3* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 n = m->data[col];
+  __m128 tmp;
+       if (row == 0) { tmp = _mm_shuffle_ps(n, n, 0); } // Compiler doesn't like a variable here?
+  else if (row == 1) { tmp = _mm_shuffle_ps(n, n, 1); }
+  else if (row == 2) { tmp = _mm_shuffle_ps(n, n, 2); }
+  return _mm_cvtss_f32(tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  return m->data[col][row];
+#endif
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_addv(mat3x3 a, mat3x3 b) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_add_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_add_ps(a.data[1], b.data[1]);
+  n.data[2] = _mm_add_ps(a.data[2], b.data[2]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] + b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_add(mat3x3* a, mat3x3* b) {
+  return mat3x3_addv(*a, *b);
+}
+
+void mat3x3_add_to(mat3x3* dst, mat3x3* a, mat3x3* b) {
+  *dst = mat3x3_addv(*a, *b);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_subv(mat3x3 a, mat3x3 b) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_sub_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_sub_ps(a.data[1], b.data[1]);
+  n.data[2] = _mm_sub_ps(a.data[2], b.data[2]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] - b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_sub(mat3x3* a, mat3x3* b) {
+  return mat3x3_subv(*a, *b);
+}
+
+void mat3x3_sub_to(mat3x3* dst, mat3x3* a, mat3x3* b) {
+  *dst = mat3x3_subv(*a, *b);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_scalev(mat3x3 m, float s) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps1(s);
+  n.data[0] = _mm_mul_ps(m.data[0], tmp);
+  n.data[1] = _mm_mul_ps(m.data[1], tmp);
+  n.data[2] = _mm_mul_ps(m.data[2], tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = m.data[col][row] * s;
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_scale(mat3x3* m, float s) {
+  return mat3x3_scalev(*m, s);
+}
+
+void mat3x3_scale_to(mat3x3* dst, mat3x3* m, float s) {
+  *dst = mat3x3_scalev(*m, s);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_mulv(mat3x3 a, mat3x3 b) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Each column of the product is a combination of the columns of a
+  n.data[0] = __mat3x3_combine(a.data[0], a.data[1], a.data[2], b.data[0]);
+  n.data[1] = __mat3x3_combine(a.data[0], a.data[1], a.data[2], b.data[1]);
+  n.data[2] = __mat3x3_combine(a.data[0], a.data[1], a.data[2], b.data[2]);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (a.data[0][row] * b.data[col][0]) +
+                         (a.data[1][row] * b.data[col][1]) +
+                         (a.data[2][row] * b.data[col][2]);
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_mul(mat3x3* a, mat3x3* b) {
+  return mat3x3_mulv(*a, *b);
+}
+
+void mat3x3_mul_to(mat3x3* dst, mat3x3* a, mat3x3* b) {
+  *dst = mat3x3_mulv(*a, *b);
+}
+
+void mat3x3_mul_n(mat3x3* dst, mat3x3* a, mat3x3* b, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  for (size_t i = 0; i < count; ++i) {
+    __m128 a0 = a[i].data[0];
+    __m128 a1 = a[i].data[1];
+    __m128 a2 = a[i].data[2];
+    __m128 b0 = b[i].data[0];
+    __m128 b1 = b[i].data[1];
+    __m128 b2 = b[i].data[2];
+    dst[i].data[0] = __mat3x3_combine(a0, a1, a2, b0);
+    dst[i].data[1] = __mat3x3_combine(a0, a1, a2, b1);
+    dst[i].data[2] = __mat3x3_combine(a0, a1, a2, b2);
+  }
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = mat3x3_mul(&a[i], &b[i]);
+  }
+#endif
+}
+
+vec3 CAM_VECTORCALL mat3x3_vec3_mulv(mat3x3 m, vec3 v) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = __mat3x3_combine(m.data[0], m.data[1], m.data[2], v.data);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int row = 0; row < 4; ++row) {
+    r.data[row] = (m.data[0][row] * v.data[0]) +
+                  (m.data[1][row] * v.data[1]) +
+                  (m.data[2][row] * v.data[2]);
+  }
+#endif
+  return r;
+}
+
+vec3 mat3x3_vec3_mul(mat3x3* m, vec3* v) {
+  return mat3x3_vec3_mulv(*m, *v);
+}
+
+void mat3x3_vec3_mul_to(vec3* dst, mat3x3* m, vec3* v) {
+  *dst = mat3x3_vec3_mulv(*m, *v);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_transposev(mat3x3 m) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 c0 = m.data[0], c1 = m.data[1], c2 = m.data[2], c3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  n.data[0] = c0;
+  n.data[1] = c1;
+  n.data[2] = c2;
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (row < 3) ? m.data[row][col] : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_transpose(mat3x3* m) {
+  return mat3x3_transposev(*m);
+}
+
+void mat3x3_transpose_to(mat3x3* dst, mat3x3* m) {
+  *dst = mat3x3_transposev(*m);
+}
+
+float CAM_VECTORCALL mat3x3_detv(mat3x3 m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 c = __mat3x3_cross(m.data[1], m.data[2]);
+  return _mm_cvtss_f32(__linear_hsum(_mm_mul_ps(m.data[0], c)));
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  float c[3];
+  __mat3x3_cross((const float*)&m.data[1], (const float*)&m.data[2], c);
+  return (m.data[0][0] * c[0]) + (m.data[0][1] * c[1]) + (m.data[0][2] * c[2]);
+
+#endif
+}
+
+float mat3x3_det(mat3x3* m) {
+  return mat3x3_detv(*m);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_inversev(mat3x3 m) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Rows of the adjugate are the cross products of column pairs
+  __m128 r0 = __mat3x3_cross(m.data[1], m.data[2]);
+  __m128 r1 = __mat3x3_cross(m.data[2], m.data[0]);
+  __m128 r2 = __mat3x3_cross(m.data[0], m.data[1]);
+  __m128 r3 = _mm_setzero_ps();
+  __m128 rdet = _mm_div_ps(_mm_set1_ps(1.0f), __linear_hsum(_mm_mul_ps(m.data[0], r0)));
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  n.data[0] = _mm_mul_ps(r0, rdet);
+  n.data[1] = _mm_mul_ps(r1, rdet);
+  n.data[2] = _mm_mul_ps(r2, rdet);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  float r[3][3];
+  __mat3x3_cross((const float*)&m.data[1], (const float*)&m.data[2], r[0]);
+  __mat3x3_cross((const float*)&m.data[2], (const float*)&m.data[0], r[1]);
+  __mat3x3_cross((const float*)&m.data[0], (const float*)&m.data[1], r[2]);
+  float rdet = 1.0f / ((m.data[0][0] * r[0][0]) + (m.data[0][1] * r[0][1]) + (m.data[0][2] * r[0][2]));
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (row < 3) ? r[row][col] * rdet : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_inverse(mat3x3* m) {
+  return mat3x3_inversev(*m);
+}
+
+void mat3x3_inverse_to(mat3x3* dst, mat3x3* m) {
+  *dst = mat3x3_inversev(*m);
+}
+
+mat3x3 CAM_VECTORCALL mat3x3_inverse_rigidv(mat3x3 m) {
+  mat3x3 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Transposed rotation block, then -(R^T * t) with 1 in the homogeneous row
+  __m128 t = _mm_unpacklo_ps(m.data[0], m.data[1]);
+  n.data[0] = _mm_movelh_ps(t, _mm_setzero_ps());
+  n.data[1] = _mm_movehl_ps(_mm_setzero_ps(), t);
+  __m128 tr = _mm_mul_ps(n.data[0], _mm_shuffle_ps(m.data[2], m.data[2], _MM_SHUFFLE(0, 0, 0, 0)));
+  tr = __linear_fmadd(n.data[1], _mm_shuffle_ps(m.data[2], m.data[2], _MM_SHUFFLE(1, 1, 1, 1)), tr);
+  n.data[2] = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f), tr);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  float tx = m.data[2][0];
+  float ty = m.data[2][1];
+  for (int col = 0; col < 2; ++col) {
+    n.data[col][0] = m.data[0][col];
+    n.data[col][1] = m.data[1][col];
+    n.data[col][2] = 0.0f;
+    n.data[col][3] = 0.0f;
+  }
+  n.data[2][0] = -((m.data[0][0] * tx) + (m.data[0][1] * ty));
+  n.data[2][1] = -((m.data[1][0] * tx) + (m.data[1][1] * ty));
+  n.data[2][2] = 1.0f;
+  n.data[2][3] = 0.0f;
+#endif
+  return n;
+}
+
+mat3x3 mat3x3_inverse_rigid(mat3x3* m) {
+  return mat3x3_inverse_rigidv(*m);
+}
+
+void mat3x3_inverse_rigid_to(mat3x3* dst, mat3x3* m) {
+  *dst = mat3x3_inverse_rigidv(*m);
+}
+
+#endif
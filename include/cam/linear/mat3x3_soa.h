@@ -0,0 +1,42 @@
+/*
+ * mat3x3_soa.h
+ * Declaration for batches of 3x3 float matrices in structure-of-arrays order.
+ */
+
+#ifndef CAM_LINEAR_MAT3X3_SOA_H
+#define CAM_LINEAR_MAT3X3_SOA_H
+
+#include "cam/linear/linear_common.h"
+#include "cam/linear/mat3x3.h"
+
+/* Define mat3x3_soa struct */
+typedef struct {
+  float* data[9]; // Element arrays in column-major order (data[col * 3 + row]), each aligned to CAM_SIMD_ALIGN bytes
+  size_t count;   // Number of matrices in the batch
+} mat3x3_soa;
+
+
+/* mat3x3_soa functions */
+// Batch operations process m->count (or src->count) matrices. The destination must hold
+// at least that many and may alias the source. Singular matrices give non-finite results.
+CAM_LINEAR_API mat3x3_soa mat3x3_soa_make(size_t count);
+
+CAM_LINEAR_API void mat3x3_soa_free(mat3x3_soa* s);
+
+CAM_LINEAR_API mat3x3 mat3x3_soa_get(mat3x3_soa* s, size_t i);
+
+CAM_LINEAR_API void mat3x3_soa_set(mat3x3_soa* s, size_t i, mat3x3* m);
+
+CAM_LINEAR_API void mat3x3_soa_det(float* dst, mat3x3_soa* m);
+
+CAM_LINEAR_API void mat3x3_soa_inverse(mat3x3_soa* dst, mat3x3_soa* src);
+
+// Same as mat3x3_inverse_rigid for every matrix in the batch
+CAM_LINEAR_API void mat3x3_soa_inverse_rigid(mat3x3_soa* dst, mat3x3_soa* src);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/mat3x3_soa.inl"
+#endif
+
+#endif
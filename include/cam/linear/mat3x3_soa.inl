@@ -0,0 +1,149 @@
+/*
+ * mat3x3_soa.inl
+ * Definitions for batches of 3x3 float matrices in structure-of-arrays order.
+ * Compiled by src/linear/mat3x3_soa.c, or included by mat3x3_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_MAT3X3_SOA_INL
+#define CAM_LINEAR_MAT3X3_SOA_INL
+
+#include "cam/linear/mat3x3_soa.h"
+#include <string.h>
+
+mat3x3_soa mat3x3_soa_make(size_t count) {
+  mat3x3_soa s;
+  memset(&s, 0, sizeof(s));
+  if (count == 0) { return s; }
+
+  // One block for all nine arrays, each rounded up to a whole register
+  size_t stride = (count + 7) & ~(size_t)7;
+
+  // Stagger the arrays by a cache line when the stride is a multiple of 4 KiB, otherwise every
+  // element of a lane block maps to the same cache set and the loads alias each other
+  if ((stride % 1024) == 0) { stride += 16; }
+  float* block = (float*)cam_aligned_alloc(9 * stride * sizeof(float), CAM_SIMD_ALIGN);
+  if (!block) { return s; }
+  memset(block, 0, 9 * stride * sizeof(float));
+  for (int j = 0; j < 9; ++j) {
+    s.data[j] = block + (j * stride);
+  }
+  s.count = count;
+  return s;
+}
+
+void mat3x3_soa_free(mat3x3_soa* s) {
+  cam_aligned_free(s->data[0]);
+  memset(s, 0, sizeof(*s));
+}
+
+mat3x3 mat3x3_soa_get(mat3x3_soa* s, size_t i) {
+  return mat3x3_make(s->data[0][i], s->data[1][i], s->data[2][i],
+                     s->data[3][i], s->data[4][i], s->data[5][i],
+                     s->data[6][i], s->data[7][i], s->data[8][i]);
+}
+
+void mat3x3_soa_set(mat3x3_soa* s, size_t i, mat3x3* m) {
+  for (unsigned int col = 0; col < 3; ++col) {
+    for (unsigned int row = 0; row < 3; ++row) {
+      s->data[(col * 3) + row][i] = mat3x3_get(col, row, m);
+    }
+  }
+}
+
+void mat3x3_soa_det(float* dst, mat3x3_soa* m) {
+  size_t n = m->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec e[9];
+    for (int j = 0; j < 9; ++j) { e[j] = __soa_load(m->data[j] + i, k, tail); }
+    __soa_vec det = __soa_mul(e[0], __soa_sub(__soa_mul(e[4], e[8]), __soa_mul(e[5], e[7])));
+    det = __soa_add(det, __soa_mul(e[1], __soa_sub(__soa_mul(e[5], e[6]), __soa_mul(e[3], e[8]))));
+    det = __soa_add(det, __soa_mul(e[2], __soa_sub(__soa_mul(e[3], e[7]), __soa_mul(e[4], e[6]))));
+    __soa_store(dst + i, det, k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat3x3 t = mat3x3_soa_get(m, i);
+    dst[i] = mat3x3_detv(t);
+  }
+#endif
+}
+
+void mat3x3_soa_inverse(mat3x3_soa* dst, mat3x3_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec e[9];
+    for (int j = 0; j < 9; ++j) { e[j] = __soa_load(src->data[j] + i, k, tail); }
+
+    // Cofactors by column pair cross products; r[row * 3 + col] is the adjugate
+    __soa_vec r[9];
+    r[0] = __soa_sub(__soa_mul(e[4], e[8]), __soa_mul(e[5], e[7]));
+    r[1] = __soa_sub(__soa_mul(e[5], e[6]), __soa_mul(e[3], e[8]));
+    r[2] = __soa_sub(__soa_mul(e[3], e[7]), __soa_mul(e[4], e[6]));
+    r[3] = __soa_sub(__soa_mul(e[7], e[2]), __soa_mul(e[8], e[1]));
+    r[4] = __soa_sub(__soa_mul(e[8], e[0]), __soa_mul(e[6], e[2]));
+    r[5] = __soa_sub(__soa_mul(e[6], e[1]), __soa_mul(e[7], e[0]));
+    r[6] = __soa_sub(__soa_mul(e[1], e[5]), __soa_mul(e[2], e[4]));
+    r[7] = __soa_sub(__soa_mul(e[2], e[3]), __soa_mul(e[0], e[5]));
+    r[8] = __soa_sub(__soa_mul(e[0], e[4]), __soa_mul(e[1], e[3]));
+
+    // One division per lane block
+    __soa_vec det = __soa_add(__soa_add(__soa_mul(e[0], r[0]), __soa_mul(e[1], r[1])), __soa_mul(e[2], r[2]));
+    __soa_vec rdet = __soa_div(__soa_set1(1.0f), det);
+    for (int col = 0; col < 3; ++col) {
+      for (int row = 0; row < 3; ++row) {
+        __soa_store(dst->data[(col * 3) + row] + i, __soa_mul(r[(row * 3) + col], rdet), k, tail);
+      }
+    }
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat3x3 t = mat3x3_inversev(mat3x3_soa_get(src, i));
+    mat3x3_soa_set(dst, i, &t);
+  }
+#endif
+}
+
+void mat3x3_soa_inverse_rigid(mat3x3_soa* dst, mat3x3_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec r00 = __soa_load(src->data[0] + i, k, tail);
+    __soa_vec r10 = __soa_load(src->data[1] + i, k, tail);
+    __soa_vec r01 = __soa_load(src->data[3] + i, k, tail);
+    __soa_vec r11 = __soa_load(src->data[4] + i, k, tail);
+    __soa_vec tx = __soa_load(src->data[6] + i, k, tail);
+    __soa_vec ty = __soa_load(src->data[7] + i, k, tail);
+    __soa_vec zero = __soa_set1(0.0f);
+    __soa_store(dst->data[0] + i, r00, k, tail);
+    __soa_store(dst->data[1] + i, r01, k, tail);
+    __soa_store(dst->data[2] + i, zero, k, tail);
+    __soa_store(dst->data[3] + i, r10, k, tail);
+    __soa_store(dst->data[4] + i, r11, k, tail);
+    __soa_store(dst->data[5] + i, zero, k, tail);
+    __soa_store(dst->data[6] + i, __soa_sub(zero, __soa_add(__soa_mul(r00, tx), __soa_mul(r10, ty))), k, tail);
+    __soa_store(dst->data[7] + i, __soa_sub(zero, __soa_add(__soa_mul(r01, tx), __soa_mul(r11, ty))), k, tail);
+    __soa_store(dst->data[8] + i, __soa_set1(1.0f), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat3x3 t = mat3x3_inverse_rigidv(mat3x3_soa_get(src, i));
+    mat3x3_soa_set(dst, i, &t);
+  }
+#endif
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * mat4x4.h
+ * Declaration for 4x4 matrix of floats in column-major order.
+ */
+
+#ifndef CAM_LINEAR_MAT4X4_H
+#define CAM_LINEAR_MAT4X4_H
+
+#include "cam/linear/linear_common.h"
+#include "cam/linear/vec4.h"
+
+ /* Define mat4x4 struct */
+typedef struct {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 data[4];
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics, columns padded like the SIMD layout
+  float data[4][4];
+#endif
+} mat4x4;
+
+
+/* mat4x4 functions */
+CAM_LINEAR_API mat4x4 mat4x4_make(float x1, float y1, float z1, float w1,
+                           float x2, float y2, float z2, float w2,
+                           float x3, float y3, float z3, float w3,
+                           float x4, float y4, float z4, float w4);
+
+CAM_LINEAR_API mat4x4 mat4x4_makeid();
+
+CAM_LINEAR_API bool mat4x4_equal(mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API bool mat4x4_equalid(mat4x4* m);
+
+CAM_LINEAR_API float mat4x4_get(unsigned int col, unsigned int row, mat4x4* m);
+
+CAM_LINEAR_API mat4x4 mat4x4_add(mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API mat4x4 mat4x4_sub(mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API mat4x4 mat4x4_scale(mat4x4* m, float s);
+
+CAM_LINEAR_API mat4x4 mat4x4_mul(mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API vec4 mat4x4_vec4_mul(mat4x4* m, vec4* v);
+
+// Computes dst[i] = m * src[i] for count vectors. dst may alias src.
+CAM_LINEAR_API void mat4x4_transform_vec4_array(vec4* dst, mat4x4* m, vec4* src, size_t count);
+
+CAM_LINEAR_API mat4x4 mat4x4_transpose(mat4x4* m);
+
+CAM_LINEAR_API float mat4x4_det(mat4x4* m);
+
+// Result is undefined (non-finite) when the matrix is singular.
+CAM_LINEAR_API mat4x4 mat4x4_inverse(mat4x4* m);
+
+// Inverse of a rigid transform (rotation in the upper 3x3 block, translation in the
+// fourth column, bottom row (0, 0, 0, 1)): transposes the rotation and negates the
+// rotated translation. Other matrices give a meaningless result; use mat4x4_inverse for them.
+CAM_LINEAR_API mat4x4 mat4x4_inverse_rigid(mat4x4* m);
+
+
+/* mat4x4 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_addv(mat4x4 a, mat4x4 b);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_subv(mat4x4 a, mat4x4 b);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_scalev(mat4x4 m, float s);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_mulv(mat4x4 a, mat4x4 b);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL mat4x4_vec4_mulv(mat4x4 m, vec4 v);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_transposev(mat4x4 m);
+
+CAM_LINEAR_API float CAM_VECTORCALL mat4x4_detv(mat4x4 m);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_inversev(mat4x4 m);
+
+CAM_LINEAR_API mat4x4 CAM_VECTORCALL mat4x4_inverse_rigidv(mat4x4 m);
+
+
+/* mat4x4 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void mat4x4_add_to(mat4x4* dst, mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API void mat4x4_sub_to(mat4x4* dst, mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API void mat4x4_scale_to(mat4x4* dst, mat4x4* m, float s);
+
+CAM_LINEAR_API void mat4x4_mul_to(mat4x4* dst, mat4x4* a, mat4x4* b);
+
+CAM_LINEAR_API void mat4x4_vec4_mul_to(vec4* dst, mat4x4* m, vec4* v);
+
+CAM_LINEAR_API void mat4x4_transpose_to(mat4x4* dst, mat4x4* m);
+
+CAM_LINEAR_API void mat4x4_inverse_to(mat4x4* dst, mat4x4* m);
+
+CAM_LINEAR_API void mat4x4_inverse_rigid_to(mat4x4* dst, mat4x4* m);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/mat4x4.inl"
+#endif
+
+#endif
@@ -0,0 +1,580 @@
+/*
+ * mat4x4.inl
+ * Definitions for 4x4 matrix of floats in column-major order.
+ * Compiled by src/linear/mat4x4.c, or included by mat4x4.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_MAT4X4_INL
+#define CAM_LINEAR_MAT4X4_INL
+
+#include "cam/linear/mat4x4.h"
+
+/* mat4x4 helpers */
+#if defined(CAM_SIMD_AVX)
+// Lane selection in natural (x, y, z, w) order
+#define __mat4x4_shuffle(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define __mat4x4_swizzle(v, x, y, z, w) __mat4x4_shuffle(v, v, x, y, z, w)
+
+// m * v as a linear combination of the columns of m, weighted by the broadcast lanes of v
+static inline __m128 __mat4x4_combine(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v) {
+  __m128 r0 = _mm_mul_ps(c0, __mat4x4_swizzle(v, 0, 0, 0, 0));
+  __m128 r1 = _mm_mul_ps(c2, __mat4x4_swizzle(v, 2, 2, 2, 2));
+  r0 = __linear_fmadd(c1, __mat4x4_swizzle(v, 1, 1, 1, 1), r0);
+  r1 = __linear_fmadd(c3, __mat4x4_swizzle(v, 3, 3, 3, 3), r1);
+  return _mm_add_ps(r0, r1);
+}
+
+// The inverse and determinant below treat the matrix as four 2x2 blocks, each held in one
+// register in row-major order. Inverting the transpose gives the transposed inverse, so
+// columns can be used as rows without shuffling the input first.
+
+// 2x2 a * b
+static inline __m128 __mat4x4_mat2_mul(__m128 a, __m128 b) {
+  return _mm_add_ps(_mm_mul_ps(a, __mat4x4_swizzle(b, 0, 3, 0, 3)),
+                    _mm_mul_ps(__mat4x4_swizzle(a, 1, 0, 3, 2), __mat4x4_swizzle(b, 2, 1, 2, 1)));
+}
+
+// 2x2 adj(a) * b
+static inline __m128 __mat4x4_mat2_adjmul(__m128 a, __m128 b) {
+  return _mm_sub_ps(_mm_mul_ps(__mat4x4_swizzle(a, 3, 3, 0, 0), b),
+                    _mm_mul_ps(__mat4x4_swizzle(a, 1, 1, 2, 2), __mat4x4_swizzle(b, 2, 3, 0, 1)));
+}
+
+// 2x2 a * adj(b)
+static inline __m128 __mat4x4_mat2_muladj(__m128 a, __m128 b) {
+  return _mm_sub_ps(_mm_mul_ps(a, __mat4x4_swizzle(b, 3, 0, 3, 0)),
+                    _mm_mul_ps(__mat4x4_swizzle(a, 1, 0, 3, 2), __mat4x4_swizzle(b, 2, 1, 2, 1)));
+}
+
+// Determinants of the four 2x2 blocks (A, B, C, D) in one register
+static inline __m128 __mat4x4_block_dets(mat4x4* m) {
+  return _mm_sub_ps(
+    _mm_mul_ps(__mat4x4_shuffle(m->data[0], m->data[2], 0, 2, 0, 2), __mat4x4_shuffle(m->data[1], m->data[3], 1, 3, 1, 3)),
+    _mm_mul_ps(__mat4x4_shuffle(m->data[0], m->data[2], 1, 3, 1, 3), __mat4x4_shuffle(m->data[1], m->data[3], 0, 2, 0, 2)));
+}
+
+// det(M) = det(A)det(D) + det(B)det(C) - tr(adj(A)B adj(D)C), broadcast to every lane
+static inline __m128 __mat4x4_det_from_blocks(__m128 dets, __m128 ab, __m128 dc) {
+  __m128 det = _mm_mul_ps(dets, __mat4x4_swizzle(dets, 3, 2, 1, 0));
+  det = _mm_add_ps(__mat4x4_swizzle(det, 0, 0, 0, 0), __mat4x4_swizzle(det, 1, 1, 1, 1));
+  __m128 tr = _mm_mul_ps(ab, __mat4x4_swizzle(dc, 0, 2, 1, 3));
+  tr = _mm_hadd_ps(tr, tr);
+  tr = _mm_hadd_ps(tr, tr);
+  return _mm_sub_ps(det, tr);
+}
+
+#elif !defined(CAM_SIMD_NEON)
+// Adjugate by cofactor expansion. Works in either storage order since adj(M^T) = adj(M)^T.
+static void __mat4x4_adjugate(const float* m, float* inv) {
+  inv[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inv[8]  =  m[4] * m[9]  * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inv[12] = -m[4] * m[9]  * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inv[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inv[9]  = -m[0] * m[9]  * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inv[13] =  m[0] * m[9]  * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inv[2]  =  m[1] * m[6]  * m[15] - m[1] * m[7]  * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7]  - m[13] * m[3] * m[6];
+  inv[6]  = -m[0] * m[6]  * m[15] + m[0] * m[7]  * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7]  + m[12] * m[3] * m[6];
+  inv[10] =  m[0] * m[5]  * m[15] - m[0] * m[7]  * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7]  - m[12] * m[3] * m[5];
+  inv[14] = -m[0] * m[5]  * m[14] + m[0] * m[6]  * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6]  + m[12] * m[2] * m[5];
+  inv[3]  = -m[1] * m[6]  * m[11] + m[1] * m[7]  * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9]  * m[2] * m[7]  + m[9]  * m[3] * m[6];
+  inv[7]  =  m[0] * m[6]  * m[11] - m[0] * m[7]  * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8]  * m[2] * m[7]  - m[8]  * m[3] * m[6];
+  inv[11] = -m[0] * m[5]  * m[11] + m[0] * m[7]  * m[9]  + m[4] * m[1] * m[11] - m[4] * m[3] * m[9]  - m[8]  * m[1] * m[7]  + m[8]  * m[3] * m[5];
+  inv[15] =  m[0] * m[5]  * m[10] - m[0] * m[6]  * m[9]  - m[4] * m[1] * m[10] + m[4] * m[2] * m[9]  + m[8]  * m[1] * m[6]  - m[8]  * m[2] * m[5];
+}
+#endif
+
+
+/* mat4x4 functions */
+mat4x4 mat4x4_make(float x1, float y1, float z1, float w1,
+                   float x2, float y2, float z2, float w2,
+                   float x3, float y3, float z3, float w3,
+                   float x4, float y4, float z4, float w4) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(w1, z1, y1, x1);
+  n.data[1] = _mm_set_ps(w2, z2, y2, x2);
+  n.data[2] = _mm_set_ps(w3, z3, y3, x3);
+  n.data[3] = _mm_set_ps(w4, z4, y4, x4);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  n.data[0][0] = x1;
+  n.data[0][1] = y1;
+  n.data[0][2] = z1;
+  n.data[0][3] = w1;
+  n.data[1][0] = x2;
+  n.data[1][1] = y2;
+  n.data[1][2] = z2;
+  n.data[1][3] = w2;
+  n.data[2][0] = x3;
+  n.data[2][1] = y3;
+  n.data[2][2] = z3;
+  n.data[2][3] = w3;
+  n.data[3][0] = x4;
+  n.data[3][1] = y4;
+  n.data[3][2] = z4;
+  n.data[3][3] = w4;
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_makeid() {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f);
+  n.data[1] = _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f);
+  n.data[2] = _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f);
+  n.data[3] = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (col == row) ? 1.0f : 0.0f;
+    }
+  }
+#endif
+  return n;
+}
+
+bool mat4x4_equal(mat4x4* a, mat4x4* b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(a->data[0], b->data[0]);
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[1], b->data[1]);
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[2], b->data[2]);
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(a->data[3], b->data[3]);
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      if (a->data[col][row] != b->data[col][row]) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+bool mat4x4_equalid(mat4x4* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(m->data[0], _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  int mask = _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[1], _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[2], _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  vcmp = _mm_cmpeq_ps(m->data[3], _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+  mask &= _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      if (m->data[col][row] != ((col == row) ? 1.0f : 0.0f)) { return false; }
+    }
+  }
+  return true;
+#endif
+}
+
+float mat4x4_get(unsigned int col, unsigned int row, mat4x4* m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 n = m->data[col];
+  __m128 tmp;
+       if (row == 0) { tmp = n; }
+  else if (row == 1) { tmp = _mm_shuffle_ps(n, n, 1); }
+  else if (row == 2) { tmp = _mm_shuffle_ps(n, n, 2); }
+  else               { tmp = _mm_shuffle_ps(n, n, 3); }
+  return _mm_cvtss_f32(tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  return m->data[col][row];
+#endif
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_addv(mat4x4 a, mat4x4 b) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_add_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_add_ps(a.data[1], b.data[1]);
+  n.data[2] = _mm_add_ps(a.data[2], b.data[2]);
+  n.data[3] = _mm_add_ps(a.data[3], b.data[3]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] + b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_add(mat4x4* a, mat4x4* b) {
+  return mat4x4_addv(*a, *b);
+}
+
+void mat4x4_add_to(mat4x4* dst, mat4x4* a, mat4x4* b) {
+  *dst = mat4x4_addv(*a, *b);
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_subv(mat4x4 a, mat4x4 b) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  n.data[0] = _mm_sub_ps(a.data[0], b.data[0]);
+  n.data[1] = _mm_sub_ps(a.data[1], b.data[1]);
+  n.data[2] = _mm_sub_ps(a.data[2], b.data[2]);
+  n.data[3] = _mm_sub_ps(a.data[3], b.data[3]);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = a.data[col][row] - b.data[col][row];
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_sub(mat4x4* a, mat4x4* b) {
+  return mat4x4_subv(*a, *b);
+}
+
+void mat4x4_sub_to(mat4x4* dst, mat4x4* a, mat4x4* b) {
+  *dst = mat4x4_subv(*a, *b);
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_scalev(mat4x4 m, float s) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps1(s);
+  n.data[0] = _mm_mul_ps(m.data[0], tmp);
+  n.data[1] = _mm_mul_ps(m.data[1], tmp);
+  n.data[2] = _mm_mul_ps(m.data[2], tmp);
+  n.data[3] = _mm_mul_ps(m.data[3], tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = m.data[col][row] * s;
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_scale(mat4x4* m, float s) {
+  return mat4x4_scalev(*m, s);
+}
+
+void mat4x4_scale_to(mat4x4* dst, mat4x4* m, float s) {
+  *dst = mat4x4_scalev(*m, s);
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_mulv(mat4x4 a, mat4x4 b) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Each column of the product is a combination of the columns of a
+  __m128 c0 = a.data[0];
+  __m128 c1 = a.data[1];
+  __m128 c2 = a.data[2];
+  __m128 c3 = a.data[3];
+  n.data[0] = __mat4x4_combine(c0, c1, c2, c3, b.data[0]);
+  n.data[1] = __mat4x4_combine(c0, c1, c2, c3, b.data[1]);
+  n.data[2] = __mat4x4_combine(c0, c1, c2, c3, b.data[2]);
+  n.data[3] = __mat4x4_combine(c0, c1, c2, c3, b.data[3]);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = (a.data[0][row] * b.data[col][0]) +
+                         (a.data[1][row] * b.data[col][1]) +
+                         (a.data[2][row] * b.data[col][2]) +
+                         (a.data[3][row] * b.data[col][3]);
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_mul(mat4x4* a, mat4x4* b) {
+  return mat4x4_mulv(*a, *b);
+}
+
+void mat4x4_mul_to(mat4x4* dst, mat4x4* a, mat4x4* b) {
+  *dst = mat4x4_mulv(*a, *b);
+}
+
+vec4 CAM_VECTORCALL mat4x4_vec4_mulv(mat4x4 m, vec4 v) {
+  vec4 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = __mat4x4_combine(m.data[0], m.data[1], m.data[2], m.data[3], v.data);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int row = 0; row < 4; ++row) {
+    r.data[row] = (m.data[0][row] * v.data[0]) +
+                  (m.data[1][row] * v.data[1]) +
+                  (m.data[2][row] * v.data[2]) +
+                  (m.data[3][row] * v.data[3]);
+  }
+#endif
+  return r;
+}
+
+vec4 mat4x4_vec4_mul(mat4x4* m, vec4* v) {
+  return mat4x4_vec4_mulv(*m, *v);
+}
+
+void mat4x4_vec4_mul_to(vec4* dst, mat4x4* m, vec4* v) {
+  *dst = mat4x4_vec4_mulv(*m, *v);
+}
+
+void mat4x4_transform_vec4_array(vec4* dst, mat4x4* m, vec4* src, size_t count) {
+  size_t i = 0;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+#if defined(CAM_SIMD_AVX2)
+  // Two vertices per iteration, the columns duplicated into both 128-bit lanes
+  __m256 c0 = _mm256_broadcast_ps(&m->data[0]);
+  __m256 c1 = _mm256_broadcast_ps(&m->data[1]);
+  __m256 c2 = _mm256_broadcast_ps(&m->data[2]);
+  __m256 c3 = _mm256_broadcast_ps(&m->data[3]);
+  for (; i + 2 <= count; i += 2) {
+    __m256 v = _mm256_loadu_ps((float*)&src[i]);
+    __m256 r0 = _mm256_mul_ps(c0, _mm256_permute_ps(v, 0x00));
+    __m256 r1 = _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xAA));
+    r0 = __linear_fmadd256(c1, _mm256_permute_ps(v, 0x55), r0);
+    r1 = __linear_fmadd256(c3, _mm256_permute_ps(v, 0xFF), r1);
+    _mm256_storeu_ps((float*)&dst[i], _mm256_add_ps(r0, r1));
+  }
+#endif
+  __m128 d0 = m->data[0];
+  __m128 d1 = m->data[1];
+  __m128 d2 = m->data[2];
+  __m128 d3 = m->data[3];
+  for (; i < count; ++i) {
+    dst[i].data = __mat4x4_combine(d0, d1, d2, d3, src[i].data);
+  }
+
+#else
+  // No SIMD intrinsics
+  for (; i < count; ++i) {
+    dst[i] = mat4x4_vec4_mul(m, &src[i]);
+  }
+#endif
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_transposev(mat4x4 m) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 t0 = _mm_unpacklo_ps(m.data[0], m.data[1]);
+  __m128 t1 = _mm_unpacklo_ps(m.data[2], m.data[3]);
+  __m128 t2 = _mm_unpackhi_ps(m.data[0], m.data[1]);
+  __m128 t3 = _mm_unpackhi_ps(m.data[2], m.data[3]);
+  n.data[0] = _mm_movelh_ps(t0, t1);
+  n.data[1] = _mm_movehl_ps(t1, t0);
+  n.data[2] = _mm_movelh_ps(t2, t3);
+  n.data[3] = _mm_movehl_ps(t3, t2);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = m.data[row][col];
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_transpose(mat4x4* m) {
+  return mat4x4_transposev(*m);
+}
+
+void mat4x4_transpose_to(mat4x4* dst, mat4x4* m) {
+  *dst = mat4x4_transposev(*m);
+}
+
+float CAM_VECTORCALL mat4x4_detv(mat4x4 m) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 a = _mm_movelh_ps(m.data[0], m.data[1]);
+  __m128 b = _mm_movehl_ps(m.data[1], m.data[0]);
+  __m128 c = _mm_movelh_ps(m.data[2], m.data[3]);
+  __m128 d = _mm_movehl_ps(m.data[3], m.data[2]);
+  __m128 ab = __mat4x4_mat2_adjmul(a, b);
+  __m128 dc = __mat4x4_mat2_adjmul(d, c);
+  return _mm_cvtss_f32(__mat4x4_det_from_blocks(__mat4x4_block_dets(&m), ab, dc));
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  const float* f = (const float*)m.data;
+  float inv[16];
+  __mat4x4_adjugate(f, inv);
+  return (f[0] * inv[0]) + (f[1] * inv[4]) + (f[2] * inv[8]) + (f[3] * inv[12]);
+
+#endif
+}
+
+float mat4x4_det(mat4x4* m) {
+  return mat4x4_detv(*m);
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_inversev(mat4x4 m) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 a = _mm_movelh_ps(m.data[0], m.data[1]);
+  __m128 b = _mm_movehl_ps(m.data[1], m.data[0]);
+  __m128 c = _mm_movelh_ps(m.data[2], m.data[3]);
+  __m128 d = _mm_movehl_ps(m.data[3], m.data[2]);
+  __m128 dets = __mat4x4_block_dets(&m);
+  __m128 det_a = __mat4x4_swizzle(dets, 0, 0, 0, 0);
+  __m128 det_b = __mat4x4_swizzle(dets, 1, 1, 1, 1);
+  __m128 det_c = __mat4x4_swizzle(dets, 2, 2, 2, 2);
+  __m128 det_d = __mat4x4_swizzle(dets, 3, 3, 3, 3);
+  __m128 ab = __mat4x4_mat2_adjmul(a, b);
+  __m128 dc = __mat4x4_mat2_adjmul(d, c);
+
+  // Blocks of the adjugate, before sign correction
+  __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), __mat4x4_mat2_mul(b, dc));
+  __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), __mat4x4_mat2_mul(c, ab));
+  __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), __mat4x4_mat2_muladj(d, ab));
+  __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), __mat4x4_mat2_muladj(a, dc));
+
+  // One division for the whole matrix
+  __m128 rdet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), __mat4x4_det_from_blocks(dets, ab, dc));
+  x = _mm_mul_ps(x, rdet);
+  y = _mm_mul_ps(y, rdet);
+  z = _mm_mul_ps(z, rdet);
+  w = _mm_mul_ps(w, rdet);
+
+  n.data[0] = __mat4x4_shuffle(x, y, 3, 1, 3, 1);
+  n.data[1] = __mat4x4_shuffle(x, y, 2, 0, 2, 0);
+  n.data[2] = __mat4x4_shuffle(z, w, 3, 1, 3, 1);
+  n.data[3] = __mat4x4_shuffle(z, w, 2, 0, 2, 0);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  const float* f = (const float*)m.data;
+  float inv[16];
+  __mat4x4_adjugate(f, inv);
+  float det = (f[0] * inv[0]) + (f[1] * inv[4]) + (f[2] * inv[8]) + (f[3] * inv[12]);
+  float rdet = 1.0f / det;
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      n.data[col][row] = inv[(col * 4) + row] * rdet;
+    }
+  }
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_inverse(mat4x4* m) {
+  return mat4x4_inversev(*m);
+}
+
+void mat4x4_inverse_to(mat4x4* dst, mat4x4* m) {
+  *dst = mat4x4_inversev(*m);
+}
+
+mat4x4 CAM_VECTORCALL mat4x4_inverse_rigidv(mat4x4 m) {
+  mat4x4 n;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  // Transposed rotation block, then -(R^T * t) with 1 in the homogeneous row
+  __m128 c0 = m.data[0], c1 = m.data[1], c2 = m.data[2], c3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  __m128 t = m.data[3];
+  __m128 tr = _mm_mul_ps(c0, __mat4x4_swizzle(t, 0, 0, 0, 0));
+  tr = __linear_fmadd(c1, __mat4x4_swizzle(t, 1, 1, 1, 1), tr);
+  tr = __linear_fmadd(c2, __mat4x4_swizzle(t, 2, 2, 2, 2), tr);
+  n.data[0] = c0;
+  n.data[1] = c1;
+  n.data[2] = c2;
+  n.data[3] = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), tr);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+
+#else
+  // No SIMD intrinsics
+  for (int col = 0; col < 3; ++col) {
+    for (int row = 0; row < 3; ++row) {
+      n.data[col][row] = m.data[row][col];
+    }
+    n.data[col][3] = 0.0f;
+  }
+  for (int row = 0; row < 3; ++row) {
+    n.data[3][row] = -((m.data[row][0] * m.data[3][0]) + (m.data[row][1] * m.data[3][1]) + (m.data[row][2] * m.data[3][2]));
+  }
+  n.data[3][3] = 1.0f;
+#endif
+  return n;
+}
+
+mat4x4 mat4x4_inverse_rigid(mat4x4* m) {
+  return mat4x4_inverse_rigidv(*m);
+}
+
+void mat4x4_inverse_rigid_to(mat4x4* dst, mat4x4* m) {
+  *dst = mat4x4_inverse_rigidv(*m);
+}
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * mat4x4_soa.h
+ * Declaration for batches of 4x4 float matrices in structure-of-arrays order.
+ */
+
+#ifndef CAM_LINEAR_MAT4X4_SOA_H
+#define CAM_LINEAR_MAT4X4_SOA_H
+
+#include "cam/linear/linear_common.h"
+#include "cam/linear/mat4x4.h"
+
+/* Define mat4x4_soa struct */
+typedef struct {
+  float* data[16]; // Element arrays in column-major order (data[col * 4 + row]), each aligned to CAM_SIMD_ALIGN bytes
+  size_t count;    // Number of matrices in the batch
+} mat4x4_soa;
+
+
+/* mat4x4_soa functions */
+// Batch operations process m->count (or src->count) matrices. The destination must hold
+// at least that many and may alias the source. Singular matrices give non-finite results.
+CAM_LINEAR_API mat4x4_soa mat4x4_soa_make(size_t count);
+
+CAM_LINEAR_API void mat4x4_soa_free(mat4x4_soa* s);
+
+CAM_LINEAR_API mat4x4 mat4x4_soa_get(mat4x4_soa* s, size_t i);
+
+CAM_LINEAR_API void mat4x4_soa_set(mat4x4_soa* s, size_t i, mat4x4* m);
+
+CAM_LINEAR_API void mat4x4_soa_det(float* dst, mat4x4_soa* m);
+
+CAM_LINEAR_API void mat4x4_soa_inverse(mat4x4_soa* dst, mat4x4_soa* src);
+
+// Same as mat4x4_inverse_rigid for every matrix in the batch
+CAM_LINEAR_API void mat4x4_soa_inverse_rigid(mat4x4_soa* dst, mat4x4_soa* src);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/mat4x4_soa.inl"
+#endif
+
+#endif
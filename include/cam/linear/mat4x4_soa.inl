@@ -0,0 +1,197 @@
+/*
+ * mat4x4_soa.inl
+ * Definitions for batches of 4x4 float matrices in structure-of-arrays order.
+ * Compiled by src/linear/mat4x4_soa.c, or included by mat4x4_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_MAT4X4_SOA_INL
+#define CAM_LINEAR_MAT4X4_SOA_INL
+
+#include "cam/linear/mat4x4_soa.h"
+#include <string.h>
+
+/* mat4x4_soa helpers */
+#if defined(CAM_SIMD_AVX)
+// Loads the sixteen elements of a lane block; a[r][c] is row r, column c
+static inline void __mat4x4_soa_load(__soa_vec a[4][4], mat4x4_soa* s, size_t i, size_t k, __soa_mask tail) {
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      a[row][col] = __soa_load(s->data[(col * 4) + row] + i, k, tail);
+    }
+  }
+}
+
+// 2x2 minors of the top two rows (s) and bottom two rows (c), shared by det and inverse
+static inline void __mat4x4_soa_minors(__soa_vec a[4][4], __soa_vec s[6], __soa_vec c[6]) {
+  s[0] = __soa_sub(__soa_mul(a[0][0], a[1][1]), __soa_mul(a[1][0], a[0][1]));
+  s[1] = __soa_sub(__soa_mul(a[0][0], a[1][2]), __soa_mul(a[1][0], a[0][2]));
+  s[2] = __soa_sub(__soa_mul(a[0][0], a[1][3]), __soa_mul(a[1][0], a[0][3]));
+  s[3] = __soa_sub(__soa_mul(a[0][1], a[1][2]), __soa_mul(a[1][1], a[0][2]));
+  s[4] = __soa_sub(__soa_mul(a[0][1], a[1][3]), __soa_mul(a[1][1], a[0][3]));
+  s[5] = __soa_sub(__soa_mul(a[0][2], a[1][3]), __soa_mul(a[1][2], a[0][3]));
+  c[0] = __soa_sub(__soa_mul(a[2][0], a[3][1]), __soa_mul(a[3][0], a[2][1]));
+  c[1] = __soa_sub(__soa_mul(a[2][0], a[3][2]), __soa_mul(a[3][0], a[2][2]));
+  c[2] = __soa_sub(__soa_mul(a[2][0], a[3][3]), __soa_mul(a[3][0], a[2][3]));
+  c[3] = __soa_sub(__soa_mul(a[2][1], a[3][2]), __soa_mul(a[3][1], a[2][2]));
+  c[4] = __soa_sub(__soa_mul(a[2][1], a[3][3]), __soa_mul(a[3][1], a[2][3]));
+  c[5] = __soa_sub(__soa_mul(a[2][2], a[3][3]), __soa_mul(a[3][2], a[2][3]));
+}
+
+// det = s0 c5 - s1 c4 + s2 c3 + s3 c2 - s4 c1 + s5 c0
+static inline __soa_vec __mat4x4_soa_det(__soa_vec s[6], __soa_vec c[6]) {
+  __soa_vec det = __soa_sub(__soa_mul(s[0], c[5]), __soa_mul(s[1], c[4]));
+  det = __soa_add(det, __soa_add(__soa_mul(s[2], c[3]), __soa_mul(s[3], c[2])));
+  return __soa_add(det, __soa_sub(__soa_mul(s[5], c[0]), __soa_mul(s[4], c[1])));
+}
+
+// x * p - y * q + z * r
+static inline __soa_vec __mat4x4_soa_cof(__soa_vec x, __soa_vec p, __soa_vec y, __soa_vec q, __soa_vec z, __soa_vec r) {
+  return __soa_add(__soa_sub(__soa_mul(x, p), __soa_mul(y, q)), __soa_mul(z, r));
+}
+#endif
+
+/* mat4x4_soa functions */
+mat4x4_soa mat4x4_soa_make(size_t count) {
+  mat4x4_soa s;
+  memset(&s, 0, sizeof(s));
+  if (count == 0) { return s; }
+
+  // One block for all sixteen arrays, each rounded up to a whole register
+  size_t stride = (count + 7) & ~(size_t)7;
+
+  // Stagger the arrays by a cache line when the stride is a multiple of 4 KiB, otherwise every
+  // element of a lane block maps to the same cache set and the loads alias each other
+  if ((stride % 1024) == 0) { stride += 16; }
+  float* block = (float*)cam_aligned_alloc(16 * stride * sizeof(float), CAM_SIMD_ALIGN);
+  if (!block) { return s; }
+  memset(block, 0, 16 * stride * sizeof(float));
+  for (int j = 0; j < 16; ++j) {
+    s.data[j] = block + (j * stride);
+  }
+  s.count = count;
+  return s;
+}
+
+void mat4x4_soa_free(mat4x4_soa* s) {
+  cam_aligned_free(s->data[0]);
+  memset(s, 0, sizeof(*s));
+}
+
+mat4x4 mat4x4_soa_get(mat4x4_soa* s, size_t i) {
+  return mat4x4_make(s->data[0][i],  s->data[1][i],  s->data[2][i],  s->data[3][i],
+                     s->data[4][i],  s->data[5][i],  s->data[6][i],  s->data[7][i],
+                     s->data[8][i],  s->data[9][i],  s->data[10][i], s->data[11][i],
+                     s->data[12][i], s->data[13][i], s->data[14][i], s->data[15][i]);
+}
+
+void mat4x4_soa_set(mat4x4_soa* s, size_t i, mat4x4* m) {
+  for (unsigned int col = 0; col < 4; ++col) {
+    for (unsigned int row = 0; row < 4; ++row) {
+      s->data[(col * 4) + row][i] = mat4x4_get(col, row, m);
+    }
+  }
+}
+
+void mat4x4_soa_det(float* dst, mat4x4_soa* m) {
+  size_t n = m->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec a[4][4], s[6], c[6];
+    __mat4x4_soa_load(a, m, i, k, tail);
+    __mat4x4_soa_minors(a, s, c);
+    __soa_store(dst + i, __mat4x4_soa_det(s, c), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat4x4 t = mat4x4_soa_get(m, i);
+    dst[i] = mat4x4_detv(t);
+  }
+#endif
+}
+
+void mat4x4_soa_inverse(mat4x4_soa* dst, mat4x4_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec a[4][4], s[6], c[6], b[4][4];
+    __mat4x4_soa_load(a, src, i, k, tail);
+    __mat4x4_soa_minors(a, s, c);
+
+    // Cofactor magnitudes from the shared minors; b[r][c] is row r, column c of the adjugate
+    // before the checkerboard sign, which is folded into the reciprocal below
+    b[0][0] = __mat4x4_soa_cof(a[1][1], c[5], a[1][2], c[4], a[1][3], c[3]);
+    b[0][1] = __mat4x4_soa_cof(a[0][1], c[5], a[0][2], c[4], a[0][3], c[3]);
+    b[0][2] = __mat4x4_soa_cof(a[3][1], s[5], a[3][2], s[4], a[3][3], s[3]);
+    b[0][3] = __mat4x4_soa_cof(a[2][1], s[5], a[2][2], s[4], a[2][3], s[3]);
+    b[1][0] = __mat4x4_soa_cof(a[1][0], c[5], a[1][2], c[2], a[1][3], c[1]);
+    b[1][1] = __mat4x4_soa_cof(a[0][0], c[5], a[0][2], c[2], a[0][3], c[1]);
+    b[1][2] = __mat4x4_soa_cof(a[3][0], s[5], a[3][2], s[2], a[3][3], s[1]);
+    b[1][3] = __mat4x4_soa_cof(a[2][0], s[5], a[2][2], s[2], a[2][3], s[1]);
+    b[2][0] = __mat4x4_soa_cof(a[1][0], c[4], a[1][1], c[2], a[1][3], c[0]);
+    b[2][1] = __mat4x4_soa_cof(a[0][0], c[4], a[0][1], c[2], a[0][3], c[0]);
+    b[2][2] = __mat4x4_soa_cof(a[3][0], s[4], a[3][1], s[2], a[3][3], s[0]);
+    b[2][3] = __mat4x4_soa_cof(a[2][0], s[4], a[2][1], s[2], a[2][3], s[0]);
+    b[3][0] = __mat4x4_soa_cof(a[1][0], c[3], a[1][1], c[1], a[1][2], c[0]);
+    b[3][1] = __mat4x4_soa_cof(a[0][0], c[3], a[0][1], c[1], a[0][2], c[0]);
+    b[3][2] = __mat4x4_soa_cof(a[3][0], s[3], a[3][1], s[1], a[3][2], s[0]);
+    b[3][3] = __mat4x4_soa_cof(a[2][0], s[3], a[2][1], s[1], a[2][2], s[0]);
+
+    // One division per lane block
+    __soa_vec rdet[2];
+    rdet[0] = __soa_div(__soa_set1(1.0f), __mat4x4_soa_det(s, c));
+    rdet[1] = __soa_sub(__soa_set1(0.0f), rdet[0]);
+    for (int col = 0; col < 4; ++col) {
+      for (int row = 0; row < 4; ++row) {
+        __soa_store(dst->data[(col * 4) + row] + i, __soa_mul(b[row][col], rdet[(row + col) & 1]), k, tail);
+      }
+    }
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat4x4 t = mat4x4_inversev(mat4x4_soa_get(src, i));
+    mat4x4_soa_set(dst, i, &t);
+  }
+#endif
+}
+
+void mat4x4_soa_inverse_rigid(mat4x4_soa* dst, mat4x4_soa* src) {
+  size_t n = src->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec a[4][4];
+    __mat4x4_soa_load(a, src, i, k, tail);
+    __soa_vec zero = __soa_set1(0.0f);
+    for (int col = 0; col < 3; ++col) {
+      // Row col of the inverse is column col of the rotation
+      __soa_vec t = __soa_mul(a[0][col], a[0][3]);
+      t = __soa_add(t, __soa_mul(a[1][col], a[1][3]));
+      t = __soa_add(t, __soa_mul(a[2][col], a[2][3]));
+      __soa_store(dst->data[(col * 4) + 0] + i, a[col][0], k, tail);
+      __soa_store(dst->data[(col * 4) + 1] + i, a[col][1], k, tail);
+      __soa_store(dst->data[(col * 4) + 2] + i, a[col][2], k, tail);
+      __soa_store(dst->data[(col * 4) + 3] + i, zero, k, tail);
+      __soa_store(dst->data[12 + col] + i, __soa_sub(zero, t), k, tail);
+    }
+    __soa_store(dst->data[15] + i, __soa_set1(1.0f), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    mat4x4 t = mat4x4_inverse_rigidv(mat4x4_soa_get(src, i));
+    mat4x4_soa_set(dst, i, &t);
+  }
+#endif
+}
+
+#endif
@@ -24,36 +24,96 @@ typedef struct {
 
 
 /* vec2 functions */
-CAM_API vec2 vec2_make(float x, float y);
+CAM_LINEAR_API vec2 vec2_make(float x, float y);
 
-CAM_API vec2 vec2_makez();
+CAM_LINEAR_API vec2 vec2_makez();
 
-CAM_API float vec2_getx(vec2* v);
+CAM_LINEAR_API float vec2_getx(vec2* v);
 
-CAM_API float vec2_gety(vec2* v);
+CAM_LINEAR_API float vec2_gety(vec2* v);
 
-CAM_API void vec2_setx(vec2* v, float x);
+CAM_LINEAR_API void vec2_setx(vec2* v, float x);
 
-CAM_API void vec2_sety(vec2* v, float y);
+CAM_LINEAR_API void vec2_sety(vec2* v, float y);
 
-CAM_API bool vec2_equal(vec2* a, vec2* b);
+CAM_LINEAR_API bool vec2_equal(vec2* a, vec2* b);
 
-CAM_API bool vec2_equalz(vec2* v);
+CAM_LINEAR_API bool vec2_equalz(vec2* v);
 
-CAM_API vec2 vec2_add(vec2* a, vec2* b);
+CAM_LINEAR_API vec2 vec2_add(vec2* a, vec2* b);
 
-CAM_API vec2 vec2_sub(vec2* a, vec2* b);
+CAM_LINEAR_API vec2 vec2_sub(vec2* a, vec2* b);
 
-CAM_API vec2 vec2_mul(vec2* a, vec2* b);
+CAM_LINEAR_API vec2 vec2_mul(vec2* a, vec2* b);
 
-CAM_API vec2 vec2_div(vec2* a, vec2* b);
+CAM_LINEAR_API vec2 vec2_div(vec2* a, vec2* b);
 
-CAM_API float vec2_mag(vec2* v);
+CAM_LINEAR_API float vec2_mag(vec2* v);
 
-CAM_API vec2 vec2_scale(vec2* a, float s);
+CAM_LINEAR_API vec2 vec2_scale(vec2* a, float s);
 
-CAM_API vec2 vec2_norm(vec2* v);
+CAM_LINEAR_API vec2 vec2_norm(vec2* v);
 
-CAM_API float vec2_dist(vec2* a, vec2* b);
+CAM_LINEAR_API float vec2_dist(vec2* a, vec2* b);
+
+
+/* vec2 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_addv(vec2 a, vec2 b);
+
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_subv(vec2 a, vec2 b);
+
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_mulv(vec2 a, vec2 b);
+
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_divv(vec2 a, vec2 b);
+
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_scalev(vec2 a, float s);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec2_magv(vec2 v);
+
+CAM_LINEAR_API vec2 CAM_VECTORCALL vec2_normv(vec2 v);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec2_distv(vec2 a, vec2 b);
+
+
+/* vec2 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void vec2_add_to(vec2* dst, vec2* a, vec2* b);
+
+CAM_LINEAR_API void vec2_sub_to(vec2* dst, vec2* a, vec2* b);
+
+CAM_LINEAR_API void vec2_mul_to(vec2* dst, vec2* a, vec2* b);
+
+CAM_LINEAR_API void vec2_div_to(vec2* dst, vec2* a, vec2* b);
+
+CAM_LINEAR_API void vec2_scale_to(vec2* dst, vec2* a, float s);
+
+CAM_LINEAR_API void vec2_norm_to(vec2* dst, vec2* v);
+
+
+/* vec2 approximate functions */
+// Built on the hardware reciprocal estimates, see linear_common.h: maximum relative
+// error 3.7e-4, or below 1e-6 with CAM_FAST_NEWTON. Exact without SIMD intrinsics.
+CAM_LINEAR_API float vec2_mag_fast(vec2* v);
+
+// Undefined for the zero vector, like vec2_norm
+CAM_LINEAR_API vec2 vec2_norm_fast(vec2* v);
+
+// Reciprocal of each component (padding lanes stay zero)
+CAM_LINEAR_API vec2 vec2_rcp_fast(vec2* v);
+
+CAM_LINEAR_API void vec2_mag_fast_n(float* dst, vec2* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec2_norm_fast_n(vec2* dst, vec2* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec2_rcp_fast_n(vec2* dst, vec2* src, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/vec2.inl"
+#endif
 
 #endif
@@ -24,40 +24,100 @@ typedef struct {
 
 
 /* vec3 functions */
-CAM_API vec3 vec3_make(float x, float y, float z);
+CAM_LINEAR_API vec3 vec3_make(float x, float y, float z);
 
-CAM_API vec3 vec3_makez();
+CAM_LINEAR_API vec3 vec3_makez();
 
-CAM_API float vec3_getx(vec3* v);
+CAM_LINEAR_API float vec3_getx(vec3* v);
 
-CAM_API float vec3_gety(vec3* v);
+CAM_LINEAR_API float vec3_gety(vec3* v);
 
-CAM_API float vec3_getz(vec3* v);
+CAM_LINEAR_API float vec3_getz(vec3* v);
 
-CAM_API void vec3_setx(vec3* v, float x);
+CAM_LINEAR_API void vec3_setx(vec3* v, float x);
 
-CAM_API void vec3_sety(vec3* v, float y);
+CAM_LINEAR_API void vec3_sety(vec3* v, float y);
 
-CAM_API void vec3_setz(vec3* v, float z);
+CAM_LINEAR_API void vec3_setz(vec3* v, float z);
 
-CAM_API bool vec3_equal(vec3* a, vec3* b);
+CAM_LINEAR_API bool vec3_equal(vec3* a, vec3* b);
 
-CAM_API bool vec3_equalz(vec3* v);
+CAM_LINEAR_API bool vec3_equalz(vec3* v);
 
-CAM_API vec3 vec3_add(vec3* a, vec3* b);
+CAM_LINEAR_API vec3 vec3_add(vec3* a, vec3* b);
 
-CAM_API vec3 vec3_sub(vec3* a, vec3* b);
+CAM_LINEAR_API vec3 vec3_sub(vec3* a, vec3* b);
 
-CAM_API vec3 vec3_mul(vec3* a, vec3* b);
+CAM_LINEAR_API vec3 vec3_mul(vec3* a, vec3* b);
 
-CAM_API vec3 vec3_div(vec3* a, vec3* b);
+CAM_LINEAR_API vec3 vec3_div(vec3* a, vec3* b);
 
-CAM_API float vec3_mag(vec3* v);
+CAM_LINEAR_API float vec3_mag(vec3* v);
 
-CAM_API vec3 vec3_scale(vec3* a, float s);
+CAM_LINEAR_API vec3 vec3_scale(vec3* a, float s);
 
-CAM_API vec3 vec3_norm(vec3* v);
+CAM_LINEAR_API vec3 vec3_norm(vec3* v);
 
-CAM_API float vec3_dist(vec3* a, vec3* b);
+CAM_LINEAR_API float vec3_dist(vec3* a, vec3* b);
+
+
+/* vec3 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_addv(vec3 a, vec3 b);
+
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_subv(vec3 a, vec3 b);
+
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_mulv(vec3 a, vec3 b);
+
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_divv(vec3 a, vec3 b);
+
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_scalev(vec3 a, float s);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec3_magv(vec3 v);
+
+CAM_LINEAR_API vec3 CAM_VECTORCALL vec3_normv(vec3 v);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec3_distv(vec3 a, vec3 b);
+
+
+/* vec3 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void vec3_add_to(vec3* dst, vec3* a, vec3* b);
+
+CAM_LINEAR_API void vec3_sub_to(vec3* dst, vec3* a, vec3* b);
+
+CAM_LINEAR_API void vec3_mul_to(vec3* dst, vec3* a, vec3* b);
+
+CAM_LINEAR_API void vec3_div_to(vec3* dst, vec3* a, vec3* b);
+
+CAM_LINEAR_API void vec3_scale_to(vec3* dst, vec3* a, float s);
+
+CAM_LINEAR_API void vec3_norm_to(vec3* dst, vec3* v);
+
+
+/* vec3 approximate functions */
+// Built on the hardware reciprocal estimates, see linear_common.h: maximum relative
+// error 3.7e-4, or below 1e-6 with CAM_FAST_NEWTON. Exact without SIMD intrinsics.
+CAM_LINEAR_API float vec3_mag_fast(vec3* v);
+
+// Undefined for the zero vector, like vec3_norm
+CAM_LINEAR_API vec3 vec3_norm_fast(vec3* v);
+
+// Reciprocal of each component (padding lanes stay zero)
+CAM_LINEAR_API vec3 vec3_rcp_fast(vec3* v);
+
+CAM_LINEAR_API void vec3_mag_fast_n(float* dst, vec3* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec3_norm_fast_n(vec3* dst, vec3* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec3_rcp_fast_n(vec3* dst, vec3* src, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/vec3.inl"
+#endif
 
 #endif
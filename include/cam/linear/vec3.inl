@@ -0,0 +1,471 @@
+/*
+ * vec3.inl
+ * Definitions for 3D vector of floats.
+ * Compiled by src/linear/vec3.c, or included by vec3.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_VEC3_INL
+#define CAM_LINEAR_VEC3_INL
+
+#include "cam/linear/vec3.h"
+
+vec3 vec3_make(float x, float y, float z) {
+  vec3 v;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  v.data = _mm_set_ps(0.0f, z, y, x);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  float arr[4] = {x, y, z, 0.0f};
+  v.data = vld1q_f32(arr);
+#else
+  // No SIMD intrinsics
+  v.data[0] = x;
+  v.data[1] = y;
+  v.data[2] = z;
+  v.data[3] = 0.0f;
+#endif
+  return v;
+}
+
+vec3 vec3_makez() {
+  vec3 v;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  v.data = _mm_setzero_ps();
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  v.data = vmovq_n_f32(0.0f);
+#else
+  // No SIMD intrinsics
+  v.data[0] = 0.0f;
+  v.data[1] = 0.0f;
+  v.data[2] = 0.0f;
+  v.data[3] = 0.0f;
+#endif
+  return v;
+}
+
+float vec3_getx(vec3* v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(v->data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  return vgetq_lane_f32(v->data, 0);
+#else
+  // No SIMD intrinsics
+  return v->data[0];
+#endif
+}
+
+float vec3_gety(vec3* v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_shuffle_ps(v->data, v->data, 1);
+  return _mm_cvtss_f32(tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  return vgetq_lane_f32(v->data, 1);
+#else
+  // No SIMD intrinsics
+  return v->data[1];
+#endif
+}
+
+float vec3_getz(vec3* v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_shuffle_ps(v->data, v->data, 2);
+  return _mm_cvtss_f32(tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  return vgetq_lane_f32(v->data, 2);
+#else
+  // No SIMD intrinsics
+  return v->data[2];
+#endif
+}
+
+void vec3_setx(vec3* v, float x) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps(0.0f, 0.0f, 0.0f, x);
+  v->data = _mm_blend_ps(v->data, tmp, 0b0001);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  v->data = vsetq_lane_f32(x, v->data, 0);
+#else
+  // No SIMD intrinsics
+  v->data[0] = x;
+#endif
+}
+
+void vec3_sety(vec3* v, float y) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps(0.0f, 0.0f, y, 0.0f);
+  v->data = _mm_blend_ps(v->data, tmp, 0b0010);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  v->data = vsetq_lane_f32(y, v->data, 1);
+#else
+  // No SIMD intrinsics
+  v->data[1] = y;
+#endif
+}
+
+void vec3_setz(vec3* v, float z) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps(0.0f, z, 0.0f, 0.0f);
+  v->data = _mm_blend_ps(v->data, tmp, 0b0100);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  v->data = vsetq_lane_f32(z, v->data, 2);
+#else
+  // No SIMD intrinsics
+  v->data[2] = z;
+#endif
+}
+
+bool vec3_equal(vec3* a, vec3* b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(a->data, b->data);
+  int mask = _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  uint32x4_t result = vceqq_f32(a->data, b->data);
+  return (vminvq_u32(result) != 0);
+#else
+  // No SIMD intrinsics
+  return (a->data[0] == b->data[0] && 
+          a->data[1] == b->data[1] &&
+          a->data[2] == b->data[2]);
+#endif
+}
+
+bool vec3_equalz(vec3* v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 vcmp = _mm_cmpeq_ps(v->data, _mm_setzero_ps());
+  int mask = _mm_movemask_ps(vcmp);
+  return mask == 0xF;
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  uint32x4_t result = vceqzq_f32(v->data);
+  return (vminvq_u32(result) != 0);
+#else
+  // No SIMD intrinsics
+  return (v->data[0] == 0.0f && 
+          v->data[1] == 0.0f &&
+          v->data[2] == 0.0f);
+#endif
+}
+
+vec3 CAM_VECTORCALL vec3_addv(vec3 a, vec3 b) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_add_ps(a.data, b.data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vaddq_f32(a.data, b.data);
+#else
+  // No SIMD intrinsics
+  r.data[0] = a.data[0] + b.data[0];
+  r.data[1] = a.data[1] + b.data[1];
+  r.data[2] = a.data[2] + b.data[2];
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 vec3_add(vec3* a, vec3* b) {
+  return vec3_addv(*a, *b);
+}
+
+void vec3_add_to(vec3* dst, vec3* a, vec3* b) {
+  *dst = vec3_addv(*a, *b);
+}
+
+vec3 CAM_VECTORCALL vec3_subv(vec3 a, vec3 b) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_sub_ps(a.data, b.data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vsubq_f32(a.data, b.data);
+#else
+  // No SIMD intrinsics
+  r.data[0] = a.data[0] - b.data[0];
+  r.data[1] = a.data[1] - b.data[1];
+  r.data[2] = a.data[2] - b.data[2];
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 vec3_sub(vec3* a, vec3* b) {
+  return vec3_subv(*a, *b);
+}
+
+void vec3_sub_to(vec3* dst, vec3* a, vec3* b) {
+  *dst = vec3_subv(*a, *b);
+}
+
+vec3 CAM_VECTORCALL vec3_mulv(vec3 a, vec3 b) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_mul_ps(a.data, b.data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vmulq_f32(a.data, b.data);
+#else
+  // No SIMD intrinsics
+  r.data[0] = a.data[0] * b.data[0];
+  r.data[1] = a.data[1] * b.data[1];
+  r.data[2] = a.data[2] * b.data[2];
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 vec3_mul(vec3* a, vec3* b) {
+  return vec3_mulv(*a, *b);
+}
+
+void vec3_mul_to(vec3* dst, vec3* a, vec3* b) {
+  *dst = vec3_mulv(*a, *b);
+}
+
+vec3 CAM_VECTORCALL vec3_divv(vec3 a, vec3 b) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_div_ps(a.data, b.data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vdivq_f32(a.data, b.data);
+#else
+  // No SIMD intrinsics
+  r.data[0] = a.data[0] / b.data[0];
+  r.data[1] = a.data[1] / b.data[1];
+  r.data[2] = a.data[2] / b.data[2];
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 vec3_div(vec3* a, vec3* b) {
+  return vec3_divv(*a, *b);
+}
+
+void vec3_div_to(vec3* dst, vec3* a, vec3* b) {
+  *dst = vec3_divv(*a, *b);
+}
+
+float CAM_VECTORCALL vec3_magv(vec3 v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_dp_ps(v.data, v.data, 0xFF);
+  return (float)sqrt(_mm_cvtss_f32(tmp));
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  float32x4_t tmp = vmulq_f32(v.data, v.data);
+  tmp = vpaddq_f32(tmp, tmp);
+  return (float)sqrt(vgetq_lane_f32(tmp, 0));
+#else
+  // No SIMD intrinsics
+  float x = v.data[0];
+  float y = v.data[1];
+  float z = v.data[2];
+  return (float)sqrt(x * x + y * y + z * z);
+#endif
+}
+
+float vec3_mag(vec3* v) {
+  return vec3_magv(*v);
+}
+
+vec3 CAM_VECTORCALL vec3_scalev(vec3 a, float s) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_set_ps1(s);
+  r.data = _mm_mul_ps(a.data, tmp);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vmulq_n_f32(a.data, s);
+#else
+  // No SIMD intrinsics
+  r.data[0] = a.data[0] * s;
+  r.data[1] = a.data[1] * s;
+  r.data[2] = a.data[2] * s;
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+vec3 vec3_scale(vec3* a, float s) {
+  return vec3_scalev(*a, s);
+}
+
+void vec3_scale_to(vec3* dst, vec3* a, float s) {
+  *dst = vec3_scalev(*a, s);
+}
+
+vec3 CAM_VECTORCALL vec3_normv(vec3 v) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_dp_ps(v.data, v.data, 0xFF);
+  tmp = _mm_sqrt_ps(tmp);
+  r.data = _mm_div_ps(v.data, tmp);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  float32x4_t tmp = vmulq_f32(v.data, v.data);
+  tmp = vpaddq_f32(tmp, tmp);
+  float s = (float)sqrt(vgetq_lane_f32(tmp, 0));
+  r.data = vmulq_n_f32(v.data, 1.0f/s);
+#else
+  // No SIMD intrinsics
+  float x = v.data[0];
+  float y = v.data[1];
+  float z = v.data[2];
+  float mag = sqrt(x * x + y * y + z * z);
+  r.data[0] = x / mag;
+  r.data[1] = y / mag;
+  r.data[2] = z / mag;
+  r.data[3] = 0.0f;
+  
+#endif
+  return r;
+}
+
+vec3 vec3_norm(vec3* v) {
+  return vec3_normv(*v);
+}
+
+void vec3_norm_to(vec3* dst, vec3* v) {
+  *dst = vec3_normv(*v);
+}
+
+float CAM_VECTORCALL vec3_distv(vec3 a, vec3 b) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __m128 tmp = _mm_sub_ps(a.data, b.data);
+  tmp = _mm_dp_ps(tmp, tmp, 0xFF);
+  double mag = sqrt(_mm_cvtss_f32(tmp));
+  return (float)fabs(mag);
+
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  float32x4_t tmp = vsubq_f32(a.data, b.data);
+  tmp = vmulq_f32(tmp, tmp);
+  tmp = vpaddq_f32(tmp, tmp);
+  double mag = sqrt(vgetq_lane_f32(tmp, 0));
+  return (float)fabs(mag);
+#else
+  // No SIMD intrinsics
+  float x = a.data[0] - b.data[0];
+  float y = a.data[1] - b.data[1];
+  float z = a.data[2] - b.data[2];
+  double mag = sqrt(x * x + y * y + z * z);
+  return (float)fabs(mag);
+#endif
+}
+
+float vec3_dist(vec3* a, vec3* b) {
+  return vec3_distv(*a, *b);
+}
+
+float vec3_mag_fast(vec3* v) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  return _mm_cvtss_f32(__linear_mag_fast(v->data));
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  return vgetq_lane_f32(__linear_mag_fast(v->data), 0);
+#else
+  // No SIMD intrinsics
+  return vec3_mag(v);
+#endif
+}
+
+vec3 vec3_norm_fast(vec3* v) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = __linear_norm_fast(v->data);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = __linear_norm_fast(v->data);
+#else
+  // No SIMD intrinsics
+  r = vec3_norm(v);
+#endif
+  return r;
+}
+
+vec3 vec3_rcp_fast(vec3* v) {
+  vec3 r;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  r.data = _mm_blend_ps(__linear_rcp_fast(v->data), _mm_setzero_ps(), 0b1000);
+#elif defined(CAM_SIMD_NEON)
+  // AMD NEON
+  r.data = vsetq_lane_f32(0.0f, __linear_rcp_fast(v->data), 3);
+#else
+  // No SIMD intrinsics
+  r.data[0] = 1.0f / v->data[0];
+  r.data[1] = 1.0f / v->data[1];
+  r.data[2] = 1.0f / v->data[2];
+  r.data[3] = 0.0f;
+#endif
+  return r;
+}
+
+void vec3_mag_fast_n(float* dst, vec3* src, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __linear_mag_fast_n(dst, &src->data, count);
+#else
+  // AMD NEON, no SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = vec3_mag_fast(&src[i]);
+  }
+#endif
+}
+
+void vec3_norm_fast_n(vec3* dst, vec3* src, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __linear_norm_fast_n(&dst->data, &src->data, count);
+#else
+  // AMD NEON, no SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = vec3_norm_fast(&src[i]);
+  }
+#endif
+}
+
+void vec3_rcp_fast_n(vec3* dst, vec3* src, size_t count) {
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __linear_rcp_fast_n(&dst->data, &src->data, count, _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+#else
+  // AMD NEON, no SIMD intrinsics
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = vec3_rcp_fast(&src[i]);
+  }
+#endif
+}
+
+#endif
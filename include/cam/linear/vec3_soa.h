@@ -0,0 +1,53 @@
+/*
+ * vec3_soa.h
+ * Declaration for batches of 3D float vectors in structure-of-arrays order.
+ */
+
+#ifndef CAM_LINEAR_VEC3_SOA_H
+#define CAM_LINEAR_VEC3_SOA_H
+
+#include "cam/linear/linear_common.h"
+#include "cam/linear/vec3.h"
+
+/* Define vec3_soa struct */
+typedef struct {
+  float* x;       // Component arrays, each aligned to CAM_SIMD_ALIGN bytes
+  float* y;
+  float* z;
+  size_t count;   // Number of vectors in the batch
+} vec3_soa;
+
+
+/* vec3_soa functions */
+// Batch operations process a->count elements. Every other operand (including
+// the destination) must hold at least that many. Destinations may alias sources.
+CAM_LINEAR_API vec3_soa vec3_soa_make(size_t count);
+
+CAM_LINEAR_API void vec3_soa_free(vec3_soa* s);
+
+CAM_LINEAR_API vec3 vec3_soa_get(vec3_soa* s, size_t i);
+
+CAM_LINEAR_API void vec3_soa_set(vec3_soa* s, size_t i, vec3* v);
+
+CAM_LINEAR_API void vec3_soa_add(vec3_soa* dst, vec3_soa* a, vec3_soa* b);
+
+CAM_LINEAR_API void vec3_soa_sub(vec3_soa* dst, vec3_soa* a, vec3_soa* b);
+
+CAM_LINEAR_API void vec3_soa_mul(vec3_soa* dst, vec3_soa* a, vec3_soa* b);
+
+CAM_LINEAR_API void vec3_soa_div(vec3_soa* dst, vec3_soa* a, vec3_soa* b);
+
+CAM_LINEAR_API void vec3_soa_mag(float* dst, vec3_soa* v);
+
+CAM_LINEAR_API void vec3_soa_scale(vec3_soa* dst, vec3_soa* a, float s);
+
+CAM_LINEAR_API void vec3_soa_norm(vec3_soa* dst, vec3_soa* v);
+
+CAM_LINEAR_API void vec3_soa_dist(float* dst, vec3_soa* a, vec3_soa* b);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/vec3_soa.inl"
+#endif
+
+#endif
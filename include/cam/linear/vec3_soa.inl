@@ -0,0 +1,237 @@
+/*
+ * vec3_soa.inl
+ * Definitions for batches of 3D float vectors in structure-of-arrays order.
+ * Compiled by src/linear/vec3_soa.c, or included by vec3_soa.h in CAM_HEADER_ONLY builds.
+ */
+
+#ifndef CAM_LINEAR_VEC3_SOA_INL
+#define CAM_LINEAR_VEC3_SOA_INL
+
+#include "cam/linear/vec3_soa.h"
+#include <string.h>
+
+vec3_soa vec3_soa_make(size_t count) {
+  vec3_soa s = { NULL, NULL, NULL, 0 };
+  if (count == 0) { return s; }
+
+  // Round each array up to a whole register so the padding is always readable
+  size_t bytes = ((count + 7) & ~(size_t)7) * sizeof(float);
+  s.x = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.y = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  s.z = (float*)cam_aligned_alloc(bytes, CAM_SIMD_ALIGN);
+  if (!s.x || !s.y || !s.z) {
+    vec3_soa_free(&s);
+    return s;
+  }
+  memset(s.x, 0, bytes);
+  memset(s.y, 0, bytes);
+  memset(s.z, 0, bytes);
+  s.count = count;
+  return s;
+}
+
+void vec3_soa_free(vec3_soa* s) {
+  cam_aligned_free(s->x);
+  cam_aligned_free(s->y);
+  cam_aligned_free(s->z);
+  s->x = NULL;
+  s->y = NULL;
+  s->z = NULL;
+  s->count = 0;
+}
+
+vec3 vec3_soa_get(vec3_soa* s, size_t i) {
+  return vec3_make(s->x[i], s->y[i], s->z[i]);
+}
+
+void vec3_soa_set(vec3_soa* s, size_t i, vec3* v) {
+  s->x[i] = vec3_getx(v);
+  s->y[i] = vec3_gety(v);
+  s->z[i] = vec3_getz(v);
+}
+
+void vec3_soa_add(vec3_soa* dst, vec3_soa* a, vec3_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->x + i, __soa_add(__soa_load(a->x + i, k, tail), __soa_load(b->x + i, k, tail)), k, tail);
+    __soa_store(dst->y + i, __soa_add(__soa_load(a->y + i, k, tail), __soa_load(b->y + i, k, tail)), k, tail);
+    __soa_store(dst->z + i, __soa_add(__soa_load(a->z + i, k, tail), __soa_load(b->z + i, k, tail)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->x[i] = a->x[i] + b->x[i];
+    dst->y[i] = a->y[i] + b->y[i];
+    dst->z[i] = a->z[i] + b->z[i];
+  }
+#endif
+}
+
+void vec3_soa_sub(vec3_soa* dst, vec3_soa* a, vec3_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->x + i, __soa_sub(__soa_load(a->x + i, k, tail), __soa_load(b->x + i, k, tail)), k, tail);
+    __soa_store(dst->y + i, __soa_sub(__soa_load(a->y + i, k, tail), __soa_load(b->y + i, k, tail)), k, tail);
+    __soa_store(dst->z + i, __soa_sub(__soa_load(a->z + i, k, tail), __soa_load(b->z + i, k, tail)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->x[i] = a->x[i] - b->x[i];
+    dst->y[i] = a->y[i] - b->y[i];
+    dst->z[i] = a->z[i] - b->z[i];
+  }
+#endif
+}
+
+void vec3_soa_mul(vec3_soa* dst, vec3_soa* a, vec3_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->x + i, __soa_mul(__soa_load(a->x + i, k, tail), __soa_load(b->x + i, k, tail)), k, tail);
+    __soa_store(dst->y + i, __soa_mul(__soa_load(a->y + i, k, tail), __soa_load(b->y + i, k, tail)), k, tail);
+    __soa_store(dst->z + i, __soa_mul(__soa_load(a->z + i, k, tail), __soa_load(b->z + i, k, tail)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->x[i] = a->x[i] * b->x[i];
+    dst->y[i] = a->y[i] * b->y[i];
+    dst->z[i] = a->z[i] * b->z[i];
+  }
+#endif
+}
+
+void vec3_soa_div(vec3_soa* dst, vec3_soa* a, vec3_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->x + i, __soa_div(__soa_load(a->x + i, k, tail), __soa_load(b->x + i, k, tail)), k, tail);
+    __soa_store(dst->y + i, __soa_div(__soa_load(a->y + i, k, tail), __soa_load(b->y + i, k, tail)), k, tail);
+    __soa_store(dst->z + i, __soa_div(__soa_load(a->z + i, k, tail), __soa_load(b->z + i, k, tail)), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->x[i] = a->x[i] / b->x[i];
+    dst->y[i] = a->y[i] / b->y[i];
+    dst->z[i] = a->z[i] / b->z[i];
+  }
+#endif
+}
+
+void vec3_soa_mag(float* dst, vec3_soa* v) {
+  size_t n = v->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec x = __soa_load(v->x + i, k, tail);
+    __soa_vec y = __soa_load(v->y + i, k, tail);
+    __soa_vec z = __soa_load(v->z + i, k, tail);
+    __soa_vec tmp = __soa_add(__soa_add(__soa_mul(x, x), __soa_mul(y, y)), __soa_mul(z, z));
+    __soa_store(dst + i, __soa_sqrt(tmp), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    float x = v->x[i];
+    float y = v->y[i];
+    float z = v->z[i];
+    dst[i] = (float)sqrt(x * x + y * y + z * z);
+  }
+#endif
+}
+
+void vec3_soa_scale(vec3_soa* dst, vec3_soa* a, float s) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  __soa_vec vs = __soa_set1(s);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_store(dst->x + i, __soa_mul(__soa_load(a->x + i, k, tail), vs), k, tail);
+    __soa_store(dst->y + i, __soa_mul(__soa_load(a->y + i, k, tail), vs), k, tail);
+    __soa_store(dst->z + i, __soa_mul(__soa_load(a->z + i, k, tail), vs), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    dst->x[i] = a->x[i] * s;
+    dst->y[i] = a->y[i] * s;
+    dst->z[i] = a->z[i] * s;
+  }
+#endif
+}
+
+void vec3_soa_norm(vec3_soa* dst, vec3_soa* v) {
+  size_t n = v->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec x = __soa_load(v->x + i, k, tail);
+    __soa_vec y = __soa_load(v->y + i, k, tail);
+    __soa_vec z = __soa_load(v->z + i, k, tail);
+    __soa_vec mag = __soa_add(__soa_add(__soa_mul(x, x), __soa_mul(y, y)), __soa_mul(z, z));
+    mag = __soa_sqrt(mag);
+    __soa_store(dst->x + i, __soa_div(x, mag), k, tail);
+    __soa_store(dst->y + i, __soa_div(y, mag), k, tail);
+    __soa_store(dst->z + i, __soa_div(z, mag), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    float x = v->x[i];
+    float y = v->y[i];
+    float z = v->z[i];
+    float mag = (float)sqrt(x * x + y * y + z * z);
+    dst->x[i] = x / mag;
+    dst->y[i] = y / mag;
+    dst->z[i] = z / mag;
+  }
+#endif
+}
+
+void vec3_soa_dist(float* dst, vec3_soa* a, vec3_soa* b) {
+  size_t n = a->count;
+#if defined(CAM_SIMD_AVX)
+  // Intel AVX
+  __soa_mask tail = __soa_tail_mask(n % __SOA_WIDTH);
+  for (size_t i = 0; i < n; i += __SOA_WIDTH) {
+    size_t k = n - i;
+    __soa_vec x = __soa_sub(__soa_load(a->x + i, k, tail), __soa_load(b->x + i, k, tail));
+    __soa_vec y = __soa_sub(__soa_load(a->y + i, k, tail), __soa_load(b->y + i, k, tail));
+    __soa_vec z = __soa_sub(__soa_load(a->z + i, k, tail), __soa_load(b->z + i, k, tail));
+    __soa_vec tmp = __soa_add(__soa_add(__soa_mul(x, x), __soa_mul(y, y)), __soa_mul(z, z));
+    __soa_store(dst + i, __soa_sqrt(tmp), k, tail);
+  }
+#else
+  // No SIMD intrinsics
+  for (size_t i = 0; i < n; ++i) {
+    float x = a->x[i] - b->x[i];
+    float y = a->y[i] - b->y[i];
+    float z = a->z[i] - b->z[i];
+    dst[i] = (float)sqrt(x * x + y * y + z * z);
+  }
+#endif
+}
+
+#endif
@@ -24,44 +24,104 @@ typedef struct {
 
 
 /* vec4 functions */
-CAM_API vec4 vec4_make(float x, float y, float z, float w);
+CAM_LINEAR_API vec4 vec4_make(float x, float y, float z, float w);
 
-CAM_API vec4 vec4_makez();
+CAM_LINEAR_API vec4 vec4_makez();
 
-CAM_API float vec4_getx(vec4* v);
+CAM_LINEAR_API float vec4_getx(vec4* v);
 
-CAM_API float vec4_gety(vec4* v);
+CAM_LINEAR_API float vec4_gety(vec4* v);
 
-CAM_API float vec4_getw(vec4* v);
+CAM_LINEAR_API float vec4_getw(vec4* v);
 
-CAM_API float vec4_getz(vec4* v);
+CAM_LINEAR_API float vec4_getz(vec4* v);
 
-CAM_API void vec4_setx(vec4* v, float x);
+CAM_LINEAR_API void vec4_setx(vec4* v, float x);
 
-CAM_API void vec4_sety(vec4* v, float y);
+CAM_LINEAR_API void vec4_sety(vec4* v, float y);
 
-CAM_API void vec4_setz(vec4* v, float z);
+CAM_LINEAR_API void vec4_setz(vec4* v, float z);
 
-CAM_API void vec4_setw(vec4* v, float z);
+CAM_LINEAR_API void vec4_setw(vec4* v, float z);
 
-CAM_API bool vec4_equal(vec4* a, vec4* b);
+CAM_LINEAR_API bool vec4_equal(vec4* a, vec4* b);
 
-CAM_API bool vec4_equalz(vec4* v);
+CAM_LINEAR_API bool vec4_equalz(vec4* v);
 
-CAM_API vec4 vec4_add(vec4* a, vec4* b);
+CAM_LINEAR_API vec4 vec4_add(vec4* a, vec4* b);
 
-CAM_API vec4 vec4_sub(vec4* a, vec4* b);
+CAM_LINEAR_API vec4 vec4_sub(vec4* a, vec4* b);
 
-CAM_API vec4 vec4_mul(vec4* a, vec4* b);
+CAM_LINEAR_API vec4 vec4_mul(vec4* a, vec4* b);
 
-CAM_API vec4 vec4_div(vec4* a, vec4* b);
+CAM_LINEAR_API vec4 vec4_div(vec4* a, vec4* b);
 
-CAM_API float vec4_mag(vec4* v);
+CAM_LINEAR_API float vec4_mag(vec4* v);
 
-CAM_API vec4 vec4_scale(vec4* a, float s);
+CAM_LINEAR_API vec4 vec4_scale(vec4* a, float s);
 
-CAM_API vec4 vec4_norm(vec4* v);
+CAM_LINEAR_API vec4 vec4_norm(vec4* v);
 
-CAM_API float vec4_dist(vec4* a, vec4* b);
+CAM_LINEAR_API float vec4_dist(vec4* a, vec4* b);
+
+
+/* vec4 functions taking operands by value */
+// Same as the pointer versions; see CAM_VECTORCALL in linear_common.h
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_addv(vec4 a, vec4 b);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_subv(vec4 a, vec4 b);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_mulv(vec4 a, vec4 b);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_divv(vec4 a, vec4 b);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_scalev(vec4 a, float s);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec4_magv(vec4 v);
+
+CAM_LINEAR_API vec4 CAM_VECTORCALL vec4_normv(vec4 v);
+
+CAM_LINEAR_API float CAM_VECTORCALL vec4_distv(vec4 a, vec4 b);
+
+
+/* vec4 functions writing the result to dst */
+// Same as the pointer versions; dst may alias an operand
+CAM_LINEAR_API void vec4_add_to(vec4* dst, vec4* a, vec4* b);
+
+CAM_LINEAR_API void vec4_sub_to(vec4* dst, vec4* a, vec4* b);
+
+CAM_LINEAR_API void vec4_mul_to(vec4* dst, vec4* a, vec4* b);
+
+CAM_LINEAR_API void vec4_div_to(vec4* dst, vec4* a, vec4* b);
+
+CAM_LINEAR_API void vec4_scale_to(vec4* dst, vec4* a, float s);
+
+CAM_LINEAR_API void vec4_norm_to(vec4* dst, vec4* v);
+
+
+/* vec4 approximate functions */
+// Built on the hardware reciprocal estimates, see linear_common.h: maximum relative
+// error 3.7e-4, or below 1e-6 with CAM_FAST_NEWTON. Exact without SIMD intrinsics.
+CAM_LINEAR_API float vec4_mag_fast(vec4* v);
+
+// Undefined for the zero vector, like vec4_norm
+CAM_LINEAR_API vec4 vec4_norm_fast(vec4* v);
+
+// Reciprocal of each component
+CAM_LINEAR_API vec4 vec4_rcp_fast(vec4* v);
+
+CAM_LINEAR_API void vec4_mag_fast_n(float* dst, vec4* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec4_norm_fast_n(vec4* dst, vec4* src, size_t count);
+
+// dst may alias src
+CAM_LINEAR_API void vec4_rcp_fast_n(vec4* dst, vec4* src, size_t count);
+
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/vec4.inl"
+#endif
 
 #endif
@@ -0,0 +1,54 @@
+/*
+ * vec4_soa.h
+ * Declaration for batches of 4D float vectors in structure-of-arrays order.
+ */
+
+#ifndef CAM_LINEAR_VEC4_SOA_H
+#define CAM_LINEAR_VEC4_SOA_H
+
+#include "cam/linear/linear_common.h"
+#include "cam/linear/vec4.h"
+
+/* Define vec4_soa struct */
+typedef struct {
+  float* x;       // Component arrays, each aligned to CAM_SIMD_ALIGN bytes
+  float* y;
+  float* z;
+  float* w;
+  size_t count;   // Number of vectors in the batch
+} vec4_soa;
+
+
+/* vec4_soa functions */
+// Batch operations process a->count elements. Every other operand (including
+// the destination) must hold at least that many. Destinations may alias sources.
+CAM_LINEAR_API vec4_soa vec4_soa_make(size_t count);
+
+CAM_LINEAR_API void vec4_soa_free(vec4_soa* s);
+
+CAM_LINEAR_API vec4 vec4_soa_get(vec4_soa* s, size_t i);
+
+CAM_LINEAR_API void vec4_soa_set(vec4_soa* s, size_t i, vec4* v);
+
+CAM_LINEAR_API void vec4_soa_add(vec4_soa* dst, vec4_soa* a, vec4_soa* b);
+
+CAM_LINEAR_API void vec4_soa_sub(vec4_soa* dst, vec4_soa* a, vec4_soa* b);
+
+CAM_LINEAR_API void vec4_soa_mul(vec4_soa* dst, vec4_soa* a, vec4_soa* b);
+
+CAM_LINEAR_API void vec4_soa_div(vec4_soa* dst, vec4_soa* a, vec4_soa* b);
+
+CAM_LINEAR_API void vec4_soa_mag(float* dst, vec4_soa* v);
+
+CAM_LINEAR_API void vec4_soa_scale(vec4_soa* dst, vec4_soa* a, float s);
+
+CAM_LINEAR_API void vec4_soa_norm(vec4_soa* dst, vec4_soa* v);
+
+CAM_LINEAR_API void vec4_soa_dist(float* dst, vec4_soa* a, vec4_soa* b);
+
+/* Inline definitions */
+#if defined(CAM_HEADER_ONLY)
+#include "cam/linear/vec4_soa.inl"
+#endif
+
+#endif
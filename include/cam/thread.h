@@ -0,0 +1,43 @@
+/*
+ * thread.h
+ * Worker thread pool shared by the parallel functions of the library.
+ */
+
+#ifndef CAM_THREAD_H
+#define CAM_THREAD_H
+
+#include "cam/common.h"
+
+#define CAM_MAX_THREADS 256   // Upper bound on cam_set_threads
+
+/* Thread functions */
+// Parallel functions split their work over a pool of worker threads plus the calling
+// thread. The pool starts on first use with one thread per logical CPU, or with the
+// count in the environment variable CAM_THREADS. CAM_HEADER_ONLY builds have no pool
+// and run everything on the calling thread.
+
+// Inline in CAM_HEADER_ONLY builds, which link no library
+#if defined(CAM_HEADER_ONLY)
+#define CAM_THREAD_API static inline
+#else
+#define CAM_THREAD_API CAM_API
+#endif
+
+// Threads parallel functions spread their work over, including the calling thread
+CAM_THREAD_API int cam_get_threads();
+
+// Sets the thread count, clamped to [1, CAM_MAX_THREADS]; 0 or less restores the
+// default. Returns the new count. Not safe to call while other threads are using the library.
+CAM_THREAD_API int cam_set_threads(int count);
+
+// Calls fn(arg, begin, end) over disjoint ranges covering [0, count), in parallel and
+// in no particular order, and returns when every range is done. Ranges are handed out
+// as threads become free, so uneven work balances itself. Calls made from inside fn,
+// or while another thread's call is running, run on the calling thread alone.
+CAM_THREAD_API void cam_parallel_for(size_t count, void (*fn)(void* arg, size_t begin, size_t end), void* arg);
+
+#if defined(CAM_HEADER_ONLY)
+#include "cam/thread.inl"
+#endif
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * thread.inl
+ * Definitions of the thread functions for CAM_HEADER_ONLY builds, which have no thread
+ * pool. Included by thread.h in CAM_HEADER_ONLY builds; library builds compile src/thread.c.
+ */
+
+#ifndef CAM_THREAD_INL
+#define CAM_THREAD_INL
+
+#include "cam/thread.h"
+
+/* Thread functions */
+int cam_get_threads() {
+  return 1;
+}
+
+int cam_set_threads(int count) {
+  // Always the calling thread alone
+  (void)count;
+  return 1;
+}
+
+void cam_parallel_for(size_t count, void (*fn)(void* arg, size_t begin, size_t end), void* arg) {
+  if (count > 0) { fn(arg, 0, count); }
+}
+
+#endif
@@ -0,0 +1,7 @@
+/*
+ * common.c
+ * Definitions for functionality shared across the project.
+ */
+
+#include "cam/common.h"
+#include "cam/common.inl"
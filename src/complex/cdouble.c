@@ -0,0 +1,7 @@
+/*
+ * cdouble.c
+ * Declaration for complex numbers of doubles and interleaved arrays of them.
+ */
+
+#include "cam/complex/cdouble.h"
+#include "cam/complex/cdouble.inl"
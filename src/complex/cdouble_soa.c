@@ -0,0 +1,7 @@
+/*
+ * cdouble_soa.c
+ * Declaration for arrays of double complex numbers in split (re[] / im[]) order.
+ */
+
+#include "cam/complex/cdouble_soa.h"
+#include "cam/complex/cdouble_soa.inl"
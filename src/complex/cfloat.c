@@ -0,0 +1,7 @@
+/*
+ * cfloat.c
+ * Declaration for complex numbers of floats and interleaved arrays of them.
+ */
+
+#include "cam/complex/cfloat.h"
+#include "cam/complex/cfloat.inl"
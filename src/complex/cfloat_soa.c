@@ -0,0 +1,7 @@
+/*
+ * cfloat_soa.c
+ * Declaration for arrays of float complex numbers in split (re[] / im[]) order.
+ */
+
+#include "cam/complex/cfloat_soa.h"
+#include "cam/complex/cfloat_soa.inl"
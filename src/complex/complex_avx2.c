@@ -0,0 +1,8 @@
+/*
+ * complex_avx2.c
+ * AVX2 + FMA build of the complex & quaternion functions for runtime dispatch.
+ */
+
+#define CAM_COMPLEX_TIER_AVX2
+#define CAM_COMPLEX_TIER_TABLE __cam_complex_avx2
+#include "complex_tier.h"
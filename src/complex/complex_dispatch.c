@@ -0,0 +1,29 @@
+/*
+ * complex_dispatch.c
+ * Public entry points of the complex & quaternion algebra module for the runtime dispatch build.
+ */
+
+#include "complex_dispatch.h"
+
+// Start at the portable tier so calls made before the CPU is probed are safe
+static const cam_complex_table* __cam_complex = &__cam_complex_scalar;
+
+void __cam_complex_bind(cam_tier tier) {
+  switch (tier) {
+  case CAM_TIER_AVX2:  __cam_complex = &__cam_complex_avx2; break;
+  case CAM_TIER_SSE41: __cam_complex = &__cam_complex_sse41; break;
+  default:             __cam_complex = &__cam_complex_scalar; break;
+  }
+}
+
+// Runs before main. Lives here rather than in cpu.c so static links that only
+// pull in the complex & quaternion functions still get bound.
+__attribute__((constructor)) static void __cam_complex_init() {
+  __cam_cpu_init();
+}
+
+/* Forward each public function through the bound table */
+#define __CAM_COMPLEX_FORWARD_F(ret, name, params, args) ret name params { return __cam_complex->name args; }
+#define __CAM_COMPLEX_FORWARD_P(name, params, args) void name params { __cam_complex->name args; }
+
+CAM_COMPLEX_FUNCTIONS(__CAM_COMPLEX_FORWARD_F, __CAM_COMPLEX_FORWARD_P)
@@ -0,0 +1,143 @@
+/*
+ * complex_dispatch.h
+ * Function table used to bind the complex & quaternion algebra module to a SIMD tier at runtime.
+ */
+
+#ifndef CAM_COMPLEX_DISPATCH_H
+#define CAM_COMPLEX_DISPATCH_H
+
+#include "cam/cpu.h"
+#include "cam/complex/complex.h"
+
+/* Every public complex & quaternion function */
+// F(return type, name, parameters, arguments) for functions returning a value,
+// P(name, parameters, arguments) for functions returning void.
+#define CAM_COMPLEX_FUNCTIONS(F, P) \
+  /* quat */ \
+  F(quat, quat_make, (float x, float y, float z, float w), (x, y, z, w)) \
+  F(quat, quat_makeid, (), ()) \
+  F(quat, quat_make_axis_angle, (vec3* axis, float angle), (axis, angle)) \
+  F(float, quat_getx, (quat* q), (q)) \
+  F(float, quat_gety, (quat* q), (q)) \
+  F(float, quat_getz, (quat* q), (q)) \
+  F(float, quat_getw, (quat* q), (q)) \
+  F(bool, quat_equal, (quat* a, quat* b), (a, b)) \
+  F(quat, quat_mul, (quat* a, quat* b), (a, b)) \
+  F(quat, quat_conj, (quat* q), (q)) \
+  F(float, quat_dot, (quat* a, quat* b), (a, b)) \
+  F(quat, quat_norm, (quat* q), (q)) \
+  F(vec3, quat_rotate, (quat* q, vec3* v), (q, v)) \
+  F(mat3x3, quat_to_mat3x3, (quat* q), (q)) \
+  F(quat, quat_from_mat3x3, (mat3x3* m), (m)) \
+  F(quat, quat_nlerp, (quat* a, quat* b, float t), (a, b, t)) \
+  F(quat, quat_slerp, (quat* a, quat* b, float t), (a, b, t)) \
+  F(quat, quat_mulv, (quat a, quat b), (a, b)) \
+  F(quat, quat_conjv, (quat q), (q)) \
+  F(float, quat_dotv, (quat a, quat b), (a, b)) \
+  F(quat, quat_normv, (quat q), (q)) \
+  F(vec3, quat_rotatev, (quat q, vec3 v), (q, v)) \
+  F(mat3x3, quat_to_mat3x3v, (quat q), (q)) \
+  F(quat, quat_from_mat3x3v, (mat3x3 m), (m)) \
+  F(quat, quat_nlerpv, (quat a, quat b, float t), (a, b, t)) \
+  F(quat, quat_slerpv, (quat a, quat b, float t), (a, b, t)) \
+  P(quat_mul_to, (quat* dst, quat* a, quat* b), (dst, a, b)) \
+  P(quat_conj_to, (quat* dst, quat* q), (dst, q)) \
+  P(quat_norm_to, (quat* dst, quat* q), (dst, q)) \
+  P(quat_rotate_to, (vec3* dst, quat* q, vec3* v), (dst, q, v)) \
+  P(quat_nlerp_to, (quat* dst, quat* a, quat* b, float t), (dst, a, b, t)) \
+  P(quat_slerp_to, (quat* dst, quat* a, quat* b, float t), (dst, a, b, t)) \
+  /* quat_soa */ \
+  F(quat_soa, quat_soa_make, (size_t count), (count)) \
+  P(quat_soa_free, (quat_soa* s), (s)) \
+  F(quat, quat_soa_get, (quat_soa* s, size_t i), (s, i)) \
+  P(quat_soa_set, (quat_soa* s, size_t i, quat* q), (s, i, q)) \
+  P(quat_soa_mul, (quat_soa* dst, quat_soa* a, quat_soa* b), (dst, a, b)) \
+  P(quat_soa_norm, (quat_soa* dst, quat_soa* q), (dst, q)) \
+  P(quat_soa_nlerp, (quat_soa* dst, quat_soa* a, quat_soa* b, float t), (dst, a, b, t)) \
+  P(quat_soa_slerp, (quat_soa* dst, quat_soa* a, quat_soa* b, float t), (dst, a, b, t)) \
+  /* cfloat */ \
+  F(cfloat, cfloat_make, (float re, float im), (re, im)) \
+  F(bool, cfloat_equal, (cfloat* a, cfloat* b), (a, b)) \
+  F(cfloat, cfloat_add, (cfloat* a, cfloat* b), (a, b)) \
+  F(cfloat, cfloat_sub, (cfloat* a, cfloat* b), (a, b)) \
+  F(cfloat, cfloat_mul, (cfloat* a, cfloat* b), (a, b)) \
+  F(cfloat, cfloat_conj, (cfloat* a), (a)) \
+  F(cfloat, cfloat_conjmul, (cfloat* a, cfloat* b), (a, b)) \
+  F(cfloat, cfloat_scale, (cfloat* a, float s), (a, s)) \
+  F(float, cfloat_mag, (cfloat* a), (a)) \
+  F(float, cfloat_phase, (cfloat* a), (a)) \
+  F(cfloat, cfloat_exp, (cfloat* a), (a)) \
+  P(cfloat_mul_n, (cfloat* dst, cfloat* a, cfloat* b, size_t count), (dst, a, b, count)) \
+  P(cfloat_conjmul_n, (cfloat* dst, cfloat* a, cfloat* b, size_t count), (dst, a, b, count)) \
+  P(cfloat_scale_n, (cfloat* dst, cfloat* a, float s, size_t count), (dst, a, s, count)) \
+  P(cfloat_mag_n, (float* dst, cfloat* a, size_t count), (dst, a, count)) \
+  P(cfloat_phase_n, (float* dst, cfloat* a, size_t count), (dst, a, count)) \
+  P(cfloat_exp_n, (cfloat* dst, cfloat* a, size_t count), (dst, a, count)) \
+  /* cfloat_soa */ \
+  F(cfloat_soa, cfloat_soa_make, (size_t count), (count)) \
+  P(cfloat_soa_free, (cfloat_soa* s), (s)) \
+  F(cfloat_soa, cfloat_soa_view, (float* re, float* im, size_t count), (re, im, count)) \
+  F(cfloat, cfloat_soa_get, (cfloat_soa* s, size_t i), (s, i)) \
+  P(cfloat_soa_set, (cfloat_soa* s, size_t i, cfloat* c), (s, i, c)) \
+  P(cfloat_soa_from_interleaved, (cfloat_soa* dst, cfloat* src), (dst, src)) \
+  P(cfloat_soa_to_interleaved, (cfloat* dst, cfloat_soa* src), (dst, src)) \
+  P(cfloat_soa_mul, (cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b), (dst, a, b)) \
+  P(cfloat_soa_conjmul, (cfloat_soa* dst, cfloat_soa* a, cfloat_soa* b), (dst, a, b)) \
+  P(cfloat_soa_scale, (cfloat_soa* dst, cfloat_soa* a, float s), (dst, a, s)) \
+  P(cfloat_soa_mag, (float* dst, cfloat_soa* a), (dst, a)) \
+  P(cfloat_soa_phase, (float* dst, cfloat_soa* a), (dst, a)) \
+  P(cfloat_soa_exp, (cfloat_soa* dst, cfloat_soa* a), (dst, a)) \
+  /* cdouble */ \
+  F(cdouble, cdouble_make, (double re, double im), (re, im)) \
+  F(bool, cdouble_equal, (cdouble* a, cdouble* b), (a, b)) \
+  F(cdouble, cdouble_add, (cdouble* a, cdouble* b), (a, b)) \
+  F(cdouble, cdouble_sub, (cdouble* a, cdouble* b), (a, b)) \
+  F(cdouble, cdouble_mul, (cdouble* a, cdouble* b), (a, b)) \
+  F(cdouble, cdouble_conj, (cdouble* a), (a)) \
+  F(cdouble, cdouble_conjmul, (cdouble* a, cdouble* b), (a, b)) \
+  F(cdouble, cdouble_scale, (cdouble* a, double s), (a, s)) \
+  F(double, cdouble_mag, (cdouble* a), (a)) \
+  F(double, cdouble_phase, (cdouble* a), (a)) \
+  F(cdouble, cdouble_exp, (cdouble* a), (a)) \
+  P(cdouble_mul_n, (cdouble* dst, cdouble* a, cdouble* b, size_t count), (dst, a, b, count)) \
+  P(cdouble_conjmul_n, (cdouble* dst, cdouble* a, cdouble* b, size_t count), (dst, a, b, count)) \
+  P(cdouble_scale_n, (cdouble* dst, cdouble* a, double s, size_t count), (dst, a, s, count)) \
+  P(cdouble_mag_n, (double* dst, cdouble* a, size_t count), (dst, a, count)) \
+  P(cdouble_phase_n, (double* dst, cdouble* a, size_t count), (dst, a, count)) \
+  P(cdouble_exp_n, (cdouble* dst, cdouble* a, size_t count), (dst, a, count)) \
+  /* cdouble_soa */ \
+  F(cdouble_soa, cdouble_soa_make, (size_t count), (count)) \
+  P(cdouble_soa_free, (cdouble_soa* s), (s)) \
+  F(cdouble_soa, cdouble_soa_view, (double* re, double* im, size_t count), (re, im, count)) \
+  F(cdouble, cdouble_soa_get, (cdouble_soa* s, size_t i), (s, i)) \
+  P(cdouble_soa_set, (cdouble_soa* s, size_t i, cdouble* c), (s, i, c)) \
+  P(cdouble_soa_from_interleaved, (cdouble_soa* dst, cdouble* src), (dst, src)) \
+  P(cdouble_soa_to_interleaved, (cdouble* dst, cdouble_soa* src), (dst, src)) \
+  P(cdouble_soa_mul, (cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b), (dst, a, b)) \
+  P(cdouble_soa_conjmul, (cdouble_soa* dst, cdouble_soa* a, cdouble_soa* b), (dst, a, b)) \
+  P(cdouble_soa_scale, (cdouble_soa* dst, cdouble_soa* a, double s), (dst, a, s)) \
+  P(cdouble_soa_mag, (double* dst, cdouble_soa* a), (dst, a)) \
+  P(cdouble_soa_phase, (double* dst, cdouble_soa* a), (dst, a)) \
+  P(cdouble_soa_exp, (cdouble_soa* dst, cdouble_soa* a), (dst, a))
+
+
+/* Dispatch table */
+#define __CAM_COMPLEX_FIELD_F(ret, name, params, args) ret (*name) params;
+#define __CAM_COMPLEX_FIELD_P(name, params, args) void (*name) params;
+
+typedef struct {
+  CAM_COMPLEX_FUNCTIONS(__CAM_COMPLEX_FIELD_F, __CAM_COMPLEX_FIELD_P)
+} cam_complex_table;
+
+// One table per tier, each defined by the matching complex_<tier>.c
+extern const cam_complex_table __cam_complex_scalar;
+extern const cam_complex_table __cam_complex_sse41;
+extern const cam_complex_table __cam_complex_avx2;
+
+// Points the public functions at the table for the given tier
+void __cam_complex_bind(cam_tier tier);
+
+// Binds the best tier for this CPU, lowered by CAM_SIMD_TIER (defined in cpu.c)
+void __cam_cpu_init();
+
+#endif
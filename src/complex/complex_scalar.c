@@ -0,0 +1,8 @@
+/*
+ * complex_scalar.c
+ * Portable build of the complex & quaternion functions for runtime dispatch.
+ */
+
+#define CAM_COMPLEX_TIER_SCALAR
+#define CAM_COMPLEX_TIER_TABLE __cam_complex_scalar
+#include "complex_tier.h"
@@ -0,0 +1,8 @@
+/*
+ * complex_sse41.c
+ * SSE4.1 build of the complex & quaternion functions for runtime dispatch.
+ */
+
+#define CAM_COMPLEX_TIER_SSE41
+#define CAM_COMPLEX_TIER_TABLE __cam_complex_sse41
+#include "complex_tier.h"
@@ -0,0 +1,33 @@
+/*
+ * complex_tier.h
+ * Compiles every complex & quaternion function for one SIMD tier and collects them into a
+ * dispatch table. Included by complex_scalar.c, complex_sse41.c and complex_avx2.c, which
+ * are built with the matching instruction set flags and name the table to define.
+ */
+
+// Internal linkage lets every tier reuse the public function names
+#define CAM_COMPLEX_API static
+#include "cam/complex/complex.h"
+#include "complex_dispatch.h"
+
+#if defined(CAM_COMPLEX_TIER_SCALAR)
+// Keep the SSE storage layout shared by every tier but take the portable code paths,
+// which index the __m128 members element-wise (a GCC/Clang vector extension)
+#undef CAM_SIMD_AVX
+#undef CAM_SIMD_AVX2
+#define CAM_SIMD_NONE
+#endif
+
+#include "cam/complex/quat.inl"
+#include "cam/complex/quat_soa.inl"
+#include "cam/complex/cfloat.inl"
+#include "cam/complex/cfloat_soa.inl"
+#include "cam/complex/cdouble.inl"
+#include "cam/complex/cdouble_soa.inl"
+
+#define __CAM_COMPLEX_ENTRY_F(ret, name, params, args) name,
+#define __CAM_COMPLEX_ENTRY_P(name, params, args) name,
+
+const cam_complex_table CAM_COMPLEX_TIER_TABLE = {
+  CAM_COMPLEX_FUNCTIONS(__CAM_COMPLEX_ENTRY_F, __CAM_COMPLEX_ENTRY_P)
+};
@@ -0,0 +1,7 @@
+/*
+ * quat.c
+ * Declaration for quaternions of floats.
+ */
+
+#include "cam/complex/quat.h"
+#include "cam/complex/quat.inl"
@@ -0,0 +1,7 @@
+/*
+ * quat_soa.c
+ * Declaration for batches of float quaternions in structure-of-arrays order.
+ */
+
+#include "cam/complex/quat_soa.h"
+#include "cam/complex/quat_soa.inl"
@@ -0,0 +1,134 @@
+/*
+ * cpu.c
+ * CPU feature detection and selection of the SIMD tier used by the library.
+ */
+
+#include "cam/cpu.h"
+#include <string.h>
+
+#if defined(CAM_DISPATCH)
+#include "linear/linear_dispatch.h"
+#include "complex/complex_dispatch.h"
+#include "fourier/fourier_dispatch.h"
+#include "integration/integration_dispatch.h"
+#endif
+
+#if defined(CAM_SIMD_AVX) && !defined(CAM_CMP_MSVC)
+#include <cpuid.h>
+#endif
+
+static const char* __cpu_tier_names[CAM_TIER_COUNT] = { "scalar", "sse41", "avx2" };
+
+// Highest tier this build contains code for
+#if defined(CAM_DISPATCH) || defined(CAM_SIMD_AVX2)
+#define __CPU_BUILD_TIER CAM_TIER_AVX2
+#elif defined(CAM_SIMD_AVX)
+#define __CPU_BUILD_TIER CAM_TIER_SSE41
+#else
+#define __CPU_BUILD_TIER CAM_TIER_SCALAR
+#endif
+
+static int __cpu_supported = -1;  // Probed on first use
+#if defined(CAM_DISPATCH)
+static cam_tier __cpu_bound = CAM_TIER_SCALAR;
+#endif
+
+#if defined(CAM_SIMD_AVX)
+// Fills regs with eax, ebx, ecx, edx for the given CPUID leaf
+static void __cpu_cpuid(unsigned int leaf, unsigned int sub, unsigned int regs[4]) {
+#if defined(CAM_CMP_MSVC)
+  __cpuidex((int*)regs, (int)leaf, (int)sub);
+#else
+  __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register state the OS saves on context switches
+static uint64_t __cpu_xgetbv() {
+#if defined(CAM_CMP_MSVC)
+  return _xgetbv(0);
+#else
+  uint32_t lo, hi;
+  __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return ((uint64_t)hi << 32) | lo;
+#endif
+}
+#endif
+
+static cam_tier __cpu_probe() {
+#if defined(CAM_SIMD_AVX)
+  unsigned int regs[4] = { 0 };
+  __cpu_cpuid(0, 0, regs);
+  unsigned int max_leaf = regs[0];
+
+  __cpu_cpuid(1, 0, regs);
+  bool sse41 = (regs[2] >> 19) & 1;
+  bool fma = (regs[2] >> 12) & 1;
+  bool osxsave = (regs[2] >> 27) & 1;
+  bool avx = (regs[2] >> 28) & 1;
+
+  bool avx2 = false;
+  if (max_leaf >= 7) {
+    __cpu_cpuid(7, 0, regs);
+    avx2 = (regs[1] >> 5) & 1;
+  }
+
+  // The OS must preserve both XMM and YMM registers before AVX can be used
+  bool ymm = osxsave && (__cpu_xgetbv() & 0x6) == 0x6;
+
+  if (avx && avx2 && fma && ymm) { return CAM_TIER_AVX2; }
+  if (sse41) { return CAM_TIER_SSE41; }
+#endif
+  return CAM_TIER_SCALAR;
+}
+
+cam_tier cam_cpu_tier() {
+  if (__cpu_supported < 0) {
+    cam_tier tier = __cpu_probe();
+    __cpu_supported = (tier < __CPU_BUILD_TIER) ? tier : __CPU_BUILD_TIER;
+  }
+  return (cam_tier)__cpu_supported;
+}
+
+cam_tier cam_get_tier() {
+#if defined(CAM_DISPATCH)
+  return __cpu_bound;
+#else
+  return cam_cpu_tier();
+#endif
+}
+
+cam_tier cam_set_tier(cam_tier tier) {
+#if defined(CAM_DISPATCH)
+  cam_tier max = cam_cpu_tier();
+  if (tier > max) { tier = max; }
+  __cam_linear_bind(tier);
+  __cam_complex_bind(tier);
+  __cam_fourier_bind(tier);
+  __cam_integration_bind(tier);
+  __cpu_bound = tier;
+  return tier;
+#else
+  // Fixed at compile time
+  (void)tier;
+  return cam_get_tier();
+#endif
+}
+
+const char* cam_tier_name(cam_tier tier) {
+  if (tier < 0 || tier >= CAM_TIER_COUNT) { return "unknown"; }
+  return __cpu_tier_names[tier];
+}
+
+#if defined(CAM_DISPATCH)
+void __cam_cpu_init() {
+  cam_tier tier = cam_cpu_tier();
+  const char* env = getenv("CAM_SIMD_TIER");
+  if (env) {
+    for (int i = 0; i < CAM_TIER_COUNT; ++i) {
+      if (strcmp(env, __cpu_tier_names[i]) == 0 && i < (int)tier) { tier = (cam_tier)i; }
+    }
+  }
+  cam_set_tier(tier);
+}
+#endif
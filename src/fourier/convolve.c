@@ -0,0 +1,7 @@
+/*
+ * convolve.c
+ * Definitions for single precision convolution and correlation.
+ */
+
+#include "cam/fourier/convolve.h"
+#include "cam/fourier/convolve.inl"
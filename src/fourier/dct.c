@@ -0,0 +1,7 @@
+/*
+ * dct.c
+ * Definitions for single precision discrete cosine transforms.
+ */
+
+#include "cam/fourier/dct.h"
+#include "cam/fourier/dct.inl"
@@ -0,0 +1,7 @@
+/*
+ * fft.c
+ * Declaration for complex single precision fast fourier transforms.
+ */
+
+#include "cam/fourier/fft.h"
+#include "cam/fourier/fft.inl"
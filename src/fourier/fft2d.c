@@ -0,0 +1,7 @@
+/*
+ * fft2d.c
+ * Definitions for two dimensional single precision fast fourier transforms.
+ */
+
+#include "cam/fourier/fft2d.h"
+#include "cam/fourier/fft2d.inl"
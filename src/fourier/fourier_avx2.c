@@ -0,0 +1,8 @@
+/*
+ * fourier_avx2.c
+ * AVX2 + FMA build of the fourier functions for runtime dispatch.
+ */
+
+#define CAM_FOURIER_TIER_AVX2
+#define CAM_FOURIER_TIER_TABLE __cam_fourier_avx2
+#include "fourier_tier.h"
@@ -0,0 +1,29 @@
+/*
+ * fourier_dispatch.c
+ * Public entry points of the fourier analysis module for the runtime dispatch build.
+ */
+
+#include "fourier_dispatch.h"
+
+// Start at the portable tier so calls made before the CPU is probed are safe
+static const cam_fourier_table* __cam_fourier = &__cam_fourier_scalar;
+
+void __cam_fourier_bind(cam_tier tier) {
+  switch (tier) {
+  case CAM_TIER_AVX2:  __cam_fourier = &__cam_fourier_avx2; break;
+  case CAM_TIER_SSE41: __cam_fourier = &__cam_fourier_sse41; break;
+  default:             __cam_fourier = &__cam_fourier_scalar; break;
+  }
+}
+
+// Runs before main. Lives here rather than in cpu.c so static links that only
+// pull in the fourier functions still get bound.
+__attribute__((constructor)) static void __cam_fourier_init() {
+  __cam_cpu_init();
+}
+
+/* Forward each public function through the bound table */
+#define __CAM_FOURIER_FORWARD_F(ret, name, params, args) ret name params { return __cam_fourier->name args; }
+#define __CAM_FOURIER_FORWARD_P(name, params, args) void name params { __cam_fourier->name args; }
+
+CAM_FOURIER_FUNCTIONS(__CAM_FOURIER_FORWARD_F, __CAM_FOURIER_FORWARD_P)
@@ -0,0 +1,96 @@
+/*
+ * fourier_dispatch.h
+ * Function table used to bind the fourier analysis module to a SIMD tier at runtime.
+ */
+
+#ifndef CAM_FOURIER_DISPATCH_H
+#define CAM_FOURIER_DISPATCH_H
+
+#include "cam/cpu.h"
+#include "cam/fourier/fourier.h"
+
+/* Every public fourier function */
+// F(return type, name, parameters, arguments) for functions returning a value,
+// P(name, parameters, arguments) for functions returning void.
+#define CAM_FOURIER_FUNCTIONS(F, P) \
+  /* fft */ \
+  F(cam_fft_plan*, cam_fft_plan_make, (size_t n), (n)) \
+  P(cam_fft_plan_free, (cam_fft_plan* plan), (plan)) \
+  F(int, cam_fft_plan_describe, (cam_fft_plan* plan, char* buf, size_t size), (plan, buf, size)) \
+  P(cam_fft_forward, (cam_fft_plan* plan, cfloat* dst, cfloat* src), (plan, dst, src)) \
+  P(cam_fft_inverse, (cam_fft_plan* plan, cfloat* dst, cfloat* src), (plan, dst, src)) \
+  F(size_t, cam_fft_plan_scratch_size, (cam_fft_plan* plan), (plan)) \
+  P(cam_fft_forward_scratch, (cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work), (plan, dst, src, work)) \
+  P(cam_fft_inverse_scratch, (cam_fft_plan* plan, cfloat* dst, cfloat* src, cfloat* work), (plan, dst, src, work)) \
+  P(cam_fft_many, (cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src), (plan, dst, src)) \
+  P(cam_ifft_many, (cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src), (plan, dst, src)) \
+  F(size_t, cam_fft_many_scratch_size, (cam_fft_plan* plan), (plan)) \
+  P(cam_fft_many_scratch, (cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work), (plan, dst, src, work)) \
+  P(cam_ifft_many_scratch, (cam_fft_plan* plan, cfloat_soa* dst, cfloat_soa* src, cfloat* work), (plan, dst, src, work)) \
+  F(cam_fft_plan*, cam_fft_plan_tune, (size_t n), (n)) \
+  F(bool, cam_fft_wisdom_save, (const char* path, cam_fft_plan** plans, size_t count), (path, plans, count)) \
+  F(cam_fft_wisdom*, cam_fft_wisdom_load, (const char* path), (path)) \
+  F(cam_fft_plan*, cam_fft_wisdom_plan, (cam_fft_wisdom* w, size_t n), (w, n)) \
+  P(cam_fft_wisdom_close, (cam_fft_wisdom* w), (w)) \
+  /* rfft */ \
+  F(cam_rfft_plan*, cam_rfft_plan_make, (size_t n), (n)) \
+  P(cam_rfft_plan_free, (cam_rfft_plan* plan), (plan)) \
+  P(cam_rfft, (cam_rfft_plan* plan, cfloat* dst, float* src), (plan, dst, src)) \
+  P(cam_irfft, (cam_rfft_plan* plan, float* dst, cfloat* src), (plan, dst, src)) \
+  /* stft */ \
+  P(cam_window_fill, (float* dst, size_t n, cam_window window), (dst, n, window)) \
+  F(cam_stft*, cam_stft_make, (size_t n, size_t hop, float* window), (n, hop, window)) \
+  P(cam_stft_free, (cam_stft* s), (s)) \
+  P(cam_stft_reset, (cam_stft* s), (s)) \
+  F(size_t, cam_stft_frames, (cam_stft* s, size_t count), (s, count)) \
+  F(size_t, cam_stft_push, (cam_stft* s, cfloat* dst, float* src, size_t count), (s, dst, src, count)) \
+  F(size_t, cam_istft_push, (cam_stft* s, float* dst, cfloat* src, size_t frames), (s, dst, src, frames)) \
+  /* convolve */ \
+  F(bool, cam_convolve, (float* dst, float* a, size_t na, float* b, size_t nb), (dst, a, na, b, nb)) \
+  F(bool, cam_cconvolve, (cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb), (dst, a, na, b, nb)) \
+  F(bool, cam_correlate, (float* dst, float* a, size_t na, float* b, size_t nb), (dst, a, na, b, nb)) \
+  F(bool, cam_ccorrelate, (cfloat* dst, cfloat* a, size_t na, cfloat* b, size_t nb), (dst, a, na, b, nb)) \
+  F(cam_fir*, cam_fir_make, (float* filter, size_t count, size_t block), (filter, count, block)) \
+  P(cam_fir_free, (cam_fir* f), (f)) \
+  P(cam_fir_reset, (cam_fir* f), (f)) \
+  P(cam_fir_run, (cam_fir* f, float* dst, float* src), (f, dst, src)) \
+  /* dct */ \
+  F(cam_dct_plan*, cam_dct_plan_make, (size_t n), (n)) \
+  P(cam_dct_plan_free, (cam_dct_plan* plan), (plan)) \
+  F(cam_mdct_plan*, cam_mdct_plan_make, (size_t n), (n)) \
+  P(cam_mdct_plan_free, (cam_mdct_plan* plan), (plan)) \
+  P(cam_dct, (cam_dct_plan* plan, float* dst, float* src), (plan, dst, src)) \
+  P(cam_idct, (cam_dct_plan* plan, float* dst, float* src), (plan, dst, src)) \
+  P(cam_mdct, (cam_mdct_plan* plan, float* dst, float* src), (plan, dst, src)) \
+  P(cam_imdct, (cam_mdct_plan* plan, float* dst, float* src), (plan, dst, src)) \
+  P(cam_dct8x8_many, (float* dst, float* src, size_t count), (dst, src, count)) \
+  P(cam_idct8x8_many, (float* dst, float* src, size_t count), (dst, src, count)) \
+  /* fft2d */ \
+  F(cam_fft2d_plan*, cam_fft2d_plan_make, (size_t rows, size_t cols), (rows, cols)) \
+  P(cam_fft2d_plan_free, (cam_fft2d_plan* plan), (plan)) \
+  P(cam_fft2d_forward, (cam_fft2d_plan* plan, cfloat* dst, cfloat* src), (plan, dst, src)) \
+  P(cam_fft2d_inverse, (cam_fft2d_plan* plan, cfloat* dst, cfloat* src), (plan, dst, src)) \
+  P(cam_rfft2d, (cam_fft2d_plan* plan, cfloat* dst, float* src), (plan, dst, src)) \
+  P(cam_irfft2d, (cam_fft2d_plan* plan, float* dst, cfloat* src), (plan, dst, src))
+
+
+/* Dispatch table */
+#define __CAM_FOURIER_FIELD_F(ret, name, params, args) ret (*name) params;
+#define __CAM_FOURIER_FIELD_P(name, params, args) void (*name) params;
+
+typedef struct {
+  CAM_FOURIER_FUNCTIONS(__CAM_FOURIER_FIELD_F, __CAM_FOURIER_FIELD_P)
+} cam_fourier_table;
+
+// One table per tier, each defined by the matching fourier_<tier>.c
+extern const cam_fourier_table __cam_fourier_scalar;
+extern const cam_fourier_table __cam_fourier_sse41;
+extern const cam_fourier_table __cam_fourier_avx2;
+
+// Points the public functions at the table for the given tier
+void __cam_fourier_bind(cam_tier tier);
+
+// Binds the best tier for this CPU, lowered by CAM_SIMD_TIER (defined in cpu.c)
+void __cam_cpu_init();
+
+#endif
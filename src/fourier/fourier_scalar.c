@@ -0,0 +1,8 @@
+/*
+ * fourier_scalar.c
+ * Portable build of the fourier functions for runtime dispatch.
+ */
+
+#define CAM_FOURIER_TIER_SCALAR
+#define CAM_FOURIER_TIER_TABLE __cam_fourier_scalar
+#include "fourier_tier.h"
@@ -0,0 +1,8 @@
+/*
+ * fourier_sse41.c
+ * SSE4.1 build of the fourier functions for runtime dispatch.
+ */
+
+#define CAM_FOURIER_TIER_SSE41
+#define CAM_FOURIER_TIER_TABLE __cam_fourier_sse41
+#include "fourier_tier.h"
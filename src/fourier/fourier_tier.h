@@ -0,0 +1,32 @@
+/*
+ * fourier_tier.h
+ * Compiles every fourier function for one SIMD tier and collects them into a
+ * dispatch table. Included by fourier_scalar.c, fourier_sse41.c and fourier_avx2.c, which
+ * are built with the matching instruction set flags and name the table to define.
+ */
+
+// Internal linkage lets every tier reuse the public function names
+#define CAM_FOURIER_API static
+#include "cam/fourier/fourier.h"
+#include "fourier_dispatch.h"
+
+#if defined(CAM_FOURIER_TIER_SCALAR)
+// Take the portable code paths; the plans and data are laid out the same for every tier
+#undef CAM_SIMD_AVX
+#undef CAM_SIMD_AVX2
+#define CAM_SIMD_NONE
+#endif
+
+#include "cam/fourier/fft.inl"
+#include "cam/fourier/rfft.inl"
+#include "cam/fourier/stft.inl"
+#include "cam/fourier/convolve.inl"
+#include "cam/fourier/dct.inl"
+#include "cam/fourier/fft2d.inl"
+
+#define __CAM_FOURIER_ENTRY_F(ret, name, params, args) name,
+#define __CAM_FOURIER_ENTRY_P(name, params, args) name,
+
+const cam_fourier_table CAM_FOURIER_TIER_TABLE = {
+  CAM_FOURIER_FUNCTIONS(__CAM_FOURIER_ENTRY_F, __CAM_FOURIER_ENTRY_P)
+};
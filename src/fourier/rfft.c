@@ -0,0 +1,7 @@
+/*
+ * rfft.c
+ * Declaration for single precision fast fourier transforms of real signals.
+ */
+
+#include "cam/fourier/rfft.h"
+#include "cam/fourier/rfft.inl"
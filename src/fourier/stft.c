@@ -0,0 +1,7 @@
+/*
+ * stft.c
+ * Definitions for streaming short-time fourier transforms of real signals.
+ */
+
+#include "cam/fourier/stft.h"
+#include "cam/fourier/stft.inl"
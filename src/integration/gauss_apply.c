@@ -0,0 +1,7 @@
+/*
+ * gauss_apply.c
+ * Definitions for applying Gauss rules to sampled values.
+ */
+
+#include "cam/integration/gauss_rule.h"
+#include "cam/integration/gauss_apply.inl"
@@ -0,0 +1,7 @@
+/*
+ * gauss_kronrod.c
+ * Definitions for adaptive Gauss-Kronrod quadrature.
+ */
+
+#include "cam/integration/gauss_kronrod.h"
+#include "cam/integration/gauss_kronrod.inl"
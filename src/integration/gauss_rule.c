@@ -0,0 +1,7 @@
+/*
+ * gauss_rule.c
+ * Definitions for fixed order Gauss-Legendre and Gauss-Jacobi rules.
+ */
+
+#include "cam/integration/gauss_rule.h"
+#include "cam/integration/gauss_rule.inl"
@@ -0,0 +1,8 @@
+/*
+ * integration_avx2.c
+ * AVX2 + FMA build of the integration kernels for runtime dispatch.
+ */
+
+#define CAM_INTEGRATION_TIER_AVX2
+#define CAM_INTEGRATION_TIER_TABLE __cam_integration_avx2
+#include "integration_tier.h"
@@ -0,0 +1,29 @@
+/*
+ * integration_dispatch.c
+ * Public entry points of the numerical integration kernels for the runtime dispatch build.
+ */
+
+#include "integration_dispatch.h"
+
+// Start at the portable tier so calls made before the CPU is probed are safe
+static const cam_integration_table* __cam_integration = &__cam_integration_scalar;
+
+void __cam_integration_bind(cam_tier tier) {
+  switch (tier) {
+  case CAM_TIER_AVX2:  __cam_integration = &__cam_integration_avx2; break;
+  case CAM_TIER_SSE41: __cam_integration = &__cam_integration_sse41; break;
+  default:             __cam_integration = &__cam_integration_scalar; break;
+  }
+}
+
+// Runs before main. Lives here rather than in cpu.c so static links that only
+// pull in the integration functions still get bound.
+__attribute__((constructor)) static void __cam_integration_init() {
+  __cam_cpu_init();
+}
+
+/* Forward each public kernel through the bound table */
+#define __CAM_INTEGRATION_FORWARD_F(ret, name, params, args) ret name params { return __cam_integration->name args; }
+#define __CAM_INTEGRATION_FORWARD_P(name, params, args) void name params { __cam_integration->name args; }
+
+CAM_INTEGRATION_FUNCTIONS(__CAM_INTEGRATION_FORWARD_F, __CAM_INTEGRATION_FORWARD_P)
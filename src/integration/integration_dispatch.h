@@ -0,0 +1,41 @@
+/*
+ * integration_dispatch.h
+ * Function table used to bind the numerical integration kernels to a SIMD tier at runtime.
+ */
+
+#ifndef CAM_INTEGRATION_DISPATCH_H
+#define CAM_INTEGRATION_DISPATCH_H
+
+#include "cam/cpu.h"
+#include "cam/integration/integration.h"
+
+/* Every integration kernel */
+// F(return type, name, parameters, arguments) for functions returning a value,
+// P(name, parameters, arguments) for functions returning void. Only the functions
+// declared CAM_INTEGRATION_KERNEL_API; the integrators are compiled once.
+#define CAM_INTEGRATION_FUNCTIONS(F, P) \
+  /* gauss_apply */ \
+  F(double, cam_gauss_apply, (const cam_gauss_rule* rule, const double* y), (rule, y)) \
+  P(cam_gauss_apply_many, (const cam_gauss_rule* rule, double* dst, const double* y, size_t count), (rule, dst, y, count))
+
+
+/* Dispatch table */
+#define __CAM_INTEGRATION_FIELD_F(ret, name, params, args) ret (*name) params;
+#define __CAM_INTEGRATION_FIELD_P(name, params, args) void (*name) params;
+
+typedef struct {
+  CAM_INTEGRATION_FUNCTIONS(__CAM_INTEGRATION_FIELD_F, __CAM_INTEGRATION_FIELD_P)
+} cam_integration_table;
+
+// One table per tier, each defined by the matching integration_<tier>.c
+extern const cam_integration_table __cam_integration_scalar;
+extern const cam_integration_table __cam_integration_sse41;
+extern const cam_integration_table __cam_integration_avx2;
+
+// Points the public kernels at the table for the given tier
+void __cam_integration_bind(cam_tier tier);
+
+// Binds the best tier for this CPU, lowered by CAM_SIMD_TIER (defined in cpu.c)
+void __cam_cpu_init();
+
+#endif
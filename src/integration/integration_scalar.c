@@ -0,0 +1,8 @@
+/*
+ * integration_scalar.c
+ * Portable build of the integration kernels for runtime dispatch.
+ */
+
+#define CAM_INTEGRATION_TIER_SCALAR
+#define CAM_INTEGRATION_TIER_TABLE __cam_integration_scalar
+#include "integration_tier.h"
@@ -0,0 +1,8 @@
+/*
+ * integration_sse41.c
+ * SSE4.1 build of the integration kernels for runtime dispatch.
+ */
+
+#define CAM_INTEGRATION_TIER_SSE41
+#define CAM_INTEGRATION_TIER_TABLE __cam_integration_sse41
+#include "integration_tier.h"
@@ -0,0 +1,28 @@
+/*
+ * integration_tier.h
+ * Compiles every integration kernel for one SIMD tier and collects them into a
+ * dispatch table. Included by integration_scalar.c, integration_sse41.c and
+ * integration_avx2.c, which are built with the matching instruction set flags and name
+ * the table to define.
+ */
+
+// Internal linkage lets every tier reuse the public function names
+#define CAM_INTEGRATION_KERNEL_API static
+#include "cam/integration/integration.h"
+#include "integration_dispatch.h"
+
+#if defined(CAM_INTEGRATION_TIER_SCALAR)
+// Take the portable code paths
+#undef CAM_SIMD_AVX
+#undef CAM_SIMD_AVX2
+#define CAM_SIMD_NONE
+#endif
+
+#include "cam/integration/gauss_apply.inl"
+
+#define __CAM_INTEGRATION_ENTRY_F(ret, name, params, args) name,
+#define __CAM_INTEGRATION_ENTRY_P(name, params, args) name,
+
+const cam_integration_table CAM_INTEGRATION_TIER_TABLE = {
+  CAM_INTEGRATION_FUNCTIONS(__CAM_INTEGRATION_ENTRY_F, __CAM_INTEGRATION_ENTRY_P)
+};
@@ -0,0 +1,7 @@
+/*
+ * monte_carlo.c
+ * Definitions for Monte Carlo and quasi-Monte Carlo integration over boxes.
+ */
+
+#include "cam/integration/monte_carlo.h"
+#include "cam/integration/monte_carlo.inl"
@@ -0,0 +1,7 @@
+/*
+ * tanh_sinh.c
+ * Definitions for tanh-sinh (double exponential) quadrature.
+ */
+
+#include "cam/integration/tanh_sinh.h"
+#include "cam/integration/tanh_sinh.inl"
@@ -0,0 +1,8 @@
+/*
+ * linear_avx2.c
+ * AVX2 + FMA build of the linear algebra functions for runtime dispatch.
+ */
+
+#define CAM_LINEAR_TIER_AVX2
+#define CAM_LINEAR_TIER_TABLE __cam_linear_avx2
+#include "linear_tier.h"
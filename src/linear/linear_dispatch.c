@@ -0,0 +1,29 @@
+/*
+ * linear_dispatch.c
+ * Public entry points of the linear algebra module for the runtime dispatch build.
+ */
+
+#include "linear_dispatch.h"
+
+// Start at the portable tier so calls made before the CPU is probed are safe
+static const cam_linear_table* __cam_linear = &__cam_linear_scalar;
+
+void __cam_linear_bind(cam_tier tier) {
+  switch (tier) {
+  case CAM_TIER_AVX2:  __cam_linear = &__cam_linear_avx2; break;
+  case CAM_TIER_SSE41: __cam_linear = &__cam_linear_sse41; break;
+  default:             __cam_linear = &__cam_linear_scalar; break;
+  }
+}
+
+// Runs before main. Lives here rather than in cpu.c so static links that only
+// pull in the linear algebra functions still get bound.
+__attribute__((constructor)) static void __cam_linear_init() {
+  __cam_cpu_init();
+}
+
+/* Forward each public function through the bound table */
+#define __CAM_LINEAR_FORWARD_F(ret, name, params, args) ret name params { return __cam_linear->name args; }
+#define __CAM_LINEAR_FORWARD_P(name, params, args) void name params { __cam_linear->name args; }
+
+CAM_LINEAR_FUNCTIONS(__CAM_LINEAR_FORWARD_F, __CAM_LINEAR_FORWARD_P)
@@ -0,0 +1,289 @@
+/*
+ * linear_dispatch.h
+ * Function table used to bind the linear algebra module to a SIMD tier at runtime.
+ */
+
+#ifndef CAM_LINEAR_DISPATCH_H
+#define CAM_LINEAR_DISPATCH_H
+
+#include "cam/cpu.h"
+#include "cam/linear/linear.h"
+
+/* Every public linear algebra function */
+// F(return type, name, parameters, arguments) for functions returning a value,
+// P(name, parameters, arguments) for functions returning void.
+#define CAM_LINEAR_FUNCTIONS(F, P) \
+  /* vec2 */ \
+  F(vec2, vec2_make, (float x, float y), (x, y)) \
+  F(vec2, vec2_makez, (), ()) \
+  F(float, vec2_getx, (vec2* v), (v)) \
+  F(float, vec2_gety, (vec2* v), (v)) \
+  P(vec2_setx, (vec2* v, float x), (v, x)) \
+  P(vec2_sety, (vec2* v, float y), (v, y)) \
+  F(bool, vec2_equal, (vec2* a, vec2* b), (a, b)) \
+  F(bool, vec2_equalz, (vec2* v), (v)) \
+  F(vec2, vec2_add, (vec2* a, vec2* b), (a, b)) \
+  F(vec2, vec2_sub, (vec2* a, vec2* b), (a, b)) \
+  F(vec2, vec2_mul, (vec2* a, vec2* b), (a, b)) \
+  F(vec2, vec2_div, (vec2* a, vec2* b), (a, b)) \
+  F(float, vec2_mag, (vec2* v), (v)) \
+  F(vec2, vec2_scale, (vec2* a, float s), (a, s)) \
+  F(vec2, vec2_norm, (vec2* v), (v)) \
+  F(float, vec2_dist, (vec2* a, vec2* b), (a, b)) \
+  F(vec2, vec2_addv, (vec2 a, vec2 b), (a, b)) \
+  F(vec2, vec2_subv, (vec2 a, vec2 b), (a, b)) \
+  F(vec2, vec2_mulv, (vec2 a, vec2 b), (a, b)) \
+  F(vec2, vec2_divv, (vec2 a, vec2 b), (a, b)) \
+  F(vec2, vec2_scalev, (vec2 a, float s), (a, s)) \
+  F(float, vec2_magv, (vec2 v), (v)) \
+  F(vec2, vec2_normv, (vec2 v), (v)) \
+  F(float, vec2_distv, (vec2 a, vec2 b), (a, b)) \
+  P(vec2_add_to, (vec2* dst, vec2* a, vec2* b), (dst, a, b)) \
+  P(vec2_sub_to, (vec2* dst, vec2* a, vec2* b), (dst, a, b)) \
+  P(vec2_mul_to, (vec2* dst, vec2* a, vec2* b), (dst, a, b)) \
+  P(vec2_div_to, (vec2* dst, vec2* a, vec2* b), (dst, a, b)) \
+  P(vec2_scale_to, (vec2* dst, vec2* a, float s), (dst, a, s)) \
+  P(vec2_norm_to, (vec2* dst, vec2* v), (dst, v)) \
+  F(float, vec2_mag_fast, (vec2* v), (v)) \
+  F(vec2, vec2_norm_fast, (vec2* v), (v)) \
+  F(vec2, vec2_rcp_fast, (vec2* v), (v)) \
+  P(vec2_mag_fast_n, (float* dst, vec2* src, size_t count), (dst, src, count)) \
+  P(vec2_norm_fast_n, (vec2* dst, vec2* src, size_t count), (dst, src, count)) \
+  P(vec2_rcp_fast_n, (vec2* dst, vec2* src, size_t count), (dst, src, count)) \
+  /* vec3 */ \
+  F(vec3, vec3_make, (float x, float y, float z), (x, y, z)) \
+  F(vec3, vec3_makez, (), ()) \
+  F(float, vec3_getx, (vec3* v), (v)) \
+  F(float, vec3_gety, (vec3* v), (v)) \
+  F(float, vec3_getz, (vec3* v), (v)) \
+  P(vec3_setx, (vec3* v, float x), (v, x)) \
+  P(vec3_sety, (vec3* v, float y), (v, y)) \
+  P(vec3_setz, (vec3* v, float z), (v, z)) \
+  F(bool, vec3_equal, (vec3* a, vec3* b), (a, b)) \
+  F(bool, vec3_equalz, (vec3* v), (v)) \
+  F(vec3, vec3_add, (vec3* a, vec3* b), (a, b)) \
+  F(vec3, vec3_sub, (vec3* a, vec3* b), (a, b)) \
+  F(vec3, vec3_mul, (vec3* a, vec3* b), (a, b)) \
+  F(vec3, vec3_div, (vec3* a, vec3* b), (a, b)) \
+  F(float, vec3_mag, (vec3* v), (v)) \
+  F(vec3, vec3_scale, (vec3* a, float s), (a, s)) \
+  F(vec3, vec3_norm, (vec3* v), (v)) \
+  F(float, vec3_dist, (vec3* a, vec3* b), (a, b)) \
+  F(vec3, vec3_addv, (vec3 a, vec3 b), (a, b)) \
+  F(vec3, vec3_subv, (vec3 a, vec3 b), (a, b)) \
+  F(vec3, vec3_mulv, (vec3 a, vec3 b), (a, b)) \
+  F(vec3, vec3_divv, (vec3 a, vec3 b), (a, b)) \
+  F(vec3, vec3_scalev, (vec3 a, float s), (a, s)) \
+  F(float, vec3_magv, (vec3 v), (v)) \
+  F(vec3, vec3_normv, (vec3 v), (v)) \
+  F(float, vec3_distv, (vec3 a, vec3 b), (a, b)) \
+  P(vec3_add_to, (vec3* dst, vec3* a, vec3* b), (dst, a, b)) \
+  P(vec3_sub_to, (vec3* dst, vec3* a, vec3* b), (dst, a, b)) \
+  P(vec3_mul_to, (vec3* dst, vec3* a, vec3* b), (dst, a, b)) \
+  P(vec3_div_to, (vec3* dst, vec3* a, vec3* b), (dst, a, b)) \
+  P(vec3_scale_to, (vec3* dst, vec3* a, float s), (dst, a, s)) \
+  P(vec3_norm_to, (vec3* dst, vec3* v), (dst, v)) \
+  F(float, vec3_mag_fast, (vec3* v), (v)) \
+  F(vec3, vec3_norm_fast, (vec3* v), (v)) \
+  F(vec3, vec3_rcp_fast, (vec3* v), (v)) \
+  P(vec3_mag_fast_n, (float* dst, vec3* src, size_t count), (dst, src, count)) \
+  P(vec3_norm_fast_n, (vec3* dst, vec3* src, size_t count), (dst, src, count)) \
+  P(vec3_rcp_fast_n, (vec3* dst, vec3* src, size_t count), (dst, src, count)) \
+  /* vec4 */ \
+  F(vec4, vec4_make, (float x, float y, float z, float w), (x, y, z, w)) \
+  F(vec4, vec4_makez, (), ()) \
+  F(float, vec4_getx, (vec4* v), (v)) \
+  F(float, vec4_gety, (vec4* v), (v)) \
+  F(float, vec4_getw, (vec4* v), (v)) \
+  F(float, vec4_getz, (vec4* v), (v)) \
+  P(vec4_setx, (vec4* v, float x), (v, x)) \
+  P(vec4_sety, (vec4* v, float y), (v, y)) \
+  P(vec4_setz, (vec4* v, float z), (v, z)) \
+  P(vec4_setw, (vec4* v, float z), (v, z)) \
+  F(bool, vec4_equal, (vec4* a, vec4* b), (a, b)) \
+  F(bool, vec4_equalz, (vec4* v), (v)) \
+  F(vec4, vec4_add, (vec4* a, vec4* b), (a, b)) \
+  F(vec4, vec4_sub, (vec4* a, vec4* b), (a, b)) \
+  F(vec4, vec4_mul, (vec4* a, vec4* b), (a, b)) \
+  F(vec4, vec4_div, (vec4* a, vec4* b), (a, b)) \
+  F(float, vec4_mag, (vec4* v), (v)) \
+  F(vec4, vec4_scale, (vec4* a, float s), (a, s)) \
+  F(vec4, vec4_norm, (vec4* v), (v)) \
+  F(float, vec4_dist, (vec4* a, vec4* b), (a, b)) \
+  F(vec4, vec4_addv, (vec4 a, vec4 b), (a, b)) \
+  F(vec4, vec4_subv, (vec4 a, vec4 b), (a, b)) \
+  F(vec4, vec4_mulv, (vec4 a, vec4 b), (a, b)) \
+  F(vec4, vec4_divv, (vec4 a, vec4 b), (a, b)) \
+  F(vec4, vec4_scalev, (vec4 a, float s), (a, s)) \
+  F(float, vec4_magv, (vec4 v), (v)) \
+  F(vec4, vec4_normv, (vec4 v), (v)) \
+  F(float, vec4_distv, (vec4 a, vec4 b), (a, b)) \
+  P(vec4_add_to, (vec4* dst, vec4* a, vec4* b), (dst, a, b)) \
+  P(vec4_sub_to, (vec4* dst, vec4* a, vec4* b), (dst, a, b)) \
+  P(vec4_mul_to, (vec4* dst, vec4* a, vec4* b), (dst, a, b)) \
+  P(vec4_div_to, (vec4* dst, vec4* a, vec4* b), (dst, a, b)) \
+  P(vec4_scale_to, (vec4* dst, vec4* a, float s), (dst, a, s)) \
+  P(vec4_norm_to, (vec4* dst, vec4* v), (dst, v)) \
+  F(float, vec4_mag_fast, (vec4* v), (v)) \
+  F(vec4, vec4_norm_fast, (vec4* v), (v)) \
+  F(vec4, vec4_rcp_fast, (vec4* v), (v)) \
+  P(vec4_mag_fast_n, (float* dst, vec4* src, size_t count), (dst, src, count)) \
+  P(vec4_norm_fast_n, (vec4* dst, vec4* src, size_t count), (dst, src, count)) \
+  P(vec4_rcp_fast_n, (vec4* dst, vec4* src, size_t count), (dst, src, count)) \
+  /* mat2x2 */ \
+  F(mat2x2, mat2x2_make, (float x1, float y1, float x2, float y2), (x1, y1, x2, y2)) \
+  F(mat2x2, mat2x2_makeid, (), ()) \
+  F(bool, mat2x2_equal, (mat2x2* a, mat2x2* b), (a, b)) \
+  F(bool, mat2x2_equalid, (mat2x2* m), (m)) \
+  F(float, mat2x2_get, (unsigned int col, unsigned int row, mat2x2* m), (col, row, m)) \
+  F(mat2x2, mat2x2_add, (mat2x2* a, mat2x2* b), (a, b)) \
+  F(mat2x2, mat2x2_sub, (mat2x2* a, mat2x2* b), (a, b)) \
+  F(mat2x2, mat2x2_scale, (mat2x2* m, float s), (m, s)) \
+  F(mat2x2, mat2x2_mul, (mat2x2* a, mat2x2* b), (a, b)) \
+  P(mat2x2_mul_n, (mat2x2* dst, mat2x2* a, mat2x2* b, size_t count), (dst, a, b, count)) \
+  F(vec2, mat2x2_vec2_mul, (mat2x2* m, vec2* v), (m, v)) \
+  F(mat2x2, mat2x2_transpose, (mat2x2* m), (m)) \
+  F(float, mat2x2_det, (mat2x2* m), (m)) \
+  F(mat2x2, mat2x2_addv, (mat2x2 a, mat2x2 b), (a, b)) \
+  F(mat2x2, mat2x2_subv, (mat2x2 a, mat2x2 b), (a, b)) \
+  F(mat2x2, mat2x2_scalev, (mat2x2 m, float s), (m, s)) \
+  F(mat2x2, mat2x2_mulv, (mat2x2 a, mat2x2 b), (a, b)) \
+  F(vec2, mat2x2_vec2_mulv, (mat2x2 m, vec2 v), (m, v)) \
+  F(mat2x2, mat2x2_transposev, (mat2x2 m), (m)) \
+  F(float, mat2x2_detv, (mat2x2 m), (m)) \
+  P(mat2x2_add_to, (mat2x2* dst, mat2x2* a, mat2x2* b), (dst, a, b)) \
+  P(mat2x2_sub_to, (mat2x2* dst, mat2x2* a, mat2x2* b), (dst, a, b)) \
+  P(mat2x2_scale_to, (mat2x2* dst, mat2x2* m, float s), (dst, m, s)) \
+  P(mat2x2_mul_to, (mat2x2* dst, mat2x2* a, mat2x2* b), (dst, a, b)) \
+  P(mat2x2_vec2_mul_to, (vec2* dst, mat2x2* m, vec2* v), (dst, m, v)) \
+  P(mat2x2_transpose_to, (mat2x2* dst, mat2x2* m), (dst, m)) \
+  /* mat3x3 */ \
+  F(mat3x3, mat3x3_make, (float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3), (x1, y1, z1, x2, y2, z2, x3, y3, z3)) \
+  F(mat3x3, mat3x3_makeid, (), ()) \
+  F(bool, mat3x3_equal, (mat3x3* a, mat3x3* b), (a, b)) \
+  F(bool, mat3x3_equalid, (mat3x3* m), (m)) \
+  F(float, mat3x3_get, (unsigned int col, unsigned int row, mat3x3* m), (col, row, m)) \
+  F(mat3x3, mat3x3_add, (mat3x3* a, mat3x3* b), (a, b)) \
+  F(mat3x3, mat3x3_sub, (mat3x3* a, mat3x3* b), (a, b)) \
+  F(mat3x3, mat3x3_scale, (mat3x3* m, float s), (m, s)) \
+  F(mat3x3, mat3x3_mul, (mat3x3* a, mat3x3* b), (a, b)) \
+  P(mat3x3_mul_n, (mat3x3* dst, mat3x3* a, mat3x3* b, size_t count), (dst, a, b, count)) \
+  F(vec3, mat3x3_vec3_mul, (mat3x3* m, vec3* v), (m, v)) \
+  F(mat3x3, mat3x3_transpose, (mat3x3* m), (m)) \
+  F(float, mat3x3_det, (mat3x3* m), (m)) \
+  F(mat3x3, mat3x3_inverse, (mat3x3* m), (m)) \
+  F(mat3x3, mat3x3_inverse_rigid, (mat3x3* m), (m)) \
+  F(mat3x3, mat3x3_addv, (mat3x3 a, mat3x3 b), (a, b)) \
+  F(mat3x3, mat3x3_subv, (mat3x3 a, mat3x3 b), (a, b)) \
+  F(mat3x3, mat3x3_scalev, (mat3x3 m, float s), (m, s)) \
+  F(mat3x3, mat3x3_mulv, (mat3x3 a, mat3x3 b), (a, b)) \
+  F(vec3, mat3x3_vec3_mulv, (mat3x3 m, vec3 v), (m, v)) \
+  F(mat3x3, mat3x3_transposev, (mat3x3 m), (m)) \
+  F(float, mat3x3_detv, (mat3x3 m), (m)) \
+  F(mat3x3, mat3x3_inversev, (mat3x3 m), (m)) \
+  F(mat3x3, mat3x3_inverse_rigidv, (mat3x3 m), (m)) \
+  P(mat3x3_add_to, (mat3x3* dst, mat3x3* a, mat3x3* b), (dst, a, b)) \
+  P(mat3x3_sub_to, (mat3x3* dst, mat3x3* a, mat3x3* b), (dst, a, b)) \
+  P(mat3x3_scale_to, (mat3x3* dst, mat3x3* m, float s), (dst, m, s)) \
+  P(mat3x3_mul_to, (mat3x3* dst, mat3x3* a, mat3x3* b), (dst, a, b)) \
+  P(mat3x3_vec3_mul_to, (vec3* dst, mat3x3* m, vec3* v), (dst, m, v)) \
+  P(mat3x3_transpose_to, (mat3x3* dst, mat3x3* m), (dst, m)) \
+  P(mat3x3_inverse_to, (mat3x3* dst, mat3x3* m), (dst, m)) \
+  P(mat3x3_inverse_rigid_to, (mat3x3* dst, mat3x3* m), (dst, m)) \
+  /* mat4x4 */ \
+  F(mat4x4, mat4x4_make, (float x1, float y1, float z1, float w1, float x2, float y2, float z2, float w2, float x3, float y3, float z3, float w3, float x4, float y4, float z4, float w4), (x1, y1, z1, w1, x2, y2, z2, w2, x3, y3, z3, w3, x4, y4, z4, w4)) \
+  F(mat4x4, mat4x4_makeid, (), ()) \
+  F(bool, mat4x4_equal, (mat4x4* a, mat4x4* b), (a, b)) \
+  F(bool, mat4x4_equalid, (mat4x4* m), (m)) \
+  F(float, mat4x4_get, (unsigned int col, unsigned int row, mat4x4* m), (col, row, m)) \
+  F(mat4x4, mat4x4_add, (mat4x4* a, mat4x4* b), (a, b)) \
+  F(mat4x4, mat4x4_sub, (mat4x4* a, mat4x4* b), (a, b)) \
+  F(mat4x4, mat4x4_scale, (mat4x4* m, float s), (m, s)) \
+  F(mat4x4, mat4x4_mul, (mat4x4* a, mat4x4* b), (a, b)) \
+  F(vec4, mat4x4_vec4_mul, (mat4x4* m, vec4* v), (m, v)) \
+  P(mat4x4_transform_vec4_array, (vec4* dst, mat4x4* m, vec4* src, size_t count), (dst, m, src, count)) \
+  F(mat4x4, mat4x4_transpose, (mat4x4* m), (m)) \
+  F(float, mat4x4_det, (mat4x4* m), (m)) \
+  F(mat4x4, mat4x4_inverse, (mat4x4* m), (m)) \
+  F(mat4x4, mat4x4_inverse_rigid, (mat4x4* m), (m)) \
+  F(mat4x4, mat4x4_addv, (mat4x4 a, mat4x4 b), (a, b)) \
+  F(mat4x4, mat4x4_subv, (mat4x4 a, mat4x4 b), (a, b)) \
+  F(mat4x4, mat4x4_scalev, (mat4x4 m, float s), (m, s)) \
+  F(mat4x4, mat4x4_mulv, (mat4x4 a, mat4x4 b), (a, b)) \
+  F(vec4, mat4x4_vec4_mulv, (mat4x4 m, vec4 v), (m, v)) \
+  F(mat4x4, mat4x4_transposev, (mat4x4 m), (m)) \
+  F(float, mat4x4_detv, (mat4x4 m), (m)) \
+  F(mat4x4, mat4x4_inversev, (mat4x4 m), (m)) \
+  F(mat4x4, mat4x4_inverse_rigidv, (mat4x4 m), (m)) \
+  P(mat4x4_add_to, (mat4x4* dst, mat4x4* a, mat4x4* b), (dst, a, b)) \
+  P(mat4x4_sub_to, (mat4x4* dst, mat4x4* a, mat4x4* b), (dst, a, b)) \
+  P(mat4x4_scale_to, (mat4x4* dst, mat4x4* m, float s), (dst, m, s)) \
+  P(mat4x4_mul_to, (mat4x4* dst, mat4x4* a, mat4x4* b), (dst, a, b)) \
+  P(mat4x4_vec4_mul_to, (vec4* dst, mat4x4* m, vec4* v), (dst, m, v)) \
+  P(mat4x4_transpose_to, (mat4x4* dst, mat4x4* m), (dst, m)) \
+  P(mat4x4_inverse_to, (mat4x4* dst, mat4x4* m), (dst, m)) \
+  P(mat4x4_inverse_rigid_to, (mat4x4* dst, mat4x4* m), (dst, m)) \
+  /* vec3_soa */ \
+  F(vec3_soa, vec3_soa_make, (size_t count), (count)) \
+  P(vec3_soa_free, (vec3_soa* s), (s)) \
+  F(vec3, vec3_soa_get, (vec3_soa* s, size_t i), (s, i)) \
+  P(vec3_soa_set, (vec3_soa* s, size_t i, vec3* v), (s, i, v)) \
+  P(vec3_soa_add, (vec3_soa* dst, vec3_soa* a, vec3_soa* b), (dst, a, b)) \
+  P(vec3_soa_sub, (vec3_soa* dst, vec3_soa* a, vec3_soa* b), (dst, a, b)) \
+  P(vec3_soa_mul, (vec3_soa* dst, vec3_soa* a, vec3_soa* b), (dst, a, b)) \
+  P(vec3_soa_div, (vec3_soa* dst, vec3_soa* a, vec3_soa* b), (dst, a, b)) \
+  P(vec3_soa_mag, (float* dst, vec3_soa* v), (dst, v)) \
+  P(vec3_soa_scale, (vec3_soa* dst, vec3_soa* a, float s), (dst, a, s)) \
+  P(vec3_soa_norm, (vec3_soa* dst, vec3_soa* v), (dst, v)) \
+  P(vec3_soa_dist, (float* dst, vec3_soa* a, vec3_soa* b), (dst, a, b)) \
+  /* vec4_soa */ \
+  F(vec4_soa, vec4_soa_make, (size_t count), (count)) \
+  P(vec4_soa_free, (vec4_soa* s), (s)) \
+  F(vec4, vec4_soa_get, (vec4_soa* s, size_t i), (s, i)) \
+  P(vec4_soa_set, (vec4_soa* s, size_t i, vec4* v), (s, i, v)) \
+  P(vec4_soa_add, (vec4_soa* dst, vec4_soa* a, vec4_soa* b), (dst, a, b)) \
+  P(vec4_soa_sub, (vec4_soa* dst, vec4_soa* a, vec4_soa* b), (dst, a, b)) \
+  P(vec4_soa_mul, (vec4_soa* dst, vec4_soa* a, vec4_soa* b), (dst, a, b)) \
+  P(vec4_soa_div, (vec4_soa* dst, vec4_soa* a, vec4_soa* b), (dst, a, b)) \
+  P(vec4_soa_mag, (float* dst, vec4_soa* v), (dst, v)) \
+  P(vec4_soa_scale, (vec4_soa* dst, vec4_soa* a, float s), (dst, a, s)) \
+  P(vec4_soa_norm, (vec4_soa* dst, vec4_soa* v), (dst, v)) \
+  P(vec4_soa_dist, (float* dst, vec4_soa* a, vec4_soa* b), (dst, a, b)) \
+  /* mat3x3_soa */ \
+  F(mat3x3_soa, mat3x3_soa_make, (size_t count), (count)) \
+  P(mat3x3_soa_free, (mat3x3_soa* s), (s)) \
+  F(mat3x3, mat3x3_soa_get, (mat3x3_soa* s, size_t i), (s, i)) \
+  P(mat3x3_soa_set, (mat3x3_soa* s, size_t i, mat3x3* m), (s, i, m)) \
+  P(mat3x3_soa_det, (float* dst, mat3x3_soa* m), (dst, m)) \
+  P(mat3x3_soa_inverse, (mat3x3_soa* dst, mat3x3_soa* src), (dst, src)) \
+  P(mat3x3_soa_inverse_rigid, (mat3x3_soa* dst, mat3x3_soa* src), (dst, src)) \
+  /* mat4x4_soa */ \
+  F(mat4x4_soa, mat4x4_soa_make, (size_t count), (count)) \
+  P(mat4x4_soa_free, (mat4x4_soa* s), (s)) \
+  F(mat4x4, mat4x4_soa_get, (mat4x4_soa* s, size_t i), (s, i)) \
+  P(mat4x4_soa_set, (mat4x4_soa* s, size_t i, mat4x4* m), (s, i, m)) \
+  P(mat4x4_soa_det, (float* dst, mat4x4_soa* m), (dst, m)) \
+  P(mat4x4_soa_inverse, (mat4x4_soa* dst, mat4x4_soa* src), (dst, src)) \
+  P(mat4x4_soa_inverse_rigid, (mat4x4_soa* dst, mat4x4_soa* src), (dst, src))
+
+
+/* Dispatch table */
+#define __CAM_LINEAR_FIELD_F(ret, name, params, args) ret (*name) params;
+#define __CAM_LINEAR_FIELD_P(name, params, args) void (*name) params;
+
+typedef struct {
+  CAM_LINEAR_FUNCTIONS(__CAM_LINEAR_FIELD_F, __CAM_LINEAR_FIELD_P)
+} cam_linear_table;
+
+// One table per tier, each defined by the matching linear_<tier>.c
+extern const cam_linear_table __cam_linear_scalar;
+extern const cam_linear_table __cam_linear_sse41;
+extern const cam_linear_table __cam_linear_avx2;
+
+// Points the public functions at the table for the given tier
+void __cam_linear_bind(cam_tier tier);
+
+// Binds the best tier for this CPU, lowered by CAM_SIMD_TIER (defined in cpu.c)
+void __cam_cpu_init();
+
+#endif
@@ -0,0 +1,8 @@
+/*
+ * linear_scalar.c
+ * Portable build of the linear algebra functions for runtime dispatch.
+ */
+
+#define CAM_LINEAR_TIER_SCALAR
+#define CAM_LINEAR_TIER_TABLE __cam_linear_scalar
+#include "linear_tier.h"
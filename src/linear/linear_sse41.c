@@ -0,0 +1,8 @@
+/*
+ * linear_sse41.c
+ * SSE4.1 build of the linear algebra functions for runtime dispatch.
+ */
+
+#define CAM_LINEAR_TIER_SSE41
+#define CAM_LINEAR_TIER_TABLE __cam_linear_sse41
+#include "linear_tier.h"
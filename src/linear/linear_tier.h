@@ -0,0 +1,37 @@
+/*
+ * linear_tier.h
+ * Compiles every linear algebra function for one SIMD tier and collects them into a
+ * dispatch table. Included by linear_scalar.c, linear_sse41.c and linear_avx2.c, which
+ * are built with the matching instruction set flags and name the table to define.
+ */
+
+// Internal linkage lets every tier reuse the public function names
+#define CAM_LINEAR_API static
+#include "cam/linear/linear.h"
+#include "linear_dispatch.h"
+
+#if defined(CAM_LINEAR_TIER_SCALAR)
+// Keep the SSE storage layout shared by every tier but take the portable code paths,
+// which index the __m128 members element-wise (a GCC/Clang vector extension)
+#undef CAM_SIMD_AVX
+#undef CAM_SIMD_AVX2
+#define CAM_SIMD_NONE
+#endif
+
+#include "cam/linear/vec2.inl"
+#include "cam/linear/vec3.inl"
+#include "cam/linear/vec4.inl"
+#include "cam/linear/mat2x2.inl"
+#include "cam/linear/mat3x3.inl"
+#include "cam/linear/mat4x4.inl"
+#include "cam/linear/vec3_soa.inl"
+#include "cam/linear/vec4_soa.inl"
+#include "cam/linear/mat3x3_soa.inl"
+#include "cam/linear/mat4x4_soa.inl"
+
+#define __CAM_LINEAR_ENTRY_F(ret, name, params, args) name,
+#define __CAM_LINEAR_ENTRY_P(name, params, args) name,
+
+const cam_linear_table CAM_LINEAR_TIER_TABLE = {
+  CAM_LINEAR_FUNCTIONS(__CAM_LINEAR_ENTRY_F, __CAM_LINEAR_ENTRY_P)
+};
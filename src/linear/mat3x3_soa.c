@@ -0,0 +1,7 @@
+/*
+ * mat3x3_soa.c
+ * Declaration for batches of 3x3 float matrices in structure-of-arrays order.
+ */
+
+#include "cam/linear/mat3x3_soa.h"
+#include "cam/linear/mat3x3_soa.inl"
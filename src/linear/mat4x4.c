@@ -0,0 +1,7 @@
+/*
+ * mat4x4.c
+ * Declaration for 4x4 matrix of floats in column-major order.
+ */
+
+#include "cam/linear/mat4x4.h"
+#include "cam/linear/mat4x4.inl"
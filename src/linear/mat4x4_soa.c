@@ -0,0 +1,7 @@
+/*
+ * mat4x4_soa.c
+ * Declaration for batches of 4x4 float matrices in structure-of-arrays order.
+ */
+
+#include "cam/linear/mat4x4_soa.h"
+#include "cam/linear/mat4x4_soa.inl"
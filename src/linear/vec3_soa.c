@@ -0,0 +1,7 @@
+/*
+ * vec3_soa.c
+ * Declaration for batches of 3D float vectors in structure-of-arrays order.
+ */
+
+#include "cam/linear/vec3_soa.h"
+#include "cam/linear/vec3_soa.inl"
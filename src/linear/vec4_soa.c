@@ -0,0 +1,7 @@
+/*
+ * vec4_soa.c
+ * Declaration for batches of 4D float vectors in structure-of-arrays order.
+ */
+
+#include "cam/linear/vec4_soa.h"
+#include "cam/linear/vec4_soa.inl"
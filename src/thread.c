@@ -0,0 +1,192 @@
+/*
+ * thread.c
+ * Worker thread pool shared by the parallel functions of the library.
+ */
+
+#include "cam/thread.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef SRWLOCK __pool_lock;
+typedef CONDITION_VARIABLE __pool_cond;
+typedef HANDLE __pool_handle;
+#define __POOL_LOCK_INIT SRWLOCK_INIT
+#define __POOL_COND_INIT CONDITION_VARIABLE_INIT
+#define __pool_lock(l) AcquireSRWLockExclusive(l)
+#define __pool_unlock(l) ReleaseSRWLockExclusive(l)
+#define __pool_wait(c, l) SleepConditionVariableSRW(c, l, INFINITE, 0)
+#define __pool_signal(c) WakeConditionVariable(c)
+#define __pool_broadcast(c) WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_mutex_t __pool_lock;
+typedef pthread_cond_t __pool_cond;
+typedef pthread_t __pool_handle;
+#define __POOL_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define __POOL_COND_INIT PTHREAD_COND_INITIALIZER
+#define __pool_lock(l) pthread_mutex_lock(l)
+#define __pool_unlock(l) pthread_mutex_unlock(l)
+#define __pool_wait(c, l) pthread_cond_wait(c, l)
+#define __pool_signal(c) pthread_cond_signal(c)
+#define __pool_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+// Ranges handed out per thread on average, trading balance against locking
+#define __POOL_CHUNKS 8
+
+/* Pool state, all guarded by __pool_mutex */
+static __pool_lock __pool_mutex = __POOL_LOCK_INIT;
+static __pool_cond __pool_wake = __POOL_COND_INIT;   // A job was posted or the pool is stopping
+static __pool_cond __pool_done = __POOL_COND_INIT;   // The last worker left a job
+static __pool_handle __pool_workers[CAM_MAX_THREADS];
+static int __pool_count = 0;      // Configured thread count, 0 until first use
+static int __pool_started = 0;    // Workers running, at most __pool_count - 1
+static bool __pool_stop = false;
+static bool __pool_busy = false;  // A job is running
+
+// The posted job; every worker joins each generation once and leaves by
+// decrementing __pool_active
+static unsigned long __pool_generation = 0;
+static void (*__pool_fn)(void*, size_t, size_t);
+static void* __pool_arg;
+static size_t __pool_total;
+static size_t __pool_chunk;
+static size_t __pool_next;
+static int __pool_active;
+
+static int __pool_default() {
+  const char* env = getenv("CAM_THREADS");
+  if (env && atoi(env) > 0) { return atoi(env); }
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (int)info.dwNumberOfProcessors;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0) ? (int)n : 1;
+#endif
+}
+
+static int __pool_clamp(int count) {
+  if (count < 1) { return 1; }
+  return (count > CAM_MAX_THREADS) ? CAM_MAX_THREADS : count;
+}
+
+// Takes ranges of the posted job until none are left. Called with the lock held.
+static void __pool_run() {
+  while (__pool_next < __pool_total) {
+    size_t begin = __pool_next;
+    size_t end = begin + __pool_chunk;
+    if (end > __pool_total) { end = __pool_total; }
+    __pool_next = end;
+    __pool_unlock(&__pool_mutex);
+    __pool_fn(__pool_arg, begin, end);
+    __pool_lock(&__pool_mutex);
+  }
+}
+
+// Workers start out having seen the generation before the job that started them
+#if defined(_WIN32)
+static DWORD WINAPI __pool_main(LPVOID born) {
+#else
+static void* __pool_main(void* born) {
+#endif
+  unsigned long seen = (unsigned long)(uintptr_t)born;
+  __pool_lock(&__pool_mutex);
+  for (;;) {
+    while (seen == __pool_generation && !__pool_stop) {
+      __pool_wait(&__pool_wake, &__pool_mutex);
+    }
+    if (__pool_stop) { break; }
+    seen = __pool_generation;
+    __pool_run();
+    if (--__pool_active == 0) { __pool_signal(&__pool_done); }
+  }
+  __pool_unlock(&__pool_mutex);
+  return 0;
+}
+
+// Starts workers up to the configured count. Called with the lock held.
+static void __pool_start() {
+  void* born = (void*)(uintptr_t)__pool_generation;
+  while (__pool_started < __pool_count - 1) {
+#if defined(_WIN32)
+    HANDLE h = CreateThread(NULL, 0, __pool_main, born, 0, NULL);
+    if (!h) { break; }
+#else
+    pthread_t h;
+    if (pthread_create(&h, NULL, __pool_main, born) != 0) { break; }
+#endif
+    __pool_workers[__pool_started++] = h;
+  }
+}
+
+// Joins every worker. Called without the lock held.
+static void __pool_join() {
+  __pool_lock(&__pool_mutex);
+  __pool_stop = true;
+  __pool_broadcast(&__pool_wake);
+  int started = __pool_started;
+  __pool_unlock(&__pool_mutex);
+  for (int i = 0; i < started; ++i) {
+#if defined(_WIN32)
+    WaitForSingleObject(__pool_workers[i], INFINITE);
+    CloseHandle(__pool_workers[i]);
+#else
+    pthread_join(__pool_workers[i], NULL);
+#endif
+  }
+  __pool_lock(&__pool_mutex);
+  __pool_started = 0;
+  __pool_stop = false;
+  __pool_unlock(&__pool_mutex);
+}
+
+int cam_get_threads() {
+  __pool_lock(&__pool_mutex);
+  if (__pool_count == 0) { __pool_count = __pool_clamp(__pool_default()); }
+  int count = __pool_count;
+  __pool_unlock(&__pool_mutex);
+  return count;
+}
+
+int cam_set_threads(int count) {
+  __pool_join();
+  count = __pool_clamp((count > 0) ? count : __pool_default());
+  __pool_lock(&__pool_mutex);
+  __pool_count = count;
+  __pool_unlock(&__pool_mutex);
+  return count;
+}
+
+void cam_parallel_for(size_t count, void (*fn)(void* arg, size_t begin, size_t end), void* arg) {
+  if (count == 0) { return; }
+  __pool_lock(&__pool_mutex);
+  if (__pool_count == 0) { __pool_count = __pool_clamp(__pool_default()); }
+  if (__pool_busy || __pool_count == 1 || count == 1) {
+    // Nested, concurrent or serial: no workers
+    __pool_unlock(&__pool_mutex);
+    fn(arg, 0, count);
+    return;
+  }
+  __pool_start();
+  __pool_busy = true;
+  __pool_fn = fn;
+  __pool_arg = arg;
+  __pool_total = count;
+  __pool_chunk = count / ((size_t)(__pool_started + 1) * __POOL_CHUNKS);
+  if (__pool_chunk == 0) { __pool_chunk = 1; }
+  __pool_next = 0;
+  __pool_active = __pool_started;
+  ++__pool_generation;
+  __pool_broadcast(&__pool_wake);
+
+  __pool_run();
+  while (__pool_active > 0) {
+    __pool_wait(&__pool_done, &__pool_mutex);
+  }
+  __pool_busy = false;
+  __pool_unlock(&__pool_mutex);
+}
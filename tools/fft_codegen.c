@@ -0,0 +1,388 @@
+/*
+ * fft_codegen.c
+ * Build time generator of the straight-line FFT codelets in fft_codelets.inl.
+ * Usage: fft_codegen <output file> <largest size>
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI 3.14159265358979323846
+
+/* Expression graph */
+// Every real value of a codelet is a node: an input component, or an operation on
+// earlier nodes. Nodes are made once per distinct expression and folded where a
+// constant makes them trivial, so the emitted code has no multiplications by 0 or 1
+// and no repeated subexpressions.
+
+typedef enum { OP_ZERO, OP_LOAD, OP_ADD, OP_SUB, OP_NEG, OP_MUL } op;
+
+typedef struct {
+  op kind;
+  int a, b;        // Operands, or for OP_LOAD the index and 0 / 1 for re / im
+  double k;        // Constant factor of OP_MUL
+  int uses;
+  bool fused;      // OP_MUL folded into the add or subtract using it
+} node;
+
+typedef struct {
+  int re, im;
+} cnode;
+
+#define HASH_SIZE (1 << 16)   // Open addressing table of node indices, larger than any codelet
+
+static node* nodes = NULL;
+static int count = 0, capacity = 0;
+static int table[HASH_SIZE];
+
+static unsigned hash(op kind, int a, int b, double k) {
+  unsigned long long bits;
+  memcpy(&bits, &k, sizeof(bits));
+  unsigned long long h = ((unsigned long long)kind * 0x9e3779b97f4a7c15ull) ^ ((unsigned long long)a * 0xc2b2ae3d27d4eb4full) ^
+    ((unsigned long long)b * 0x165667b19e3779f9ull) ^ (bits * 0x27d4eb2f165667c5ull);
+  return (unsigned)(h ^ (h >> 29)) & (HASH_SIZE - 1);
+}
+
+static int make(op kind, int a, int b, double k) {
+  unsigned h = hash(kind, a, b, k);
+  for (; table[h] >= 0; h = (h + 1) & (HASH_SIZE - 1)) {
+    node* e = &nodes[table[h]];
+    if (e->kind == kind && e->a == a && e->b == b && e->k == k) { return table[h]; }
+  }
+  if (count == capacity) {
+    capacity = capacity ? 2 * capacity : 1024;
+    nodes = (node*)realloc(nodes, capacity * sizeof(node));
+  }
+  if (!nodes || count >= HASH_SIZE / 2) {
+    fprintf(stderr, "fft_codegen: codelet too large\n");
+    exit(1);
+  }
+  node n = { kind, a, b, k, 0, false };
+  nodes[count] = n;
+  table[h] = count;
+  return count++;
+}
+
+static int zero() { return make(OP_ZERO, 0, 0, 0.0); }
+
+static int neg(int a) {
+  if (nodes[a].kind == OP_ZERO) { return a; }
+  if (nodes[a].kind == OP_NEG) { return nodes[a].a; }
+  return make(OP_NEG, a, 0, 0.0);
+}
+
+static int add(int a, int b) {
+  if (nodes[a].kind == OP_ZERO) { return b; }
+  if (nodes[b].kind == OP_ZERO) { return a; }
+  if (nodes[b].kind == OP_NEG) { return make(OP_SUB, a, nodes[b].a, 0.0); }
+  if (nodes[a].kind == OP_NEG) { return make(OP_SUB, b, nodes[a].a, 0.0); }
+  return (a < b) ? make(OP_ADD, a, b, 0.0) : make(OP_ADD, b, a, 0.0);
+}
+
+static int sub(int a, int b) {
+  if (nodes[b].kind == OP_ZERO) { return a; }
+  if (nodes[a].kind == OP_ZERO) { return neg(b); }
+  if (nodes[b].kind == OP_NEG) { return add(a, nodes[b].a); }
+  if (nodes[a].kind == OP_NEG) { return neg(add(nodes[a].a, b)); }
+  return make(OP_SUB, a, b, 0.0);
+}
+
+// a k, with constants within rounding of 0 or +-1 taken as exact
+static int mul(int a, double k) {
+  if (fabs(k) < 1e-15 || nodes[a].kind == OP_ZERO) { return zero(); }
+  if (fabs(k - 1.0) < 1e-15) { return a; }
+  if (fabs(k + 1.0) < 1e-15) { return neg(a); }
+  if (k < 0.0) { return neg(mul(a, -k)); }
+  if (nodes[a].kind == OP_NEG) { return neg(mul(nodes[a].a, k)); }
+  return make(OP_MUL, a, 0, k);
+}
+
+static cnode cadd(cnode a, cnode b) { cnode r = { add(a.re, b.re), add(a.im, b.im) }; return r; }
+static cnode csub(cnode a, cnode b) { cnode r = { sub(a.re, b.re), sub(a.im, b.im) }; return r; }
+
+// a -i, the forward rotation
+static cnode crot(cnode a) { cnode r = { a.im, neg(a.re) }; return r; }
+
+// a (c + i s)
+static cnode cmul(cnode a, double c, double s) {
+  cnode r = { sub(mul(a.re, c), mul(a.im, s)), add(mul(a.re, s), mul(a.im, c)) };
+  return r;
+}
+
+// a e^(-2 pi i t / n), reducing t to the octant so the eighth roots come out exact
+static cnode twiddle(cnode a, long t, long n) {
+  t %= n;
+  if (t == 0) { return a; }
+  if (4 * t == n) { return crot(a); }
+  if (2 * t == n) { cnode r = { neg(a.re), neg(a.im) }; return r; }
+  if (4 * t == 3 * n) { cnode r = { neg(a.im), a.re }; return r; }
+  if (8 * t == n || 8 * t == 3 * n || 8 * t == 5 * n || 8 * t == 7 * n) {
+    // (1 - i) / sqrt(2) turned by a multiple of -i
+    double h = sqrt(0.5);
+    cnode r = { mul(add(a.re, a.im), h), mul(sub(a.im, a.re), h) };
+    for (long q = 1; q < (8 * t) / n; q += 2) { r = crot(r); }
+    return r;
+  }
+  double angle = -2.0 * PI * (double)t / (double)n;
+  return cmul(a, cos(angle), sin(angle));
+}
+
+
+/* Transforms */
+// Decimation in time: n = r m splits into r transforms of m points over the inputs
+// q, q + r, q + 2r, ..., whose outputs are twiddled and combined by r point
+// transforms. r is 4 where it divides n, then 2, then the smallest prime factor,
+// the same order as the mixed-radix passes.
+
+static void dft(cnode* x, long n, cnode* y);
+
+// p point transform of x into y for prime p, pairing x_m with x_(p - m)
+static void dft_prime(cnode* x, long p, cnode* y) {
+  long s = (p - 1) / 2;
+  cnode* a = (cnode*)malloc(s * sizeof(cnode));
+  cnode* d = (cnode*)malloc(s * sizeof(cnode));
+  cnode y0 = x[0];
+  for (long m = 1; m <= s; ++m) {
+    a[m - 1] = cadd(x[m], x[p - m]);
+    d[m - 1] = csub(x[m], x[p - m]);
+    y0 = cadd(y0, a[m - 1]);
+  }
+  for (long k = 1; k <= s; ++k) {
+    cnode c = x[0];
+    cnode t = { zero(), zero() };
+    for (long m = 1; m <= s; ++m) {
+      double angle = 2.0 * PI * (double)((k * m) % p) / (double)p;
+      c.re = add(c.re, mul(a[m - 1].re, cos(angle)));
+      c.im = add(c.im, mul(a[m - 1].im, cos(angle)));
+      t.re = add(t.re, mul(d[m - 1].re, sin(angle)));
+      t.im = add(t.im, mul(d[m - 1].im, sin(angle)));
+    }
+    y[k] = cadd(c, crot(t));
+    y[p - k] = csub(c, crot(t));
+  }
+  y[0] = y0;
+  free(a);
+  free(d);
+}
+
+static long radix(long n) {
+  if (n % 4 == 0 && n > 4) { return 4; }
+  if (n % 2 == 0 && n > 2) { return 2; }
+  for (long r = 3; r * r <= n; r += 2) {
+    if (n % r == 0) { return r; }
+  }
+  return n;
+}
+
+static void dft(cnode* x, long n, cnode* y) {
+  if (n == 1) {
+    y[0] = x[0];
+    return;
+  }
+  if (n == 2) {
+    y[0] = cadd(x[0], x[1]);
+    y[1] = csub(x[0], x[1]);
+    return;
+  }
+  if (n == 4) {
+    cnode s0 = cadd(x[0], x[2]), d0 = csub(x[0], x[2]);
+    cnode s1 = cadd(x[1], x[3]), d1 = crot(csub(x[1], x[3]));
+    y[0] = cadd(s0, s1);
+    y[1] = cadd(d0, d1);
+    y[2] = csub(s0, s1);
+    y[3] = csub(d0, d1);
+    return;
+  }
+  long r = radix(n);
+  if (r == n) {
+    dft_prime(x, n, y);
+    return;
+  }
+
+  long m = n / r;
+  cnode* in = (cnode*)malloc(n * sizeof(cnode));
+  cnode* sub_out = (cnode*)malloc(n * sizeof(cnode));
+  cnode* v = (cnode*)malloc(r * sizeof(cnode));
+  cnode* w = (cnode*)malloc(r * sizeof(cnode));
+  for (long q = 0; q < r; ++q) {
+    for (long j = 0; j < m; ++j) { in[(q * m) + j] = x[q + (r * j)]; }
+    dft(in + (q * m), m, sub_out + (q * m));
+  }
+  for (long k = 0; k < m; ++k) {
+    for (long q = 0; q < r; ++q) { v[q] = twiddle(sub_out[(q * m) + k], q * k, n); }
+    dft(v, r, w);
+    for (long q = 0; q < r; ++q) { y[k + (q * m)] = w[q]; }
+  }
+  free(in);
+  free(sub_out);
+  free(v);
+  free(w);
+}
+
+
+/* Emission */
+// Codelets are written against macros the including file defines, so one graph
+// serves every element type: __cl_t, __cl_load, __cl_store, __cl_add, __cl_sub,
+// __cl_neg, __cl_mul (by a constant), __cl_fma (a k + b), __cl_fms (a k - b) and
+// __cl_fnma (b - a k).
+
+static void count_uses(const cnode* out, long n) {
+  for (int i = 0; i < count; ++i) {
+    nodes[i].uses = 0;
+    nodes[i].fused = false;
+  }
+  for (int i = 0; i < count; ++i) {
+    node* e = &nodes[i];
+    if (e->kind == OP_ADD || e->kind == OP_SUB) {
+      ++nodes[e->a].uses;
+      ++nodes[e->b].uses;
+    }
+    else if (e->kind == OP_NEG || e->kind == OP_MUL) {
+      ++nodes[e->a].uses;
+    }
+  }
+  for (long k = 0; k < n; ++k) {
+    ++nodes[out[k].re].uses;
+    ++nodes[out[k].im].uses;
+  }
+}
+
+// Whether node i is a product used only by one add or subtract, which takes it in
+static bool fusable(int i) {
+  return nodes[i].kind == OP_MUL && nodes[i].uses == 1;
+}
+
+static void emit_value(FILE* f, const cnode* out, long n) {
+  // Only nodes reachable from the outputs are emitted: folding can orphan some
+  bool* live = (bool*)calloc(count, sizeof(bool));
+  for (long k = 0; k < n; ++k) {
+    live[out[k].re] = true;
+    live[out[k].im] = true;
+  }
+  for (int i = count - 1; i >= 0; --i) {
+    if (!live[i]) { continue; }
+    node* e = &nodes[i];
+    if (e->kind == OP_ADD || e->kind == OP_SUB) {
+      live[e->a] = true;
+      live[e->b] = true;
+    }
+    else if (e->kind == OP_NEG || e->kind == OP_MUL) {
+      live[e->a] = true;
+    }
+  }
+  count_uses(out, n);
+  for (int i = 0; i < count; ++i) {
+    node* e = &nodes[i];
+    if (!live[i]) { continue; }
+    if ((e->kind == OP_ADD || e->kind == OP_SUB) && fusable(e->a)) { nodes[e->a].fused = true; }
+    else if ((e->kind == OP_ADD || e->kind == OP_SUB) && fusable(e->b)) { nodes[e->b].fused = true; }
+  }
+
+  for (int i = 0; i < count; ++i) {
+    node* e = &nodes[i];
+    if (!live[i] || e->fused) { continue; }
+    switch (e->kind) {
+      case OP_ZERO:
+        // Every output of a transform depends on the inputs
+        fprintf(stderr, "fft_codegen: constant output\n");
+        exit(1);
+      case OP_LOAD:
+        fprintf(f, "  __cl_t t%d = __cl_load(x%s + (%d * is));\n", i, e->b ? "i" : "r", e->a);
+        break;
+      case OP_NEG:
+        fprintf(f, "  __cl_t t%d = __cl_neg(t%d);\n", i, e->a);
+        break;
+      case OP_MUL:
+        fprintf(f, "  __cl_t t%d = __cl_mul(t%d, %.9ef);\n", i, e->a, e->k);
+        break;
+      case OP_ADD:
+      case OP_SUB: {
+        const node* a = &nodes[e->a];
+        const node* b = &nodes[e->b];
+        if (a->fused) {
+          fprintf(f, "  __cl_t t%d = __cl_%s(t%d, %.9ef, t%d);\n", i, (e->kind == OP_ADD) ? "fma" : "fms", a->a, a->k, e->b);
+        }
+        else if (b->fused) {
+          fprintf(f, "  __cl_t t%d = __cl_%s(t%d, %.9ef, t%d);\n", i, (e->kind == OP_ADD) ? "fma" : "fnma", b->a, b->k, e->a);
+        }
+        else {
+          fprintf(f, "  __cl_t t%d = __cl_%s(t%d, t%d);\n", i, (e->kind == OP_ADD) ? "add" : "sub", e->a, e->b);
+        }
+        break;
+      }
+    }
+  }
+  // Stores come last, so dst may be src
+  for (long k = 0; k < n; ++k) {
+    fprintf(f, "  __cl_store(yr + (%ld * os), t%d);\n", k, out[k].re);
+    fprintf(f, "  __cl_store(yi + (%ld * os), t%d);\n", k, out[k].im);
+  }
+  free(live);
+}
+
+static void emit(FILE* f, long n) {
+  count = 0;
+  memset(table, 0xff, sizeof(table));
+  cnode* x = (cnode*)malloc(n * sizeof(cnode));
+  cnode* y = (cnode*)malloc(n * sizeof(cnode));
+  for (long k = 0; k < n; ++k) {
+    x[k].re = make(OP_LOAD, (int)k, 0, 0.0);
+    x[k].im = make(OP_LOAD, (int)k, 1, 0.0);
+  }
+  dft(x, n, y);
+
+  fprintf(f, "static void __CL_FN(%ld)(const float* xr, const float* xi, float* yr, float* yi, size_t is, size_t os) {\n", n);
+  emit_value(f, y, n);
+  fprintf(f, "}\n\n");
+  free(x);
+  free(y);
+}
+
+// Sizes the codelets cover: those whose prime factors are all 2, 3, 5 or 7. A prime p
+// takes about p^2 / 2 operations, and larger primes would grow the library for sizes
+// Bluestein's algorithm already covers.
+static bool smooth(long n) {
+  static const long primes[] = { 2, 3, 5, 7 };
+  for (int i = 0; i < 4; ++i) {
+    while (n % primes[i] == 0) { n /= primes[i]; }
+  }
+  return n == 1;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3 || atol(argv[2]) < 2) {
+    fprintf(stderr, "usage: fft_codegen <output file> <largest size>\n");
+    return 1;
+  }
+  long max = atol(argv[2]);
+  FILE* f = fopen(argv[1], "w");
+  if (!f) {
+    fprintf(stderr, "fft_codegen: cannot write %s\n", argv[1]);
+    return 1;
+  }
+
+  fprintf(f, "/*\n * fft_codelets.inl\n * Straight-line FFT codelets of 2 to %ld points whose prime factors are at most 7,\n * generated by tools/fft_codegen.c.\n", max);
+  fprintf(f, " * Included by fft.inl once per element type, with the __cl_* macros defined.\n */\n\n");
+  fprintf(f, "#define __CL_MAX %ld\n\n", max);
+  for (long n = 2; n <= max; ++n) {
+    if (smooth(n)) { emit(f, n); }
+  }
+
+  fprintf(f, "static void (* const __CL_TABLE[__CL_MAX + 1])(const float*, const float*, float*, float*, size_t, size_t) = {\n");
+  fprintf(f, "  NULL, NULL");
+  for (long n = 2; n <= max; ++n) {
+    if (smooth(n)) { fprintf(f, ",%s__CL_FN(%ld)", (n % 8 == 0) ? "\n  " : " ", n); }
+    else { fprintf(f, ",%sNULL", (n % 8 == 0) ? "\n  " : " "); }
+  }
+  fprintf(f, "\n};\n\n#undef __CL_MAX\n");
+
+  if (fclose(f) != 0) {
+    fprintf(stderr, "fft_codegen: cannot write %s\n", argv[1]);
+    return 1;
+  }
+  free(nodes);
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * tanh_sinh_gen.c
+ * Build time generator of the tanh-sinh quadrature node tables in tanh_sinh_tables.inl.
+ * Usage: tanh_sinh_gen <output file>
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Keep in step with __TS_LEVELS and __TS_TMAX in include/cam/integration/tanh_sinh.inl
+#define LEVELS 8      // Steps 1, 1/2, ..., 1/128
+#define TMAX 6.1      // Last t whose weight and distance to the end are normal doubles
+
+/* Nodes */
+// x = tanh(pi/2 sinh t) with weight pi/2 cosh t / cosh^2(pi/2 sinh t). The tables hold
+// 1 - x, which keeps its precision right up to the ends where x rounds to 1, computed
+// in long double and rounded once.
+static void node(long double t, double* d, double* w) {
+  const long double half_pi = 1.570796326794896619231321691639751442L;
+  long double u = half_pi * sinhl(t), c = coshl(u);
+  *d = (double)(expl(-u) / c);
+  *w = (double)(half_pi * coshl(t) / (c * c));
+}
+
+// t of node j of level k: j h0 on level 0, odd multiples of the step after it
+static long double node_t(int k, long j) {
+  return (k == 0) ? (long double)j : (long double)((2 * j) + 1) / (long double)(1L << k);
+}
+
+static long level_count(int k) {
+  long n = 0;
+  while (node_t(k, n) <= TMAX) { ++n; }
+  return n;
+}
+
+static void emit_array(FILE* f, const char* name, int which) {
+  fprintf(f, "static const double %s[] = {", name);
+  long i = 0;
+  for (int k = 0; k < LEVELS; ++k) {
+    long n = level_count(k);
+    for (long j = 0; j < n; ++j, ++i) {
+      double d, w;
+      node(node_t(k, j), &d, &w);
+      fprintf(f, "%s%.17g,", (i % 4 == 0) ? "\n  " : " ", which ? w : d);
+    }
+  }
+  fprintf(f, "\n};\n\n");
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: tanh_sinh_gen <output file>\n");
+    return 1;
+  }
+  FILE* f = fopen(argv[1], "w");
+  if (!f) {
+    fprintf(stderr, "tanh_sinh_gen: cannot write %s\n", argv[1]);
+    return 1;
+  }
+
+  fprintf(f, "/*\n * tanh_sinh_tables.inl\n * Tanh-sinh nodes of %d levels, t up to %.1f, generated by tools/tanh_sinh_gen.c.\n", LEVELS, TMAX);
+  fprintf(f, " * Included by tanh_sinh.inl: 1 - x and the weight of every node, level after level.\n */\n\n");
+  emit_array(f, "__ts_table_d", 0);
+  emit_array(f, "__ts_table_w", 1);
+  fprintf(f, "static const size_t __ts_table_offset[%d] = {", LEVELS + 1);
+  long offset = 0;
+  for (int k = 0; k <= LEVELS; ++k) {
+    fprintf(f, "%s%ld", (k == 0) ? " " : ", ", offset);
+    if (k < LEVELS) { offset += level_count(k); }
+  }
+  fprintf(f, " };\n");
+
+  if (fclose(f) != 0) {
+    fprintf(stderr, "tanh_sinh_gen: cannot write %s\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}